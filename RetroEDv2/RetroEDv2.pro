@@ -1,4 +1,4 @@
-QT       += core gui svg xml
+QT       += core gui svg xml concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets xml
 
@@ -88,9 +88,22 @@ SOURCES += \
     tools/sceneviewer.cpp \
     tools/scriptcompiler.cpp \
     tools/userdbmanager.cpp \
+    tools/utils/activeranges.cpp \
+    tools/utils/chunkatlas.cpp \
+    tools/utils/entitycounts.cpp \
+    tools/utils/filtervarindex.cpp \
+    tools/utils/modelmesh.cpp \
     tools/utils/modelviewer.cpp \
+    tools/utils/objectgroups.cpp \
+    tools/utils/palettetexture.cpp \
     tools/utils/propertygrid.cpp \
+    tools/utils/tileatlas.cpp \
+    tools/utils/tilededuplicator.cpp \
+    tools/utils/tileusageindex.cpp \
+    tools/utils/userdbmodel.cpp \
     utils/appconfig.cpp \
+    utils/csvstream.cpp \
+    utils/frameprofiler.cpp \
     utils/retroedutils.cpp \
     utils/shaders.cpp \
     main.cpp \
@@ -161,9 +174,22 @@ HEADERS += \
     tools/sceneviewer.hpp \
     tools/scriptcompiler.hpp \
     tools/userdbmanager.hpp \
+    tools/utils/activeranges.hpp \
+    tools/utils/chunkatlas.hpp \
+    tools/utils/entitycounts.hpp \
+    tools/utils/filtervarindex.hpp \
+    tools/utils/modelmesh.hpp \
     tools/utils/modelviewer.hpp \
+    tools/utils/objectgroups.hpp \
+    tools/utils/palettetexture.hpp \
     tools/utils/propertygrid.hpp \
+    tools/utils/tileatlas.hpp \
+    tools/utils/tilededuplicator.hpp \
+    tools/utils/tileusageindex.hpp \
+    tools/utils/userdbmodel.hpp \
     utils/appconfig.hpp \
+    utils/csvstream.hpp \
+    utils/frameprofiler.hpp \
     utils/retroedutils.hpp \
     utils/shaders.hpp \
     includes.hpp \
@@ -111,36 +111,41 @@ void RSDKv2::GFX::write(Writer &writer, bool dcGFX)
     writer.flush();
 }
 
-void RSDKv2::GFX::importImage(QImage image)
+void RSDKv2::GFX::importImage(QImage image, bool dither)
 {
-    if (image.format() != QImage::Format_Indexed8) {
+    // 0xFF is the RLE marker, so only 255 colours are usable
+    QVector<QRgb> colors;
+    QByteArray indexed = Quantizer::toIndexed(image, colors, 0xFF, dither);
+    if (image.isNull())
         return;
-    }
 
-    int w = image.width();
-    int h = image.height();
-    pixels.resize(w * h);
+    setPalette(colors);
 
-    int size = image.colorCount();
-    for (int c = 0; c < size; ++c) {
-        palette[c] = Color(qRed(image.color(c)), qGreen(image.color(c)), qBlue(image.color(c)));
-    }
+    width  = image.width();
+    height = image.height();
+    pixels = indexed;
+}
 
-    for (int c = size; c < 0xFF; ++c) {
-        palette[c] = Color(0xFF, 0x00, 0xFF);
-    }
+void RSDKv2::GFX::importImage(QImage image, const QVector<QRgb> &targetPalette, bool dither)
+{
+    if (image.isNull() || targetPalette.isEmpty())
+        return;
 
-    int i  = 0;
-    width  = w;
-    height = h;
-    for (int y = 0; y < image.height(); ++y) {
-        for (int x = 0; x < image.width(); ++x) {
-            if (image.format() == QImage::Format_Indexed8)
-                pixels[i++] = (byte)image.pixelIndex(x, y);
-            else
-                pixels[i++] = 0;
-        }
-    }
+    QVector<QRgb> colors = targetPalette.mid(0, 0xFF);
+    setPalette(colors);
+
+    width  = image.width();
+    height = image.height();
+    pixels = Quantizer::remap(image, colors, 0, dither);
+}
+
+void RSDKv2::GFX::setPalette(const QVector<QRgb> &colors)
+{
+    int size = qMin(colors.count(), 0xFF);
+    for (int c = 0; c < size; ++c)
+        palette[c] = Color(qRed(colors[c]), qGreen(colors[c]), qBlue(colors[c]));
+
+    for (int c = size; c < 0xFF; ++c) palette[c] = Color(0xFF, 0x00, 0xFF);
 }
 
 void RSDKv2::GFX::importImage(FormatHelpers::Gif image)
@@ -151,7 +156,7 @@ void RSDKv2::GFX::importImage(FormatHelpers::Gif image)
     pixels.resize(w * h);
 
     for (int c = 0; c < 0xFF; ++c)
-        palette[c] = Color(image.palette[c].red(), image.palette[c].green(), image.palette[c].blue());
+        palette[c] = Color(qRed(image.palette[c]), qGreen(image.palette[c]), qBlue(image.palette[c]));
 
     int i  = 0;
     width  = w;
@@ -193,7 +198,7 @@ FormatHelpers::Gif RSDKv2::GFX::exportGif()
 
     for (int i = 0; i < 0xFF; ++i) {
         Color c        = palette[i];
-        img.palette[i] = QColor(c.r, c.g, c.b);
+        img.palette[i] = qRgb(c.r, c.g, c.b);
     }
 
     for (int y = 0; y < height; ++y) {
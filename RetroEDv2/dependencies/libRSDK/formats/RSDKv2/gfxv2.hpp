@@ -28,7 +28,10 @@ public:
     }
     void write(Writer &writer, bool dcGFX = false);
 
-    void importImage(QImage image);
+    // true colour images are quantized, indexed ones keep their palette as long as it fits
+    void importImage(QImage image, bool dither = false);
+    // maps the image onto targetPalette (eg. a stage palette), index 0 is kept for transparency
+    void importImage(QImage image, const QVector<QRgb> &targetPalette, bool dither = false);
     void importImage(FormatHelpers::Gif image);
 
     QImage exportImage();
@@ -40,6 +43,9 @@ public:
     QByteArray pixels;
 
     QString filePath = "";
+
+private:
+    void setPalette(const QVector<QRgb> &colors);
 };
 
 } // namespace RSDKv2
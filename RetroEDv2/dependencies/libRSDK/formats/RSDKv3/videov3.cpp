@@ -3,6 +3,26 @@
 #include "videov3.hpp"
 
 void RSDKv3::Video::read(Reader &reader)
+{
+    readIndex(reader);
+
+    frames.clear();
+    frames.reserve(frameIndex.count());
+    for (int f = 0; f < frameIndex.count(); f += batchSize()) {
+        int count = qMin(batchSize(), frameIndex.count() - f);
+
+        ushort w = width, h = height;
+        QList<QFuture<FormatHelpers::Gif>> tasks;
+        for (int i = 0; i < count; ++i) {
+            QByteArray data = readFrameData(reader, f + i);
+            tasks.append(QtConcurrent::run([data, w, h] { return decodeFrame(data, w, h); }));
+        }
+
+        for (auto &task : tasks) frames.append(task.result());
+    }
+}
+
+void RSDKv3::Video::readIndex(Reader &reader)
 {
     filePath = reader.filePath;
 
@@ -10,44 +30,87 @@ void RSDKv3::Video::read(Reader &reader)
     width             = reader.read<ushort>();
     height            = reader.read<ushort>();
 
+    // frame sizes include the size prefix itself
     int videoFilePos = (int)reader.tell();
-    frames.clear();
+    frameIndex.clear();
+    frameIndex.reserve(frameCount);
     for (int f = 0; f < frameCount; ++f) {
-        uint frameSize = reader.read<uint>();
-
-        FormatHelpers::Gif frame;
-        frame.width  = width;
-        frame.height = height;
-        frame.read(reader, true, 0x80);
+        reader.seek(videoFilePos);
 
-        frames.append(frame);
+        FrameInfo info;
+        uint frameSize = reader.read<uint>();
+        info.offset    = videoFilePos + 4;
+        info.size      = frameSize > 4 ? frameSize - 4 : 0;
+        frameIndex.append(info);
 
         videoFilePos += frameSize;
-        reader.seek(videoFilePos);
     }
 }
 
+QByteArray RSDKv3::Video::readFrameData(Reader &reader, int id)
+{
+    if (id < 0 || id >= frameIndex.count())
+        return QByteArray();
+
+    reader.seek(frameIndex[id].offset);
+    return reader.readByteArray(frameIndex[id].size);
+}
+
+FormatHelpers::Gif RSDKv3::Video::decodeFrame(const QByteArray &data, ushort width, ushort height)
+{
+    QByteArray bytes = data;
+    QBuffer buffer(&bytes);
+    buffer.open(QIODevice::ReadOnly);
+    Reader reader(new QDataStream(&buffer));
+
+    FormatHelpers::Gif frame;
+    frame.width  = width;
+    frame.height = height;
+    frame.read(reader, true, 0x80);
+    return frame;
+}
+
 void RSDKv3::Video::write(Writer &writer)
 {
     filePath = writer.filePath;
 
-    writer.write<ushort>(frames.count());
+    writeHeader(writer, frames.count());
+    for (int f = 0; f < frames.count(); f += batchSize()) {
+        int count = qMin(batchSize(), frames.count() - f);
+
+        QList<QFuture<QByteArray>> tasks;
+        for (int i = 0; i < count; ++i) {
+            // the batch is finished before frames can change, so the tasks can share each frame
+            const FormatHelpers::Gif &frame = frames.at(f + i);
+            tasks.append(QtConcurrent::run([&frame] { return encodeFrame(frame); }));
+        }
+
+        for (auto &task : tasks) writeFrameData(writer, task.result());
+    }
+    writer.flush();
+}
+
+void RSDKv3::Video::writeHeader(Writer &writer, ushort frameCount)
+{
+    writer.write<ushort>(frameCount);
     writer.write(width);
     writer.write(height);
+}
 
-    for (FormatHelpers::Gif frame : frames) {
-
-        QByteArray gifData;
-        QBuffer sbuffer(&gifData);
-        sbuffer.open(QIODevice::Append);
-        QDataStream *smem = new QDataStream(&sbuffer);
-        Writer swriter(smem);
+QByteArray RSDKv3::Video::encodeFrame(const FormatHelpers::Gif &frame)
+{
+    QByteArray gifData;
+    QBuffer sbuffer(&gifData);
+    sbuffer.open(QIODevice::Append);
+    Writer swriter(new QDataStream(&sbuffer));
 
-        frame.write(swriter, true, true);
-        swriter.flush();
+    frame.encode(swriter, true, true);
+    swriter.flush();
+    return gifData;
+}
 
-        writer.write<uint>(gifData.count() + 4);
-        writer.write(gifData);
-    }
-    writer.flush();
+void RSDKv3::Video::writeFrameData(Writer &writer, const QByteArray &data)
+{
+    writer.write<uint>(data.count() + 4);
+    writer.write(data);
 }
@@ -28,6 +28,25 @@ public:
     }
     void write(Writer &writer);
 
+    // streaming helpers, these let frames be decoded/encoded in batches without
+    // keeping the whole video in memory
+    void readIndex(Reader &reader);
+    QByteArray readFrameData(Reader &reader, int id);
+    static FormatHelpers::Gif decodeFrame(const QByteArray &data, ushort width, ushort height);
+
+    void writeHeader(Writer &writer, ushort frameCount);
+    static QByteArray encodeFrame(const FormatHelpers::Gif &frame);
+    static void writeFrameData(Writer &writer, const QByteArray &data);
+
+    // how many frames to keep in flight at once when streaming
+    static inline int batchSize() { return qMax(QThread::idealThreadCount(), 1) * 4; }
+
+    struct FrameInfo {
+        qint64 offset = 0; // start of the gif data, past the size prefix
+        uint size     = 0;
+    };
+
+    QList<FrameInfo> frameIndex;
     QList<FormatHelpers::Gif> frames;
 
     ushort width  = 0x100;
@@ -107,40 +107,54 @@ void RSDKv4::Model::writeAsOBJ(QString filePath, int exportFrame)
     }
 }
 
-int RSDKv4::Model::getPLYPropertyType(QString propertyType)
+void RSDKv4::Model::loadOBJ(QString filePath)
 {
-    QString type = propertyType;
-    type         = type.toLower();
+    texCoords.clear();
+    frames.clear();
+    indices.clear();
 
-    if (type == "char" || type == "int8") {
-        return PLYPropTypes::INT8;
-    }
-    else if (type == "uchar" || type == "uint8") {
-        return PLYPropTypes::UINT8;
-    }
-    else if (type == "short" || type == "int16") {
-        return PLYPropTypes::INT16;
-    }
-    else if (type == "ushort" || type == "uint16") {
-        return PLYPropTypes::UINT16;
-    }
-    else if (type == "int32" || type == "int") {
-        return PLYPropTypes::INT32;
-    }
-    else if (type == "uint32" || type == "uint") {
-        return PLYPropTypes::UINT32;
+    FormatHelpers::OBJ obj;
+    if (!obj.read(filePath)) {
+        frames.append(Frame());
+        return;
     }
-    else if (type == "float" || type == "float32") {
-        return PLYPropTypes::FLOAT;
+
+    frames.reserve(obj.frames.count());
+    for (auto &objFrame : obj.frames) {
+        Frame frame;
+        frame.vertices.reserve(obj.vertexCount);
+        for (int v = 0; v < obj.vertexCount; ++v) {
+            Frame::Vertex vertex;
+            vertex.x  = objFrame.positions[v * 3 + 0];
+            vertex.y  = objFrame.positions[v * 3 + 1];
+            vertex.z  = objFrame.positions[v * 3 + 2];
+            vertex.nx = objFrame.normals[v * 3 + 0];
+            vertex.ny = objFrame.normals[v * 3 + 1];
+            vertex.nz = objFrame.normals[v * 3 + 2];
+            frame.vertices.append(vertex);
+        }
+        frames.append(frame);
     }
-    else if (type == "double64" || type == "double" || type == "float64") {
-        return PLYPropTypes::DOUBLE;
+
+    texCoords.reserve(obj.vertexCount);
+    for (int v = 0; v < obj.vertexCount; ++v) {
+        TexCoord texCoord;
+        texCoord.x = obj.texCoords[v * 2 + 0];
+        texCoord.y = obj.texCoords[v * 2 + 1];
+        texCoords.append(texCoord);
     }
-    else if (type == "list") {
-        return PLYPropTypes::LIST;
+
+    if (obj.faceVerticesCount != 4) {
+        indices.reserve(obj.indices.count());
+        for (ushort index : obj.indices) indices.append(index);
+        return;
     }
 
-    return PLYPropTypes::UNKNOWN;
+    // v4 models are only ever triangles, so quads are split in two
+    indices.reserve(obj.indices.count() / 4 * 6);
+    for (int i = 0; i + 3 < obj.indices.count(); i += 4) {
+        for (int c : { 0, 1, 2, 0, 2, 3 }) indices.append(obj.indices[i + c]);
+    }
 }
 
 void RSDKv4::Model::loadPLY(QString filePath)
@@ -151,550 +165,32 @@ void RSDKv4::Model::loadPLY(QString filePath)
 
     frames.append(Frame());
 
-    Reader reader(filePath);
-
-    QString signature = reader.readLine().toLower();
-    if (signature != "ply")
+    FormatHelpers::PLY ply;
+    if (!ply.read(filePath))
         return;
 
-    QStringList format = reader.readLine().split(" ");
-    if (format.count() < 3 || format[0].toLower() != "format")
-        return;
-
-    bool binary    = format[1].toLower() != "ascii";
-    bool bigEndian = format[1].toLower().contains("big_endian");
-
-    QList<PLYElement> elements;
-
-    while (!reader.isEOF()) {
-        QStringList line = reader.readLine().split(" ");
-        if (!line.count())
-            continue;
-
-        QString instruction = line[0].toLower();
-        if (instruction == "end_header")
-            break;
-
-        if (instruction == "element") {
-            PLYElement element;
-            element.name = line[1];
-
-            bool ok  = false;
-            int size = line[2].toInt(&ok);
-            if (ok) {
-                element.propertyValues.clear();
-                for (int i = 0; i < size; ++i) element.propertyValues.append(PLYPropertyValue());
-            }
-
-            elements.append(element);
-        }
-
-        if (instruction == "property") {
-            if (!elements.count()) {
-                // error
-                continue;
-            }
-
-            PLYProperty property;
-            property.type = line[1].toLower();
-            if (property.type == "list") {
-                property.sizeType = line[2].toLower();
-                property.itemType = line[3].toLower();
-                property.name     = line[4];
-            }
-            else {
-                property.name = line[2];
-            }
-
-            elements.last().properties.append(property);
-        }
-    }
-
-    if (binary) {
-        if (bigEndian) {
-            // TODO: this
-            for (auto &element : elements) {
-
-                // read each property value
-            }
-        }
-        else {
-            // little endian :)
-            for (auto &element : elements) {
-
-                // read each property value
-
-                for (int i = 0; i < element.propertyValues.count(); ++i) {
-                    int p = 0;
-                    element.propertyValues[i].values.clear();
-
-                    for (auto &property : element.properties) {
-
-                        if (property.type == "list") {
-                            int size = 0;
-                            switch (getPLYPropertyType(property.sizeType)) {
-                                default: break;
-                                case PLYPropTypes::INT8: size = reader.read<sbyte>(); break;
-                                case PLYPropTypes::UINT8: size = reader.read<byte>(); break;
-                                case PLYPropTypes::INT16: size = reader.read<short>(); break;
-                                case PLYPropTypes::UINT16: size = reader.read<ushort>(); break;
-                                case PLYPropTypes::INT32: size = reader.read<int>(); break;
-                                case PLYPropTypes::UINT32: size = (int)reader.read<uint>(); break;
-                                case PLYPropTypes::FLOAT: size = (int)reader.read<float>(); break;
-                                case PLYPropTypes::DOUBLE: size = (int)reader.read<double>(); break;
-                            }
-
-                            for (int s = 0; s < size; ++s) {
-                                QVariant value = "";
-                                switch (getPLYPropertyType(property.itemType)) {
-                                    default: break;
-                                    case PLYPropTypes::INT8: value = reader.read<sbyte>(); break;
-                                    case PLYPropTypes::UINT8: value = reader.read<byte>(); break;
-                                    case PLYPropTypes::INT16: value = reader.read<short>(); break;
-                                    case PLYPropTypes::UINT16: value = reader.read<ushort>(); break;
-                                    case PLYPropTypes::INT32: value = reader.read<int>(); break;
-                                    case PLYPropTypes::UINT32: value = reader.read<uint>(); break;
-                                    case PLYPropTypes::FLOAT: value = reader.read<float>(); break;
-                                    case PLYPropTypes::DOUBLE: value = reader.read<double>(); break;
-                                }
-
-                                element.propertyValues[i].values.append(value);
-                            }
-                            break;
-                        }
-                        else {
-                            QVariant value = "";
-                            switch (getPLYPropertyType(property.type)) {
-                                default: break;
-                                case PLYPropTypes::INT8: value = reader.read<sbyte>(); break;
-                                case PLYPropTypes::UINT8: value = reader.read<byte>(); break;
-                                case PLYPropTypes::INT16: value = reader.read<short>(); break;
-                                case PLYPropTypes::UINT16: value = reader.read<ushort>(); break;
-                                case PLYPropTypes::INT32: value = reader.read<int>(); break;
-                                case PLYPropTypes::UINT32: value = reader.read<uint>(); break;
-                                case PLYPropTypes::FLOAT: value = reader.read<float>(); break;
-                                case PLYPropTypes::DOUBLE: value = reader.read<double>(); break;
-                            }
-
-                            element.propertyValues[i].values.append(value);
-
-                            ++p;
-                        }
-                    }
-                }
-            }
-        }
+    Frame &frame = frames[0];
+    frame.vertices.reserve(ply.vertexCount);
+    texCoords.reserve(ply.vertexCount);
+
+    for (int v = 0; v < ply.vertexCount; ++v) {
+        Frame::Vertex vertex;
+        vertex.x  = ply.positions[v * 3 + 0];
+        vertex.y  = ply.positions[v * 3 + 1];
+        vertex.z  = ply.positions[v * 3 + 2];
+        vertex.nx = ply.normals[v * 3 + 0];
+        vertex.ny = ply.normals[v * 3 + 1];
+        vertex.nz = ply.normals[v * 3 + 2];
+        frame.vertices.append(vertex);
+
+        TexCoord texCoord;
+        texCoord.x = ply.texCoords[v * 2 + 0];
+        texCoord.y = ply.texCoords[v * 2 + 1];
+        texCoords.append(texCoord);
     }
-    else {
-        // ascii
-        for (auto &element : elements) {
-            // assume each index is a property value
-            QStringList line = reader.readLine().split(" ");
-
-            for (int i = 0; i < element.propertyValues.count(); ++i) {
-                int p = 0;
-                for (auto &property : element.properties) {
-
-                    if (property.type == "list") {
-                        int size = 0;
-                        bool ok  = false;
-                        switch (getPLYPropertyType(property.sizeType)) {
-                            default: break;
-                            case PLYPropTypes::INT8: size = (sbyte)line[0].toInt(&ok); break;
-                            case PLYPropTypes::UINT8: size = (byte)line[0].toInt(&ok); break;
-                            case PLYPropTypes::INT16: size = (short)line[0].toInt(&ok); break;
-                            case PLYPropTypes::UINT16: size = (ushort)line[0].toInt(&ok); break;
-                            case PLYPropTypes::INT32: size = line[0].toInt(&ok); break;
-                            case PLYPropTypes::UINT32: size = (int)line[0].toInt(&ok); break;
-                            case PLYPropTypes::FLOAT: size = (int)line[0].toFloat(&ok); break;
-                            case PLYPropTypes::DOUBLE: size = (int)line[0].toDouble(&ok); break;
-                        }
-
-                        for (int s = 0; s < size; ++s)
-                            element.propertyValues[i].values.append(QVariant(line[1 + s]));
-
-                        break;
-                    }
-                    else {
-                        element.propertyValues[i].values.append(QVariant(line[p]));
-
-                        ++p;
-                    }
-                }
-            }
-        }
-    }
-
-    for (auto &element : elements) {
-        QString name = element.name.toLower();
 
-        if (name == "vertex") {
-            frames[0].vertices.clear();
-            texCoords.clear();
-
-            // Fill up all the blanks
-            for (int v = 0; v < element.propertyValues.count(); ++v) {
-                frames[0].vertices.append(Frame::Vertex());
-                texCoords.append(TexCoord());
-            }
-
-            int p = 0;
-            for (auto &property : element.properties) {
-                QString name = property.name.toLower();
-                int v        = 0;
-
-                // VERTEX POSITION
-                {
-                    if (name == "x") {
-                        for (auto &propertyValue : element.propertyValues) {
-                            bool ok = false;
-                            switch (getPLYPropertyType(property.type)) {
-                                default: break;
-                                case PLYPropTypes::INT8:
-                                    frames[0].vertices[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT8:
-                                    frames[0].vertices[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT16:
-                                    frames[0].vertices[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT16:
-                                    frames[0].vertices[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT32:
-                                    frames[0].vertices[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT32:
-                                    frames[0].vertices[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::FLOAT:
-                                    frames[0].vertices[v].x = propertyValue.values[p].toFloat(&ok);
-                                    break;
-                                case PLYPropTypes::DOUBLE:
-                                    frames[0].vertices[v].x = propertyValue.values[p].toDouble(&ok);
-                                    break;
-                            }
-
-                            ++v;
-                        }
-                    }
-
-                    if (name == "y") {
-                        for (auto &propertyValue : element.propertyValues) {
-                            bool ok = false;
-                            switch (getPLYPropertyType(property.type)) {
-                                default: break;
-                                case PLYPropTypes::INT8:
-                                    frames[0].vertices[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT8:
-                                    frames[0].vertices[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT16:
-                                    frames[0].vertices[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT16:
-                                    frames[0].vertices[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT32:
-                                    frames[0].vertices[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT32:
-                                    frames[0].vertices[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::FLOAT:
-                                    frames[0].vertices[v].y = propertyValue.values[p].toFloat(&ok);
-                                    break;
-                                case PLYPropTypes::DOUBLE:
-                                    frames[0].vertices[v].y = propertyValue.values[p].toDouble(&ok);
-                                    break;
-                            }
-
-                            ++v;
-                        }
-                    }
-
-                    if (name == "z") {
-                        for (auto &propertyValue : element.propertyValues) {
-                            bool ok = false;
-                            switch (getPLYPropertyType(property.type)) {
-                                default: break;
-                                case PLYPropTypes::INT8:
-                                    frames[0].vertices[v].z = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT8:
-                                    frames[0].vertices[v].z = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT16:
-                                    frames[0].vertices[v].z = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT16:
-                                    frames[0].vertices[v].z = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT32:
-                                    frames[0].vertices[v].z = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT32:
-                                    frames[0].vertices[v].z = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::FLOAT:
-                                    frames[0].vertices[v].z = propertyValue.values[p].toFloat(&ok);
-                                    break;
-                                case PLYPropTypes::DOUBLE:
-                                    frames[0].vertices[v].z = propertyValue.values[p].toDouble(&ok);
-                                    break;
-                            }
-
-                            ++v;
-                        }
-                    }
-                }
-
-                // VERTEX NORMALS
-                {
-                    if (name == "nx") {
-                        for (auto &propertyValue : element.propertyValues) {
-                            bool ok = false;
-                            switch (getPLYPropertyType(property.type)) {
-                                default: break;
-                                case PLYPropTypes::INT8:
-                                    frames[0].vertices[v].nx = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT8:
-                                    frames[0].vertices[v].nx = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT16:
-                                    frames[0].vertices[v].nx = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT16:
-                                    frames[0].vertices[v].nx = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT32:
-                                    frames[0].vertices[v].nx = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT32:
-                                    frames[0].vertices[v].nx = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::FLOAT:
-                                    frames[0].vertices[v].nx = propertyValue.values[p].toFloat(&ok);
-                                    break;
-                                case PLYPropTypes::DOUBLE:
-                                    frames[0].vertices[v].nx = propertyValue.values[p].toDouble(&ok);
-                                    break;
-                            }
-
-                            ++v;
-                        }
-                    }
-
-                    if (name == "ny") {
-                        for (auto &propertyValue : element.propertyValues) {
-                            bool ok = false;
-                            switch (getPLYPropertyType(property.type)) {
-                                default: break;
-                                case PLYPropTypes::INT8:
-                                    frames[0].vertices[v].ny = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT8:
-                                    frames[0].vertices[v].ny = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT16:
-                                    frames[0].vertices[v].ny = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT16:
-                                    frames[0].vertices[v].ny = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT32:
-                                    frames[0].vertices[v].ny = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT32:
-                                    frames[0].vertices[v].ny = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::FLOAT:
-                                    frames[0].vertices[v].ny = propertyValue.values[p].toFloat(&ok);
-                                    break;
-                                case PLYPropTypes::DOUBLE:
-                                    frames[0].vertices[v].ny = propertyValue.values[p].toDouble(&ok);
-                                    break;
-                            }
-
-                            ++v;
-                        }
-                    }
-
-                    if (name == "nz") {
-                        for (auto &propertyValue : element.propertyValues) {
-                            bool ok = false;
-                            switch (getPLYPropertyType(property.type)) {
-                                default: break;
-                                case PLYPropTypes::INT8:
-                                    frames[0].vertices[v].nz = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT8:
-                                    frames[0].vertices[v].nz = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT16:
-                                    frames[0].vertices[v].nz = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT16:
-                                    frames[0].vertices[v].nz = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT32:
-                                    frames[0].vertices[v].nz = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT32:
-                                    frames[0].vertices[v].nz = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::FLOAT:
-                                    frames[0].vertices[v].nz = propertyValue.values[p].toFloat(&ok);
-                                    break;
-                                case PLYPropTypes::DOUBLE:
-                                    frames[0].vertices[v].nz = propertyValue.values[p].toDouble(&ok);
-                                    break;
-                            }
-
-                            ++v;
-                        }
-                    }
-                }
-
-                // VERTEX TEXTURE COORDS
-                {
-                    if (name == "u" || name == "s" || name == "tx" || name == "texture_u") {
-                        for (auto &propertyValue : element.propertyValues) {
-                            bool ok = false;
-                            switch (getPLYPropertyType(property.type)) {
-                                default: break;
-                                case PLYPropTypes::INT8:
-                                    texCoords[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT8:
-                                    texCoords[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT16:
-                                    texCoords[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT16:
-                                    texCoords[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT32:
-                                    texCoords[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT32:
-                                    texCoords[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::FLOAT:
-                                    texCoords[v].x = propertyValue.values[p].toFloat(&ok);
-                                    break;
-                                case PLYPropTypes::DOUBLE:
-                                    texCoords[v].x = propertyValue.values[p].toDouble(&ok);
-                                    break;
-                            }
-
-                            ++v;
-                        }
-                    }
-
-                    if (name == "v" || name == "t" || name == "ty" || name == "texture_v") {
-                        for (auto &propertyValue : element.propertyValues) {
-                            bool ok = false;
-                            switch (getPLYPropertyType(property.type)) {
-                                default: break;
-                                case PLYPropTypes::INT8:
-                                    texCoords[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT8:
-                                    texCoords[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT16:
-                                    texCoords[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT16:
-                                    texCoords[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT32:
-                                    texCoords[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT32:
-                                    texCoords[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::FLOAT:
-                                    texCoords[v].y = propertyValue.values[p].toFloat(&ok);
-                                    break;
-                                case PLYPropTypes::DOUBLE:
-                                    texCoords[v].y = propertyValue.values[p].toDouble(&ok);
-                                    break;
-                            }
-
-                            ++v;
-                        }
-                    }
-                }
-
-                ++p;
-            }
-            // read vertices
-        }
-    }
-
-    for (auto &element : elements) {
-        QString name = element.name.toLower();
-
-        if (name == "face") {
-            // read indices
-
-            int p = 0;
-            for (auto &property : element.properties) {
-                if (property.type == "list")
-                    break;
-                ++p;
-            }
-
-            indices.clear();
-            if (p != element.properties.count()) {
-                for (auto &propertyValue : element.propertyValues) {
-                    // they should all be the same, but in the 1% chance it's not, update it
-                    int faceVerticesCount = propertyValue.values.count();
-
-                    for (int i = 0; i < faceVerticesCount; ++i) {
-                        ushort index = 0;
-
-                        bool ok = false;
-                        switch (getPLYPropertyType(element.properties[p].itemType)) {
-                            default: break;
-                            case PLYPropTypes::INT8:
-                                index = (sbyte)propertyValue.values[i].toInt(&ok);
-                                break;
-                            case PLYPropTypes::UINT8:
-                                index = (byte)propertyValue.values[i].toInt(&ok);
-                                break;
-                            case PLYPropTypes::INT16:
-                                index = (short)propertyValue.values[i].toInt(&ok);
-                                break;
-                            case PLYPropTypes::UINT16:
-                                index = propertyValue.values[i].toInt(&ok);
-                                break;
-                            case PLYPropTypes::INT32:
-                                index = (ushort)propertyValue.values[i].toInt(&ok);
-                                break;
-                            case PLYPropTypes::UINT32:
-                                index = (ushort)propertyValue.values[i].toInt(&ok);
-                                break;
-                            case PLYPropTypes::FLOAT:
-                                index = (ushort)propertyValue.values[i].toFloat(&ok);
-                                break;
-                            case PLYPropTypes::DOUBLE:
-                                index = (ushort)propertyValue.values[i].toDouble(&ok);
-                                break;
-                        }
-
-                        indices.append(index);
-                    }
-                }
-            }
-        }
-    }
+    indices.reserve(ply.indices.count());
+    for (ushort index : ply.indices) indices.append(index);
 }
 
 void RSDKv4::Model::writeAsPLY(QString filePath, int exportFrame)
@@ -170,43 +170,7 @@ void RSDKv5::Model::writeMTL(QString filepath)
     writer.flush();
 }
 
-int RSDKv5::Model::getPLYPropertyType(QString propertyType)
-{
-    QString type = propertyType;
-    type         = type.toLower();
-
-    if (type == "char" || type == "int8") {
-        return PLYPropTypes::INT8;
-    }
-    else if (type == "uchar" || type == "uint8") {
-        return PLYPropTypes::UINT8;
-    }
-    else if (type == "short" || type == "int16") {
-        return PLYPropTypes::INT16;
-    }
-    else if (type == "ushort" || type == "uint16") {
-        return PLYPropTypes::UINT16;
-    }
-    else if (type == "int32" || type == "int") {
-        return PLYPropTypes::INT32;
-    }
-    else if (type == "uint32" || type == "uint") {
-        return PLYPropTypes::UINT32;
-    }
-    else if (type == "float" || type == "float32") {
-        return PLYPropTypes::FLOAT;
-    }
-    else if (type == "double64" || type == "double" || type == "float64") {
-        return PLYPropTypes::DOUBLE;
-    }
-    else if (type == "list") {
-        return PLYPropTypes::LIST;
-    }
-
-    return PLYPropTypes::UNKNOWN;
-}
-
-void RSDKv5::Model::loadPLY(QString filePath)
+void RSDKv5::Model::loadOBJ(QString filePath)
 {
     hasColors         = false;
     hasNormals        = false;
@@ -218,724 +182,107 @@ void RSDKv5::Model::loadPLY(QString filePath)
     colors.clear();
     indices.clear();
 
-    frames.append(Frame());
-
-    Reader reader(filePath);
-
-    QString signature = reader.readLine().toLower();
-    if (signature != "ply")
-        return;
-
-    QStringList format = reader.readLine().split(" ");
-    if (format.count() < 3 || format[0].toLower() != "format")
+    FormatHelpers::OBJ obj;
+    if (!obj.read(filePath)) {
+        frames.append(Frame());
         return;
+    }
 
-    bool binary    = format[1].toLower() != "ascii";
-    bool bigEndian = format[1].toLower().contains("big_endian");
-
-    QList<PLYElement> elements;
-
-    while (!reader.isEOF()) {
-        QStringList line = reader.readLine().split(" ");
-        if (!line.count())
-            continue;
-
-        QString instruction = line[0].toLower();
-        if (instruction == "end_header")
-            break;
-
-        if (instruction == "element") {
-            PLYElement element;
-            element.name = line[1];
-
-            bool ok  = false;
-            int size = line[2].toInt(&ok);
-            if (ok) {
-                element.propertyValues.clear();
-                for (int i = 0; i < size; ++i) element.propertyValues.append(PLYPropertyValue());
-            }
-
-            elements.append(element);
-        }
-
-        if (instruction == "property") {
-            if (!elements.count()) {
-                // error
-                continue;
-            }
-
-            PLYProperty property;
-            property.type = line[1].toLower();
-            if (property.type == "list") {
-                property.sizeType = line[2].toLower();
-                property.itemType = line[3].toLower();
-                property.name     = line[4];
-            }
-            else {
-                property.name = line[2];
-            }
+    hasNormals        = obj.hasNormals;
+    hasTextures       = obj.hasTextures;
+    hasColors         = obj.hasColors;
+    faceVerticesCount = obj.faceVerticesCount;
 
-            elements.last().properties.append(property);
+    frames.reserve(obj.frames.count());
+    for (auto &objFrame : obj.frames) {
+        Frame frame;
+        frame.vertices.reserve(obj.vertexCount);
+        for (int v = 0; v < obj.vertexCount; ++v) {
+            Frame::Vertex vertex;
+            vertex.x  = objFrame.positions[v * 3 + 0];
+            vertex.y  = objFrame.positions[v * 3 + 1];
+            vertex.z  = objFrame.positions[v * 3 + 2];
+            vertex.nx = objFrame.normals[v * 3 + 0];
+            vertex.ny = objFrame.normals[v * 3 + 1];
+            vertex.nz = objFrame.normals[v * 3 + 2];
+            frame.vertices.append(vertex);
         }
+        frames.append(frame);
     }
 
-    if (binary) {
-        if (bigEndian) {
-            // TODO: this
-            for (auto &element : elements) {
-                Q_UNUSED(element);
-                // read each property value
-            }
-        }
-        else {
-            // little endian :)
-            for (auto &element : elements) {
-
-                // read each property value
-
-                for (int i = 0; i < element.propertyValues.count(); ++i) {
-                    int p = 0;
-                    element.propertyValues[i].values.clear();
-
-                    for (auto &property : element.properties) {
-
-                        if (property.type == "list") {
-                            int size = 0;
-                            switch (getPLYPropertyType(property.sizeType)) {
-                                default: break;
-                                case PLYPropTypes::INT8: size = reader.read<sbyte>(); break;
-                                case PLYPropTypes::UINT8: size = reader.read<byte>(); break;
-                                case PLYPropTypes::INT16: size = reader.read<short>(); break;
-                                case PLYPropTypes::UINT16: size = reader.read<ushort>(); break;
-                                case PLYPropTypes::INT32: size = reader.read<int>(); break;
-                                case PLYPropTypes::UINT32: size = (int)reader.read<uint>(); break;
-                                case PLYPropTypes::FLOAT: size = (int)reader.read<float>(); break;
-                                case PLYPropTypes::DOUBLE: size = (int)reader.read<double>(); break;
-                            }
-
-                            for (int s = 0; s < size; ++s) {
-                                QVariant value = "";
-                                switch (getPLYPropertyType(property.itemType)) {
-                                    default: break;
-                                    case PLYPropTypes::INT8: value = reader.read<sbyte>(); break;
-                                    case PLYPropTypes::UINT8: value = reader.read<byte>(); break;
-                                    case PLYPropTypes::INT16: value = reader.read<short>(); break;
-                                    case PLYPropTypes::UINT16: value = reader.read<ushort>(); break;
-                                    case PLYPropTypes::INT32: value = reader.read<int>(); break;
-                                    case PLYPropTypes::UINT32: value = reader.read<uint>(); break;
-                                    case PLYPropTypes::FLOAT: value = reader.read<float>(); break;
-                                    case PLYPropTypes::DOUBLE: value = reader.read<double>(); break;
-                                }
-
-                                element.propertyValues[i].values.append(value);
-                            }
-                            break;
-                        }
-                        else {
-                            QVariant value = "";
-                            switch (getPLYPropertyType(property.type)) {
-                                default: break;
-                                case PLYPropTypes::INT8: value = reader.read<sbyte>(); break;
-                                case PLYPropTypes::UINT8: value = reader.read<byte>(); break;
-                                case PLYPropTypes::INT16: value = reader.read<short>(); break;
-                                case PLYPropTypes::UINT16: value = reader.read<ushort>(); break;
-                                case PLYPropTypes::INT32: value = reader.read<int>(); break;
-                                case PLYPropTypes::UINT32: value = reader.read<uint>(); break;
-                                case PLYPropTypes::FLOAT: value = reader.read<float>(); break;
-                                case PLYPropTypes::DOUBLE: value = reader.read<double>(); break;
-                            }
-
-                            element.propertyValues[i].values.append(value);
-
-                            ++p;
-                        }
-                    }
-                }
-            }
-        }
-    }
-    else {
-        // ascii
-        for (auto &element : elements) {
-            // assume each index is a property value
-            QStringList line = reader.readLine().split(" ");
-
-            for (int i = 0; i < element.propertyValues.count(); ++i) {
-                int p = 0;
-                for (auto &property : element.properties) {
-
-                    if (property.type == "list") {
-                        int size = 0;
-                        bool ok  = false;
-                        switch (getPLYPropertyType(property.sizeType)) {
-                            default: break;
-                            case PLYPropTypes::INT8: size = (sbyte)line[0].toInt(&ok); break;
-                            case PLYPropTypes::UINT8: size = (byte)line[0].toInt(&ok); break;
-                            case PLYPropTypes::INT16: size = (short)line[0].toInt(&ok); break;
-                            case PLYPropTypes::UINT16: size = (ushort)line[0].toInt(&ok); break;
-                            case PLYPropTypes::INT32: size = line[0].toInt(&ok); break;
-                            case PLYPropTypes::UINT32: size = (int)line[0].toInt(&ok); break;
-                            case PLYPropTypes::FLOAT: size = (int)line[0].toFloat(&ok); break;
-                            case PLYPropTypes::DOUBLE: size = (int)line[0].toDouble(&ok); break;
-                        }
-
-                        for (int s = 0; s < size; ++s)
-                            element.propertyValues[i].values.append(QVariant(line[1 + s]));
-
-                        break;
-                    }
-                    else {
-                        element.propertyValues[i].values.append(QVariant(line[p]));
-
-                        ++p;
-                    }
-                }
-            }
-        }
+    colors.reserve(obj.vertexCount);
+    texCoords.reserve(obj.vertexCount);
+    for (int v = 0; v < obj.vertexCount; ++v) {
+        Color color;
+        color.r = obj.colors[v * 4 + 0];
+        color.g = obj.colors[v * 4 + 1];
+        color.b = obj.colors[v * 4 + 2];
+        color.a = obj.colors[v * 4 + 3];
+        colors.append(color);
+
+        TexCoord texCoord;
+        texCoord.x = obj.texCoords[v * 2 + 0];
+        texCoord.y = obj.texCoords[v * 2 + 1];
+        texCoords.append(texCoord);
     }
 
-    for (auto &element : elements) {
-        QString name = element.name.toLower();
-
-        if (name == "vertex") {
-            frames[0].vertices.clear();
-            colors.clear();
-            texCoords.clear();
-
-            // Fill up all the blanks
-            for (int v = 0; v < element.propertyValues.count(); ++v) {
-                frames[0].vertices.append(Frame::Vertex());
-                colors.append(Color());
-                texCoords.append(TexCoord());
-            }
+    indices.reserve(obj.indices.count());
+    for (ushort index : obj.indices) indices.append(index);
+}
 
-            int p = 0;
-            for (auto &property : element.properties) {
-                QString name = property.name.toLower();
-                int v        = 0;
-
-                // VERTEX POSITION
-                {
-                    if (name == "x") {
-                        for (auto &propertyValue : element.propertyValues) {
-                            bool ok = false;
-                            switch (getPLYPropertyType(property.type)) {
-                                default: break;
-                                case PLYPropTypes::INT8:
-                                    frames[0].vertices[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT8:
-                                    frames[0].vertices[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT16:
-                                    frames[0].vertices[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT16:
-                                    frames[0].vertices[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT32:
-                                    frames[0].vertices[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT32:
-                                    frames[0].vertices[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::FLOAT:
-                                    frames[0].vertices[v].x = propertyValue.values[p].toFloat(&ok);
-                                    break;
-                                case PLYPropTypes::DOUBLE:
-                                    frames[0].vertices[v].x = propertyValue.values[p].toDouble(&ok);
-                                    break;
-                            }
-
-                            ++v;
-                        }
-                    }
-
-                    if (name == "y") {
-                        for (auto &propertyValue : element.propertyValues) {
-                            bool ok = false;
-                            switch (getPLYPropertyType(property.type)) {
-                                default: break;
-                                case PLYPropTypes::INT8:
-                                    frames[0].vertices[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT8:
-                                    frames[0].vertices[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT16:
-                                    frames[0].vertices[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT16:
-                                    frames[0].vertices[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT32:
-                                    frames[0].vertices[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT32:
-                                    frames[0].vertices[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::FLOAT:
-                                    frames[0].vertices[v].y = propertyValue.values[p].toFloat(&ok);
-                                    break;
-                                case PLYPropTypes::DOUBLE:
-                                    frames[0].vertices[v].y = propertyValue.values[p].toDouble(&ok);
-                                    break;
-                            }
-
-                            ++v;
-                        }
-                    }
-
-                    if (name == "z") {
-                        for (auto &propertyValue : element.propertyValues) {
-                            bool ok = false;
-                            switch (getPLYPropertyType(property.type)) {
-                                default: break;
-                                case PLYPropTypes::INT8:
-                                    frames[0].vertices[v].z = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT8:
-                                    frames[0].vertices[v].z = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT16:
-                                    frames[0].vertices[v].z = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT16:
-                                    frames[0].vertices[v].z = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT32:
-                                    frames[0].vertices[v].z = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT32:
-                                    frames[0].vertices[v].z = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::FLOAT:
-                                    frames[0].vertices[v].z = propertyValue.values[p].toFloat(&ok);
-                                    break;
-                                case PLYPropTypes::DOUBLE:
-                                    frames[0].vertices[v].z = propertyValue.values[p].toDouble(&ok);
-                                    break;
-                            }
-
-                            ++v;
-                        }
-                    }
-                }
+void RSDKv5::Model::loadPLY(QString filePath)
+{
+    hasColors         = false;
+    hasNormals        = false;
+    hasTextures       = false;
+    faceVerticesCount = 3;
 
-                // VERTEX NORMALS
-                {
-                    if (name == "nx") {
-                        if (element.propertyValues.count())
-                            hasNormals = true;
-
-                        for (auto &propertyValue : element.propertyValues) {
-                            bool ok = false;
-                            switch (getPLYPropertyType(property.type)) {
-                                default: break;
-                                case PLYPropTypes::INT8:
-                                    frames[0].vertices[v].nx = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT8:
-                                    frames[0].vertices[v].nx = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT16:
-                                    frames[0].vertices[v].nx = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT16:
-                                    frames[0].vertices[v].nx = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT32:
-                                    frames[0].vertices[v].nx = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT32:
-                                    frames[0].vertices[v].nx = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::FLOAT:
-                                    frames[0].vertices[v].nx = propertyValue.values[p].toFloat(&ok);
-                                    break;
-                                case PLYPropTypes::DOUBLE:
-                                    frames[0].vertices[v].nx = propertyValue.values[p].toDouble(&ok);
-                                    break;
-                            }
-
-                            ++v;
-                        }
-                    }
-
-                    if (name == "ny") {
-                        if (element.propertyValues.count())
-                            hasNormals = true;
-
-                        for (auto &propertyValue : element.propertyValues) {
-                            bool ok = false;
-                            switch (getPLYPropertyType(property.type)) {
-                                default: break;
-                                case PLYPropTypes::INT8:
-                                    frames[0].vertices[v].ny = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT8:
-                                    frames[0].vertices[v].ny = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT16:
-                                    frames[0].vertices[v].ny = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT16:
-                                    frames[0].vertices[v].ny = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT32:
-                                    frames[0].vertices[v].ny = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT32:
-                                    frames[0].vertices[v].ny = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::FLOAT:
-                                    frames[0].vertices[v].ny = propertyValue.values[p].toFloat(&ok);
-                                    break;
-                                case PLYPropTypes::DOUBLE:
-                                    frames[0].vertices[v].ny = propertyValue.values[p].toDouble(&ok);
-                                    break;
-                            }
-
-                            ++v;
-                        }
-                    }
-
-                    if (name == "nz") {
-                        if (element.propertyValues.count())
-                            hasNormals = true;
-
-                        for (auto &propertyValue : element.propertyValues) {
-                            bool ok = false;
-                            switch (getPLYPropertyType(property.type)) {
-                                default: break;
-                                case PLYPropTypes::INT8:
-                                    frames[0].vertices[v].nz = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT8:
-                                    frames[0].vertices[v].nz = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT16:
-                                    frames[0].vertices[v].nz = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT16:
-                                    frames[0].vertices[v].nz = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT32:
-                                    frames[0].vertices[v].nz = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT32:
-                                    frames[0].vertices[v].nz = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::FLOAT:
-                                    frames[0].vertices[v].nz = propertyValue.values[p].toFloat(&ok);
-                                    break;
-                                case PLYPropTypes::DOUBLE:
-                                    frames[0].vertices[v].nz = propertyValue.values[p].toDouble(&ok);
-                                    break;
-                            }
-
-                            ++v;
-                        }
-                    }
-                }
+    texCoords.clear();
+    frames.clear();
+    colors.clear();
+    indices.clear();
 
-                // VERTEX TEXTURE COORDS
-                {
-                    if (name == "u" || name == "s" || name == "tx" || name == "texture_u") {
-                        if (element.propertyValues.count())
-                            hasTextures = true;
-
-                        for (auto &propertyValue : element.propertyValues) {
-                            bool ok = false;
-                            switch (getPLYPropertyType(property.type)) {
-                                default: break;
-                                case PLYPropTypes::INT8:
-                                    texCoords[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT8:
-                                    texCoords[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT16:
-                                    texCoords[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT16:
-                                    texCoords[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT32:
-                                    texCoords[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT32:
-                                    texCoords[v].x = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::FLOAT:
-                                    texCoords[v].x = propertyValue.values[p].toFloat(&ok);
-                                    break;
-                                case PLYPropTypes::DOUBLE:
-                                    texCoords[v].x = propertyValue.values[p].toDouble(&ok);
-                                    break;
-                            }
-
-                            ++v;
-                        }
-                    }
-
-                    if (name == "v" || name == "t" || name == "ty" || name == "texture_v") {
-                        if (element.propertyValues.count())
-                            hasTextures = true;
-
-                        for (auto &propertyValue : element.propertyValues) {
-                            bool ok = false;
-                            switch (getPLYPropertyType(property.type)) {
-                                default: break;
-                                case PLYPropTypes::INT8:
-                                    texCoords[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT8:
-                                    texCoords[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT16:
-                                    texCoords[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT16:
-                                    texCoords[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT32:
-                                    texCoords[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT32:
-                                    texCoords[v].y = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::FLOAT:
-                                    texCoords[v].y = propertyValue.values[p].toFloat(&ok);
-                                    break;
-                                case PLYPropTypes::DOUBLE:
-                                    texCoords[v].y = propertyValue.values[p].toDouble(&ok);
-                                    break;
-                            }
-
-                            ++v;
-                        }
-                    }
-                }
+    frames.append(Frame());
 
-                // VERTEX COLORS
-                {
-                    if (name == "r" || name == "red") {
-                        if (element.propertyValues.count())
-                            hasColors = true;
-
-                        for (auto &propertyValue : element.propertyValues) {
-                            bool ok = false;
-                            switch (getPLYPropertyType(property.type)) {
-                                default: break;
-                                case PLYPropTypes::INT8:
-                                    colors[v].r = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT8:
-                                    colors[v].r = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT16:
-                                    colors[v].r = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT16:
-                                    colors[v].r = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT32:
-                                    colors[v].r = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT32:
-                                    colors[v].r = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::FLOAT:
-                                    colors[v].r = propertyValue.values[p].toFloat(&ok) * 255.0f;
-                                    break;
-                                case PLYPropTypes::DOUBLE:
-                                    colors[v].r = propertyValue.values[p].toDouble(&ok) * 255.0f;
-                                    break;
-                            }
-
-                            ++v;
-                        }
-                    }
-
-                    if (name == "g" || name == "green") {
-                        if (element.propertyValues.count())
-                            hasColors = true;
-
-                        for (auto &propertyValue : element.propertyValues) {
-                            bool ok = false;
-                            switch (getPLYPropertyType(property.type)) {
-                                default: break;
-                                case PLYPropTypes::INT8:
-                                    colors[v].g = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT8:
-                                    colors[v].g = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT16:
-                                    colors[v].g = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT16:
-                                    colors[v].g = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT32:
-                                    colors[v].g = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT32:
-                                    colors[v].g = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::FLOAT:
-                                    colors[v].g = propertyValue.values[p].toFloat(&ok) * 255.0f;
-                                    break;
-                                case PLYPropTypes::DOUBLE:
-                                    colors[v].g = propertyValue.values[p].toDouble(&ok) * 255.0f;
-                                    break;
-                            }
-
-                            ++v;
-                        }
-                    }
-
-                    if (name == "b" || name == "blue") {
-                        if (element.propertyValues.count())
-                            hasColors = true;
-
-                        for (auto &propertyValue : element.propertyValues) {
-                            bool ok = false;
-                            switch (getPLYPropertyType(property.type)) {
-                                default: break;
-                                case PLYPropTypes::INT8:
-                                    colors[v].b = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT8:
-                                    colors[v].b = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT16:
-                                    colors[v].b = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT16:
-                                    colors[v].b = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT32:
-                                    colors[v].b = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT32:
-                                    colors[v].b = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::FLOAT:
-                                    colors[v].b = propertyValue.values[p].toFloat(&ok) * 255.0f;
-                                    break;
-                                case PLYPropTypes::DOUBLE:
-                                    colors[v].b = propertyValue.values[p].toDouble(&ok) * 255.0f;
-                                    break;
-                            }
-
-                            ++v;
-                        }
-                    }
-
-                    if (name == "a" || name == "alpha") {
-                        if (element.propertyValues.count())
-                            hasColors = true;
-
-                        for (auto &propertyValue : element.propertyValues) {
-                            bool ok = false;
-                            switch (getPLYPropertyType(property.type)) {
-                                default: break;
-                                case PLYPropTypes::INT8:
-                                    colors[v].a = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT8:
-                                    colors[v].a = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT16:
-                                    colors[v].a = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT16:
-                                    colors[v].a = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::INT32:
-                                    colors[v].a = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::UINT32:
-                                    colors[v].a = propertyValue.values[p].toInt(&ok);
-                                    break;
-                                case PLYPropTypes::FLOAT:
-                                    colors[v].a = propertyValue.values[p].toFloat(&ok) * 255.0f;
-                                    break;
-                                case PLYPropTypes::DOUBLE:
-                                    colors[v].a = propertyValue.values[p].toDouble(&ok) * 255.0f;
-                                    break;
-                            }
-
-                            ++v;
-                        }
-                    }
-                }
+    FormatHelpers::PLY ply;
+    if (!ply.read(filePath))
+        return;
 
-                ++p;
-            }
-            // read vertices
-        }
+    hasNormals        = ply.hasNormals;
+    hasTextures       = ply.hasTextures;
+    hasColors         = ply.hasColors;
+    faceVerticesCount = ply.faceVerticesCount;
+
+    Frame &frame = frames[0];
+    frame.vertices.reserve(ply.vertexCount);
+    colors.reserve(ply.vertexCount);
+    texCoords.reserve(ply.vertexCount);
+
+    for (int v = 0; v < ply.vertexCount; ++v) {
+        Frame::Vertex vertex;
+        vertex.x  = ply.positions[v * 3 + 0];
+        vertex.y  = ply.positions[v * 3 + 1];
+        vertex.z  = ply.positions[v * 3 + 2];
+        vertex.nx = ply.normals[v * 3 + 0];
+        vertex.ny = ply.normals[v * 3 + 1];
+        vertex.nz = ply.normals[v * 3 + 2];
+        frame.vertices.append(vertex);
+
+        Color color;
+        color.r = ply.colors[v * 4 + 0];
+        color.g = ply.colors[v * 4 + 1];
+        color.b = ply.colors[v * 4 + 2];
+        color.a = ply.colors[v * 4 + 3];
+        colors.append(color);
+
+        TexCoord texCoord;
+        texCoord.x = ply.texCoords[v * 2 + 0];
+        texCoord.y = ply.texCoords[v * 2 + 1];
+        texCoords.append(texCoord);
     }
 
-    for (auto &element : elements) {
-        QString name = element.name.toLower();
-
-        if (name == "face") {
-            // read indices
-
-            int p = 0;
-            for (auto &property : element.properties) {
-                if (property.type == "list")
-                    break;
-                ++p;
-            }
-
-            indices.clear();
-            if (p != element.properties.count()) {
-                for (auto &propertyValue : element.propertyValues) {
-                    // they should all be the same, but in the 1% chance it's not, update it
-                    faceVerticesCount = propertyValue.values.count();
-
-                    for (int i = 0; i < faceVerticesCount; ++i) {
-                        ushort index = 0;
-
-                        bool ok = false;
-                        switch (getPLYPropertyType(element.properties[p].itemType)) {
-                            default: break;
-                            case PLYPropTypes::INT8:
-                                index = (sbyte)propertyValue.values[i].toInt(&ok);
-                                break;
-                            case PLYPropTypes::UINT8:
-                                index = (byte)propertyValue.values[i].toInt(&ok);
-                                break;
-                            case PLYPropTypes::INT16:
-                                index = (short)propertyValue.values[i].toInt(&ok);
-                                break;
-                            case PLYPropTypes::UINT16:
-                                index = propertyValue.values[i].toInt(&ok);
-                                break;
-                            case PLYPropTypes::INT32:
-                                index = (ushort)propertyValue.values[i].toInt(&ok);
-                                break;
-                            case PLYPropTypes::UINT32:
-                                index = (ushort)propertyValue.values[i].toInt(&ok);
-                                break;
-                            case PLYPropTypes::FLOAT:
-                                index = (ushort)propertyValue.values[i].toFloat(&ok);
-                                break;
-                            case PLYPropTypes::DOUBLE:
-                                index = (ushort)propertyValue.values[i].toDouble(&ok);
-                                break;
-                        }
-
-                        indices.append(index);
-                    }
-                }
-            }
-        }
-    }
+    indices.reserve(ply.indices.count());
+    for (ushort index : ply.indices) indices.append(index);
 }
 
 void RSDKv5::Model::writeAsPLY(QString filePath, int exportFrame)
@@ -2,188 +2,400 @@
 
 #include "replayv5.hpp"
 
-void RSDKv5::Replay::read(Reader &reader)
+namespace
 {
-    filePath       = reader.filePath;
-    Reader creader = reader.getCReaderRaw();
 
-    uint sig = creader.read<uint>();
+// frames are stored in native byte order, the same as Reader/Writer
+template <typename T> inline void readRaw(const byte *&data, T &value)
+{
+    memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+}
+
+template <typename T> inline void appendRaw(QByteArray &buffer, T value)
+{
+    buffer.append((const char *)&value, sizeof(T));
+}
+
+} // namespace
+
+void RSDKv5::Replay::read(Reader &reader) { load(reader, &frames); }
+
+bool RSDKv5::Replay::open(Reader &reader) { return load(reader, nullptr); }
+
+bool RSDKv5::Replay::load(Reader &reader, FrameColumns *decoded)
+{
+    filePath = reader.filePath;
+
+    packedFrames.clear();
+    packedFrameCount = 0;
+    seekIndex.clear();
+    if (decoded)
+        decoded->clear();
+
+    QByteArray data = reader.readZLib(true);
+    reader.close();
+
+    if (data.size() < headerSize)
+        return false;
+
+    const byte *ptr = (const byte *)data.constData();
+    const byte *end = ptr + data.size();
+
+    uint sig = 0;
+    readRaw(ptr, sig);
     if (sig != signature) {
         // error
-        creader.close();
-        reader.close();
-        return;
+        return false;
     }
 
-    gameVer         = creader.read<int>();
-    isPacked        = creader.read<uint>() != 0;
-    bool isNotEmpty = creader.read<uint>() != 0;
-    int frameCount  = creader.read<int>();
-    startingFrame   = creader.read<int>();
-    zoneID          = creader.read<int>();
-    act             = creader.read<int>();
-    characterID     = creader.read<int>();
-    isPlusLayout    = creader.read<uint>() != 0;
-    oscillation     = creader.read<int>();
-    int bufferSize  = creader.read<int>();
-    unknown1        = creader.read<float>();
-    unknown2        = creader.read<int>();
+    uint packed     = 0;
+    uint isNotEmpty = 0;
+    uint plusLayout = 0;
+    int frameCount  = 0;
+    int bufferSize  = 0;
+    readRaw(ptr, gameVer);
+    readRaw(ptr, packed);
+    readRaw(ptr, isNotEmpty);
+    readRaw(ptr, frameCount);
+    readRaw(ptr, startingFrame);
+    readRaw(ptr, zoneID);
+    readRaw(ptr, act);
+    readRaw(ptr, characterID);
+    readRaw(ptr, plusLayout);
+    readRaw(ptr, oscillation);
+    readRaw(ptr, bufferSize);
+    readRaw(ptr, unknown1);
+    readRaw(ptr, unknown2);
 
     Q_UNUSED(isNotEmpty);
-    Q_UNUSED(startingFrame);
     Q_UNUSED(bufferSize);
-    Q_UNUSED(unknown1);
-    Q_UNUSED(unknown2);
 
-    for (int f = 0; f < frameCount; ++f) {
-        ReplayEntry entry;
-        entry.unpack(creader, isPacked);
-        frames.append(entry);
+    isPacked     = packed != 0;
+    isPlusLayout = plusLayout != 0;
+
+    // every frame is at least 2 bytes, so a corrupted count can't make us allocate past the data
+    frameCount = (int)qMax<qint64>(qMin<qint64>(frameCount, (end - ptr) / 2), 0);
+    seekIndex.reserve(frameCount / seekInterval + 1);
+    if (decoded)
+        decoded->reserve(frameCount);
+
+    ReplayEntry state;
+    int f = 0;
+    for (; f < frameCount; ++f) {
+        if (!decoded && !(f % seekInterval)) {
+            SeekPoint point;
+            point.offset = (int)(ptr - (const byte *)data.constData());
+            point.state  = state;
+            seekIndex.append(point);
+        }
+
+        if (!state.decode(ptr, end, isPacked))
+            break;
+
+        if (decoded)
+            decoded->append(state);
     }
 
-    creader.close();
-    reader.close();
+    // a full read has everything in frames, so only an opened file keeps the inflated stream around
+    if (!decoded)
+        packedFrames = data;
+    packedFrameCount = f;
+    return true;
+}
+
+RSDKv5::Replay::FrameColumns RSDKv5::Replay::decodeFrames(int start, int count) const
+{
+    FrameColumns columns;
+
+    if (!isStreamed())
+        return frames.mid(start, count);
+
+    start = qMax(start, 0);
+    count = qMin(count, packedFrameCount - start);
+    if (count <= 0)
+        return columns;
+
+    columns.reserve(count);
+
+    int first              = start / seekInterval;
+    const SeekPoint &point = seekIndex[first];
+    const byte *ptr        = (const byte *)packedFrames.constData() + point.offset;
+    const byte *end        = (const byte *)packedFrames.constData() + packedFrames.size();
+    ReplayEntry state      = point.state;
+
+    for (int f = first * seekInterval; f < start + count; ++f) {
+        if (!state.decode(ptr, end, isPacked))
+            break;
+
+        if (f >= start)
+            columns.append(state);
+    }
+
+    return columns;
+}
+
+RSDKv5::Replay::ReplayEntry RSDKv5::Replay::decodeFrame(int f) const
+{
+    FrameColumns columns = decodeFrames(f, 1);
+    return columns.count() ? columns.at(0) : ReplayEntry();
 }
 
 void RSDKv5::Replay::write(Writer &writer)
 {
     filePath = writer.filePath;
 
-    QByteArray compressed;
-    QBuffer buffer(&compressed);
-    buffer.open(QIODevice::Append);
-    QDataStream *cmem = new QDataStream(&buffer);
-    Writer cwriter(cmem);
-
-    QByteArray frameBuffer;
-    QBuffer fbuffer(&frameBuffer);
-    fbuffer.open(QIODevice::Append);
-    QDataStream *fmem = new QDataStream(&fbuffer);
-    Writer fwriter(fmem);
-
-    int bufferSize = 0;
-    for (int f = 0; f < frames.count(); ++f) {
-        bufferSize += frames[f].pack(fwriter, isPacked);
-    }
-    fwriter.flush();
+    writeFrames(writer, frames);
+}
+
+void RSDKv5::Replay::exportFrames(Writer &writer, int start, int count)
+{
+    // use the loaded frames if there are any, otherwise decode the range straight from the opened file
+    FrameColumns columns = frames.count() ? frames.mid(start, count) : decodeFrames(start, count);
+
+    // the first frame has nothing before it to carry values over from, so store its full state
+    if (columns.count())
+        columns.flags[0] |= 0xF7;
 
+    writeFrames(writer, columns);
+}
+
+void RSDKv5::Replay::writeFrames(Writer &writer, const FrameColumns &columns)
+{
+    QByteArray data;
+    data.reserve(headerSize + columns.count() * ReplayEntry::packedSize(1, 0xFF, isPacked));
+
+    appendRaw<uint>(data, signature);
+    appendRaw<int>(data, gameVer);
+    appendRaw<uint>(data, isPacked);
+    appendRaw<uint>(data, true);
+    appendRaw<int>(data, columns.count());
+    appendRaw<int>(data, startingFrame);
+    appendRaw<int>(data, zoneID);
+    appendRaw<int>(data, act);
+    appendRaw<int>(data, characterID);
+    appendRaw<uint>(data, isPlusLayout);
+    appendRaw<int>(data, oscillation);
+    appendRaw<int>(data, 0); // bufferSize, filled in below
+    appendRaw<float>(data, unknown1);
+    appendRaw<int>(data, unknown2);
+
+    for (int f = 0; f < columns.count(); ++f) columns.at(f).encode(data, isPacked);
+
+    int bufferSize = data.size() - headerSize;
     if (!isPacked) {
-        bufferSize = 28 * (frames.count() + 2);
+        bufferSize = 28 * (columns.count() + 2);
     }
+    memcpy(data.data() + 11 * sizeof(int), &bufferSize, sizeof(int));
 
-    cwriter.write<uint>(signature);
-    cwriter.write<int>(gameVer);
-    cwriter.write<uint>(isPacked);
-    cwriter.write<uint>(true);
-    cwriter.write<int>(frames.count());
-    cwriter.write<int>(startingFrame);
-    cwriter.write<int>(zoneID);
-    cwriter.write<int>(act);
-    cwriter.write<int>(characterID);
-    cwriter.write<uint>(isPlusLayout);
-    cwriter.write<int>(oscillation);
-    cwriter.write<int>(bufferSize);
-    cwriter.write<float>(unknown1);
-    cwriter.write<int>(unknown2);
-    cwriter.write(frameBuffer);
-    cwriter.flush();
-
-    writer.writeCompressedRaw(compressed);
+    writer.writeCompressedRaw(data);
     writer.flush();
 }
 
-int RSDKv5::Replay::ReplayEntry::unpack(Reader &reader, bool isPacked)
+void RSDKv5::Replay::FrameColumns::clear()
 {
-    int pos = reader.tell();
+    info.clear();
+    flags.clear();
+    inputs.clear();
+    direction.clear();
+    position.clear();
+    velocity.clear();
+    rotation.clear();
+    anim.clear();
+    frame.clear();
+}
 
-    info  = reader.read<byte>();
-    flags = reader.read<byte>();
+void RSDKv5::Replay::FrameColumns::reserve(int count)
+{
+    info.reserve(count);
+    flags.reserve(count);
+    inputs.reserve(count);
+    direction.reserve(count);
+    position.reserve(count);
+    velocity.reserve(count);
+    rotation.reserve(count);
+    anim.reserve(count);
+    frame.reserve(count);
+}
+
+void RSDKv5::Replay::FrameColumns::append(const ReplayEntry &entry)
+{
+    info.append(entry.info);
+    flags.append(entry.flags);
+    inputs.append(entry.inputs);
+    direction.append(entry.direction);
+    position.append(entry.position);
+    velocity.append(entry.velocity);
+    rotation.append(entry.rotation);
+    anim.append(entry.anim);
+    frame.append(entry.frame);
+}
+
+void RSDKv5::Replay::FrameColumns::set(int f, const ReplayEntry &entry)
+{
+    info[f]      = entry.info;
+    flags[f]     = entry.flags;
+    inputs[f]    = entry.inputs;
+    direction[f] = entry.direction;
+    position[f]  = entry.position;
+    velocity[f]  = entry.velocity;
+    rotation[f]  = entry.rotation;
+    anim[f]      = entry.anim;
+    frame[f]     = entry.frame;
+}
+
+RSDKv5::Replay::ReplayEntry RSDKv5::Replay::FrameColumns::at(int f) const
+{
+    ReplayEntry entry;
+    entry.info      = info[f];
+    entry.flags     = flags[f];
+    entry.inputs    = inputs[f];
+    entry.direction = direction[f];
+    entry.position  = position[f];
+    entry.velocity  = velocity[f];
+    entry.rotation  = rotation[f];
+    entry.anim      = anim[f];
+    entry.frame     = frame[f];
+    return entry;
+}
+
+RSDKv5::Replay::FrameColumns RSDKv5::Replay::FrameColumns::mid(int start, int count) const
+{
+    FrameColumns columns;
+
+    start = qMax(start, 0);
+    count = qMin(count, this->count() - start);
+    if (count <= 0)
+        return columns;
+
+    columns.info      = info.mid(start, count);
+    columns.flags     = flags.mid(start, count);
+    columns.inputs    = inputs.mid(start, count);
+    columns.direction = direction.mid(start, count);
+    columns.position  = position.mid(start, count);
+    columns.velocity  = velocity.mid(start, count);
+    columns.rotation  = rotation.mid(start, count);
+    columns.anim      = anim.mid(start, count);
+    columns.frame     = frame.mid(start, count);
+    return columns;
+}
+
+int RSDKv5::Replay::ReplayEntry::packedSize(byte info, byte flags, bool isPacked)
+{
+    if (!isPacked)
+        return 2 + 1 + 8 + 8 + 4 + 3;
+
+    bool flag = info == 1 || info == 3;
+
+    int size = 2;
+    if ((flags & 0x01) || flag)
+        size += 1;
+    if ((flags & 0x02) || flag)
+        size += 8;
+    if ((flags & 0x04) || flag)
+        size += 8;
+    if ((flags & 0x20) || flag)
+        size += 1;
+    if ((flags & 0x10) || flag)
+        size += 1;
+    if ((flags & 0x40) || flag)
+        size += 1;
+    if ((flags & 0x80) || flag)
+        size += 1;
+    return size;
+}
+
+bool RSDKv5::Replay::ReplayEntry::decode(const byte *&data, const byte *end, bool isPacked)
+{
+    if (end - data < 2 || end - data < packedSize(data[0], data[1], isPacked))
+        return false;
+
+    info  = *data++;
+    flags = *data++;
     if (isPacked) {
         bool flag = info == 1 || info == 3;
 
         if ((flags & 0x01) || flag)
-            inputs = reader.read<byte>();
+            inputs = *data++;
 
         if ((flags & 0x02) || flag) {
-            position.x = reader.read<int>();
-            position.y = reader.read<int>();
+            readRaw(data, position.x);
+            readRaw(data, position.y);
         }
         if ((flags & 0x04) || flag) {
-            velocity.x = reader.read<int>();
-            velocity.y = reader.read<int>();
+            readRaw(data, velocity.x);
+            readRaw(data, velocity.y);
         }
 
         if ((flags & 0x20) || flag)
-            rotation = reader.read<byte>() << 1;
+            rotation = *data++ << 1;
 
         if ((flags & 0x10) || flag)
-            direction = reader.read<byte>();
+            direction = *data++;
 
         if ((flags & 0x40) || flag)
-            anim = reader.read<byte>();
+            anim = *data++;
 
         if ((flags & 0x80) || flag)
-            frame = reader.read<byte>();
+            frame = *data++;
     }
     else {
-        inputs     = reader.read<byte>();
-        position.x = reader.read<int>();
-        position.y = reader.read<int>();
-        velocity.x = reader.read<int>();
-        velocity.y = reader.read<int>();
-        rotation   = reader.read<int>();
-        direction  = reader.read<byte>();
-        anim       = reader.read<byte>();
-        frame      = reader.read<byte>();
+        inputs = *data++;
+        readRaw(data, position.x);
+        readRaw(data, position.y);
+        readRaw(data, velocity.x);
+        readRaw(data, velocity.y);
+        readRaw(data, rotation);
+        direction = *data++;
+        anim      = *data++;
+        frame     = *data++;
     }
-    return reader.tell() - pos;
-}
-int RSDKv5::Replay::ReplayEntry::pack(Writer &writer, bool isPacked)
-{
-    int pos = writer.tell();
 
-    writer.write(info);
+    return true;
+}
 
-    bool flag = info == 1 || info == 3;
-    writer.write(flags);
+void RSDKv5::Replay::ReplayEntry::encode(QByteArray &buffer, bool isPacked) const
+{
+    buffer.append((char)info);
+    buffer.append((char)flags);
 
     if (isPacked) {
+        bool flag = info == 1 || info == 3;
+
         if (flag || (flags & 0x01))
-            writer.write(inputs);
+            buffer.append((char)inputs);
 
         if (flag || (flags & 0x02)) {
-            writer.write(position.x);
-            writer.write(position.y);
+            appendRaw(buffer, position.x);
+            appendRaw(buffer, position.y);
         }
 
         if (flag || (flags & 0x04)) {
-            writer.write(velocity.x);
-            writer.write(velocity.y);
+            appendRaw(buffer, velocity.x);
+            appendRaw(buffer, velocity.y);
         }
 
         if (flag || (flags & 0x20))
-            writer.write((byte)(rotation >> 1));
+            buffer.append((char)(byte)(rotation >> 1));
 
         if (flag || (flags & 0x10))
-            writer.write(direction);
+            buffer.append((char)direction);
 
         if (flag || (flags & 0x40))
-            writer.write(anim);
+            buffer.append((char)anim);
 
         if (flag || (flags & 0x80))
-            writer.write(frame);
+            buffer.append((char)frame);
     }
     else {
-        writer.write(inputs);
-        writer.write(position.x);
-        writer.write(position.y);
-        writer.write(velocity.x);
-        writer.write(velocity.y);
-        writer.write(rotation);
-        writer.write(direction);
-        writer.write(anim);
-        writer.write(frame);
+        buffer.append((char)inputs);
+        appendRaw(buffer, position.x);
+        appendRaw(buffer, position.y);
+        appendRaw(buffer, velocity.x);
+        appendRaw(buffer, velocity.y);
+        appendRaw(buffer, rotation);
+        buffer.append((char)direction);
+        buffer.append((char)anim);
+        buffer.append((char)frame);
     }
-
-    return writer.tell() - pos;
 }
@@ -23,8 +23,38 @@ public:
 
         ReplayEntry() {}
 
-        int unpack(Reader &reader, bool isPacked);
-        int pack(Writer &writer, bool isPacked);
+        // packed frames only store the fields that changed, anything missing keeps its previous value
+        bool decode(const byte *&data, const byte *end, bool isPacked);
+        void encode(QByteArray &buffer, bool isPacked) const;
+
+        static int packedSize(byte info, byte flags, bool isPacked);
+    };
+
+    // one array per field instead of a list of entries, keeps long replays compact & cheap to scan
+    class FrameColumns
+    {
+    public:
+        QVector<byte> info;
+        QVector<byte> flags;
+        QVector<byte> inputs;
+        QVector<byte> direction;
+        QVector<Vector2<int>> position;
+        QVector<Vector2<int>> velocity;
+        QVector<int> rotation;
+        QVector<byte> anim;
+        QVector<byte> frame;
+
+        FrameColumns() {}
+
+        inline int count() const { return info.count(); }
+
+        void clear();
+        void reserve(int count);
+        void append(const ReplayEntry &entry);
+        void set(int f, const ReplayEntry &entry);
+        ReplayEntry at(int f) const;
+
+        FrameColumns mid(int start, int count) const;
     };
 
     Replay() {}
@@ -38,6 +68,22 @@ public:
     }
     void read(Reader &reader);
 
+    // loads the header & builds the seek index without keeping any frames, decodeFrames fetches them
+    inline bool open(QString filename)
+    {
+        Reader reader(filename);
+        return open(reader);
+    }
+    bool open(Reader &reader);
+
+    // the total frames in the file, which may differ from frames.count() if only a window was decoded
+    inline int frameCount() const { return packedFrameCount; }
+    // true if frames are decoded from the opened file on demand, a read only keeps the decoded ones
+    inline bool isStreamed() const { return !packedFrames.isEmpty(); }
+
+    FrameColumns decodeFrames(int start, int count) const;
+    ReplayEntry decodeFrame(int f) const;
+
     inline void write(QString filename)
     {
         if (filename == "")
@@ -49,6 +95,14 @@ public:
     }
     void write(Writer &writer);
 
+    // writes frames [start, start + count) as a standalone replay
+    inline void exportFrames(QString filename, int start, int count)
+    {
+        Writer writer(filename);
+        exportFrames(writer, start, count);
+    }
+    void exportFrames(Writer &writer, int start, int count);
+
     // Header
     int gameVer       = 0;
     bool isPacked     = false;
@@ -61,9 +115,26 @@ public:
     float unknown1    = 0;
     int unknown2      = 0;
 
-    QList<ReplayEntry> frames = QList<ReplayEntry>();
+    FrameColumns frames;
 
     QString filePath = "";
+
+private:
+    // a full decoded state every seekInterval frames, so decoding never starts more than that far back
+    struct SeekPoint {
+        int offset = 0;
+        ReplayEntry state;
+    };
+
+    static const int seekInterval = 0x100;
+    static const int headerSize   = 14 * sizeof(int);
+
+    QByteArray packedFrames;
+    int packedFrameCount = 0;
+    QVector<SeekPoint> seekIndex;
+
+    bool load(Reader &reader, FrameColumns *decoded);
+    void writeFrames(Writer &writer, const FrameColumns &columns);
 };
 
 } // namespace RSDKv5
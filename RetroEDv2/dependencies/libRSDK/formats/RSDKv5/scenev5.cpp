@@ -59,12 +59,48 @@ void RSDKv5::Scene::VariableValue::write(Writer &writer)
     }
 }
 
+void RSDKv5::Scene::VariableValue::setType(byte newType)
+{
+    if (type <= VariableTypes::BOOL && newType <= VariableTypes::BOOL) {
+        int value = 0;
+        switch (type) {
+            case VariableTypes::UINT8: value = value_uint8; break;
+            case VariableTypes::UINT16: value = value_uint16; break;
+            case VariableTypes::UINT32: value = value_uint32; break;
+            case VariableTypes::INT8: value = value_int8; break;
+            case VariableTypes::INT16: value = value_int16; break;
+            case VariableTypes::INT32: value = value_int32; break;
+            case VariableTypes::ENUM: value = value_enum; break;
+            case VariableTypes::BOOL: value = value_bool ? 1 : 0; break;
+        }
+
+        // write the whole word first so no bytes of a wider type linger in a narrower one
+        value_uint32 = 0;
+        switch (newType) {
+            case VariableTypes::UINT8: value_uint8 = value; break;
+            case VariableTypes::UINT16: value_uint16 = value; break;
+            case VariableTypes::UINT32: value_uint32 = value; break;
+            case VariableTypes::INT8: value_int8 = value; break;
+            case VariableTypes::INT16: value_int16 = value; break;
+            case VariableTypes::INT32: value_int32 = value; break;
+            case VariableTypes::ENUM: value_enum = value; break;
+            case VariableTypes::BOOL: value_bool = value != 0; break;
+        }
+    }
+    else if (type != newType) {
+        // scalars share storage, don't carry the old bits over to an unrelated type
+        value_uint32 = 0;
+    }
+
+    type = newType;
+}
+
 void RSDKv5::Scene::SceneLayer::read(Reader &reader)
 {
     // I have no confirmation that this is what it is but you gotta trust me on this
     visible = reader.read<byte>();
 
-    name = reader.readString();
+    name = reader.readStringV5();
 
     type      = reader.read<byte>();
     drawGroup = reader.read<byte>();
@@ -80,12 +116,11 @@ void RSDKv5::Scene::SceneLayer::read(Reader &reader)
 
     lineScroll = reader.readZLib();
 
-    Reader creader = reader.getCReader();
+    QVector<ushort> tiles(width * height);
+    reader.readZLib(tiles.data(), tiles.count() * sizeof(ushort));
+
     layout.resize(height);
-    for (int y = 0; y < height; ++y) {
-        layout[y].resize(width);
-        for (int x = 0; x < width; ++x) layout[y][x] = creader.read<ushort>();
-    }
+    for (int y = 0; y < height; ++y) layout[y] = tiles.mid(y * width, width);
 
     scrollInfoFromIndices();
 }
@@ -93,10 +128,15 @@ void RSDKv5::Scene::SceneLayer::read(Reader &reader)
 void RSDKv5::Scene::SceneLayer::write(Writer &writer)
 {
     scrollIndicesFromInfo();
+    write(writer, Writer::compress(lineScroll), Writer::compress(layoutBytes()));
+}
 
+void RSDKv5::Scene::SceneLayer::write(Writer &writer, const QByteArray &packedLineScroll,
+                                      const QByteArray &packedLayout)
+{
     writer.write((byte)(visible ? 1 : 0));
 
-    writer.write(name + '\0');
+    writer.writeStringV5(name);
 
     writer.write(type);
     writer.write(drawGroup);
@@ -110,18 +150,19 @@ void RSDKv5::Scene::SceneLayer::write(Writer &writer)
     writer.write((ushort)scrollingInfo.count());
     for (ScrollInfo &info : scrollingInfo) info.write(writer);
 
-    writer.writeCompressed(lineScroll);
+    writer.writeCompressed(packedLineScroll, lineScroll.size());
+    writer.writeCompressed(packedLayout, width * height * sizeof(ushort));
+}
 
-    QByteArray bytes;
-    QBuffer buffer(&bytes);
-    buffer.open(QIODevice::WriteOnly);
-    QDataStream *mem = new QDataStream(&buffer);
-    Writer cwriter(mem);
+QByteArray RSDKv5::Scene::SceneLayer::layoutBytes()
+{
+    QByteArray bytes(width * height * sizeof(ushort), 0);
 
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) cwriter.write(layout[y][x]);
-    }
-    writer.writeCompressed(bytes);
+    ushort *dst = (ushort *)bytes.data();
+    for (int y = 0; y < height; ++y, dst += width)
+        memcpy(dst, layout[y].constData(), qMin((int)width, layout[y].count()) * sizeof(ushort));
+
+    return bytes;
 }
 
 void RSDKv5::Scene::SceneLayer::resize(ushort width, ushort height)
@@ -144,6 +185,7 @@ void RSDKv5::Scene::SceneLayer::resize(ushort width, ushort height)
         layout[y].resize(width);
         for (ushort x = oldWidth; x < width; ++x) layout[y][x] = 0;
     }
+    modified = true;
 }
 
 void RSDKv5::Scene::SceneLayer::scrollInfoFromIndices()
@@ -289,3 +331,60 @@ void RSDKv5::Scene::SceneEditorMetadata::write(Writer &writer)
     writer.write(stampName);
     writer.write(unknown9);
 }
+
+void RSDKv5::Scene::read(Reader &reader)
+{
+    filepath = reader.filePath;
+
+    if (!reader.matchesSignature(signature, 4))
+        return;
+
+    editorMetadata.read(reader);
+
+    byte layerCount = reader.read<byte>();
+    layers.clear();
+    for (int i = 0; i < layerCount; ++i) layers.append(SceneLayer(reader));
+
+    byte objectCount = reader.read<byte>();
+    objects.clear();
+    for (int i = 0; i < objectCount; ++i) objects.append(SceneObject(reader));
+}
+
+void RSDKv5::Scene::write(Writer &writer)
+{
+    filepath = writer.filePath;
+
+    // only blocks that changed since the last write are packed again, each on its own thread. every task
+    // writes to its own layer's members, & the list isn't touched until they're all done
+    QList<QFuture<void>> tasks;
+    for (SceneLayer &layer : layers) {
+        SceneLayer *packing = &layer;
+
+        layer.scrollIndicesFromInfo();
+        if (layer.packedLineScroll.isNull() || layer.lineScroll != layer.packedFromLineScroll) {
+            layer.packedFromLineScroll = layer.lineScroll;
+            tasks.append(QtConcurrent::run(
+                [packing] { packing->packedLineScroll = Writer::compress(packing->lineScroll); }));
+        }
+
+        if (layer.modified || layer.packedLayout.isNull()) {
+            layer.modified = false;
+            tasks.append(QtConcurrent::run(
+                [packing] { packing->packedLayout = Writer::compress(packing->layoutBytes()); }));
+        }
+    }
+    for (QFuture<void> &task : tasks) task.waitForFinished();
+
+    writer.write(signature, 4);
+
+    editorMetadata.write(writer);
+
+    writer.write((byte)layers.count());
+    for (int l = 0; l < layers.count(); ++l)
+        layers[l].write(writer, layers[l].packedLineScroll, layers[l].packedLayout);
+
+    writer.write((byte)objects.count());
+    for (SceneObject &obj : objects) obj.write(writer);
+
+    writer.flush();
+}
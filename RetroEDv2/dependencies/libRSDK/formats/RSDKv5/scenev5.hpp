@@ -128,13 +128,28 @@ public:
         // EDITOR-ONLY START
         bool visible = true;
 
+        // set it after changing layout, Scene::write only packs the layout of modified layers again &
+        // reuses what it packed last time for the rest
+        bool modified = true;
+        // what Scene::write last packed, lineScroll is rebuilt from scrollInfos every write so the raw
+        // bytes are kept to compare against (they're tiny next to the layout)
+        QByteArray packedLineScroll;
+        QByteArray packedLayout;
+        QByteArray packedFromLineScroll;
+
         // EDITOR-ONLY END
 
         SceneLayer() {}
         SceneLayer(Reader &reader) { read(reader); }
 
         void read(Reader &reader);
+        // packs everything again, without touching what Scene::write keeps
         void write(Writer &writer);
+        // writes with lineScroll & layout already compressed (see Writer::compress)
+        void write(Writer &writer, const QByteArray &packedLineScroll, const QByteArray &packedLayout);
+
+        // the layout as it's stored before compression
+        QByteArray layoutBytes();
 
         void resize(ushort width, ushort height);
 
@@ -231,21 +246,24 @@ public:
     class VariableValue
     {
     public:
-        byte value_uint8     = 0;
-        ushort value_uint16  = 0;
-        uint value_uint32    = 0;
-        sbyte value_int8     = 0;
-        short value_int16    = 0;
-        int value_int32      = 0;
-        int value_enum       = 0;
-        bool value_bool      = false;
-        QString value_string = "";
+        // only the member matching type is ever used, so the scalars can share storage
+        union {
+            uint value_uint32 = 0;
+            byte value_uint8;
+            ushort value_uint16;
+            sbyte value_int8;
+            short value_int16;
+            int value_int32;
+            int value_enum;
+            bool value_bool;
+            float value_float;
+        };
+        QString value_string;
         Vector2<int> value_vector2;
         Vector2<float> value_vector2f;
-        float value_float = 0;
         QColor value_color;
 
-        byte type;
+        byte type = 0;
 
         VariableValue() {}
         VariableValue(Reader &reader, int type)
@@ -256,6 +274,9 @@ public:
 
         void read(Reader &reader);
         void write(Writer &writer);
+
+        // switches to newType, scalar values are converted over & anything else starts cleared
+        void setType(byte newType);
     };
 
     class SceneObject;
@@ -267,6 +288,8 @@ public:
         Position position;
         SceneObject *parent = nullptr;
 
+        // a QList, so every value keeps its address while the list grows, the property editors
+        // & the game link hold pointers to them
         QList<VariableValue> variables;
         SceneEntity() {}
 
@@ -281,6 +304,7 @@ public:
             position.read(reader);
 
             variables.clear();
+            variables.reserve(vars.count());
             for (VariableInfo &variable : vars) variables.append(VariableValue(reader, variable.type));
         }
 
@@ -343,23 +367,7 @@ public:
         Reader reader(filename);
         read(reader);
     }
-    void read(Reader &reader)
-    {
-        filepath = reader.filePath;
-
-        if (!reader.matchesSignature(signature, 4))
-            return;
-
-        editorMetadata.read(reader);
-
-        byte layerCount = reader.read<byte>();
-        layers.clear();
-        for (int i = 0; i < layerCount; ++i) layers.append(SceneLayer(reader));
-
-        byte objectCount = reader.read<byte>();
-        objects.clear();
-        for (int i = 0; i < objectCount; ++i) objects.append(SceneObject(reader));
-    }
+    void read(Reader &reader);
 
     inline void write(QString filename)
     {
@@ -370,21 +378,7 @@ public:
         Writer writer(filename);
         write(writer);
     }
-    void write(Writer &writer)
-    {
-        filepath = writer.filePath;
-        writer.write(signature, 4);
-
-        editorMetadata.write(writer);
-
-        writer.write((byte)layers.count());
-        for (SceneLayer &layer : layers) layer.write(writer);
-
-        writer.write((byte)objects.count());
-        for (SceneObject &obj : objects) obj.write(writer);
-
-        writer.flush();
-    }
+    void write(Writer &writer);
 
     byte signature[4] = { 'S', 'C', 'N', 0 };
 
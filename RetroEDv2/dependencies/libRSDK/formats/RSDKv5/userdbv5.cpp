@@ -2,71 +2,312 @@
 
 #include "userdbv5.hpp"
 
+namespace
+{
+
+const char *typeNames[] = { "invalid", "bool",    "uint8",   "uint16", "uint32", "uint64",
+                            "int8",    "int16",   "int32",   "int64",  "float",  "double",
+                            "vector2", "vector3", "vector4", "color",  "string", "hashMD5" };
+
+template <typename T> inline void readRaw(const byte *&data, T &value)
+{
+    memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+}
+
+template <typename T> inline void appendRaw(QByteArray &buffer, T value)
+{
+    buffer.append((const char *)&value, sizeof(T));
+}
+
+template <typename T> inline T readValue(const QByteArray &data)
+{
+    T value = 0;
+    memcpy(&value, data.constData(), qMin<int>(sizeof(T), data.size()));
+    return value;
+}
+
+template <typename T> inline QByteArray valueData(T value)
+{
+    return QByteArray((const char *)&value, sizeof(T));
+}
+
+template <typename T> inline bool parseInteger(const QString &string, QByteArray &data)
+{
+    QString text = string.trimmed();
+    bool ok      = false;
+    if (std::is_signed<T>::value) {
+        qint64 value = text.toLongLong(&ok, text.startsWith("0x", Qt::CaseInsensitive) ? 0x10 : 10);
+        if (ok)
+            data = valueData((T)value);
+    }
+    else {
+        quint64 value = text.toULongLong(&ok, text.startsWith("0x", Qt::CaseInsensitive) ? 0x10 : 10);
+        if (ok)
+            data = valueData((T)value);
+    }
+    return ok;
+}
+
+} // namespace
+
+// rows copy their timestamps straight in & out of the buffer, so they have to stay the engine's 9 ints
+static_assert(sizeof(RSDKv5::UserDB::TimeStamp) == sizeof(int) * 9, "TimeStamp has to match the file");
+
 void RSDKv5::UserDB::read(Reader &reader)
 {
-    filePath       = reader.filePath;
-    Reader creader = reader.getCReaderRaw();
+    filePath = reader.filePath;
+
+    columns.clear();
+    rows.clear();
 
-    uint sig = creader.read<uint>();
+    // parsed straight out of the inflated buffer, rather than a Reader call per field
+    QByteArray data = reader.readZLib(true);
+    reader.close();
+
+    const byte *ptr = (const byte *)data.constData();
+    const byte *end = ptr + data.size();
+
+    const int headerSize = sizeof(uint) + sizeof(int) + sizeof(ushort) + sizeof(byte);
+    if (end - ptr < headerSize)
+        return;
+
+    uint sig = 0;
+    readRaw(ptr, sig);
     if (sig != signature) {
         // error
-        creader.close();
-        reader.close();
         return;
     }
 
-    int dataSize = creader.read<int>(); // total size of the buffer (may not all be used)
+    int dataSize    = 0; // total size of the buffer (may not all be used)
+    ushort rowCount = 0;
+    byte colCount   = 0;
+    readRaw(ptr, dataSize);
+    readRaw(ptr, rowCount);
+    readRaw(ptr, colCount);
     Q_UNUSED(dataSize);
 
-    ushort rowCount = creader.read<ushort>();
-    byte colCount   = creader.read<byte>();
+    const int columnSize = sizeof(byte) + 0x10;
+    columns.reserve(colCount);
+    for (int c = 0; c < colCount && end - ptr >= columnSize; ++c) {
+        TableColumn column;
+        column.type = (TableColumn::Types)*ptr++;
+        column.name = QString::fromLatin1((const char *)ptr, qstrnlen((const char *)ptr, 0x10));
+        ptr += 0x10;
+        columns.append(column);
+    }
+
+    const int rowHeaderSize = sizeof(uint) + sizeof(TimeStamp) * 2;
+    rows.reserve(rowCount);
+    for (int r = 0; r < rowCount && end - ptr >= rowHeaderSize; ++r) {
+        TableRow row;
+        readRaw(ptr, row.uuid);
+        readRaw(ptr, row.createDate);
+        readRaw(ptr, row.modifyDate);
 
-    for (int i = 0; i < colCount; i++) columns.append(TableColumn(creader));
+        row.entries.reserve(columns.count());
+        for (int v = 0; v < columns.count() && ptr < end; ++v) {
+            int size = *ptr++;
+            size     = (int)qMin<qint64>(size, end - ptr);
 
-    for (int i = 0; i < rowCount; i++) rows.append(TableRow(creader, this));
+            TableRow::Value entry;
+            entry.data = QByteArray((const char *)ptr, size);
+            ptr += size;
+            row.entries.append(entry);
+        }
 
-    creader.close();
-    reader.close();
+        rows.append(row);
+    }
 }
 
 void RSDKv5::UserDB::write(Writer &writer)
 {
     filePath = writer.filePath;
 
-    QByteArray compressed;
-    QBuffer buffer(&compressed);
-    buffer.open(QIODevice::Append);
-    QDataStream *cmem = new QDataStream(&buffer);
-    Writer cwriter(cmem);
-
     // entry limits
     ushort rowCount = rows.count();
-    if (rowCount > 0x400)
+    if (rows.count() > 0x400)
         rowCount = 0x400;
 
     byte colCount = columns.count();
-    if (colCount > 8)
+    if (columns.count() > 8)
         colCount = 8;
 
-    cwriter.write(signature);
-    int loop = 0;
-    while (loop++ < 2) {
-        if (loop == 2)
-            cwriter.write((uint)(compressed.size() - 4)); // data size (real)
-        else
-            cwriter.write(0x00); // data size (fake)
+    // built in one buffer, the data size is patched in once everything's been written
+    QByteArray data;
+    appendRaw(data, signature);
+    appendRaw<uint>(data, 0);
+    appendRaw(data, rowCount);
+    appendRaw(data, colCount);
 
-        cwriter.write(rowCount);
-        cwriter.write(colCount);
+    for (int c = 0; c < colCount; c++) {
+        QByteArray name = columns[c].name.toLatin1().left(0x10);
+        name.append(QByteArray(0x10 - name.size(), '\0'));
 
-        for (int c = 0; c < colCount; c++) columns[c].write(cwriter);
+        appendRaw(data, (byte)columns[c].type);
+        data.append(name);
+    }
 
-        for (int r = 0; r < rowCount; r++) rows[r].write(cwriter);
+    for (int r = 0; r < rowCount; r++) {
+        const TableRow &row = rows[r];
+        appendRaw(data, row.uuid);
+        appendRaw(data, row.createDate);
+        appendRaw(data, row.modifyDate);
 
-        if (loop == 1)
-            cwriter.seek(4);
+        for (auto &entry : row.entries) {
+            int size = qMin(entry.data.size(), 0xFF);
+            appendRaw(data, (byte)size);
+            data.append(entry.data.constData(), size);
+        }
     }
 
-    writer.writeCompressedRaw(compressed);
+    uint dataSize = data.size() - sizeof(uint);
+    memcpy(data.data() + sizeof(uint), &dataSize, sizeof(uint));
+
+    writer.writeCompressedRaw(data);
     writer.flush();
 }
+
+QString RSDKv5::UserDB::TimeStamp::toDateString() const
+{
+    return QString::asprintf("%04d/%02d/%02d %02d:%02d:%02d", tm_year + 1900, tm_mon + 1, tm_mday,
+                             tm_hour, tm_min, tm_sec);
+}
+
+bool RSDKv5::UserDB::TimeStamp::fromDateString(const QString &string)
+{
+    int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+
+    QByteArray text = string.trimmed().toLatin1();
+    int count =
+        sscanf(text.constData(), "%d/%d/%d %d:%d:%d", &year, &month, &day, &hour, &minute, &second);
+    if (count < 3)
+        return false;
+
+    QDate date(year, month, day);
+    if (!date.isValid())
+        return false;
+
+    tm_sec   = second;
+    tm_min   = minute;
+    tm_hour  = hour;
+    tm_mday  = day;
+    tm_mon   = month - 1;
+    tm_year  = year - 1900;
+    tm_wday  = date.dayOfWeek() % 7;
+    tm_yday  = date.dayOfYear() - 1;
+    tm_isdst = 0;
+    return true;
+}
+
+QString RSDKv5::UserDB::typeName(byte type)
+{
+    return type < (sizeof(typeNames) / sizeof(typeNames[0])) ? typeNames[type] : typeNames[0];
+}
+
+byte RSDKv5::UserDB::typeFromName(const QString &name)
+{
+    for (uint t = 0; t < sizeof(typeNames) / sizeof(typeNames[0]); ++t) {
+        if (name == typeNames[t])
+            return t;
+    }
+    return TableColumn::Invalid;
+}
+
+QString RSDKv5::UserDB::valueToString(byte type, const QByteArray &data)
+{
+    switch (type) {
+        default:
+        case TableColumn::Vector2:
+        case TableColumn::Vector3:
+        case TableColumn::Vector4:
+        case TableColumn::HashMD5:
+        case TableColumn::Invalid: return "0x" + QString(data.toHex().toUpper());
+
+        case TableColumn::Bool: return readValue<byte>(data) ? "y" : "n";
+        case TableColumn::UInt8: return QString::number(readValue<byte>(data));
+        case TableColumn::UInt16: return QString::number(readValue<ushort>(data));
+        case TableColumn::UInt64: return QString::number(readValue<uint64>(data));
+        case TableColumn::Int8: return QString::number(readValue<sbyte>(data));
+        case TableColumn::Int16: return QString::number(readValue<short>(data));
+        case TableColumn::Int32: return QString::number(readValue<int>(data));
+        case TableColumn::Int64: return QString::number(readValue<int64>(data));
+
+        case TableColumn::UInt32:
+        case TableColumn::Color: return "0x" + QString::number(readValue<uint>(data), 0x10).toUpper();
+
+        case TableColumn::Float: {
+            // shortest text that reads back as the same float
+            float value = readValue<float>(data);
+            int digits  = 6;
+            while (digits < 9 && QString::number(value, 'g', digits).toFloat() != value) ++digits;
+            return QString::number(value, 'g', digits);
+        }
+
+        case TableColumn::Double:
+            return QString::number(readValue<double>(data), 'g', QLocale::FloatingPointShortest);
+
+        case TableColumn::String: {
+            int length = data.indexOf('\0');
+            return QString::fromUtf8(data.constData(), length < 0 ? data.size() : length);
+        }
+    }
+}
+
+bool RSDKv5::UserDB::valueFromString(byte type, const QString &string, QByteArray &data)
+{
+    switch (type) {
+        default:
+        case TableColumn::Vector2:
+        case TableColumn::Vector3:
+        case TableColumn::Vector4:
+        case TableColumn::HashMD5:
+        case TableColumn::Invalid: {
+            QString text = string.trimmed();
+            if (text.startsWith("0x", Qt::CaseInsensitive))
+                text.remove(0, 2);
+
+            QByteArray hex = text.toLatin1();
+            for (char c : hex) {
+                if (!isxdigit((byte)c))
+                    return false;
+            }
+            data = QByteArray::fromHex(hex).left(0xFF);
+            return true;
+        }
+
+        case TableColumn::Bool: {
+            QString text = string.trimmed().toLower();
+            data         = valueData<byte>(text.startsWith("y") || text == "true" || text == "1");
+            return true;
+        }
+
+        case TableColumn::UInt8: return parseInteger<byte>(string, data);
+        case TableColumn::UInt16: return parseInteger<ushort>(string, data);
+        case TableColumn::UInt32:
+        case TableColumn::Color: return parseInteger<uint>(string, data);
+        case TableColumn::UInt64: return parseInteger<uint64>(string, data);
+        case TableColumn::Int8: return parseInteger<sbyte>(string, data);
+        case TableColumn::Int16: return parseInteger<short>(string, data);
+        case TableColumn::Int32: return parseInteger<int>(string, data);
+        case TableColumn::Int64: return parseInteger<int64>(string, data);
+
+        case TableColumn::Float: {
+            bool ok     = false;
+            float value = string.trimmed().toFloat(&ok);
+            if (ok)
+                data = valueData(value);
+            return ok;
+        }
+
+        case TableColumn::Double: {
+            bool ok      = false;
+            double value = string.trimmed().toDouble(&ok);
+            if (ok)
+                data = valueData(value);
+            return ok;
+        }
+
+        case TableColumn::String: data = string.toUtf8().left(0xFF); return true;
+    }
+}
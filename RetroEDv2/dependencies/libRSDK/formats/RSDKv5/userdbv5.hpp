@@ -22,33 +22,6 @@ public:
         int tm_isdst; // daylight savings time flag
 
         TimeStamp() {}
-        TimeStamp(Reader &reader) { read(reader); }
-
-        void read(Reader &reader)
-        {
-            tm_sec   = reader.read<int>();
-            tm_min   = reader.read<int>();
-            tm_hour  = reader.read<int>();
-            tm_mday  = reader.read<int>();
-            tm_mon   = reader.read<int>();
-            tm_year  = reader.read<int>();
-            tm_wday  = reader.read<int>();
-            tm_yday  = reader.read<int>();
-            tm_isdst = reader.read<int>();
-        }
-
-        void write(Writer &writer)
-        {
-            writer.write(tm_sec);
-            writer.write(tm_min);
-            writer.write(tm_hour);
-            writer.write(tm_mday);
-            writer.write(tm_mon);
-            writer.write(tm_year);
-            writer.write(tm_wday);
-            writer.write(tm_yday);
-            writer.write(tm_isdst);
-        }
 
         QString toString()
         {
@@ -60,6 +33,10 @@ public:
                 .arg(tm_min)
                 .arg(tm_sec, 2, 10, QLatin1Char('0'));
         }
+
+        // "yyyy/MM/dd hh:mm:ss", the format used by csv exports & the UserDB Manager
+        QString toDateString() const;
+        bool fromDateString(const QString &string);
     };
 
     class TableColumn
@@ -90,22 +67,6 @@ public:
         Types type   = Invalid;
 
         TableColumn() {}
-        TableColumn(Reader &reader) { read(reader); }
-
-        void read(Reader &reader)
-        {
-            type = (Types)reader.read<byte>();
-            name = QString(reader.readByteArray(0x10)).replace("\0", "");
-        }
-
-        void write(Writer &writer)
-        {
-            writer.write((byte)type);
-
-            int i = 0;
-            for (; i < name.length(); ++i) writer.write<byte>(name[i].toLatin1());
-            for (; i < 0x10; ++i) writer.write<byte>(0x00);
-        }
     };
 
     class TableRow
@@ -121,32 +82,6 @@ public:
         QList<Value> entries = QList<Value>();
 
         TableRow() {}
-        TableRow(Reader &reader, UserDB *db) { read(reader, db); }
-
-        void read(Reader &reader, UserDB *db)
-        {
-            uuid = reader.read<uint>();
-            createDate.read(reader);
-            modifyDate.read(reader);
-
-            for (int v = 0; v < db->columns.count(); ++v) {
-                Value entry;
-                entry.data = reader.readByteArray(reader.read<byte>());
-                entries.append(entry);
-            }
-        }
-
-        void write(Writer &writer)
-        {
-            writer.write(uuid);
-            createDate.write(writer);
-            modifyDate.write(writer);
-
-            for (int v = 0; v < entries.count(); ++v) {
-                writer.write((byte)entries[v].data.size());
-                writer.write(entries[v].data);
-            }
-        }
     };
 
     UserDB() {}
@@ -171,6 +106,14 @@ public:
     }
     void write(Writer &writer);
 
+    // values are kept as the raw data the engine copies in, these convert them to & from editable text
+    static QString valueToString(byte type, const QByteArray &data);
+    static bool valueFromString(byte type, const QString &string, QByteArray &data);
+
+    // "uint32", "string", etc, typeFromName returns Invalid for anything it doesn't know
+    static QString typeName(byte type);
+    static byte typeFromName(const QString &name);
+
     QList<TableColumn> columns = QList<TableColumn>();
     QList<TableRow> rows       = QList<TableRow>();
 
@@ -1,5 +1,11 @@
 #include "libRSDK.hpp"
 
+#ifdef Q_OS_WIN
+#include <QtZlib/zlib.h>
+#else
+#include <zlib.h>
+#endif
+
 Reader::Reader(QString filepath) : file(new QFile(filepath)), stream(new QDataStream(file.data()))
 {
     initialised = file->open(QIODevice::ReadOnly);
@@ -16,27 +22,85 @@ Reader::Reader(QDataStream *stream) : stream(stream)
 
 QByteArray Reader::readZLib(bool raw)
 {
+    qint64 complen    = 0;
+    uint decompressed = 0;
     if (raw) {
-        uint decompressed = filesize;
-
-        QByteArray compressed = readByteArray(filesize);
-        QByteArray intBytes;
-        for (short i = 3; i > -1; i--) intBytes.append((byte)((decompressed >> (i * 8)) & 0xFF));
-
-        compressed.insert(0, intBytes);
-        return qUncompress(compressed);
+        // no header, the rest of the file is the stream, so it's just a size hint
+        complen      = bytesLeft();
+        decompressed = filesize;
     }
     else {
-        uint complen      = read<int>();
-        uint decompLE     = read<int>();
-        uint decompressed = (uint)((decompLE << 24) | ((decompLE << 8) & 0x00FF0000)
-                                   | ((decompLE >> 8) & 0x0000FF00) | (decompLE >> 24));
+        complen       = read<int>() - 4;
+        uint decompLE = read<int>();
+        decompressed  = (uint)((decompLE << 24) | ((decompLE << 8) & 0x00FF0000)
+                              | ((decompLE >> 8) & 0x0000FF00) | (decompLE >> 24));
+    }
+
+    // the stored size is only used to preallocate, so keep a corrupted one from asking for gigabytes
+    complen = qMax<qint64>(qMin(complen, bytesLeft()), 0);
+    QByteArray result(qMin<qint64>(decompressed, complen * 0x400 + 0x1000), Qt::Uninitialized);
+    if (!inflateBlock(complen, (byte *)result.data(), result.size(), &result))
+        return QByteArray();
+    return result;
+}
 
-        QByteArray compressed = readByteArray(complen - 4);
-        QByteArray intBytes;
-        for (short i = 3; i > -1; i--) intBytes.append((byte)((decompressed >> (i * 8)) & 0xFF));
+bool Reader::readZLib(void *buffer, uint size)
+{
+    // read the header before clamping, bytesLeft() has to be taken after it
+    qint64 complen = read<int>() - 4;
+    read<int>(); // decompressed size, the caller already knows how much it wants
 
-        compressed.insert(0, intBytes);
-        return qUncompress(compressed);
+    complen = qMax<qint64>(qMin(complen, bytesLeft()), 0);
+    return inflateBlock(complen, (byte *)buffer, size, nullptr);
+}
+
+bool Reader::inflateBlock(qint64 complen, byte *dst, uint size, QByteArray *growable)
+{
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    if (inflateInit(&zs) != Z_OK)
+        return false;
+
+    // feed the compressed data through a small window instead of buffering the whole block
+    char window[0x4000];
+    qint64 end = tell() + complen;
+    int result = Z_OK;
+
+    zs.next_out  = dst;
+    zs.avail_out = size;
+    while (result == Z_OK) {
+        if (!zs.avail_in) {
+            int len = stream->readRawData(window, (int)qMin<qint64>(sizeof(window), end - tell()));
+            if (len <= 0)
+                break;
+
+            zs.next_in  = (Bytef *)window;
+            zs.avail_in = len;
+        }
+
+        if (!zs.avail_out) {
+            if (!growable)
+                break; // the caller's buffer is full, skip the rest
+
+            uint used = zs.total_out;
+            growable->resize(qMax(used * 2, 0x1000u));
+            zs.next_out  = (Bytef *)growable->data() + used;
+            zs.avail_out = growable->size() - used;
+        }
+
+        result = inflate(&zs, Z_NO_FLUSH);
     }
+
+    bool success = result == Z_STREAM_END || (!growable && result == Z_OK && !zs.avail_out);
+    if (growable)
+        growable->resize(zs.total_out);
+    else if (zs.total_out < size)
+        memset(dst + zs.total_out, 0, size - zs.total_out);
+
+    inflateEnd(&zs);
+
+    // always leave the reader after the block, even if it wasn't fully inflated
+    if (tell() < end)
+        seek(end);
+    return success;
 }
@@ -28,6 +28,14 @@ public:
             return stream->atEnd();
     }
 
+    inline qint64 bytesLeft()
+    {
+        if (file)
+            return file->size() - file->pos();
+        else
+            return stream->device()->size() - stream->device()->pos();
+    }
+
     inline void close()
     {
         if (file)
@@ -56,26 +64,20 @@ public:
 
     inline QString readString(int mode = 0)
     {
+        // lengths come straight from the file, so they're clamped by readByteArray
         if (!mode) {
             byte len = read<byte>();
-            QByteArray string;
-            for (byte i = 0; i < len; ++i) string += read<byte>();
-            return QString::fromLatin1(string).replace("\0", "");
+            return QString::fromLatin1(readByteArray(len)).replace("\0", "");
         }
         else if (mode == 1) {
-            ushort len      = read<ushort>();
-            ushort *unicode = new ushort[len + 1];
-            for (byte i = 0; i < len; ++i) unicode[i] = read<ushort>();
-            unicode[len] = 0;
-            QString str  = QString::fromUtf16(unicode);
-            delete[] unicode;
-            return str;
+            ushort len         = read<ushort>();
+            QByteArray unicode = readByteArray(len * sizeof(ushort));
+            unicode.append(2, '\0');
+            return QString::fromUtf16((const ushort *)unicode.constData());
         }
         else if (mode == 2) {
             ushort len = read<ushort>();
-            QByteArray string;
-            for (byte i = 0; i < len; ++i) string += read<byte>();
-            return QString::fromLatin1(string);
+            return QString::fromLatin1(readByteArray(len));
         }
         return "";
     }
@@ -117,32 +119,32 @@ public:
 
     inline QByteArray readByteArray(qint64 len, bool compressed = false)
     {
-        QByteArray result;
-        char *buffer = new char[sizeof(byte) * len];
-        stream->readRawData(buffer, (int)(sizeof(byte) * len));
-        result.append(buffer, len);
-        delete[] buffer;
+        // don't trust lengths from truncated or corrupted files with the allocation
+        len = qMax<qint64>(qMin(len, bytesLeft()), 0);
+
+        QByteArray result((int)len, Qt::Uninitialized);
+        result.resize(qMax(stream->readRawData(result.data(), (int)len), 0));
 
         if (!compressed)
             return result;
         return qUncompress(result);
     }
     QByteArray readZLib(bool raw = false);
+    // inflates a compressed block straight into buffer, anything past size is skipped
+    bool readZLib(void *buffer, uint size);
 
     QSharedPointer<QFile> file;
 
     template <typename T> inline T read()
     {
-        char *buffer = new char[sizeof(T)];
+        alignas(T) char buffer[sizeof(T)];
 
         if (isEOF())
             memset(buffer, 0, sizeof(T));
         else
             stream->readRawData(buffer, sizeof(T));
 
-        T result = *(reinterpret_cast<T *>(buffer));
-        delete[] buffer;
-        return result;
+        return *(reinterpret_cast<T *>(buffer));
     }
 
     template <typename T> T peek()
@@ -159,6 +161,8 @@ public:
 
 private:
     QSharedPointer<QDataStream> stream;
+
+    bool inflateBlock(qint64 complen, byte *dst, uint size, QByteArray *growable);
 };
 
 
@@ -50,12 +50,18 @@ public:
     {
         write((byte *)data.data(), data.length(), compressed);
     }
-    inline void writeCompressed(QByteArray data)
+    // qCompress minus its size header, thread-safe so blocks can be packed ahead of time
+    static inline QByteArray compress(const QByteArray &data)
     {
         QByteArray compressed = qCompress(data);
         compressed.remove(0, 4);
+        return compressed;
+    }
+
+    inline void writeCompressed(QByteArray data) { writeCompressed(compress(data), data.size()); }
+    inline void writeCompressed(const QByteArray &compressed, uint decomp)
+    {
         write((int)(compressed.size() + sizeof(int)));
-        uint decomp = data.size();
         write((uint)((decomp << 24) | ((decomp << 8) & 0x00FF0000) | ((decomp >> 8) & 0x0000FF00)
                      | (decomp >> 24)));
         write(compressed);
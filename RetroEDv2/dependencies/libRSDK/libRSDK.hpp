@@ -10,6 +10,7 @@
 #include <QtGui>
 #include <QtWidgets>
 #include <QFileSystemModel>
+#include <QtConcurrent>
 
 typedef signed char sbyte;
 typedef unsigned char byte;
@@ -28,11 +29,14 @@ typedef unsigned long long uint64;
 #include "utils/vectors.hpp"
 #include "utils/colour.hpp"
 #include "utils/palette.hpp"
+#include "utils/quantizer.hpp"
 
 enum EngineVersion { ENGINE_v5, ENGINE_v4, ENGINE_v3, ENGINE_v2, ENGINE_v1, ENGINE_NONE = 0xFF };
 
 // Helpers
 #include "utils/formathelpers/gif.hpp"
+#include "utils/formathelpers/obj.hpp"
+#include "utils/formathelpers/ply.hpp"
 
 #include "utils/formathelpers/gameconfig.hpp"
 #include "utils/formathelpers/animation.hpp"
@@ -1,4 +1,4 @@
-QT += core
+QT += core concurrent
 
 INCLUDEPATH += \
     $$PWD \
@@ -77,10 +77,14 @@ HEADERS +=    \
     $$PWD/io/writer.hpp \
     $$PWD/libRSDK.hpp \
     $$PWD/utils/formathelpers/gif.hpp \
+    $$PWD/utils/formathelpers/meshcursor.hpp \
+    $$PWD/utils/formathelpers/obj.hpp \
+    $$PWD/utils/formathelpers/ply.hpp \
     $$PWD/utils/utils.hpp \
     $$PWD/utils/vectors.hpp \
     $$PWD/utils/colour.hpp \
     $$PWD/utils/palette.hpp \
+    $$PWD/utils/quantizer.hpp \
     $$PWD/utils/formathelpers/animation.hpp \
     $$PWD/utils/formathelpers/background.hpp \
     $$PWD/utils/formathelpers/chunks.hpp \
@@ -136,7 +140,10 @@ SOURCES +=  \
     $$PWD/io/reader.cpp \
     $$PWD/io/writer.cpp \
     $$PWD/utils/formathelpers/gif.cpp \
+    $$PWD/utils/formathelpers/obj.cpp \
+    $$PWD/utils/formathelpers/ply.cpp \
     $$PWD/utils/palette.cpp \
+    $$PWD/utils/quantizer.cpp \
     $$PWD/utils/formathelpers/animation.cpp \
     $$PWD/utils/formathelpers/background.cpp \
     $$PWD/utils/formathelpers/chunks.cpp \
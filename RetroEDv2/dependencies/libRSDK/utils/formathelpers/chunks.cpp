@@ -237,32 +237,131 @@ void FormatHelpers::Chunks::write(byte ver, QString filename)
     }
 }
 
-QImage FormatHelpers::Chunks::Chunk::getImage(QList<QImage> tileList)
+// chunk images have always been fully opaque (pixelColor().rgb()), so the alpha is forced here too
+static QImage opaqueTile(const QImage &tile)
 {
-    QImage img(0x80, 0x80, QImage::Format::Format_ARGB32);
+    QImage img = tile.convertToFormat(QImage::Format_ARGB32);
+    for (int y = 0; y < img.height(); ++y) {
+        QRgb *line = (QRgb *)img.scanLine(y);
+        for (int x = 0; x < img.width(); ++x) line[x] |= 0xFF000000;
+    }
+    return img;
+}
 
+// opaqueTiles must hold an opaqueTile() for every tile the chunk uses
+static QImage drawChunk(const FormatHelpers::Chunks::Chunk &chunk, const QVector<QImage> &opaqueTiles)
+{
+    QImage img(0x80, 0x80, QImage::Format_ARGB32);
+    img.fill(0xFF000000);
+
+    uchar *bits = img.bits();
+    int pitch   = img.bytesPerLine();
     for (int h = 0; h < 0x8; ++h) {
         for (int w = 0; w < 0x8; ++w) {
-            QImage &tile = tileList[tiles[h][w].tileIndex];
-            Vector2<bool> flip;
-            flip.x = (tiles[h][w].direction & 1) == 1;
-            flip.y = (tiles[h][w].direction & 2) == 2;
+            const FormatHelpers::Chunks::Tile &info = chunk.tiles[h][w];
+            if (info.tileIndex >= opaqueTiles.count())
+                continue;
+
+            const QImage &tile = opaqueTiles[info.tileIndex];
+            if (tile.width() < 0x10 || tile.height() < 0x10)
+                continue;
+
+            bool flipX = (info.direction & 1) == 1;
+            bool flipY = (info.direction & 2) == 2;
 
             for (int y = 0; y < 0x10; ++y) {
-                for (int x = 0; x < 0x10; ++x) {
-                    int xpos = x;
-                    int ypos = y;
-                    if (flip.y)
-                        ypos = 0x0F - y;
-                    if (flip.x)
-                        xpos = 0x0F - x;
-
-                    img.setPixelColor((w * 0x10) + x, (h * 0x10) + y,
-                                      tile.pixelColor(xpos, ypos).rgb());
-                }
+                const QRgb *src = (const QRgb *)tile.constScanLine(flipY ? 0x0F - y : y);
+                QRgb *dst       = (QRgb *)(bits + ((h * 0x10) + y) * pitch) + (w * 0x10);
+
+                if (flipX)
+                    std::reverse_copy(src, src + 0x10, dst);
+                else
+                    memcpy(dst, src, 0x10 * sizeof(QRgb));
             }
         }
     }
 
     return img;
 }
+
+QImage FormatHelpers::Chunks::Chunk::getImage(const QList<QImage> &tileList)
+{
+    QVector<QImage> opaqueTiles(tileList.count());
+    for (int h = 0; h < 0x8; ++h) {
+        for (int w = 0; w < 0x8; ++w) {
+            ushort id = tiles[h][w].tileIndex;
+            if (id < tileList.count() && opaqueTiles[id].isNull())
+                opaqueTiles[id] = opaqueTile(tileList[id]);
+        }
+    }
+
+    return drawChunk(*this, opaqueTiles);
+}
+
+QByteArray FormatHelpers::Chunks::Chunk::visualKey()
+{
+    QByteArray key(8 * 8 * 3, 0);
+
+    byte *k = (byte *)key.data();
+    for (int h = 0; h < 0x8; ++h) {
+        for (int w = 0; w < 0x8; ++w) {
+            *k++ = tiles[h][w].tileIndex & 0xFF;
+            *k++ = tiles[h][w].tileIndex >> 8;
+            *k++ = tiles[h][w].direction & 3;
+        }
+    }
+
+    return key;
+}
+
+QList<QImage> FormatHelpers::Chunks::getImages(const QList<QImage> &tiles)
+{
+    // any edited tile invalidates everything, tile edits are rare compared to chunk edits
+    QVector<qint64> tileKeys(tiles.count());
+    for (int t = 0; t < tiles.count(); ++t) tileKeys[t] = tiles[t].cacheKey();
+
+    if (tileKeys != imageCacheTiles) {
+        imageCache.clear();
+        imageCacheTiles = tileKeys;
+    }
+
+    // identical chunks (mostly blank ones) only need drawing once
+    QList<QByteArray> keys;
+    QList<int> dirty;
+    QSet<QByteArray> queued;
+    for (int c = 0; c < 0x200; ++c) {
+        keys.append(chunks[c].visualKey());
+        if (!imageCache.contains(keys[c]) && !queued.contains(keys[c])) {
+            queued.insert(keys[c]);
+            dirty.append(c);
+        }
+    }
+
+    if (dirty.count()) {
+        QVector<QImage> opaqueTiles(tiles.count());
+        QImage *first = opaqueTiles.data();
+        QtConcurrent::blockingMap(opaqueTiles, [&tiles, first](QImage &tile) {
+            tile = opaqueTile(tiles[(int)(&tile - first)]);
+        });
+
+        QList<QFuture<QImage>> tasks;
+        for (int c : dirty) {
+            Chunk *chunk = &chunks[c];
+            tasks.append(QtConcurrent::run([chunk, &opaqueTiles] { return drawChunk(*chunk, opaqueTiles); }));
+        }
+
+        for (int d = 0; d < dirty.count(); ++d) imageCache.insert(keys[dirty[d]], tasks[d].result());
+    }
+
+    // only keep what's in use so the cache doesn't grow with every edit
+    QHash<QByteArray, QImage> usedImages;
+    QList<QImage> images;
+    for (int c = 0; c < 0x200; ++c) {
+        QImage img = imageCache.value(keys[c]);
+        usedImages.insert(keys[c], img);
+        images.append(img);
+    }
+    imageCache = usedImages;
+
+    return images;
+}
@@ -23,7 +23,10 @@ public:
     public:
         Chunk() {}
 
-        QImage getImage(QList<QImage> tiles);
+        QImage getImage(const QList<QImage> &tiles);
+
+        // everything that affects what the chunk looks like (tile ids & flip flags)
+        QByteArray visualKey();
 
         Tile tiles[8][8];
     };
@@ -34,9 +37,16 @@ public:
     void read(byte ver, QString filename);
     void write(byte ver, QString filename);
 
+    // images for every chunk, only redrawing chunks that changed since the last call
+    QList<QImage> getImages(const QList<QImage> &tiles);
+
     Chunk chunks[0x200];
 
     QString filePath = "";
+
+private:
+    QHash<QByteArray, QImage> imageCache;
+    QVector<qint64> imageCacheTiles; // cacheKey() of each tile the cache was drawn with
 };
 
 } // namespace FormatHelpers
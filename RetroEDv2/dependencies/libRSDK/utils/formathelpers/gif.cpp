@@ -27,12 +27,7 @@ void FormatHelpers::Gif::read(Reader &reader, bool skipHeader, int clrCnt)
         reader.read<byte>(); // unused
     }
 
-    for (int c = 0; c < clrCnt; ++c) {
-        byte r     = reader.read<byte>();
-        byte g     = reader.read<byte>();
-        byte b     = reader.read<byte>();
-        palette[c] = QColor(r, g, b, 0xFF);
-    }
+    readPalette(reader, 0, clrCnt);
 
     byte blockType = reader.read<byte>();
     while (blockType != 0 && blockType != ';') {
@@ -90,14 +85,8 @@ void FormatHelpers::Gif::read(Reader &reader, bool skipHeader, int clrCnt)
 
                 byte info2      = reader.read<byte>();
                 bool interlaced = (info2 & 0x40) != 0;
-                if (info2 >> 7 == 1) {
-                    for (int c = 0x80; c < 0x100; ++c) {
-                        byte r     = reader.read<byte>();
-                        byte g     = reader.read<byte>();
-                        byte b     = reader.read<byte>();
-                        palette[c] = QColor(r, g, b, 0xFF);
-                    }
-                }
+                if (info2 >> 7 == 1)
+                    readPalette(reader, 0x80, 0x80);
 
                 readPictureData(width, height, interlaced, reader);
                 break;
@@ -111,6 +100,11 @@ void FormatHelpers::Gif::write(Writer &writer, bool skipHeader, bool useLocal)
 {
     filePath = writer.filePath;
 
+    encode(writer, skipHeader, useLocal);
+    writer.flush();
+}
+void FormatHelpers::Gif::encode(Writer &writer, bool skipHeader, bool useLocal) const
+{
     // [GIF HEADER]
     if (!skipHeader) {
         byte fileType[] = { 'G', 'I', 'F' };
@@ -132,11 +126,7 @@ void FormatHelpers::Gif::write(Writer &writer, bool skipHeader, bool useLocal)
     }
 
     // [GLOBAL PALETTE]
-    for (int c = 0; c < (useLocal ? 0x80 : 0x100); ++c) {
-        writer.write<byte>(palette[c].red());
-        writer.write<byte>(palette[c].green());
-        writer.write<byte>(palette[c].blue());
-    }
+    writePalette(writer, 0, useLocal ? 0x80 : 0x100);
 
     // [EXTENSION BLOCKS]
 
@@ -154,21 +144,14 @@ void FormatHelpers::Gif::write(Writer &writer, bool skipHeader, bool useLocal)
                            | 0); // 0 == noLocal, 0 == no interlacing, no local palette, so we dont care
 
     // [LOCAL PALETTE]
-    if (useLocal) {
-        for (int c = 0x80; c < 0x100; ++c) {
-            writer.write<byte>(palette[c].red());
-            writer.write<byte>(palette[c].green());
-            writer.write<byte>(palette[c].blue());
-        }
-    }
+    if (useLocal)
+        writePalette(writer, 0x80, 0x80);
 
     // [IMAGE DATA]
     writePictureData(width, height, false, useLocal ? (byte)7 : (byte)8, writer);
 
     // [BLOCK END MARKER]
     writer.write<byte>(';'); // ';' used for image descriptor, 0 would be used for other blocks
-
-    writer.flush();
 }
 
 void FormatHelpers::Gif::fromImage(QImage img)
@@ -189,327 +172,280 @@ QImage FormatHelpers::Gif::toImage()
 }
 
 // GIF READING
-void FormatHelpers::Gif::initDecoder(Reader &reader)
+void FormatHelpers::Gif::readPalette(Reader &reader, int first, int count)
 {
-    byte initCodeSize      = reader.read<byte>();
-    decoder.fileState      = PARSING_IMAGE;
-    decoder.position       = 0;
-    decoder.bufferSize     = 0;
-    decoder.buffer[0]      = 0;
-    decoder.depth          = initCodeSize;
-    decoder.clearCode      = 1 << initCodeSize;
-    decoder.eofCode        = decoder.clearCode + 1;
-    decoder.runningCode    = decoder.eofCode + 1;
-    decoder.runningBits    = initCodeSize + 1;
-    decoder.maxCodePlusOne = 1 << decoder.runningBits;
-    decoder.stackPtr       = 0;
-    decoder.prevCode       = NO_SUCH_CODE;
-    decoder.shiftState     = 0;
-    decoder.shiftData      = 0;
-    for (int i = 0; i <= LZ_MAX_CODE; ++i) decoder.prefix[i] = NO_SUCH_CODE;
+    byte rgb[0x100 * 3];
+    memset(rgb, 0, count * 3);
+    reader.readBytes(rgb, count * 3);
+
+    byte *src = rgb;
+    for (int c = first; c < first + count; ++c, src += 3) palette[c] = qRgb(src[0], src[1], src[2]);
 }
-void FormatHelpers::Gif::readLine(Reader &reader, int length, int offset)
+
+void FormatHelpers::Gif::readPictureData(int width, int height, bool interlaced, Reader &reader)
 {
-    int i         = 0;
-    int stackPtr  = decoder.stackPtr;
-    int eofCode   = decoder.eofCode;
-    int clearCode = decoder.clearCode;
-    int prevCode  = decoder.prevCode;
-    if (stackPtr != 0) {
-        while (stackPtr != 0) {
-            if (i >= length)
-                break;
+    int pixelCount = width * height;
+    pixels.resize(pixelCount);
+    pixels.fill(0);
+
+    byte initCodeSize = reader.read<byte>();
+    if (initCodeSize < 1 || initCodeSize > 8)
+        initCodeSize = 8;
+
+    // pull every data sub-block in first so the decoder can run over one flat buffer
+    QByteArray data;
+    data.reserve(pixelCount);
+    int blockSize = reader.read<byte>();
+    while (blockSize != 0) {
+        int pos = data.size();
+        data.resize(pos + blockSize);
+        reader.readBytes(data.data() + pos, blockSize);
+        blockSize = reader.read<byte>();
+    }
 
-            pixels[offset++] = decoder.stack[--stackPtr];
-            i++;
-        }
+    // interlaced images are decoded linearly then moved into place afterwards
+    QByteArray linear;
+    byte *dst = reinterpret_cast<byte *>(pixels.data());
+    if (interlaced) {
+        linear.resize(pixelCount);
+        linear.fill(0);
+        dst = reinterpret_cast<byte *>(linear.data());
     }
 
-    while (i < length) {
-        int gifCode = readCode(reader);
-        if (gifCode == eofCode) {
-            if (i != length - 1 || decoder.pixelCount != 0)
-                return;
+    const byte *src    = reinterpret_cast<const byte *>(data.constData());
+    const byte *srcEnd = src + data.size();
+
+    // every code stores its prefix, last & first pixels and its full length,
+    // which lets each string be written straight into the output back to front
+    ushort prefix[LZ_MAX_CODE + 1];
+    ushort length[LZ_MAX_CODE + 1];
+    byte suffix[LZ_MAX_CODE + 1];
+    byte firstPixel[LZ_MAX_CODE + 1];
+
+    int clearCode = 1 << initCodeSize;
+    int eofCode   = clearCode + 1;
+    for (int c = 0; c < clearCode; ++c) {
+        prefix[c]     = 0;
+        length[c]     = 1;
+        suffix[c]     = (byte)c;
+        firstPixel[c] = (byte)c;
+    }
 
-            i++;
-        }
-        else {
-            if (gifCode == clearCode) {
-                for (int p = 0; p <= LZ_MAX_CODE; p++) decoder.prefix[p] = NO_SUCH_CODE;
+    int nextCode = eofCode + 1;
+    int codeBits = initCodeSize + 1;
+    int prevCode = -1;
+
+    quint64 bitBuffer = 0;
+    int bitCount      = 0;
 
-                decoder.runningCode    = decoder.eofCode + 1;
-                decoder.runningBits    = decoder.depth + 1;
-                decoder.maxCodePlusOne = 1 << decoder.runningBits;
-                prevCode = decoder.prevCode = NO_SUCH_CODE;
+    int pos = 0;
+    while (pos < pixelCount) {
+        if (bitCount < codeBits) {
+            while (bitCount <= 56 && src < srcEnd) {
+                bitBuffer |= (quint64)*src++ << bitCount;
+                bitCount += 8;
             }
-            else {
-                if (gifCode < clearCode) {
-                    pixels[offset] = (byte)gifCode;
-                    offset++;
-                    i++;
-                }
-                else {
-                    if (gifCode < 0 || gifCode > LZ_MAX_CODE)
-                        return;
+            if (bitCount < codeBits)
+                break; // ran out of data
+        }
 
-                    int code;
-                    if (decoder.prefix[gifCode] == NO_SUCH_CODE) {
-                        if (gifCode != decoder.runningCode - 2)
-                            return;
+        int code = (int)(bitBuffer & codeMasks[codeBits]);
+        bitBuffer >>= codeBits;
+        bitCount -= codeBits;
 
-                        code                                    = prevCode;
-                        decoder.suffix[decoder.runningCode - 2] = decoder.stack[stackPtr++] =
-                            tracePrefix(prevCode, clearCode);
-                    }
-                    else {
-                        code = gifCode;
-                    }
-                    int c = 0;
-                    while (c++ <= LZ_MAX_CODE && code > clearCode && code <= LZ_MAX_CODE) {
-                        decoder.stack[stackPtr++] = decoder.suffix[code];
-                        code                      = (int)decoder.prefix[code];
-                    }
-                    if (c >= LZ_MAX_CODE || code > LZ_MAX_CODE)
-                        return;
+        if (code == clearCode) {
+            nextCode = eofCode + 1;
+            codeBits = initCodeSize + 1;
+            prevCode = -1;
+            continue;
+        }
+        if (code == eofCode)
+            break;
 
-                    decoder.stack[stackPtr++] = (byte)code;
-                    while (stackPtr != 0 && i++ < length) pixels[offset++] = decoder.stack[--stackPtr];
-                }
+        if (prevCode < 0) {
+            if (code >= clearCode)
+                break; // the first code after a clear has to be a literal
 
-                if (prevCode != NO_SUCH_CODE) {
-                    if (decoder.runningCode < 2 || decoder.runningCode > FIRST_CODE)
-                        return;
+            dst[pos++] = (byte)code;
+            prevCode   = code;
+            continue;
+        }
 
-                    decoder.prefix[decoder.runningCode - 2] = (uint)prevCode;
-                    if (gifCode == decoder.runningCode - 2)
-                        decoder.suffix[decoder.runningCode - 2] = tracePrefix(prevCode, clearCode);
-                    else
-                        decoder.suffix[decoder.runningCode - 2] = tracePrefix(gifCode, clearCode);
-                }
-                prevCode = gifCode;
+        if (code > nextCode || (code == nextCode && nextCode > LZ_MAX_CODE))
+            break; // corrupt stream
+
+        if (nextCode <= LZ_MAX_CODE) {
+            prefix[nextCode]     = (ushort)prevCode;
+            length[nextCode]     = length[prevCode] + 1;
+            suffix[nextCode]     = code == nextCode ? firstPixel[prevCode] : firstPixel[code];
+            firstPixel[nextCode] = firstPixel[prevCode];
+
+            if (++nextCode == (1 << codeBits) && codeBits < LZ_BITS)
+                ++codeBits;
+        }
+
+        int len = length[code];
+        int c   = code;
+        if (pos + len <= pixelCount) {
+            byte *out = dst + pos + len - 1;
+            while (c > eofCode) {
+                *out-- = suffix[c];
+                c      = prefix[c];
             }
+            *out = (byte)c;
         }
-    }
-    decoder.prevCode = prevCode;
-    decoder.stackPtr = stackPtr;
-}
-int FormatHelpers::Gif::readCode(Reader &reader)
-{
-    while (decoder.shiftState < decoder.runningBits) {
-        byte b = readByte(reader);
-        decoder.shiftData |= (uint)b << decoder.shiftState;
-        decoder.shiftState += 8;
-    }
-    int result = (int)(decoder.shiftData & (uint)codeMasks[decoder.runningBits]);
-    decoder.shiftData >>= decoder.runningBits;
-    decoder.shiftState -= decoder.runningBits;
-    if (++decoder.runningCode > decoder.maxCodePlusOne && decoder.runningBits < LZ_BITS) {
-        decoder.maxCodePlusOne <<= 1;
-        decoder.runningBits++;
-    }
-    return result;
-}
-byte FormatHelpers::Gif::readByte(Reader &reader)
-{
-    byte c = 0;
-    if (decoder.fileState == PARSE_COMPLETE)
-        return c;
-
-    byte b;
-    if (decoder.position == decoder.bufferSize) {
-        b                  = reader.read<byte>();
-        decoder.bufferSize = (int)b;
-        if (decoder.bufferSize == 0) {
-            decoder.fileState = PARSE_COMPLETE;
-            return c;
+        else {
+            // the last string can run past the end of the image, skip what doesn't fit
+            for (int i = pos + len - 1; i >= pos; --i) {
+                if (i < pixelCount)
+                    dst[i] = suffix[c];
+                c = prefix[c];
+            }
         }
-        reader.readBytes(decoder.buffer, decoder.bufferSize);
-        b                = decoder.buffer[0];
-        decoder.position = 1;
-    }
-    else {
-        b = decoder.buffer[decoder.position++];
+        pos += len;
+        prevCode = code;
     }
-    return b;
-}
-byte FormatHelpers::Gif::tracePrefix(int code, int clearCode)
-{
-    int i = 0;
-    while (code > clearCode && i++ <= LZ_MAX_CODE) code = (int)decoder.prefix[code];
-
-    return (byte)code;
-}
-void FormatHelpers::Gif::readPictureData(int width, int height, bool interlaced, Reader &reader)
-{
-    pixels.resize(width * height);
 
-    initDecoder(reader);
     if (interlaced) {
+        const byte *row = reinterpret_cast<const byte *>(linear.constData());
         for (int p = 0; p < 4; ++p) {
-            for (int y = initialRows[p]; y < height; y += rowInc[p]) readLine(reader, width, y * width);
+            for (int y = initialRows[p]; y < height; y += rowInc[p], row += width)
+                memcpy(pixels.data() + y * width, row, width);
         }
     }
-    else {
-        for (int h = 0; h < height; ++h) readLine(reader, width, h * width);
-    }
 }
 
 // GIF WRITING
-void FormatHelpers::Gif::insertHashTable(uint key, int code)
-{
-    uint hKey = ((key >> 12) ^ key) & HT_KEY_MASK;
-
-    while ((encoder.hashTable[hKey] >> 12) != 0xFFFFF) hKey = (hKey + 1) & HT_KEY_MASK;
-
-    encoder.hashTable[hKey] = (uint)((key << 12) | (code & 0x0FFF));
-}
-int FormatHelpers::Gif::existsHashTable(uint key)
+void FormatHelpers::Gif::writePalette(Writer &writer, int first, int count) const
 {
-    uint hKey     = ((key >> 12) ^ key) & HT_KEY_MASK;
-    uint tableKey = 0;
+    byte rgb[0x100 * 3];
 
-    while ((tableKey = encoder.hashTable[hKey] >> 12) != 0xFFFFF) {
-        if (key == tableKey)
-            return (int)(encoder.hashTable[hKey] & 0x0FFF);
-        hKey = (hKey + 1) & HT_KEY_MASK;
+    byte *dst = rgb;
+    for (int c = first; c < first + count; ++c) {
+        *dst++ = qRed(palette[c]);
+        *dst++ = qGreen(palette[c]);
+        *dst++ = qBlue(palette[c]);
     }
 
-    return -1;
+    writer.write(rgb, count * 3);
 }
 
-void FormatHelpers::Gif::initEncoder(Writer &writer, byte bitsPerPixel)
+void FormatHelpers::Gif::writePictureData(int width, int height, bool interlaced, byte bitsPerPixel,
+                                          Writer &writer) const
 {
+    int pixelCount    = width * height;
     byte initCodeSize = bitsPerPixel < 2 ? (byte)2 : bitsPerPixel;
-    writer.write<byte>(initCodeSize);
-
-    encoder.fileState      = PARSING_IMAGE;
-    encoder.bufferSize     = 0;
-    encoder.buffer[0]      = 0;
-    encoder.depth          = initCodeSize;
-    encoder.clearCode      = 1 << initCodeSize;
-    encoder.eofCode        = encoder.clearCode + 1;
-    encoder.runningCode    = encoder.eofCode + 1;
-    encoder.runningBits    = initCodeSize + 1;
-    encoder.maxCodePlusOne = 1 << encoder.runningBits;
-    encoder.currentCode    = FIRST_CODE;
-    encoder.shiftState     = 0;
-    encoder.shiftData      = 0;
-    for (int i = 0; i < HT_SIZE; ++i) encoder.hashTable[i] = 0xFFFFFFFF;
-
-    writeCode(writer, encoder.clearCode);
-}
-void FormatHelpers::Gif::writeByte(Writer &writer, int b, bool flush)
-{
-    if (flush) {
-        // write everything we've got
-        writer.write<byte>(encoder.bufferSize);
-        writer.write(encoder.buffer, encoder.bufferSize);
-        encoder.bufferSize = 0;
-    }
-    else {
-        if (encoder.bufferSize == 0xFF) {
-            // buffer is full, write it to file
-            writer.write<byte>(encoder.bufferSize);
-            writer.write(encoder.buffer, encoder.bufferSize);
-            encoder.bufferSize = 0;
-        }
-        encoder.buffer[encoder.bufferSize++] = (byte)b;
-    }
-}
-void FormatHelpers::Gif::writeCode(Writer &writer, int code, bool flush)
-{
-    if (flush) {
-        // write remaining data
-        while (encoder.shiftState > 0) {
-            writeByte(writer, (int)(encoder.shiftData & 0xFF));
-            encoder.shiftData >>= 8;
-            encoder.shiftState -= 8;
+    int mask          = codeMasks[initCodeSize];
+
+    // interlaced images are reordered up front so the encoder only ever sees one linear run
+    const byte *px = reinterpret_cast<const byte *>(pixels.constData());
+    QByteArray ordered;
+    if (interlaced) {
+        ordered.resize(pixelCount);
+        byte *row = reinterpret_cast<byte *>(ordered.data());
+        for (int p = 0; p < 4; ++p) {
+            for (int y = initialRows[p]; y < height; y += rowInc[p], row += width)
+                memcpy(row, &px[y * width], width);
         }
-        // clear & reset
-        encoder.shiftState = 0;
-        writeByte(writer, 0, true);
+        px = reinterpret_cast<const byte *>(ordered.constData());
     }
-    else {
-        encoder.shiftData |= ((uint)code) << encoder.shiftState;
-        encoder.shiftState += encoder.runningBits;
-
-        // write any full bytes we have
-        while (encoder.shiftState >= 8) {
-            writeByte(writer, (int)(encoder.shiftData & 0xFF));
-            encoder.shiftData >>= 8;
-            encoder.shiftState -= 8;
+
+    // worst case is a 12 bit code per pixel plus a clear code every 4K entries
+    QByteArray codeStream;
+    codeStream.resize(((pixelCount + (pixelCount >> 11) + 8) * LZ_BITS) / 8 + 8);
+    byte *out = reinterpret_cast<byte *>(codeStream.data());
+
+    int clearCode      = 1 << initCodeSize;
+    int eofCode        = clearCode + 1;
+    int runningCode    = eofCode + 1;
+    int runningBits    = initCodeSize + 1;
+    int maxCodePlusOne = 1 << runningBits;
+
+    quint64 bitBuffer = 0;
+    int bitCount      = 0;
+
+    auto writeCode = [&](int code) {
+        bitBuffer |= (quint64)code << bitCount;
+        bitCount += runningBits;
+        while (bitCount >= 8) {
+            *out++ = (byte)bitBuffer;
+            bitBuffer >>= 8;
+            bitCount -= 8;
         }
-    }
 
-    // add more bits for the code if needed
-    if (encoder.runningCode >= encoder.maxCodePlusOne && code <= LZ_MAX_CODE)
-        encoder.maxCodePlusOne = 1 << ++encoder.runningBits;
-}
-void FormatHelpers::Gif::writeLine(Writer &writer, byte *line, int length)
-{
-    int mask = codeMasks[encoder.depth];
+        // add more bits for the code if needed
+        if (runningCode >= maxCodePlusOne && code <= LZ_MAX_CODE)
+            maxCodePlusOne = 1 << ++runningBits;
+    };
 
-    int pxPos = 0, curCode = 0;
-    if (encoder.currentCode == FIRST_CODE)
-        curCode = line[pxPos++] & mask;
-    else
-        curCode = encoder.currentCode;
+    // keys are (prefix code << 8) | pixel, empty slots are 0xFFFFFFFF
+    uint hashKeys[HT_SIZE];
+    ushort hashCodes[HT_SIZE];
+    memset(hashKeys, 0xFF, sizeof(hashKeys));
 
-    while (pxPos < length) {
-        byte pixel = line[pxPos++] & mask;
+    writeCode(clearCode);
 
-        // create a key based on our code & the next pixel
-        int newCode = 0;
-        uint newKey = (((uint)curCode) << 8) + pixel;
-        if ((newCode = existsHashTable(newKey)) >= 0) {
-            curCode = newCode;
-        }
-        else {
-            writeCode(writer, curCode);
+    if (pixelCount > 0) {
+        int curCode = px[0] & mask;
+        for (int p = 1; p < pixelCount; ++p) {
+            byte pixel = px[p] & mask;
+
+            // create a key based on our code & the next pixel
+            uint key  = ((uint)curCode << 8) | pixel;
+            uint hKey = ((key >> 12) ^ key) & HT_KEY_MASK;
+            while (hashKeys[hKey] != key && hashKeys[hKey] != 0xFFFFFFFF)
+                hKey = (hKey + 1) & HT_KEY_MASK;
+
+            if (hashKeys[hKey] == key) {
+                curCode = hashCodes[hKey];
+                continue;
+            }
+
+            writeCode(curCode);
             curCode = pixel;
 
             // handle clear codes if the hash table is full
-            if (encoder.runningCode >= LZ_MAX_CODE) {
-                writeCode(writer, encoder.clearCode);
-                encoder.runningCode    = encoder.eofCode + 1;
-                encoder.runningBits    = encoder.depth + 1;
-                encoder.maxCodePlusOne = 1 << encoder.runningBits;
-
-                // clear hash table
-                for (int h = 0; h < HT_SIZE; ++h) encoder.hashTable[h] = 0xFFFFFFFF;
+            if (runningCode >= LZ_MAX_CODE) {
+                writeCode(clearCode);
+                runningCode    = eofCode + 1;
+                runningBits    = initCodeSize + 1;
+                maxCodePlusOne = 1 << runningBits;
+
+                memset(hashKeys, 0xFF, sizeof(hashKeys));
             }
             else {
-                // add this to the hash table
-                insertHashTable(newKey, encoder.runningCode++);
+                // hKey is already sitting on the free slot the probe stopped at
+                hashKeys[hKey]  = key;
+                hashCodes[hKey] = (ushort)runningCode++;
             }
         }
-    }
-
-    // keep this, it'll be needed later or at the end
-    encoder.currentCode = curCode;
-}
-void FormatHelpers::Gif::writePictureData(int width, int height, bool interlaced, byte bitsPerPixel,
-                                          Writer &writer)
-{
-    initEncoder(writer, bitsPerPixel);
 
-    byte *px = reinterpret_cast<byte *>(pixels.data());
-    if (interlaced) {
-        for (int p = 0; p < 4; ++p) {
-            for (int y = initialRows[p]; y < height; y += rowInc[p])
-                writeLine(writer, &px[y * width], width);
-        }
+        writeCode(curCode);
     }
-    else {
-        for (int y = 0; y < height; ++y) writeLine(writer, &px[y * width], width);
+    writeCode(eofCode);
+
+    // write remaining data
+    if (bitCount > 0)
+        *out++ = (byte)bitBuffer;
+
+    // split the code stream up into sub-blocks of up to 255 bytes
+    int streamSize = (int)(out - reinterpret_cast<byte *>(codeStream.data()));
+    QByteArray blocks;
+    blocks.resize(1 + streamSize + (streamSize / 0xFF) + 2);
+
+    byte *dst       = reinterpret_cast<byte *>(blocks.data());
+    const byte *src = reinterpret_cast<const byte *>(codeStream.constData());
+    *dst++          = initCodeSize;
+    for (int remaining = streamSize; remaining > 0;) {
+        int size = remaining < 0xFF ? remaining : 0xFF;
+        *dst++   = (byte)size;
+        memcpy(dst, src, size);
+        dst += size;
+        src += size;
+        remaining -= size;
     }
+    *dst++ = 0; // block terminator
 
-    // write extra data
-    writeCode(writer, encoder.currentCode);
-    writeCode(writer, encoder.eofCode);
-    writeCode(writer, 0, true);
-
-    writer.write<byte>(0); // block terminator
-
-    encoder.fileState = PARSE_COMPLETE;
+    blocks.resize((int)(dst - reinterpret_cast<byte *>(blocks.data())));
+    writer.write(blocks);
 }
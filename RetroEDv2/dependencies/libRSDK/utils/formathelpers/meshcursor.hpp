@@ -0,0 +1,103 @@
+#pragma once
+
+namespace FormatHelpers
+{
+
+// the mesh importers read the whole file up front & walk it with this, not a Reader call per char
+struct MeshCursor {
+    const char *ptr = nullptr;
+    const char *end = nullptr;
+    bool bigEndian  = false;
+    bool failed     = false;
+
+    MeshCursor() {}
+    MeshCursor(const char *start, const char *end) : ptr(start), end(end) {}
+
+    QByteArray readLine()
+    {
+        MeshCursor line = nextLine();
+        return QByteArray(line.ptr, (int)(line.end - line.ptr));
+    }
+
+    // the next line as a cursor of its own (without the line break), nothing is copied
+    MeshCursor nextLine()
+    {
+        const char *start = ptr;
+        const char *found = (const char *)memchr(ptr, '\n', end - ptr);
+        ptr               = found ? found : end;
+
+        const char *lineEnd = ptr;
+        if (lineEnd > start && lineEnd[-1] == '\r')
+            --lineEnd;
+        if (ptr < end)
+            ++ptr;
+
+        return MeshCursor(start, lineEnd);
+    }
+
+    inline void skipSpaces()
+    {
+        while (ptr < end && (*ptr == ' ' || *ptr == '\t' || *ptr == '\r' || *ptr == '\n')) ++ptr;
+    }
+
+    template <typename T> inline double readBinary()
+    {
+        if (end - ptr < (qint64)sizeof(T)) {
+            failed = true;
+            ptr    = end;
+            return 0;
+        }
+
+        // swapped by hand since qFromBigEndian doesn't handle floats on older Qt versions
+        T value;
+        if (bigEndian)
+            std::reverse_copy(ptr, ptr + sizeof(T), (char *)&value);
+        else
+            memcpy(&value, ptr, sizeof(T));
+        ptr += sizeof(T);
+        return value;
+    }
+
+    // locale independent, floats are only stored at single precision anyways
+    double readASCII()
+    {
+        skipSpaces();
+        if (ptr >= end) {
+            failed = true;
+            return 0;
+        }
+
+        bool negative = *ptr == '-';
+        if (*ptr == '-' || *ptr == '+')
+            ++ptr;
+
+        double value = 0;
+        while (ptr < end && *ptr >= '0' && *ptr <= '9') value = value * 10 + (*ptr++ - '0');
+
+        if (ptr < end && *ptr == '.') {
+            double scale = 0.1;
+            for (++ptr; ptr < end && *ptr >= '0' && *ptr <= '9'; ++ptr, scale *= 0.1)
+                value += (*ptr - '0') * scale;
+        }
+
+        if (ptr < end && (*ptr == 'e' || *ptr == 'E')) {
+            ++ptr;
+            bool negExp = ptr < end && *ptr == '-';
+            if (ptr < end && (*ptr == '-' || *ptr == '+'))
+                ++ptr;
+
+            int exponent = 0;
+            // capped, anything past it is out of a double's range anyways
+            while (ptr < end && *ptr >= '0' && *ptr <= '9')
+                exponent = qMin(exponent * 10 + (*ptr++ - '0'), 1000);
+            value *= pow(10.0, negExp ? -exponent : exponent);
+        }
+
+        // skip anything we don't understand (nan, inf, etc) so the next value lines up
+        while (ptr < end && *ptr != ' ' && *ptr != '\t' && *ptr != '\r' && *ptr != '\n') ++ptr;
+
+        return negative ? -value : value;
+    }
+};
+
+} // namespace FormatHelpers
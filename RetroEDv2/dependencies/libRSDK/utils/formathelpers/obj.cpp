@@ -0,0 +1,279 @@
+#include "libRSDK.hpp"
+
+#include "meshcursor.hpp"
+
+namespace
+{
+
+struct Corner {
+    int position = -1;
+    int texCoord = -1;
+    int normal   = -1;
+};
+
+struct Face {
+    int object = 0;
+    int first  = 0; // into the corner list
+    int count  = 0;
+};
+
+// indices count from 1 & negative ones back from the last value read so far, -1 if it isn't either
+int readIndex(FormatHelpers::MeshCursor &line, int count)
+{
+    bool negative = line.ptr < line.end && *line.ptr == '-';
+    if (negative)
+        ++line.ptr;
+
+    qint64 value = 0;
+    bool digits  = false;
+    for (; line.ptr < line.end && *line.ptr >= '0' && *line.ptr <= '9'; ++line.ptr, digits = true)
+        value = qMin<qint64>(value * 10 + (*line.ptr - '0'), std::numeric_limits<int>::max());
+
+    qint64 index = negative ? count - value : value - 1;
+    return digits && index >= 0 && index < count ? (int)index : -1;
+}
+
+} // namespace
+
+bool FormatHelpers::OBJ::read(QString filePath)
+{
+    this->filePath = filePath;
+
+    // a file that can't be opened reads as empty, so the old mesh is still cleared
+    QByteArray data;
+    QFile file(filePath);
+    if (file.open(QIODevice::ReadOnly))
+        data = file.readAll();
+    file.close();
+
+    return read(data);
+}
+
+bool FormatHelpers::OBJ::read(const QByteArray &data)
+{
+    vertexCount       = 0;
+    faceVerticesCount = 3;
+    hasNormals        = false;
+    hasTextures       = false;
+    hasColors         = false;
+    frames.clear();
+    texCoords.clear();
+    colors.clear();
+    indices.clear();
+
+    const char *start = data.constData();
+    const char *end   = data.constData() + data.size();
+
+    // there's no header, so the counts come from a first pass over the line starts & everything is
+    // allocated once
+    int positionTotal = 0, texCoordTotal = 0, normalTotal = 0, faceTotal = 0;
+    for (MeshCursor cursor(start, end); cursor.ptr < cursor.end;) {
+        MeshCursor line = cursor.nextLine();
+        line.skipSpaces();
+        if (line.end - line.ptr < 2)
+            continue;
+
+        if (line.ptr[0] == 'v' && line.ptr[1] == ' ')
+            ++positionTotal;
+        else if (line.ptr[0] == 'v' && line.ptr[1] == 't')
+            ++texCoordTotal;
+        else if (line.ptr[0] == 'v' && line.ptr[1] == 'n')
+            ++normalTotal;
+        else if (line.ptr[0] == 'f' && line.ptr[1] == ' ')
+            ++faceTotal;
+    }
+
+    QVector<float> allPositions, allTexCoords, allNormals;
+    QVector<byte> allColors;
+    allPositions.reserve(positionTotal * 3);
+    allColors.reserve(positionTotal * 4);
+    allTexCoords.reserve(texCoordTotal * 2);
+    allNormals.reserve(normalTotal * 3);
+
+    QVector<Corner> corners;
+    QVector<Face> faces;
+    corners.reserve(faceTotal * 3);
+    faces.reserve(faceTotal);
+
+    // where each object's positions, uvs & normals start
+    QVector<int> objectPositions = { 0 };
+    QVector<int> objectTexCoords = { 0 };
+    QVector<int> objectNormals   = { 0 };
+
+    for (MeshCursor cursor(start, end); cursor.ptr < cursor.end;) {
+        MeshCursor line = cursor.nextLine();
+        line.skipSpaces();
+
+        const char *word = line.ptr;
+        while (line.ptr < line.end && *line.ptr != ' ' && *line.ptr != '\t') ++line.ptr;
+        QByteArray keyword = QByteArray::fromRawData(word, (int)(line.ptr - word));
+
+        if (keyword == "v") {
+            // "x y z", "x y z w" or "x y z r g b" for vertex colours
+            double values[7] = { 0, 0, 0, 0, 0, 0, 0 };
+            int count        = 0;
+            for (; count < 7; ++count) {
+                values[count] = line.readASCII();
+                if (line.failed)
+                    break;
+            }
+
+            allPositions.append(values[0]);
+            allPositions.append(values[1]);
+            allPositions.append(values[2]);
+
+            hasColors |= count == 6;
+            for (int c = 0; c < 3; ++c) {
+                byte colour = c == 1 ? 0x00 : 0xFF;
+                if (count == 6)
+                    colour = (byte)qBound(0, (int)(values[3 + c] * 255.0f), 0xFF);
+                allColors.append(colour);
+            }
+            allColors.append(0xFF);
+        }
+        else if (keyword == "vt") {
+            allTexCoords.append(line.readASCII());
+            allTexCoords.append(line.readASCII());
+        }
+        else if (keyword == "vn") {
+            allNormals.append(line.readASCII());
+            allNormals.append(line.readASCII());
+            allNormals.append(line.readASCII());
+        }
+        else if (keyword == "f") {
+            Face face;
+            face.object = objectPositions.count() - 1;
+            face.first  = corners.count();
+
+            // each corner is "p", "p/t", "p//n" or "p/t/n"
+            for (line.skipSpaces(); line.ptr < line.end; line.skipSpaces()) {
+                Corner corner;
+                corner.position = readIndex(line, allPositions.count() / 3);
+                if (line.ptr < line.end && *line.ptr == '/') {
+                    ++line.ptr;
+                    corner.texCoord = readIndex(line, allTexCoords.count() / 2);
+                }
+                if (line.ptr < line.end && *line.ptr == '/') {
+                    ++line.ptr;
+                    corner.normal = readIndex(line, allNormals.count() / 3);
+                }
+
+                // skip anything we don't understand so the next corner lines up
+                while (line.ptr < line.end && *line.ptr != ' ' && *line.ptr != '\t') ++line.ptr;
+
+                corners.append(corner);
+            }
+
+            face.count = corners.count() - face.first;
+            faces.append(face);
+        }
+        else if (keyword == "o") {
+            // a new frame, unless the last object hasn't had any vertices yet
+            if (allPositions.count() / 3 > objectPositions.last()) {
+                objectPositions.append(allPositions.count() / 3);
+                objectTexCoords.append(allTexCoords.count() / 2);
+                objectNormals.append(allNormals.count() / 3);
+            }
+        }
+    }
+
+    objectPositions.append(allPositions.count() / 3);
+    objectTexCoords.append(allTexCoords.count() / 2);
+    objectNormals.append(allNormals.count() / 3);
+
+    vertexCount = objectPositions[1] - objectPositions[0];
+    if (!vertexCount) {
+        hasColors = false;
+        return false;
+    }
+
+    QVector<int> objectFrames(objectPositions.count() - 1, -1);
+    for (int o = 0; o < objectFrames.count(); ++o) {
+        int first = objectPositions[o];
+        if (objectPositions[o + 1] - first != vertexCount)
+            continue;
+
+        objectFrames[o] = frames.count();
+
+        Frame frame;
+        frame.positions = allPositions.mid(first * 3, vertexCount * 3);
+        frame.normals.fill(0, vertexCount * 3);
+
+        // normals written one per vertex (the way the model editor exports them) are matched by order,
+        // any that a face names are set from there after
+        if (objectNormals[o + 1] - objectNormals[o] == vertexCount) {
+            memcpy(frame.normals.data(), allNormals.constData() + objectNormals[o] * 3,
+                   vertexCount * 3 * sizeof(float));
+            hasNormals = true;
+        }
+
+        frames.append(frame);
+    }
+
+    // uvs are shared by every frame, the first one's are matched the same way as the normals
+    texCoords.fill(0, vertexCount * 2);
+    if (objectTexCoords[1] - objectTexCoords[0] == vertexCount) {
+        memcpy(texCoords.data(), allTexCoords.constData(), vertexCount * 2 * sizeof(float));
+        hasTextures = true;
+    }
+
+    colors = allColors.mid(0, vertexCount * 4);
+    indices.reserve(faces.count() * 4);
+
+    bool firstFace = true;
+    for (const Face &face : faces) {
+        int frameID = objectFrames[face.object];
+        if (frameID < 0)
+            continue;
+
+        Frame &frame  = frames[frameID];
+        int first     = objectPositions[face.object];
+        bool complete = face.count >= 3;
+
+        for (int c = 0; c < face.count; ++c) {
+            const Corner &corner = corners[face.first + c];
+            int v                = corner.position - first;
+            if (corner.position < 0 || v < 0 || v >= vertexCount) {
+                complete = false;
+                continue;
+            }
+
+            if (corner.normal >= 0) {
+                memcpy(&frame.normals[v * 3], &allNormals[corner.normal * 3], 3 * sizeof(float));
+                hasNormals = true;
+            }
+
+            if (corner.texCoord >= 0 && frameID == 0) {
+                texCoords[v * 2 + 0] = allTexCoords[corner.texCoord * 2 + 0];
+                texCoords[v * 2 + 1] = allTexCoords[corner.texCoord * 2 + 1];
+                hasTextures          = true;
+            }
+        }
+
+        // the faces are shared by every frame, so only the first frame's are kept
+        if (frameID != 0 || !complete)
+            continue;
+
+        if (firstFace) {
+            faceVerticesCount = face.count == 4 ? 4 : 3;
+            firstFace         = false;
+        }
+
+        auto index = [&](int c) { return (ushort)(corners[face.first + c].position - first); };
+        if (faceVerticesCount == 4 && face.count == 4) {
+            for (int c = 0; c < 4; ++c) indices.append(index(c));
+            continue;
+        }
+
+        // split into a fan of triangles, the last corner is repeated if the model is made of quads
+        for (int c = 1; c + 1 < face.count; ++c) {
+            indices.append(index(0));
+            indices.append(index(c));
+            indices.append(index(c + 1));
+            if (faceVerticesCount == 4)
+                indices.append(index(c + 1));
+        }
+    }
+
+    return true;
+}
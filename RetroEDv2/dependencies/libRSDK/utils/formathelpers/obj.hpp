@@ -0,0 +1,44 @@
+#pragma once
+
+namespace FormatHelpers
+{
+
+// mesh importer shared by the v4 & v5 models, every object ("o") in a file is a frame. obj indexes
+// positions, uvs & normals separately while the models keep one of each per vertex, so uvs & normals
+// are matched up to the position a face corner uses
+class OBJ
+{
+public:
+    OBJ() {}
+    OBJ(QString filePath) { read(filePath); }
+
+    // false if no vertices were found, anything that isn't understood is skipped
+    bool read(QString filePath);
+    bool read(const QByteArray &data);
+
+    struct Frame {
+        QVector<float> positions; // xyz
+        QVector<float> normals;   // xyz
+    };
+
+    // per frame, objects with a different count can't share the first one's faces so they're dropped
+    int vertexCount = 0;
+    QVector<Frame> frames;
+
+    // per vertex, missing values are left zeroed (colours default to magenta)
+    QVector<float> texCoords; // uv
+    QVector<byte> colors;     // rgba, from "v x y z r g b" lines
+
+    // from the first frame's faces, quads are kept if the first face is one & anything else is split
+    // into triangles. past 0xFFFF the indices wrap, the models can't hold more than that
+    QVector<ushort> indices;
+    int faceVerticesCount = 3;
+
+    bool hasNormals  = false;
+    bool hasTextures = false;
+    bool hasColors   = false;
+
+    QString filePath = "";
+};
+
+} // namespace FormatHelpers
@@ -0,0 +1,307 @@
+#include "libRSDK.hpp"
+
+#include "meshcursor.hpp"
+
+namespace
+{
+
+// the largest per vertex array is 4 colour bytes, more entries than this would overflow its size
+const qint64 maxElementCount = std::numeric_limits<int>::max() / 4;
+
+} // namespace
+
+byte FormatHelpers::PLY::getPropertyType(const QByteArray &type)
+{
+    QByteArray t = type.toLower();
+
+    if (t == "char" || t == "int8")
+        return TYPE_INT8;
+    else if (t == "uchar" || t == "uint8")
+        return TYPE_UINT8;
+    else if (t == "short" || t == "int16")
+        return TYPE_INT16;
+    else if (t == "ushort" || t == "uint16")
+        return TYPE_UINT16;
+    else if (t == "int32" || t == "int")
+        return TYPE_INT32;
+    else if (t == "uint32" || t == "uint")
+        return TYPE_UINT32;
+    else if (t == "float" || t == "float32")
+        return TYPE_FLOAT;
+    else if (t == "double64" || t == "double" || t == "float64")
+        return TYPE_DOUBLE;
+
+    return TYPE_UNKNOWN;
+}
+
+byte FormatHelpers::PLY::getPropertyTarget(const QByteArray &name)
+{
+    QByteArray n = name.toLower();
+
+    if (n == "x")
+        return TARGET_X;
+    else if (n == "y")
+        return TARGET_Y;
+    else if (n == "z")
+        return TARGET_Z;
+    else if (n == "nx")
+        return TARGET_NX;
+    else if (n == "ny")
+        return TARGET_NY;
+    else if (n == "nz")
+        return TARGET_NZ;
+    else if (n == "u" || n == "s" || n == "tx" || n == "texture_u")
+        return TARGET_U;
+    else if (n == "v" || n == "t" || n == "ty" || n == "texture_v")
+        return TARGET_V;
+    else if (n == "r" || n == "red")
+        return TARGET_R;
+    else if (n == "g" || n == "green")
+        return TARGET_G;
+    else if (n == "b" || n == "blue")
+        return TARGET_B;
+    else if (n == "a" || n == "alpha")
+        return TARGET_A;
+
+    return TARGET_NONE;
+}
+
+int FormatHelpers::PLY::getPropertySize(byte type)
+{
+    switch (type) {
+        default: return 0;
+        case TYPE_INT8:
+        case TYPE_UINT8: return 1;
+        case TYPE_INT16:
+        case TYPE_UINT16: return 2;
+        case TYPE_INT32:
+        case TYPE_UINT32:
+        case TYPE_FLOAT: return 4;
+        case TYPE_DOUBLE: return 8;
+    }
+}
+
+void FormatHelpers::PLY::setVertexValue(byte target, byte type, int v, double value)
+{
+    bool isFloat = type == TYPE_FLOAT || type == TYPE_DOUBLE;
+
+    // integer types are truncated, the same as the old QVariant::toInt() path
+    float f = isFloat ? (float)value : (float)(qint64)value;
+    byte c  = isFloat ? (byte)(int)(value * 255.0f) : (byte)(qint64)value;
+
+    switch (target) {
+        default: break;
+        case TARGET_X: positions[v * 3 + 0] = f; break;
+        case TARGET_Y: positions[v * 3 + 1] = f; break;
+        case TARGET_Z: positions[v * 3 + 2] = f; break;
+        case TARGET_NX: normals[v * 3 + 0] = f; break;
+        case TARGET_NY: normals[v * 3 + 1] = f; break;
+        case TARGET_NZ: normals[v * 3 + 2] = f; break;
+        case TARGET_U: texCoords[v * 2 + 0] = f; break;
+        case TARGET_V: texCoords[v * 2 + 1] = f; break;
+        case TARGET_R: colors[v * 4 + 0] = c; break;
+        case TARGET_G: colors[v * 4 + 1] = c; break;
+        case TARGET_B: colors[v * 4 + 2] = c; break;
+        case TARGET_A: colors[v * 4 + 3] = c; break;
+    }
+}
+
+bool FormatHelpers::PLY::read(QString filePath)
+{
+    this->filePath = filePath;
+
+    // a file that can't be opened reads as empty, so the old mesh is still cleared
+    QByteArray data;
+    QFile file(filePath);
+    if (file.open(QIODevice::ReadOnly))
+        data = file.readAll();
+    file.close();
+
+    return read(data);
+}
+
+bool FormatHelpers::PLY::read(const QByteArray &data)
+{
+    vertexCount       = 0;
+    faceVerticesCount = 3;
+    hasNormals        = false;
+    hasTextures       = false;
+    hasColors         = false;
+    positions.clear();
+    normals.clear();
+    texCoords.clear();
+    colors.clear();
+    indices.clear();
+
+    MeshCursor cursor(data.constData(), data.constData() + data.size());
+
+    if (cursor.readLine().trimmed().toLower() != "ply")
+        return false;
+
+    QList<QByteArray> format = cursor.readLine().simplified().split(' ');
+    if (format.count() < 3 || format[0].toLower() != "format")
+        return false;
+
+    bool binary      = format[1].toLower() != "ascii";
+    cursor.bigEndian = format[1].toLower().contains("big_endian");
+
+    QVector<Element> elements;
+    while (cursor.ptr < cursor.end) {
+        QList<QByteArray> line = cursor.readLine().simplified().split(' ');
+
+        QByteArray instruction = line[0].toLower();
+        if (instruction == "end_header")
+            break;
+
+        if (instruction == "element" && line.count() >= 3) {
+            Element element;
+            element.name  = line[1].toLower();
+            element.count = qMax(line[2].toInt(), 0);
+            elements.append(element);
+        }
+
+        if (instruction == "property" && line.count() >= 3) {
+            if (!elements.count())
+                continue;
+
+            Property property;
+            if (line[1].toLower() == "list") {
+                if (line.count() < 5)
+                    continue;
+
+                property.list     = true;
+                property.sizeType = getPropertyType(line[2]);
+                property.type     = getPropertyType(line[3]);
+            }
+            else {
+                property.type   = getPropertyType(line[1]);
+                property.target = getPropertyTarget(line[2]);
+            }
+
+            elements.last().properties.append(property);
+        }
+    }
+
+    // binary values are walked by size, there's no way past one we can't size
+    if (binary) {
+        for (auto &element : elements) {
+            for (auto &property : element.properties) {
+                if (!getPropertySize(property.type))
+                    return false;
+                if (property.list && !getPropertySize(property.sizeType))
+                    return false;
+            }
+        }
+    }
+
+    auto readValue = [&cursor, binary](byte type) -> double {
+        if (!binary)
+            return cursor.readASCII();
+
+        switch (type) {
+            default: return 0;
+            case TYPE_INT8: return cursor.readBinary<qint8>();
+            case TYPE_UINT8: return cursor.readBinary<quint8>();
+            case TYPE_INT16: return cursor.readBinary<qint16>();
+            case TYPE_UINT16: return cursor.readBinary<quint16>();
+            case TYPE_INT32: return cursor.readBinary<qint32>();
+            case TYPE_UINT32: return cursor.readBinary<quint32>();
+            case TYPE_FLOAT: return cursor.readBinary<float>();
+            case TYPE_DOUBLE: return cursor.readBinary<double>();
+        }
+    };
+
+    for (auto &element : elements) {
+        bool isVertex = element.name == "vertex";
+        bool isFace   = element.name == "face";
+
+        // the fewest bytes one entry can take (a value & a separator each in ascii, the last value in
+        // the file has none), so a count in the header can't ask for more than the file could hold
+        qint64 entrySize = 0;
+        for (auto &property : element.properties) {
+            byte type = property.list ? property.sizeType : property.type;
+            entrySize += binary ? getPropertySize(type) : 2;
+        }
+        qint64 left     = (cursor.end - cursor.ptr) + (binary ? 0 : 1);
+        qint64 maxCount = qMin<qint64>(left / qMax<qint64>(entrySize, 1), maxElementCount);
+        int count       = (int)qMin<qint64>(element.count, maxCount);
+
+        if (isVertex) {
+            // sizes are known from the header, so everything is allocated once
+            vertexCount = count;
+            positions.fill(0, vertexCount * 3);
+            normals.fill(0, vertexCount * 3);
+            texCoords.fill(0, vertexCount * 2);
+            colors.resize(vertexCount * 4);
+            for (int v = 0; v < vertexCount; ++v) {
+                colors[v * 4 + 0] = 0xFF;
+                colors[v * 4 + 1] = 0x00;
+                colors[v * 4 + 2] = 0xFF;
+                colors[v * 4 + 3] = 0xFF;
+            }
+
+            for (auto &property : element.properties) {
+                if (!vertexCount)
+                    break;
+
+                hasNormals |= property.target == TARGET_NX;
+                hasTextures |= property.target == TARGET_U || property.target == TARGET_V;
+                hasColors |= property.target >= TARGET_R && property.target <= TARGET_A;
+            }
+        }
+
+        // only the first list of a face holds the indices
+        int indexList = -1;
+        if (isFace) {
+            for (int p = 0; p < element.properties.count() && indexList < 0; ++p) {
+                if (element.properties[p].list)
+                    indexList = p;
+            }
+
+            indices.reserve(count * 3);
+        }
+
+        for (int i = 0; i < count && !cursor.failed; ++i) {
+            for (int p = 0; p < element.properties.count(); ++p) {
+                const Property &property = element.properties[p];
+
+                if (property.list) {
+                    double listSize = readValue(property.sizeType);
+                    // written this way round so a nan size fails too
+                    if (!(listSize >= 0) || cursor.failed) {
+                        cursor.failed = true;
+                        break;
+                    }
+
+                    // the size comes from the file too, so it's held to the values the bytes left could
+                    // hold (a separator & a digit each in ascii)
+                    qint64 left    = cursor.end - cursor.ptr;
+                    qint64 maxSize = binary ? left / getPropertySize(property.type) : left / 2;
+                    int size       = (int)qMin<double>(listSize, maxSize);
+
+                    for (int s = 0; s < size; ++s) {
+                        double value = readValue(property.type);
+                        if (cursor.failed)
+                            break;
+
+                        if (p == indexList)
+                            indices.append((ushort)(qint64)value);
+                    }
+
+                    if (p == indexList)
+                        faceVerticesCount = size;
+                }
+                else {
+                    double value = readValue(property.type);
+                    if (isVertex)
+                        setVertexValue(property.target, property.type, i, value);
+                }
+            }
+        }
+
+        if (cursor.failed)
+            break;
+    }
+
+    return true;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+namespace FormatHelpers
+{
+
+// mesh importer shared by the v4 & v5 models, ascii & binary (either endian) files
+class PLY
+{
+public:
+    PLY() {}
+    PLY(QString filePath) { read(filePath); }
+
+    // false if it isn't a ply file (or it's binary & uses a type with no known size), truncated files
+    // keep whatever was read
+    bool read(QString filePath);
+    bool read(const QByteArray &data);
+
+    int vertexCount = 0;
+
+    // per vertex, missing properties are left zeroed (colours default to magenta)
+    QVector<float> positions; // xyz
+    QVector<float> normals;   // xyz
+    QVector<float> texCoords; // uv
+    QVector<byte> colors;     // rgba
+
+    QVector<ushort> indices;
+    int faceVerticesCount = 3;
+
+    bool hasNormals  = false;
+    bool hasTextures = false;
+    bool hasColors   = false;
+
+    QString filePath = "";
+
+private:
+    enum PropertyTypes {
+        TYPE_UNKNOWN,
+        TYPE_INT8,
+        TYPE_UINT8,
+        TYPE_INT16,
+        TYPE_UINT16,
+        TYPE_INT32,
+        TYPE_UINT32,
+        TYPE_FLOAT,
+        TYPE_DOUBLE,
+    };
+
+    enum PropertyTargets {
+        TARGET_NONE,
+        TARGET_X,
+        TARGET_Y,
+        TARGET_Z,
+        TARGET_NX,
+        TARGET_NY,
+        TARGET_NZ,
+        TARGET_U,
+        TARGET_V,
+        TARGET_R,
+        TARGET_G,
+        TARGET_B,
+        TARGET_A,
+    };
+
+    struct Property {
+        byte type     = TYPE_UNKNOWN;
+        byte sizeType = TYPE_UNKNOWN; // list properties only
+        byte target   = TARGET_NONE;
+        bool list     = false;
+    };
+
+    struct Element {
+        QByteArray name;
+        int count = 0;
+        QVector<Property> properties;
+    };
+
+    static byte getPropertyType(const QByteArray &type);
+    static byte getPropertyTarget(const QByteArray &name);
+    static int getPropertySize(byte type);
+
+    void setVertexValue(byte target, byte type, int v, double value);
+};
+
+} // namespace FormatHelpers
@@ -0,0 +1,363 @@
+#include "libRSDK.hpp"
+
+#include <numeric>
+
+namespace
+{
+
+// 4x4 bayer matrix, centered on 0 when used
+const int bayer4x4[4][4] = {
+    { 0, 8, 2, 10 },
+    { 12, 4, 14, 6 },
+    { 3, 11, 1, 9 },
+    { 15, 7, 13, 5 },
+};
+
+inline int colorDistance(int r1, int g1, int b1, QRgb color)
+{
+    int dr = r1 - qRed(color);
+    int dg = g1 - qGreen(color);
+    int db = b1 - qBlue(color);
+    return dr * dr * 3 + dg * dg * 4 + db * db * 2;
+}
+
+// a tiny open addressed table, palettes top out at 256 colours so 512 slots never fill up
+class ExactColors
+{
+public:
+    ExactColors(const QVector<QRgb> &palette, int skipIndex)
+    {
+        memset(keys, 0xFF, sizeof(keys));
+        memset(used, 0, sizeof(used));
+        for (int i = 0; i < palette.count() && i < 0x100; ++i) {
+            if (i == skipIndex)
+                continue;
+
+            uint key  = palette[i] & 0xFFFFFF;
+            uint slot = hash(key);
+            while (used[slot] && keys[slot] != key) slot = (slot + 1) & 0x1FF;
+            if (!used[slot]) {
+                used[slot]    = true;
+                keys[slot]    = key;
+                indices[slot] = i;
+            }
+        }
+    }
+
+    inline int find(uint key) const
+    {
+        uint slot = hash(key);
+        while (used[slot]) {
+            if (keys[slot] == key)
+                return indices[slot];
+            slot = (slot + 1) & 0x1FF;
+        }
+        return -1;
+    }
+
+private:
+    static inline uint hash(uint key) { return ((key * 0x9E3779B1u) >> 23) & 0x1FF; }
+
+    uint keys[0x200];
+    byte indices[0x200];
+    bool used[0x200];
+};
+
+// nearest palette index for every 6 bit per channel colour, built in parallel over the red axis
+QByteArray buildLookup(const QVector<QRgb> &palette, int skipIndex)
+{
+    QByteArray lookup(0x40 * 0x40 * 0x40, 0);
+
+    QVector<int> slices(0x40);
+    std::iota(slices.begin(), slices.end(), 0);
+    QtConcurrent::blockingMap(slices, [&lookup, &palette, skipIndex](int r) {
+        byte *dst = (byte *)lookup.data() + r * 0x40 * 0x40;
+        int red   = (r << 2) | (r >> 4);
+        for (int g = 0; g < 0x40; ++g) {
+            int green = (g << 2) | (g >> 4);
+            for (int b = 0; b < 0x40; ++b) {
+                int blue = (b << 2) | (b >> 4);
+
+                int best     = 0;
+                int bestDist = std::numeric_limits<int>::max();
+                for (int i = 0; i < palette.count(); ++i) {
+                    if (i == skipIndex)
+                        continue;
+
+                    int dist = colorDistance(red, green, blue, palette[i]);
+                    if (dist < bestDist) {
+                        bestDist = dist;
+                        best     = i;
+                    }
+                }
+                *dst++ = best;
+            }
+        }
+    });
+
+    return lookup;
+}
+
+struct ColorBox {
+    int min[3];
+    int max[3];
+    QVector<int> bins; // 5 bit per channel histogram bins inside this box
+    qint64 count = 0;
+};
+
+inline int binChannel(int bin, int channel) { return (bin >> (10 - channel * 5)) & 0x1F; }
+
+} // namespace
+
+QVector<QRgb> Quantizer::buildPalette(const QImage &image, int maxColors)
+{
+    QVector<QRgb> palette;
+    if (maxColors <= 0 || image.isNull())
+        return palette;
+
+    QImage src = image.convertToFormat(QImage::Format_ARGB32);
+
+    QVector<int> rows(src.height());
+    std::iota(rows.begin(), rows.end(), 0);
+
+    // counted per chunk of rows then merged, 5 bits per channel keeps the table at 32k bins
+    const int chunkRows = 0x40;
+    int chunkCount      = (src.height() + chunkRows - 1) / chunkRows;
+
+    struct Histogram {
+        QVector<qint64> count;
+        QVector<qint64> sum[3];
+        QSet<QRgb> unique;
+        bool tooMany = false;
+    };
+    QVector<Histogram> histograms(chunkCount);
+
+    QVector<int> chunks(chunkCount);
+    std::iota(chunks.begin(), chunks.end(), 0);
+    QtConcurrent::blockingMap(chunks, [&src, &histograms, chunkRows, maxColors](int c) {
+        Histogram &hist = histograms[c];
+        hist.count.fill(0, 0x8000);
+        for (int i = 0; i < 3; ++i) hist.sum[i].fill(0, 0x8000);
+
+        QRgb lastUnique = 0;
+        int end         = qMin(src.height(), (c + 1) * chunkRows);
+        for (int y = c * chunkRows; y < end; ++y) {
+            const QRgb *line = (const QRgb *)src.constScanLine(y);
+            for (int x = 0; x < src.width(); ++x) {
+                QRgb px = line[x] | 0xFF000000;
+                if (qAlpha(line[x]) < 0x80)
+                    continue;
+
+                int r   = qRed(px);
+                int g   = qGreen(px);
+                int b   = qBlue(px);
+                int bin = ((r >> 3) << 10) | ((g >> 3) << 5) | (b >> 3);
+                hist.count[bin]++;
+                hist.sum[0][bin] += r;
+                hist.sum[1][bin] += g;
+                hist.sum[2][bin] += b;
+
+                if (!hist.tooMany && px != lastUnique) {
+                    hist.unique.insert(px);
+                    hist.tooMany = hist.unique.count() > maxColors;
+                    lastUnique   = px;
+                }
+            }
+        }
+    });
+
+    QVector<qint64> count(0x8000, 0);
+    QVector<qint64> sum[3];
+    for (int i = 0; i < 3; ++i) sum[i].fill(0, 0x8000);
+
+    QSet<QRgb> unique;
+    bool tooMany = false;
+    for (auto &hist : histograms) {
+        for (int b = 0; b < 0x8000; ++b) {
+            count[b] += hist.count[b];
+            sum[0][b] += hist.sum[0][b];
+            sum[1][b] += hist.sum[1][b];
+            sum[2][b] += hist.sum[2][b];
+        }
+
+        tooMany |= hist.tooMany;
+        if (!tooMany) {
+            unique.unite(hist.unique);
+            tooMany = unique.count() > maxColors;
+        }
+    }
+
+    // few enough colours to keep every one of them
+    if (!tooMany) {
+        palette = unique.values().toVector();
+        std::sort(palette.begin(), palette.end());
+        return palette;
+    }
+
+    ColorBox first;
+    for (int i = 0; i < 3; ++i) {
+        first.min[i] = 0x1F;
+        first.max[i] = 0;
+    }
+    for (int b = 0; b < 0x8000; ++b) {
+        if (!count[b])
+            continue;
+
+        first.bins.append(b);
+        first.count += count[b];
+        for (int i = 0; i < 3; ++i) {
+            first.min[i] = qMin(first.min[i], binChannel(b, i));
+            first.max[i] = qMax(first.max[i], binChannel(b, i));
+        }
+    }
+
+    QList<ColorBox> boxes;
+    if (first.bins.count())
+        boxes.append(first);
+
+    while (boxes.count() < maxColors) {
+        // split the box with the most pixels that still has room to split
+        int target = -1;
+        for (int i = 0; i < boxes.count(); ++i) {
+            if (boxes[i].bins.count() < 2)
+                continue;
+            if (target < 0 || boxes[i].count > boxes[target].count)
+                target = i;
+        }
+        if (target < 0)
+            break;
+
+        ColorBox box = boxes.takeAt(target);
+
+        int axis = 0;
+        for (int i = 1; i < 3; ++i) {
+            if (box.max[i] - box.min[i] > box.max[axis] - box.min[axis])
+                axis = i;
+        }
+
+        std::sort(box.bins.begin(), box.bins.end(),
+                  [axis](int a, int b) { return binChannel(a, axis) < binChannel(b, axis); });
+
+        // cut at the pixel median, but always leave at least one bin on each side
+        qint64 half  = box.count / 2;
+        qint64 total = 0;
+        int cut      = 1;
+        for (; cut < box.bins.count() - 1; ++cut) {
+            total += count[box.bins[cut - 1]];
+            if (total >= half)
+                break;
+        }
+
+        ColorBox halves[2];
+        halves[0].bins = box.bins.mid(0, cut);
+        halves[1].bins = box.bins.mid(cut);
+        for (auto &half : halves) {
+            for (int i = 0; i < 3; ++i) {
+                half.min[i] = 0x1F;
+                half.max[i] = 0;
+            }
+            for (int b : half.bins) {
+                half.count += count[b];
+                for (int i = 0; i < 3; ++i) {
+                    half.min[i] = qMin(half.min[i], binChannel(b, i));
+                    half.max[i] = qMax(half.max[i], binChannel(b, i));
+                }
+            }
+            boxes.append(half);
+        }
+    }
+
+    // each box becomes the average of the real colours that landed in it
+    for (auto &box : boxes) {
+        qint64 total[3] = { 0, 0, 0 };
+        for (int b : box.bins) {
+            for (int i = 0; i < 3; ++i) total[i] += sum[i][b];
+        }
+        palette.append(qRgb(total[0] / box.count, total[1] / box.count, total[2] / box.count));
+    }
+
+    return palette;
+}
+
+QByteArray Quantizer::remap(const QImage &image, const QVector<QRgb> &palette, int transparentIndex,
+                            bool dither)
+{
+    QByteArray pixels;
+    if (image.isNull() || palette.isEmpty())
+        return pixels;
+
+    QImage src = image.convertToFormat(QImage::Format_ARGB32);
+    pixels.resize(src.width() * src.height());
+
+    // never map opaque pixels onto the transparent colour, unless it's the only one there is
+    bool hasOpaque  = palette.count() > 1 || transparentIndex != 0;
+    int skipIndex   = hasOpaque ? transparentIndex : -1;
+    byte clearIndex = transparentIndex >= 0 ? transparentIndex : 0;
+
+    ExactColors exact(palette, skipIndex);
+    QByteArray lookup = buildLookup(palette, skipIndex);
+
+    QVector<int> rows(src.height());
+    std::iota(rows.begin(), rows.end(), 0);
+    QtConcurrent::blockingMap(rows, [&](int y) {
+        const QRgb *line  = (const QRgb *)src.constScanLine(y);
+        byte *dst         = (byte *)pixels.data() + y * src.width();
+        const byte *table = (const byte *)lookup.constData();
+
+        // sprite sheets are mostly runs of the same colour, so remember the last one
+        QRgb lastColor = 0;
+        int lastIndex  = -1;
+
+        for (int x = 0; x < src.width(); ++x) {
+            QRgb px = line[x];
+            if (transparentIndex >= 0 && qAlpha(px) < 0x80) {
+                dst[x] = clearIndex;
+                continue;
+            }
+
+            uint key = px & 0xFFFFFF;
+            if (!dither && lastIndex >= 0 && key == lastColor) {
+                dst[x] = lastIndex;
+                continue;
+            }
+
+            int index = exact.find(key);
+            if (index < 0) {
+                int r = qRed(px);
+                int g = qGreen(px);
+                int b = qBlue(px);
+                if (dither) {
+                    // +-15, about a third of the gap between colours in a full 255 colour palette
+                    int offset = bayer4x4[y & 3][x & 3] * 2 - 15;
+                    r          = qBound(0, r + offset, 0xFF);
+                    g          = qBound(0, g + offset, 0xFF);
+                    b          = qBound(0, b + offset, 0xFF);
+                }
+                index = table[((r >> 2) << 12) | ((g >> 2) << 6) | (b >> 2)];
+            }
+
+            lastColor = key;
+            lastIndex = index;
+            dst[x]    = index;
+        }
+    });
+
+    return pixels;
+}
+
+QByteArray Quantizer::toIndexed(const QImage &image, QVector<QRgb> &palette, int maxColors, bool dither)
+{
+    if (image.format() == QImage::Format_Indexed8 && image.colorCount() <= maxColors) {
+        palette = image.colorTable();
+
+        int w = image.width();
+        QByteArray pixels(w * image.height(), 0);
+        for (int y = 0; y < image.height(); ++y)
+            memcpy(pixels.data() + y * w, image.constScanLine(y), w);
+        return pixels;
+    }
+
+    palette = buildPalette(image, maxColors - 1);
+    palette.prepend(qRgb(0xFF, 0x00, 0xFF));
+    return remap(image, palette, 0, dither);
+}
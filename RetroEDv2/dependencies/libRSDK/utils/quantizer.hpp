@@ -0,0 +1,19 @@
+#pragma once
+
+// converts true colour images to indexed pixels, either building a palette or mapping onto a given one
+class Quantizer
+{
+public:
+    // median cut over the image's colours, images with few enough colours keep them exactly
+    static QVector<QRgb> buildPalette(const QImage &image, int maxColors);
+
+    // maps every pixel to its nearest palette colour, pixels with alpha below 0x80 (and only those) get
+    // transparentIndex, pass -1 if there isn't one
+    static QByteArray remap(const QImage &image, const QVector<QRgb> &palette, int transparentIndex = 0,
+                            bool dither = false);
+
+    // indexed images are copied as-is (as long as their palette fits), anything else is quantized with
+    // index 0 reserved for transparency
+    static QByteArray toIndexed(const QImage &image, QVector<QRgb> &palette, int maxColors,
+                                bool dither = false);
+};
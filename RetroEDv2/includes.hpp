@@ -5,6 +5,7 @@
 
 // QT
 #include <QtCore>
+#include <QtConcurrent>
 #include <QStringList>
 #include <QColorDialog>
 #include <QDebug>
@@ -71,6 +72,8 @@ public:
 #include "utils/shaders.hpp"
 #include "utils/stringhelpers.hpp"
 #include "utils/workingdirmanager.hpp"
+#include "utils/frameprofiler.hpp"
+#include "utils/csvstream.hpp"
 
 // RSDKv5 Link
 #include "tools/gamelink/gamelink.hpp"
@@ -1,6 +1,8 @@
 #version 330 core
 layout(location = 0) in vec3 in_pos;
 layout(location = 1) in vec3 in_norm;
+in vec3 in_nextPos;
+in vec3 in_nextNorm;
 in vec4 in_color;
 in vec2 in_UV;
 
@@ -13,15 +15,19 @@ uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 
+uniform float interp; // blend between the current & next frame
+
 uniform vec3 light             = vec3(1.0, 1.0, 1.0);
 uniform float ambient_strength = 0.1;
 uniform vec3 light_pos         = vec3(0.0, 32.0, -32.0);
 
 void main()
 {
-    gl_Position = projection * view * model * vec4(in_pos, 1.0);
-    ex_fragP    = vec3(model * vec4(in_pos, 1.0));
-    ex_norm     = in_norm;
+    vec3 pos = mix(in_pos, in_nextPos, interp);
+
+    gl_Position = projection * view * model * vec4(pos, 1.0);
+    ex_fragP    = vec3(model * vec4(pos, 1.0));
+    ex_norm     = mix(in_norm, in_nextNorm, interp);
     ex_color    = in_color;
     ex_UV       = in_UV;
 
@@ -4,14 +4,30 @@ in vec4 ex_color;
 out vec4 out_color;
 
 uniform sampler2D sprite;
+uniform sampler2D palette;
 uniform vec3 transColor;
 
 uniform bool useColor;
+uniform bool indexed;
+uniform int paletteRow;
 
 void main()
 {
-    if (useColor) out_color = vec4(ex_color.rgb, 1.0);
-    else if (transColor != texture(sprite, ex_UV).rgb)
-        out_color = vec4(texture(sprite, ex_UV).rgb, 1.0);
+    if (useColor) {
+        out_color = vec4(ex_color.rgb, 1.0);
+        return;
+    }
+
+    vec3 color = texture(sprite, ex_UV).rgb;
+    vec3 trans = transColor;
+    if (indexed) {
+        // sprite holds indices, the colours (and index 0, the transparent one) live in the palette row
+        int index = int(texture(sprite, ex_UV).r * 255.0 + 0.5);
+        color     = texelFetch(palette, ivec2(index, paletteRow), 0).rgb;
+        trans     = texelFetch(palette, ivec2(0, paletteRow), 0).rgb;
+    }
+
+    if (trans != color)
+        out_color = vec4(color, 1.0);
     else discard;
 }
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "harness.hpp"
+
+// true if name matches the filter bench was started with
+bool selected(const QString &name);
+
+void benchActiveRanges();
+void benchChunks();
+void benchFormats();
+void benchGif();
+void benchPLY();
+void benchQuantizer();
+void benchSceneV5();
+void benchUserDB();
+void benchZLib();
@@ -0,0 +1,23 @@
+TARGET = bench
+TEMPLATE = app
+
+include(../common/common.pri)
+
+HEADERS += \
+    ../../tools/utils/userdbmodel.hpp \
+    bench.hpp
+
+SOURCES += \
+    ../../tools/utils/activeranges.cpp \
+    ../../tools/utils/userdbmodel.cpp \
+    ../common/alloccounter.cpp \
+    bench_activeranges.cpp \
+    bench_chunks.cpp \
+    bench_formats.cpp \
+    bench_gif.cpp \
+    bench_ply.cpp \
+    bench_quantizer.cpp \
+    bench_scenev5.cpp \
+    bench_userdb.cpp \
+    bench_zlib.cpp \
+    main.cpp
@@ -0,0 +1,36 @@
+#include "bench.hpp"
+
+#include "tools/utils/activeranges.hpp"
+
+// the per frame activity pass processObjects runs, over a stage's worth of slots & a crowded one. most
+// entities use box bounds, a few use a radius, the way real stages are set up (sizes are slots)
+static void benchCull(const QString &name, int count, int radiusShare)
+{
+    QRandomGenerator rng(count);
+
+    int screenX = 0x4000 << 16;
+    int screenY = 0x1000 << 16;
+
+    ActiveRangeList ranges;
+    ranges.resize(count);
+    for (int e = 0; e < count; ++e) {
+        int x     = screenX + ((int)rng.bounded(0x4000) - 0x2000) * 0x10000;
+        int y     = screenY + ((int)rng.bounded(0x1000) - 0x800) * 0x10000;
+        byte mode = rng.bounded(100) < radiusShare ? ACTIVE_RBOUNDS : ACTIVE_BOUNDS + rng.bounded(3);
+        ranges.set(e, x, y, 0x80 << 16, 0x80 << 16, mode);
+    }
+
+    if (selected(name))
+        Harness::report(Harness::measure(name, count, [&ranges, screenX, screenY] {
+            ranges.cull(screenX, screenY, 212 << 16, 120 << 16);
+        }));
+}
+
+void benchActiveRanges()
+{
+    printf("\n== entity activity culling (sizes are slots) ==\n");
+
+    benchCull("cull 0x940 slots", 0x940, 5);
+    benchCull("cull 0x940 slots, all radius", 0x940, 100);
+    benchCull("cull 0x10000 slots", 0x10000, 5);
+}
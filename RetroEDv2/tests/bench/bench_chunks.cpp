@@ -0,0 +1,113 @@
+#include "bench.hpp"
+#include "corpus.hpp"
+
+// Chunk::getImage as it was, a setPixelColor/pixelColor pair per pixel & the tile list copied per call
+static QImage perPixelImage(const FormatHelpers::Chunks::Chunk &chunk, QList<QImage> tileList)
+{
+    QImage img(0x80, 0x80, QImage::Format::Format_ARGB32);
+
+    for (int h = 0; h < 0x8; ++h) {
+        for (int w = 0; w < 0x8; ++w) {
+            QImage &tile = tileList[chunk.tiles[h][w].tileIndex];
+            Vector2<bool> flip;
+            flip.x = (chunk.tiles[h][w].direction & 1) == 1;
+            flip.y = (chunk.tiles[h][w].direction & 2) == 2;
+
+            for (int y = 0; y < 0x10; ++y) {
+                for (int x = 0; x < 0x10; ++x) {
+                    int xpos = x;
+                    int ypos = y;
+                    if (flip.y)
+                        ypos = 0x0F - y;
+                    if (flip.x)
+                        xpos = 0x0F - x;
+
+                    img.setPixelColor((w * 0x10) + x, (h * 0x10) + y,
+                                      tile.pixelColor(xpos, ypos).rgb());
+                }
+            }
+        }
+    }
+
+    return img;
+}
+
+// 0x400 paletted tiles, the way the v1-v4 editors cut them out of the tileset gif
+static QList<QImage> tileset()
+{
+    QRandomGenerator rng(1);
+
+    QVector<QRgb> palette(0x100);
+    for (QRgb &color : palette) color = 0xFF000000 | rng.bounded(0x1000000);
+
+    QList<QImage> tiles;
+    for (int t = 0; t < 0x400; ++t) {
+        QImage tile(0x10, 0x10, QImage::Format_Indexed8);
+        tile.setColorTable(palette);
+        for (int y = 0; y < 0x10; ++y) {
+            uchar *line = tile.scanLine(y);
+            for (int x = 0; x < 0x10; ++x) line[x] = rng.bounded(0x100);
+        }
+        tiles.append(tile);
+    }
+    return tiles;
+}
+
+static void fillChunks(FormatHelpers::Chunks &chunks)
+{
+    Harness::MemoryReader memory(Corpus::chunksV4());
+    RSDKv4::Chunks source(memory.reader);
+
+    for (int c = 0; c < 0x200; ++c) {
+        for (int y = 0; y < 8; ++y) {
+            for (int x = 0; x < 8; ++x) {
+                chunks.chunks[c].tiles[y][x].tileIndex = source.chunkList[c].tiles[y][x].tileIndex;
+                chunks.chunks[c].tiles[y][x].direction = source.chunkList[c].tiles[y][x].direction;
+            }
+        }
+    }
+}
+
+// a scene load draws all 0x200 chunks, an edit in the chunk editor only redraws the one it touched
+void benchChunks()
+{
+    printf("\n== v1-v4 chunk images ==\n");
+
+    QList<QImage> tiles = tileset();
+    FormatHelpers::Chunks chunks;
+    fillChunks(chunks);
+
+    const qint64 chunkBytes = 0x80 * 0x80 * sizeof(QRgb);
+
+    if (selected("chunk image per pixel"))
+        Harness::report(Harness::measure("chunk image per pixel", chunkBytes,
+                                         [&] { perPixelImage(chunks.chunks[0], tiles); }));
+
+    if (selected("chunk image row copies"))
+        Harness::report(Harness::measure("chunk image row copies", chunkBytes,
+                                         [&] { chunks.chunks[0].getImage(tiles); }));
+
+    if (selected("chunk images full build per pixel"))
+        Harness::report(Harness::measure("chunk images full build per pixel", chunkBytes * 0x200, [&] {
+            QList<QImage> images;
+            for (int c = 0; c < 0x200; ++c) images.append(perPixelImage(chunks.chunks[c], tiles));
+        }));
+
+    if (selected("chunk images full build")) {
+        Harness::report(Harness::measure("chunk images full build", chunkBytes * 0x200, [&] {
+            // a fresh set each run, so nothing is cached from the last one
+            FormatHelpers::Chunks fresh;
+            for (int c = 0; c < 0x200; ++c) fresh.chunks[c] = chunks.chunks[c];
+            fresh.getImages(tiles);
+        }));
+    }
+
+    if (selected("chunk images one dirty chunk")) {
+        chunks.getImages(tiles);
+        Harness::report(Harness::measure("chunk images one dirty chunk", chunkBytes, [&] {
+            // flipping back & forth, the cache only keeps images in use so both states get redrawn
+            chunks.chunks[0x10].tiles[0][0].direction ^= 1;
+            chunks.getImages(tiles);
+        }));
+    }
+}
@@ -0,0 +1,25 @@
+#include "bench.hpp"
+#include "corpus.hpp"
+#include "fuzztargets.hpp"
+
+void benchFormats()
+{
+    printf("\n== format read & round trip (read + write) ==\n");
+
+    for (int scale : { 1, 8, 64 }) {
+        for (const Corpus::Sample &sample : Corpus::samples(scale)) {
+            QString name = QString("%1 x%2").arg(sample.format).arg(scale);
+            if (!selected(name))
+                continue;
+
+            FuzzTargets::Target read = FuzzTargets::find(sample.format.toLatin1());
+            const uint8_t *data      = (const uint8_t *)sample.data.constData();
+            size_t size              = sample.data.size();
+
+            Harness::report(Harness::measure(name + " read", size, [&] { read(data, size); }));
+            if (sample.roundTrip)
+                Harness::report(Harness::measure(name + " round trip", size,
+                                                 [&] { sample.roundTrip(sample.data); }));
+        }
+    }
+}
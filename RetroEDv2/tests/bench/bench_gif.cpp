@@ -0,0 +1,41 @@
+#include "bench.hpp"
+#include "corpus.hpp"
+
+// the sheets from the corpus, plus the two ends of what LZW sees: one colour where every code is a long
+// run, & noise where the dictionary fills & clears every few thousand pixels
+static void benchGif(const QString &name, FormatHelpers::Gif &gif)
+{
+    qint64 pixels = gif.pixels.size();
+    if (selected(name + " encode"))
+        Harness::report(Harness::measure(name + " encode", pixels, [&gif] {
+            Harness::writeBytes([&gif](Writer &writer) { gif.write(writer); });
+        }));
+
+    QByteArray file = Harness::writeBytes([&gif](Writer &writer) { gif.write(writer); });
+    if (selected(name + " decode"))
+        Harness::report(Harness::measure(name + " decode", pixels, [&file] {
+            Harness::MemoryReader memory(file);
+            FormatHelpers::Gif decoded;
+            decoded.read(memory.reader);
+        }));
+}
+
+void benchGif()
+{
+    printf("\n== gif encode & decode (sizes are pixels) ==\n");
+
+    for (int scale : { 1, 8 }) {
+        Harness::MemoryReader memory(Corpus::gif(scale));
+        FormatHelpers::Gif sheet;
+        sheet.read(memory.reader);
+        benchGif(QString("sheet 512x%1").arg(sheet.height), sheet);
+    }
+
+    QRandomGenerator rng(1);
+    FormatHelpers::Gif flat(1024, 1024), noise(1024, 1024);
+    flat.pixels.fill(5);
+    for (char &px : noise.pixels) px = (char)rng.bounded(0x100);
+
+    benchGif("flat 1024x1024", flat);
+    benchGif("noise 1024x1024", noise);
+}
@@ -0,0 +1,400 @@
+#include "bench.hpp"
+#include "corpus.hpp"
+
+namespace
+{
+
+// Model::loadPLY as it was before FormatHelpers::PLY, which only read ascii & binary little endian.
+// every value is held in a QVariant & each property's type name is looked up again per value. the
+// original had a block per property name, they're folded into one loop here that does the same work
+
+enum PLYPropTypes {
+    UNKNOWN,
+    INT8,
+    UINT8,
+    INT16,
+    UINT16,
+    INT32,
+    UINT32,
+    FLOAT,
+    DOUBLE,
+    LIST,
+};
+
+struct PLYProperty {
+    PLYProperty() {}
+
+    QString sizeType = ""; // used for list types
+    QString itemType = ""; // used for list types
+    QString type     = "";
+    QString name     = "";
+};
+
+struct PLYPropertyValue {
+    PLYPropertyValue() {}
+
+    QList<QVariant> values; // if a list property exists, assume ONLY a list can exist
+};
+
+struct PLYElement {
+    PLYElement() {}
+
+    QList<PLYProperty> properties;
+    QList<PLYPropertyValue> propertyValues;
+    QString name = "";
+};
+
+int getPLYPropertyType(QString propertyType)
+{
+    QString type = propertyType;
+    type         = type.toLower();
+
+    if (type == "char" || type == "int8") {
+        return PLYPropTypes::INT8;
+    }
+    else if (type == "uchar" || type == "uint8") {
+        return PLYPropTypes::UINT8;
+    }
+    else if (type == "short" || type == "int16") {
+        return PLYPropTypes::INT16;
+    }
+    else if (type == "ushort" || type == "uint16") {
+        return PLYPropTypes::UINT16;
+    }
+    else if (type == "int32" || type == "int") {
+        return PLYPropTypes::INT32;
+    }
+    else if (type == "uint32" || type == "uint") {
+        return PLYPropTypes::UINT32;
+    }
+    else if (type == "float" || type == "float32") {
+        return PLYPropTypes::FLOAT;
+    }
+    else if (type == "double64" || type == "double" || type == "float64") {
+        return PLYPropTypes::DOUBLE;
+    }
+    else if (type == "list") {
+        return PLYPropTypes::LIST;
+    }
+
+    return PLYPropTypes::UNKNOWN;
+}
+
+QVariant readBinaryValue(Reader &reader, const QString &type)
+{
+    QVariant value = "";
+    switch (getPLYPropertyType(type)) {
+        default: break;
+        case PLYPropTypes::INT8: value = reader.read<sbyte>(); break;
+        case PLYPropTypes::UINT8: value = reader.read<byte>(); break;
+        case PLYPropTypes::INT16: value = reader.read<short>(); break;
+        case PLYPropTypes::UINT16: value = reader.read<ushort>(); break;
+        case PLYPropTypes::INT32: value = reader.read<int>(); break;
+        case PLYPropTypes::UINT32: value = reader.read<uint>(); break;
+        case PLYPropTypes::FLOAT: value = reader.read<float>(); break;
+        case PLYPropTypes::DOUBLE: value = reader.read<double>(); break;
+    }
+    return value;
+}
+
+// toInt for the integer types & toFloat/toDouble for the others, the same as each per name block did
+double convertValue(const QVariant &value, const QString &type)
+{
+    bool ok = false;
+    switch (getPLYPropertyType(type)) {
+        default: return 0;
+        case PLYPropTypes::INT8:
+        case PLYPropTypes::UINT8:
+        case PLYPropTypes::INT16:
+        case PLYPropTypes::UINT16:
+        case PLYPropTypes::INT32:
+        case PLYPropTypes::UINT32: return value.toInt(&ok);
+        case PLYPropTypes::FLOAT: return value.toFloat(&ok);
+        case PLYPropTypes::DOUBLE: return value.toDouble(&ok);
+    }
+}
+
+void oldLoadPLY(RSDKv5::Model &model, Reader &reader)
+{
+    model.hasColors         = false;
+    model.hasNormals        = false;
+    model.hasTextures       = false;
+    model.faceVerticesCount = 3;
+
+    model.texCoords.clear();
+    model.frames.clear();
+    model.colors.clear();
+    model.indices.clear();
+
+    model.frames.append(RSDKv5::Model::Frame());
+
+    QString signature = reader.readLine().toLower();
+    if (signature != "ply")
+        return;
+
+    QStringList format = reader.readLine().split(" ");
+    if (format.count() < 3 || format[0].toLower() != "format")
+        return;
+
+    bool binary = format[1].toLower() != "ascii";
+
+    QList<PLYElement> elements;
+
+    while (!reader.isEOF()) {
+        QStringList line = reader.readLine().split(" ");
+        if (!line.count())
+            continue;
+
+        QString instruction = line[0].toLower();
+        if (instruction == "end_header")
+            break;
+
+        if (instruction == "element") {
+            PLYElement element;
+            element.name = line[1];
+
+            bool ok  = false;
+            int size = line[2].toInt(&ok);
+            if (ok) {
+                element.propertyValues.clear();
+                for (int i = 0; i < size; ++i) element.propertyValues.append(PLYPropertyValue());
+            }
+
+            elements.append(element);
+        }
+
+        if (instruction == "property") {
+            if (!elements.count())
+                continue;
+
+            PLYProperty property;
+            property.type = line[1].toLower();
+            if (property.type == "list") {
+                property.sizeType = line[2].toLower();
+                property.itemType = line[3].toLower();
+                property.name     = line[4];
+            }
+            else {
+                property.name = line[2];
+            }
+
+            elements.last().properties.append(property);
+        }
+    }
+
+    if (binary) {
+        for (auto &element : elements) {
+            for (int i = 0; i < element.propertyValues.count(); ++i) {
+                element.propertyValues[i].values.clear();
+
+                for (auto &property : element.properties) {
+                    if (property.type == "list") {
+                        int size = (int)convertValue(readBinaryValue(reader, property.sizeType),
+                                                     property.sizeType);
+
+                        for (int s = 0; s < size; ++s)
+                            element.propertyValues[i].values.append(
+                                readBinaryValue(reader, property.itemType));
+                        break;
+                    }
+                    else {
+                        element.propertyValues[i].values.append(readBinaryValue(reader, property.type));
+                    }
+                }
+            }
+        }
+    }
+    else {
+        // one line per element, not per entry
+        for (auto &element : elements) {
+            QStringList line = reader.readLine().split(" ");
+
+            for (int i = 0; i < element.propertyValues.count(); ++i) {
+                int p = 0;
+                for (auto &property : element.properties) {
+                    if (property.type == "list") {
+                        int size = (int)convertValue(QVariant(line[0]), property.sizeType);
+                        for (int s = 0; s < size; ++s)
+                            element.propertyValues[i].values.append(QVariant(line[1 + s]));
+                        break;
+                    }
+                    else {
+                        element.propertyValues[i].values.append(QVariant(line[p]));
+                        ++p;
+                    }
+                }
+            }
+        }
+    }
+
+    for (auto &element : elements) {
+        QString name = element.name.toLower();
+
+        if (name == "vertex") {
+            auto &vertices = model.frames[0].vertices;
+            vertices.clear();
+            model.colors.clear();
+            model.texCoords.clear();
+
+            // Fill up all the blanks
+            for (int v = 0; v < element.propertyValues.count(); ++v) {
+                vertices.append(RSDKv5::Model::Frame::Vertex());
+                model.colors.append(RSDKv5::Model::Color());
+                model.texCoords.append(RSDKv5::Model::TexCoord());
+            }
+
+            int p = 0;
+            for (auto &property : element.properties) {
+                QString name = property.name.toLower();
+                int type     = getPLYPropertyType(property.type);
+                bool isFloat = type == PLYPropTypes::FLOAT || type == PLYPropTypes::DOUBLE;
+
+                int target = -1;
+                if (name == "x" || name == "y" || name == "z")
+                    target = 0 + name[0].unicode() - 'x';
+                else if (name == "nx" || name == "ny" || name == "nz")
+                    target = 3 + name[1].unicode() - 'x';
+                else if (name == "u" || name == "s" || name == "tx" || name == "texture_u")
+                    target = 6;
+                else if (name == "v" || name == "t" || name == "ty" || name == "texture_v")
+                    target = 7;
+                else if (name == "r" || name == "red")
+                    target = 8;
+                else if (name == "g" || name == "green")
+                    target = 9;
+                else if (name == "b" || name == "blue")
+                    target = 10;
+                else if (name == "a" || name == "alpha")
+                    target = 11;
+
+                if (element.propertyValues.count()) {
+                    model.hasNormals |= target >= 3 && target <= 5;
+                    model.hasTextures |= target == 6 || target == 7;
+                    model.hasColors |= target >= 8;
+                }
+
+                int v = 0;
+                for (auto &propertyValue : element.propertyValues) {
+                    if (target < 0)
+                        break;
+
+                    double value = convertValue(propertyValue.values[p], property.type);
+                    float colour = isFloat ? value * 255.0f : value;
+                    switch (target) {
+                        case 0: vertices[v].x = value; break;
+                        case 1: vertices[v].y = value; break;
+                        case 2: vertices[v].z = value; break;
+                        case 3: vertices[v].nx = value; break;
+                        case 4: vertices[v].ny = value; break;
+                        case 5: vertices[v].nz = value; break;
+                        case 6: model.texCoords[v].x = value; break;
+                        case 7: model.texCoords[v].y = value; break;
+                        case 8: model.colors[v].r = colour; break;
+                        case 9: model.colors[v].g = colour; break;
+                        case 10: model.colors[v].b = colour; break;
+                        case 11: model.colors[v].a = colour; break;
+                    }
+
+                    ++v;
+                }
+
+                ++p;
+            }
+        }
+    }
+
+    for (auto &element : elements) {
+        QString name = element.name.toLower();
+
+        if (name == "face") {
+            int p = 0;
+            for (auto &property : element.properties) {
+                if (property.type == "list")
+                    break;
+                ++p;
+            }
+
+            model.indices.clear();
+            if (p != element.properties.count()) {
+                for (auto &propertyValue : element.propertyValues) {
+                    // they should all be the same, but in the 1% chance it's not, update it
+                    model.faceVerticesCount = propertyValue.values.count();
+
+                    for (int i = 0; i < model.faceVerticesCount; ++i) {
+                        ushort index = (ushort)(qint64)convertValue(propertyValue.values[i],
+                                                                      element.properties[p].itemType);
+                        model.indices.append(index);
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+// model imports, the ascii paths parse every value by hand so they're the ones to watch
+void benchPLY()
+{
+    printf("\n== model import ==\n");
+
+    for (int scale : { 1, 8, 64 }) {
+        for (const char *format : { "ascii", "binary_little_endian", "binary_big_endian" }) {
+            QString name = QString("ply %1 x%2").arg(format).arg(scale);
+            if (!selected(name))
+                continue;
+
+            QByteArray data = Corpus::ply(scale, format);
+            Harness::report(Harness::measure(name, data.size(), [&data] {
+                FormatHelpers::PLY ply;
+                ply.read(data);
+            }));
+        }
+    }
+
+    // up to bigger meshes than a model can hold, only the parse is timed. the old importer is only run
+    // on little endian, its ascii path read one line per element so it'd only be timing the header
+    for (int vertices : { 10000, 100000, 1000000 }) {
+        QString prefix = QString("mesh %1k").arg(vertices / 1000);
+        int runs       = vertices >= 1000000 ? 1 : 5;
+
+        if (selected(prefix + " ply binary_little_endian old")) {
+            QByteArray data = Corpus::plyMesh(vertices);
+            QString name    = prefix + " ply binary_little_endian old";
+            Harness::report(Harness::measure(
+                name, data.size(),
+                [&data] {
+                    Harness::MemoryReader memory(data);
+                    RSDKv5::Model model;
+                    oldLoadPLY(model, memory.reader);
+                },
+                runs, 0));
+        }
+
+        for (const char *format : { "ascii", "binary_little_endian", "binary_big_endian" }) {
+            QString name = QString("%1 ply %2").arg(prefix).arg(format);
+            if (!selected(name))
+                continue;
+
+            QByteArray data = Corpus::plyMesh(vertices, format);
+            Harness::report(Harness::measure(
+                name, data.size(),
+                [&data] {
+                    FormatHelpers::PLY ply;
+                    ply.read(data);
+                },
+                runs, 0));
+        }
+
+        if (selected(prefix + " obj")) {
+            QByteArray data = Corpus::objMesh(vertices);
+            Harness::report(Harness::measure(
+                prefix + " obj", data.size(),
+                [&data] {
+                    FormatHelpers::OBJ obj;
+                    obj.read(data);
+                },
+                runs, 0));
+        }
+    }
+}
@@ -0,0 +1,76 @@
+#include "bench.hpp"
+
+// a 4096x4096 sheet, the size the import has to get through in well under a second. sprites are runs of
+// a few shades each on a transparent background, the way real sheets are, plus a gradient where every
+// pixel is a new colour & the lookup does all the work (sizes are pixels)
+static QImage sheet(int size, int shades, quint32 seed)
+{
+    QRandomGenerator rng(seed);
+
+    QImage image(size, size, QImage::Format_ARGB32);
+    image.fill(Qt::transparent);
+    for (int y = 0; y < size; y += 64) {
+        for (int x = 0; x < size; x += 64) {
+            QRgb base = rng.bounded(0x1000000);
+            for (int py = 8; py < 56; ++py) {
+                QRgb *line = (QRgb *)image.scanLine(y + py);
+                for (int px = 8; px < 56; ++px)
+                    line[x + px] = 0xFF000000 | (base ^ (rng.bounded(shades) * 0x0A0A0A));
+            }
+        }
+    }
+    return image;
+}
+
+static QImage gradient(int size)
+{
+    QImage image(size, size, QImage::Format_RGB32);
+    for (int y = 0; y < size; ++y) {
+        QRgb *line = (QRgb *)image.scanLine(y);
+        for (int x = 0; x < size; ++x) line[x] = qRgb(x * 0xFF / size, y * 0xFF / size, (x ^ y) & 0xFF);
+    }
+    return image;
+}
+
+static void benchImage(const QString &name, const QImage &image, const QVector<QRgb> &stagePalette)
+{
+    qint64 pixels = (qint64)image.width() * image.height();
+
+    if (selected(name + " quantize"))
+        Harness::report(Harness::measure(name + " quantize", pixels, [&image] {
+            QVector<QRgb> palette;
+            Quantizer::toIndexed(image, palette, 0xFF);
+        }));
+
+    if (selected(name + " quantize, dithered"))
+        Harness::report(Harness::measure(name + " quantize, dithered", pixels, [&image] {
+            QVector<QRgb> palette;
+            Quantizer::toIndexed(image, palette, 0xFF, true);
+        }));
+
+    QString remapName = name + " onto a stage palette";
+    if (selected(remapName))
+        Harness::report(Harness::measure(remapName, pixels, [&image, &stagePalette] {
+            Quantizer::remap(image, stagePalette, 0);
+        }));
+}
+
+void benchQuantizer()
+{
+    printf("\n== true colour to indexed (sizes are pixels) ==\n");
+
+    QRandomGenerator rng(1);
+    QVector<QRgb> stagePalette;
+    for (int c = 0; c < 0x100; ++c) stagePalette.append(0xFF000000 | rng.bounded(0x1000000));
+
+    benchImage("sheet 4096x4096", sheet(4096, 4, 1), stagePalette);
+    benchImage("gradient 4096x4096", gradient(4096), stagePalette);
+
+    // already indexed, only has to be copied out
+    QImage indexed = sheet(4096, 1, 2).convertToFormat(QImage::Format_Indexed8, Qt::ThresholdDither);
+    if (selected("indexed 4096x4096 copy"))
+        Harness::report(Harness::measure("indexed 4096x4096 copy", (qint64)4096 * 4096, [&indexed] {
+            QVector<QRgb> palette;
+            Quantizer::toIndexed(indexed, palette, 0x100);
+        }));
+}
@@ -0,0 +1,128 @@
+#include "bench.hpp"
+#include "corpus.hpp"
+
+namespace
+{
+
+// VariableValue the way it was before the scalars shared a union, every type kept its own field
+struct UnpackedValue {
+    byte value_uint8     = 0;
+    ushort value_uint16  = 0;
+    uint value_uint32    = 0;
+    sbyte value_int8     = 0;
+    short value_int16    = 0;
+    int value_int32      = 0;
+    int value_enum       = 0;
+    bool value_bool      = false;
+    QString value_string = "";
+    Vector2<int> value_vector2;
+    Vector2<float> value_vector2f;
+    float value_float = 0;
+    QColor value_color;
+
+    byte type = 0;
+
+    UnpackedValue() {}
+    explicit UnpackedValue(const RSDKv5::Scene::VariableValue &value)
+    {
+        type = value.type;
+        switch (type) {
+            case RSDKv5::UINT8: value_uint8 = value.value_uint8; break;
+            case RSDKv5::UINT16: value_uint16 = value.value_uint16; break;
+            case RSDKv5::UINT32: value_uint32 = value.value_uint32; break;
+            case RSDKv5::INT8: value_int8 = value.value_int8; break;
+            case RSDKv5::INT16: value_int16 = value.value_int16; break;
+            case RSDKv5::INT32: value_int32 = value.value_int32; break;
+            case RSDKv5::ENUM: value_enum = value.value_enum; break;
+            case RSDKv5::BOOL: value_bool = value.value_bool; break;
+            case RSDKv5::STRING: value_string = value.value_string; break;
+            case RSDKv5::VECTOR2:
+                value_vector2  = value.value_vector2;
+                value_vector2f = value.value_vector2f;
+                break;
+            case RSDKv5::FLOAT: value_float = value.value_float; break;
+            case RSDKv5::COLOR: value_color = value.value_color; break;
+        }
+    }
+};
+
+// a per object column store, one contiguous run of values per variable
+struct ObjectColumns {
+    QVector<QVector<RSDKv5::Scene::VariableValue>> columns;
+};
+
+qint64 valueCount(const RSDKv5::Scene &scene)
+{
+    qint64 count = 0;
+    for (auto &object : scene.objects) count += object.entities.count() * object.variables.count();
+    return count;
+}
+
+} // namespace
+
+// entity variables as the editor holds them once a scene is loaded. each layout is built from the same
+// parsed scene & kept until the run ends, so the allocated kb per run is what the layout keeps resident
+void benchSceneV5()
+{
+    printf("\n== v5 entity variables, load & resident size per layout ==\n");
+    printf("(VariableValue is %d bytes, the unpacked one it replaced %d)\n",
+           (int)sizeof(RSDKv5::Scene::VariableValue), (int)sizeof(UnpackedValue));
+
+    for (int scale : { 8, 64, 256 }) {
+        QString prefix = QString("scene v5 x%1 variables").arg(scale);
+        if (!selected(prefix))
+            continue;
+
+        QByteArray data = Corpus::sceneV5(scale);
+        RSDKv5::Scene scene;
+        {
+            Harness::MemoryReader memory(data);
+            scene.read(memory.reader);
+        }
+        printf("%s: %lld values over %d objects\n", prefix.toLatin1().constData(),
+               (long long)valueCount(scene), (int)scene.objects.count());
+
+        Harness::report(Harness::measure(prefix + " read", data.size(), [&data] {
+            Harness::MemoryReader memory(data);
+            RSDKv5::Scene loaded;
+            loaded.read(memory.reader);
+        }));
+
+        Harness::report(Harness::measure(prefix + " unpacked list", data.size(), [&scene] {
+            QList<QList<UnpackedValue>> entities;
+            for (auto &object : scene.objects) {
+                for (auto &entity : object.entities) {
+                    QList<UnpackedValue> variables;
+                    for (auto &value : entity.variables) variables.append(UnpackedValue(value));
+                    entities.append(variables);
+                }
+            }
+        }));
+
+        Harness::report(Harness::measure(prefix + " packed list", data.size(), [&scene] {
+            QList<QList<RSDKv5::Scene::VariableValue>> entities;
+            for (auto &object : scene.objects) {
+                for (auto &entity : object.entities) {
+                    QList<RSDKv5::Scene::VariableValue> variables;
+                    for (auto &value : entity.variables) variables.append(value);
+                    entities.append(variables);
+                }
+            }
+        }));
+
+        Harness::report(Harness::measure(prefix + " columns", data.size(), [&scene] {
+            QVector<ObjectColumns> objects(scene.objects.count());
+            for (int o = 0; o < scene.objects.count(); ++o) {
+                auto &object  = scene.objects[o];
+                auto &columns = objects[o].columns;
+                columns.resize(object.variables.count());
+                for (auto &column : columns) column.reserve(object.entities.count());
+
+                for (auto &entity : object.entities) {
+                    for (int v = 0; v < columns.count() && v < entity.variables.count(); ++v)
+                        columns[v].append(entity.variables[v]);
+                }
+            }
+        }));
+    }
+}
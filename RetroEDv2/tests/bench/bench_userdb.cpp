@@ -0,0 +1,102 @@
+#include "bench.hpp"
+#include "corpus.hpp"
+
+#include "tools/utils/userdbmodel.hpp"
+
+using TableColumn = RSDKv5::UserDB::TableColumn;
+
+// the corpus db's rows over & over, files only hold 0x400 of them but the editor takes any number
+static void fillRows(RSDKv5::UserDB &db, int count)
+{
+    Harness::MemoryReader memory(Corpus::userDBV5(8));
+    db.read(memory.reader);
+
+    QList<RSDKv5::UserDB::TableRow> source = db.rows;
+    db.rows.clear();
+    db.rows.reserve(count);
+    for (int r = 0; r < count; ++r) {
+        db.rows.append(source[r % source.count()]);
+        db.rows.last().uuid = r * 2654435761u; // unique & out of order
+    }
+}
+
+// the first of the db's columns with one of the given types, -1 if there isn't one
+static int findColumn(const RSDKv5::UserDB &db, std::initializer_list<TableColumn::Types> types)
+{
+    for (int c = 0; c < db.columns.count(); ++c) {
+        for (auto type : types) {
+            if (db.columns[c].type == type)
+                return UserDBModel::COLUMN_FIXEDCOUNT + c;
+        }
+    }
+    return -1;
+}
+
+// sorting & filtering a table far bigger than a save ever gets. the first sort on a column builds its
+// keys & index, later ones reuse them until an edit throws them away
+void benchUserDB()
+{
+    printf("\n== userdb view, sort & filter ==\n");
+
+    const int count = 200000;
+    RSDKv5::UserDB db;
+    fillRows(db, count);
+
+    QList<QPair<QString, int>> columns = {
+        { "uuid", UserDBModel::COLUMN_UUID },
+        { "real", findColumn(db, { TableColumn::Float, TableColumn::Double }) },
+        { "string", findColumn(db, { TableColumn::String }) },
+    };
+
+    for (auto &column : columns) {
+        QString prefix = QString("userdb 200k %1").arg(column.first);
+        if (column.second < 0 || !selected(prefix))
+            continue;
+
+        Harness::report(Harness::measure(prefix + " first sort", count, [&] {
+            UserDBModel model;
+            model.setDB(&db);
+            model.sort(column.second, Qt::AscendingOrder);
+        }));
+
+        UserDBModel model;
+        model.setDB(&db);
+        Harness::report(Harness::measure(prefix + " sort", count, [&] {
+            // both orders are kept, so this only rebuilds the visible rows
+            model.sort(column.second, Qt::DescendingOrder);
+            model.sort(column.second, Qt::AscendingOrder);
+        }));
+    }
+
+    // a range over about a quarter of the uuids, on an unsorted & a sorted view
+    UserDBModel::Filter filter;
+    filter.column = UserDBModel::COLUMN_UUID;
+    filter.mode   = UserDBModel::Filter::Range;
+    filter.min    = "0x40000000";
+    filter.max    = "0x7FFFFFFF";
+
+    if (selected("userdb 200k first filter")) {
+        Harness::report(Harness::measure("userdb 200k first filter", count, [&] {
+            UserDBModel model;
+            model.setDB(&db);
+            model.setFilters({ filter });
+        }));
+    }
+
+    if (selected("userdb 200k setFilters")) {
+        UserDBModel model;
+        model.setDB(&db);
+        model.setFilters({ filter });
+        Harness::report(Harness::measure("userdb 200k setFilters", count, [&] {
+            model.clearFilters();
+            model.setFilters({ filter });
+        }));
+
+        int modified = UserDBModel::COLUMN_MODIFIED;
+        model.sort(modified, Qt::DescendingOrder);
+        Harness::report(Harness::measure("userdb 200k setFilters sorted", count, [&] {
+            model.clearFilters();
+            model.setFilters({ filter });
+        }));
+    }
+}
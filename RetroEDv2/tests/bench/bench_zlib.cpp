@@ -0,0 +1,44 @@
+#include "bench.hpp"
+
+// both ways a block gets read: into a buffer the caller sized (layouts) & into one readZLib grows
+// itself (line scroll & the rest)
+static void benchBlock(const QString &name, const QByteArray &data)
+{
+    QByteArray block = Harness::writeBytes([&data](Writer &writer) { writer.writeCompressed(data); });
+
+    if (selected(name + " into buffer")) {
+        QByteArray buffer(data.size(), 0);
+        Harness::report(Harness::measure(name + " into buffer", data.size(), [&] {
+            Harness::MemoryReader memory(block);
+            memory.reader.readZLib(buffer.data(), buffer.size());
+        }));
+    }
+
+    if (selected(name + " grown"))
+        Harness::report(Harness::measure(name + " grown", data.size(), [&block] {
+            Harness::MemoryReader memory(block);
+            memory.reader.readZLib();
+        }));
+}
+
+void benchZLib()
+{
+    printf("\n== zlib block reads (sizes are decompressed bytes) ==\n");
+
+    QRandomGenerator rng(1);
+    for (int size : { 0x1000, 0x20000, 0x800000 }) {
+        // a v5 layout: mostly empty (0xFFFF) with runs of tiles
+        QByteArray layout(size, (char)0xFF);
+        ushort *tiles = (ushort *)layout.data();
+        for (int t = 0; t < size / 2; t += 1 + rng.bounded(0x20)) {
+            ushort tile = rng.bounded(0x400);
+            for (int r = rng.bounded(0x10); r >= 0 && t < size / 2; --r) tiles[t++] = tile;
+        }
+
+        QByteArray noise(size, 0);
+        for (char &b : noise) b = (char)rng.bounded(0x100);
+
+        benchBlock(QString("layout %1k").arg(size / 0x400), layout);
+        benchBlock(QString("noise %1k").arg(size / 0x400), noise);
+    }
+}
@@ -0,0 +1,68 @@
+#include "bench.hpp"
+#include "corpus.hpp"
+
+// bench [filter]           runs everything with filter in its name (all of it by default)
+// bench --corpus <dir>     writes the synthetic corpus to dir, eg as seeds for the fuzz target
+
+static QString filter;
+
+bool selected(const QString &name) { return filter.isEmpty() || name.contains(filter); }
+
+static int writeCorpus(const QString &path)
+{
+    QDir dir(path);
+    if (!dir.mkpath(".")) {
+        fprintf(stderr, "couldn't create %s\n", path.toLocal8Bit().constData());
+        return 1;
+    }
+
+    auto write = [&dir](const Corpus::Sample &sample, const QString &suffix) {
+        QString name = QString(sample.format).replace("::", "_") + suffix + ".bin";
+        QFile file(dir.filePath(name));
+        if (!file.open(QIODevice::WriteOnly) || file.write(sample.data) != sample.data.size()) {
+            fprintf(stderr, "couldn't write %s\n", file.fileName().toLocal8Bit().constData());
+            return false;
+        }
+        return true;
+    };
+
+    for (int scale : { 1, 8 }) {
+        for (const Corpus::Sample &sample : Corpus::samples(scale)) {
+            if (!write(sample, QString("_x%1").arg(scale)))
+                return 1;
+        }
+    }
+
+    QList<Corpus::Sample> regressions = Corpus::regressions();
+    for (int r = 0; r < regressions.count(); ++r) {
+        if (!write(regressions[r], QString("_regression%1").arg(r)))
+            return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QStringList args = app.arguments().mid(1);
+    if (args.count() >= 2 && args[0] == "--corpus")
+        return writeCorpus(args[1]);
+    if (!args.isEmpty())
+        filter = args[0];
+
+    printf("%-40s %12s %13s %15s   %s\n", "", "size", "best run", "throughput", "allocations");
+    if (!Harness::countsAllocations())
+        printf("(allocations aren't counted in this build)\n");
+
+    benchActiveRanges();
+    benchChunks();
+    benchFormats();
+    benchGif();
+    benchPLY();
+    benchQuantizer();
+    benchSceneV5();
+    benchUserDB();
+    benchZLib();
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <QtGlobal>
+
+// counts allocations for the bench & unit targets. the fuzz target doesn't link this, it leaves
+// allocation to the sanitizers. Qt's containers allocate through malloc rather than operator new, so
+// malloc itself is wrapped where the libc allows it (glibc), otherwise only operator new is counted
+
+namespace Harness
+{
+extern std::atomic<quint64> allocCount;
+extern std::atomic<quint64> allocBytes;
+extern bool allocCounterLinked;
+} // namespace Harness
+
+[[maybe_unused]] static const bool linked = (Harness::allocCounterLinked = true);
+
+static inline void countAlloc(std::size_t size)
+{
+    Harness::allocCount.fetch_add(1, std::memory_order_relaxed);
+    Harness::allocBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+#if defined(__GLIBC__)
+extern "C" {
+void *__libc_malloc(std::size_t size);
+void *__libc_calloc(std::size_t count, std::size_t size);
+void *__libc_realloc(void *ptr, std::size_t size);
+void __libc_free(void *ptr);
+
+void *malloc(std::size_t size)
+{
+    countAlloc(size);
+    return __libc_malloc(size);
+}
+
+void *calloc(std::size_t count, std::size_t size)
+{
+    countAlloc(count * size);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, std::size_t size)
+{
+    // growing in place still counts, it's still a trip into the allocator
+    countAlloc(size);
+    return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr) { __libc_free(ptr); }
+}
+#else
+void *operator new(std::size_t size)
+{
+    countAlloc(size);
+
+    if (void *ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) { return operator new(size); }
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+#endif
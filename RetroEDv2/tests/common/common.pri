@@ -0,0 +1,28 @@
+QT += core gui widgets concurrent
+
+CONFIG += c++17 console silent
+CONFIG -= app_bundle
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+include($$PWD/../../dependencies/libRSDK/libRSDK.pri)
+
+!win32 {
+LIBS += -lz
+}
+
+# common/ has to come before the editor's root, its includes.hpp stands in for the editor's one
+INCLUDEPATH += \
+    $$PWD \
+    $$PWD/../..
+
+HEADERS += \
+    $$PWD/corpus.hpp \
+    $$PWD/fuzztargets.hpp \
+    $$PWD/harness.hpp \
+    $$PWD/includes.hpp
+
+SOURCES += \
+    $$PWD/corpus.cpp \
+    $$PWD/fuzztargets.cpp \
+    $$PWD/harness.cpp
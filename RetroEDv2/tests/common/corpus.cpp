@@ -0,0 +1,600 @@
+#include "corpus.hpp"
+#include "harness.hpp"
+
+#include <RSDKv4.hpp>
+#include <RSDKv5.hpp>
+
+// layouts are mostly runs of the same few tiles with gaps of nothing, like the real thing. fully random
+// tiles would make every compressed block a worst case, which no stage ever is
+static ushort layoutTile(QRandomGenerator &rng, ushort &run, ushort &tile, ushort emptyTile)
+{
+    if (!run) {
+        run  = 1 + rng.bounded(24);
+        tile = rng.bounded(4) == 0 ? emptyTile : rng.bounded(0x400);
+    }
+    --run;
+    return tile;
+}
+
+static QString name(QRandomGenerator &rng, const QString &prefix)
+{
+    return QString("%1%2").arg(prefix).arg(rng.bounded(10000));
+}
+
+QByteArray Corpus::sceneV5(int scale, quint32 seed)
+{
+    QRandomGenerator rng(seed);
+
+    RSDKv5::Scene scene;
+    for (int l = 0; l < 4; ++l) {
+        RSDKv5::Scene::SceneLayer layer;
+        layer.name      = name(rng, "Layer");
+        layer.type      = l == 3 ? 1 : 0;
+        layer.drawGroup = l;
+        layer.width     = 0x100;
+        layer.height    = 0x20 * scale;
+
+        ushort run = 0, tile = 0;
+        layer.layout.resize(layer.height);
+        for (auto &row : layer.layout) {
+            row.resize(layer.width);
+            for (auto &value : row) {
+                value = layoutTile(rng, run, tile, 0xFFFF);
+                if (value != 0xFFFF)
+                    value |= rng.bounded(0x10) << 10;
+            }
+        }
+
+        // a few parallax bands down the layer
+        int lines = (layer.type == 1 ? layer.width : layer.height) * 0x10;
+        int bands = 1 + rng.bounded(4);
+        for (int b = 0; b < bands; ++b) {
+            RSDKv5::Scene::ScrollIndexInfo info;
+            info.parallaxFactor = 1.0f / (b + 1);
+            info.scrollSpeed    = 0.0f;
+
+            RSDKv5::Scene::ScrollInstance instance;
+            instance.startLine = b * (lines / bands);
+            instance.length    = b == bands - 1 ? lines - instance.startLine : lines / bands;
+            info.instances.append(instance);
+
+            layer.scrollInfos.append(info);
+        }
+
+        scene.layers.append(layer);
+    }
+
+    const byte types[] = { RSDKv5::UINT8, RSDKv5::INT16,  RSDKv5::INT32,   RSDKv5::ENUM,
+                           RSDKv5::BOOL,  RSDKv5::STRING, RSDKv5::VECTOR2, RSDKv5::COLOR };
+
+    for (int o = 0; o < 24; ++o) {
+        RSDKv5::Scene::SceneObject object;
+        object.name = RSDKv5::Scene::NameIdentifier(name(rng, "Object"));
+
+        int varCount = rng.bounded(8);
+        for (int v = 0; v < varCount; ++v) {
+            RSDKv5::Scene::VariableInfo variable;
+            variable.name = RSDKv5::Scene::NameIdentifier(name(rng, "var"));
+            variable.type = types[rng.bounded(8)];
+            object.variables.append(variable);
+        }
+
+        int entityCount = rng.bounded(8 * scale);
+        for (int e = 0; e < entityCount; ++e) {
+            RSDKv5::Scene::SceneEntity entity;
+            entity.slotID     = rng.bounded(0x800);
+            entity.position.x = rng.bounded(0x100 * 0x10) << 16;
+            entity.position.y = rng.bounded(0x20 * scale * 0x10) << 16;
+
+            for (auto &variable : object.variables) {
+                RSDKv5::Scene::VariableValue value;
+                value.type = variable.type;
+                switch (variable.type) {
+                    case RSDKv5::UINT8: value.value_uint8 = rng.bounded(0x100); break;
+                    case RSDKv5::INT16: value.value_int16 = rng.bounded(-0x8000, 0x8000); break;
+                    case RSDKv5::INT32: value.value_int32 = (int)rng.generate(); break;
+                    case RSDKv5::ENUM: value.value_enum = rng.bounded(8); break;
+                    case RSDKv5::BOOL: value.value_bool = rng.bounded(2); break;
+                    case RSDKv5::STRING: value.value_string = name(rng, "Text"); break;
+                    case RSDKv5::VECTOR2:
+                        value.value_vector2.x = (int)rng.generate();
+                        value.value_vector2.y = (int)rng.generate();
+                        break;
+                    case RSDKv5::COLOR: value.value_color = QColor::fromRgba(rng.generate()); break;
+                }
+                entity.variables.append(value);
+            }
+
+            object.entities.append(entity);
+        }
+
+        scene.objects.append(object);
+    }
+
+    return Harness::writeBytes([&scene](Writer &writer) { scene.write(writer); });
+}
+
+QByteArray Corpus::stageConfigV5(int scale, quint32 seed)
+{
+    QRandomGenerator rng(seed);
+
+    RSDKv5::StageConfig config;
+    config.loadGlobalObjects = rng.bounded(2);
+
+    int objectCount = qMin(8 * scale, 0xFF);
+    for (int o = 0; o < objectCount; ++o) config.objects.append(name(rng, "Object"));
+
+    for (auto &palette : config.palettes) {
+        for (int r = 0; r < 0x10; ++r) {
+            palette.activeRows[r] = rng.bounded(2);
+            for (int c = 0; c < 0x10; ++c) palette.colors[r][c] = QColor::fromRgb(rng.generate());
+        }
+    }
+
+    int sfxCount = qMin(4 * scale, 0xFF);
+    for (int s = 0; s < sfxCount; ++s)
+        config.soundFX.append(
+            RSDKv5::StageConfig::WAVConfiguration(name(rng, "Stage/SFX") + ".wav", 1 + rng.bounded(4)));
+
+    return Harness::writeBytes([&config](Writer &writer) { config.write(writer); });
+}
+
+QByteArray Corpus::tileConfigV5(quint32 seed)
+{
+    QRandomGenerator rng(seed);
+
+    RSDKv5::TileConfig config;
+    for (auto &plane : config.collisionPaths) {
+        for (auto &mask : plane) {
+            for (auto &column : mask.collision) {
+                column.height = rng.bounded(0x10);
+                column.solid  = rng.bounded(2);
+            }
+            mask.direction  = rng.bounded(2);
+            mask.flags      = rng.bounded(0x100);
+            mask.floorAngle = rng.bounded(0x100);
+            mask.lWallAngle = rng.bounded(0x100);
+            mask.roofAngle  = rng.bounded(0x100);
+            mask.rWallAngle = rng.bounded(0x100);
+        }
+    }
+
+    return Harness::writeBytes([&config](Writer &writer) { config.write(writer); });
+}
+
+QByteArray Corpus::animationV5(int scale, quint32 seed)
+{
+    QRandomGenerator rng(seed);
+
+    RSDKv5::Animation animation;
+    for (int s = 0; s < 4; ++s) animation.sheets.append(name(rng, "Players/Sheet") + ".gif");
+    for (int h = 0; h < 3; ++h) animation.hitboxTypes.append(name(rng, "Hitbox"));
+
+    int animCount = qMin(4 * scale, 0xFFFF);
+    for (int a = 0; a < animCount; ++a) {
+        RSDKv5::Animation::AnimationEntry entry;
+        entry.name          = name(rng, "Anim");
+        entry.speed         = rng.bounded(0x100);
+        entry.rotationStyle = rng.bounded(4);
+
+        int frameCount = 1 + rng.bounded(16);
+        for (int f = 0; f < frameCount; ++f) {
+            RSDKv5::Animation::Frame frame;
+            frame.sheet    = rng.bounded(animation.sheets.count());
+            frame.duration = rng.bounded(0x100);
+            frame.sprX     = rng.bounded(0x400);
+            frame.sprY     = rng.bounded(0x400);
+            frame.width    = 1 + rng.bounded(0x40);
+            frame.height   = 1 + rng.bounded(0x40);
+            frame.pivotX   = -frame.width / 2;
+            frame.pivotY   = -frame.height / 2;
+
+            for (int h = 0; h < animation.hitboxTypes.count(); ++h) {
+                RSDKv5::Animation::Hitbox hitbox;
+                hitbox.left   = frame.pivotX;
+                hitbox.top    = frame.pivotY;
+                hitbox.right  = frame.pivotX + frame.width;
+                hitbox.bottom = frame.pivotY + frame.height;
+                frame.hitboxes.append(hitbox);
+            }
+
+            entry.frames.append(frame);
+        }
+        entry.loopIndex = rng.bounded(frameCount);
+
+        animation.animations.append(entry);
+    }
+
+    return Harness::writeBytes([&animation](Writer &writer) { animation.write(writer); });
+}
+
+QByteArray Corpus::replayV5(int scale, bool packed, quint32 seed)
+{
+    QRandomGenerator rng(seed);
+
+    RSDKv5::Replay replay;
+    replay.gameVer     = 0x105;
+    replay.isPacked    = packed;
+    replay.zoneID      = rng.bounded(12);
+    replay.act         = rng.bounded(2);
+    replay.characterID = rng.bounded(5);
+    replay.oscillation = rng.bounded(0x100);
+
+    // the player moves on most frames, everything else only changes now & then. packed frames store
+    // rotation in a byte, halved, so it's kept even & under 0x200
+    RSDKv5::Replay::ReplayEntry entry;
+    int frameCount = 60 * 60 * scale;
+    replay.frames.reserve(frameCount);
+    for (int f = 0; f < frameCount; ++f) {
+        entry.info  = !f || !rng.bounded(0x1000) ? 1 : 0;
+        entry.flags = 0;
+
+        if (!rng.bounded(6)) {
+            entry.inputs = rng.bounded(0x100);
+            entry.flags |= 0x01;
+        }
+        if (rng.bounded(8)) {
+            entry.velocity.x += (int)rng.bounded(0x800) - 0x400;
+            entry.velocity.y += (int)rng.bounded(0x800) - 0x400;
+            entry.flags |= 0x04;
+        }
+        if (entry.velocity.x || entry.velocity.y) {
+            entry.position.x += entry.velocity.x;
+            entry.position.y += entry.velocity.y;
+            entry.flags |= 0x02;
+        }
+        if (!rng.bounded(0x20)) {
+            entry.rotation = rng.bounded(0x100) << 1;
+            entry.flags |= 0x20;
+        }
+        if (!rng.bounded(0x40)) {
+            entry.direction ^= 1;
+            entry.flags |= 0x10;
+        }
+        if (!rng.bounded(0x80)) {
+            entry.anim = rng.bounded(0x30);
+            entry.flags |= 0x40;
+        }
+        if (!(f % 4)) {
+            entry.frame = (entry.frame + 1) % 8;
+            entry.flags |= 0x80;
+        }
+
+        replay.frames.append(entry);
+    }
+
+    return Harness::writeBytes([&replay](Writer &writer) { replay.write(writer); });
+}
+
+QByteArray Corpus::userDBV5(int scale, quint32 seed)
+{
+    QRandomGenerator rng(seed);
+
+    using TableColumn = RSDKv5::UserDB::TableColumn;
+
+    // the engine's own limits, 8 columns & 0x400 rows, the rest wouldn't be written
+    RSDKv5::UserDB db;
+    for (int c = 0; c < 8; ++c) {
+        TableColumn column;
+        column.name = name(rng, "column");
+        column.type = (TableColumn::Types)(TableColumn::Bool + rng.bounded(TableColumn::HashMD5));
+        db.columns.append(column);
+    }
+
+    auto timeStamp = [&rng]() {
+        RSDKv5::UserDB::TimeStamp time;
+        time.tm_sec   = rng.bounded(60);
+        time.tm_min   = rng.bounded(60);
+        time.tm_hour  = rng.bounded(24);
+        time.tm_mday  = 1 + rng.bounded(28);
+        time.tm_mon   = rng.bounded(12);
+        time.tm_year  = 117 + rng.bounded(10);
+        time.tm_wday  = rng.bounded(7);
+        time.tm_yday  = rng.bounded(365);
+        time.tm_isdst = rng.bounded(2);
+        return time;
+    };
+
+    const int valueSizes[] = { 0, 1, 1, 2, 4, 8, 1, 2, 4, 8, 4, 8, 8, 12, 16, 4, 0, 16 };
+
+    int rowCount = qMin(0x80 * scale, 0x400);
+    for (int r = 0; r < rowCount; ++r) {
+        RSDKv5::UserDB::TableRow row;
+        row.uuid       = rng.generate();
+        row.createDate = timeStamp();
+        row.modifyDate = timeStamp();
+
+        for (auto &column : db.columns) {
+            RSDKv5::UserDB::TableRow::Value value;
+            if (column.type == TableColumn::String) {
+                value.data = name(rng, "entry").toLatin1();
+            }
+            else {
+                value.data.resize(valueSizes[column.type]);
+                for (char &b : value.data) b = (char)rng.bounded(0x100);
+            }
+            row.entries.append(value);
+        }
+        db.rows.append(row);
+    }
+
+    return Harness::writeBytes([&db](Writer &writer) { db.write(writer); });
+}
+
+QByteArray Corpus::sceneV4(int scale, quint32 seed)
+{
+    QRandomGenerator rng(seed);
+
+    RSDKv4::Scene scene;
+    scene.title = name(rng, "Zone");
+    for (int i = 0; i < 4; ++i) scene.activeLayers[i] = i < 2 ? i : 9;
+    scene.midpoint = 3;
+    scene.width    = qMin(0x20 * scale, 0xFF);
+    scene.height   = qMin(0x08 * scale, 0xFF);
+
+    ushort run = 0, chunk = 0;
+    for (int y = 0; y < scene.height; ++y) {
+        scene.layout.append(QList<ushort>());
+        for (int x = 0; x < scene.width; ++x)
+            scene.layout[y].append(layoutTile(rng, run, chunk, 0) & 0x1FF);
+    }
+
+    const bool varInt[] = {
+        true, false, true, true, false, false, false, false, true, false, false, true, true, true, true,
+    };
+
+    int entityCount = qMin(0x40 * scale, 0x400);
+    for (int e = 0; e < entityCount; ++e) {
+        RSDKv4::Scene::Entity entity;
+        entity.slotID        = e;
+        entity.type          = 1 + rng.bounded(0xFF);
+        entity.propertyValue = rng.bounded(0x100);
+        entity.posX          = rng.bounded(scene.width * 0x80) << 16;
+        entity.posY          = rng.bounded(scene.height * 0x80) << 16;
+
+        for (int v = 0; v < 0x0F; ++v) {
+            entity.variables[v].active = rng.bounded(4) == 0;
+            entity.variables[v].value  = varInt[v] ? (int)rng.generate() : rng.bounded(0x100);
+        }
+
+        scene.entities.append(entity);
+    }
+
+    return Harness::writeBytes([&scene](Writer &writer) { scene.write(writer); });
+}
+
+QByteArray Corpus::chunksV4(quint32 seed)
+{
+    QRandomGenerator rng(seed);
+
+    RSDKv4::Chunks chunks;
+    for (auto &chunk : chunks.chunkList) {
+        for (auto &row : chunk.tiles) {
+            for (auto &tile : row) {
+                tile.tileIndex   = rng.bounded(0x400);
+                tile.direction   = rng.bounded(4);
+                tile.visualPlane = rng.bounded(2);
+                tile.solidityA   = rng.bounded(4);
+                tile.solidityB   = rng.bounded(4);
+            }
+        }
+    }
+
+    return Harness::writeBytes([&chunks](Writer &writer) { chunks.write(writer); });
+}
+
+QByteArray Corpus::tileConfigV4(quint32 seed)
+{
+    QRandomGenerator rng(seed);
+
+    RSDKv4::TileConfig config;
+    for (auto &plane : config.collisionPaths) {
+        for (auto &mask : plane) {
+            for (auto &column : mask.collision) {
+                column.height = rng.bounded(0x10);
+                column.solid  = rng.bounded(2);
+            }
+            mask.direction  = rng.bounded(2);
+            mask.flags      = rng.bounded(0x10);
+            mask.floorAngle = rng.bounded(0x100);
+            mask.lWallAngle = rng.bounded(0x100);
+            mask.roofAngle  = rng.bounded(0x100);
+            mask.rWallAngle = rng.bounded(0x100);
+        }
+    }
+
+    return Harness::writeBytes([&config](Writer &writer) { config.write(writer); });
+}
+
+QByteArray Corpus::gif(int scale, quint32 seed)
+{
+    QRandomGenerator rng(seed);
+
+    FormatHelpers::Gif sheet(0x200, qMin(0x80 * scale, 0xFFFF));
+    for (int c = 1; c < 0x100; ++c) sheet.palette[c] = 0xFF000000 | rng.bounded(0x1000000);
+    sheet.pixels.fill(0);
+
+    // each sprite sticks to one palette row, the way sheets are drawn
+    int sprites = 0x20 * scale;
+    for (int s = 0; s < sprites; ++s) {
+        int w    = 8 + rng.bounded(0x38);
+        int h    = 8 + rng.bounded(0x38);
+        int left = rng.bounded(sheet.width - w);
+        int top  = rng.bounded(sheet.height - h);
+        int row  = rng.bounded(0x10) << 4;
+
+        ushort run = 0, color = 0;
+        for (int y = top; y < top + h; ++y) {
+            for (int x = left; x < left + w; ++x)
+                sheet.pixels[y * sheet.width + x] = row | (layoutTile(rng, run, color, 0) & 0x0F);
+        }
+    }
+
+    return Harness::writeBytes([&sheet](Writer &writer) { sheet.write(writer); });
+}
+
+static QByteArray plyGrid(int columns, int rows, const QByteArray &format, quint32 seed)
+{
+    QRandomGenerator rng(seed);
+
+    QByteArray data;
+    data += "ply\nformat " + format + " 1.0\ncomment made by the test corpus\n";
+    data += "element vertex " + QByteArray::number(columns * rows) + "\n";
+    for (const char *name : { "x", "y", "z", "nx", "ny", "nz", "s", "t" })
+        data += QByteArray("property float ") + name + "\n";
+    for (const char *name : { "red", "green", "blue", "alpha" })
+        data += QByteArray("property uchar ") + name + "\n";
+    data += "element face " + QByteArray::number((columns - 1) * (rows - 1)) + "\n";
+    data += "property list uchar uint vertex_indices\nend_header\n";
+
+    bool ascii     = format == "ascii";
+    bool bigEndian = format == "binary_big_endian";
+
+    // only used for the binary formats, ascii is appended to data directly
+    QDataStream stream(&data, QIODevice::WriteOnly | QIODevice::Append);
+    stream.setByteOrder(bigEndian ? QDataStream::BigEndian : QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    auto putFloat = [&](float value) {
+        if (ascii)
+            data += QByteArray::number(value, 'g', 7) + ' ';
+        else
+            stream << value;
+    };
+
+    auto putInt = [&](uint value, bool isByte) {
+        if (ascii)
+            data += QByteArray::number(value) + ' ';
+        else if (isByte)
+            stream << (quint8)value;
+        else
+            stream << (quint32)value;
+    };
+
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < columns; ++x) {
+            float height = rng.bounded(1.0);
+            putFloat(x);
+            putFloat(height);
+            putFloat(y);
+            putFloat(0);
+            putFloat(1);
+            putFloat(0);
+            putFloat(x / (float)columns);
+            putFloat(y / (float)rows);
+            for (int c = 0; c < 4; ++c) putInt(c == 3 ? 0xFF : rng.bounded(0x100), true);
+            if (ascii)
+                data += '\n';
+        }
+    }
+
+    for (int y = 0; y + 1 < rows; ++y) {
+        for (int x = 0; x + 1 < columns; ++x) {
+            int v = y * columns + x;
+            putInt(4, true);
+            for (int index : { v, v + 1, v + columns + 1, v + columns }) putInt(index, false);
+            if (ascii)
+                data += '\n';
+        }
+    }
+
+    return data;
+}
+
+QByteArray Corpus::ply(int scale, const QByteArray &format, quint32 seed)
+{
+    // indices are stored as ushorts, so the grid stays under 0x10000 vertices at any scale
+    int columns = 0x20;
+    return plyGrid(columns, qMin(0x10 * scale, 0xFFFF / columns), format, seed);
+}
+
+QByteArray Corpus::plyMesh(int vertexCount, const QByteArray &format, quint32 seed)
+{
+    int columns = 0x100;
+    return plyGrid(columns, qMax((vertexCount + columns - 1) / columns, 2), format, seed);
+}
+
+static QByteArray objGrid(int columns, int rows, int frames, quint32 seed)
+{
+    QRandomGenerator rng(seed);
+
+    auto number = [](float value) { return QByteArray::number(value, 'g', 7); };
+
+    QByteArray data = "# made by the test corpus\nmtllib corpus.mtl\n";
+    for (int f = 0; f < frames; ++f) {
+        data += "o Frame" + QByteArray::number(f) + "\n";
+
+        for (int y = 0; y < rows; ++y) {
+            for (int x = 0; x < columns; ++x)
+                data += "v " + number(x) + ' ' + number(rng.bounded(1.0)) + ' ' + number(y) + '\n';
+        }
+        for (int v = 0; v < columns * rows; ++v) data += "vn 0 1 0\n";
+        for (int y = 0; y < rows; ++y) {
+            for (int x = 0; x < columns; ++x)
+                data += "vt " + number(x / (float)columns) + ' ' + number(y / (float)rows) + '\n';
+        }
+
+        // every object's faces, indexed from the start of the file like blender writes them
+        data += "usemtl None\ns off\n";
+        int first = f * columns * rows + 1;
+        for (int y = 0; y + 1 < rows; ++y) {
+            for (int x = 0; x + 1 < columns; ++x) {
+                int v = first + y * columns + x;
+                data += 'f';
+                for (int index : { v, v + 1, v + columns + 1, v + columns }) {
+                    QByteArray i = QByteArray::number(index);
+                    data += ' ' + i + '/' + i + '/' + i;
+                }
+                data += '\n';
+            }
+        }
+    }
+
+    return data;
+}
+
+QByteArray Corpus::obj(int scale, quint32 seed) { return objGrid(0x20, 0x10, scale, seed); }
+
+QByteArray Corpus::objMesh(int vertexCount, quint32 seed)
+{
+    int columns = 0x100;
+    return objGrid(columns, qMax((vertexCount + columns - 1) / columns, 2), 1, seed);
+}
+
+QList<Corpus::Sample> Corpus::samples(int scale)
+{
+    return {
+        { "RSDKv5::Scene", sceneV5(scale), Harness::roundTrip<RSDKv5::Scene> },
+        { "RSDKv5::StageConfig", stageConfigV5(scale), Harness::roundTrip<RSDKv5::StageConfig> },
+        { "RSDKv5::TileConfig", tileConfigV5(), Harness::roundTrip<RSDKv5::TileConfig> },
+        { "RSDKv5::Animation", animationV5(scale), Harness::roundTrip<RSDKv5::Animation> },
+        { "RSDKv5::Replay", replayV5(scale), Harness::roundTrip<RSDKv5::Replay> },
+        { "RSDKv5::UserDB", userDBV5(scale), Harness::roundTrip<RSDKv5::UserDB> },
+        { "RSDKv4::Scene", sceneV4(scale), Harness::roundTrip<RSDKv4::Scene> },
+        { "RSDKv4::Chunks", chunksV4(), Harness::roundTrip<RSDKv4::Chunks> },
+        { "RSDKv4::TileConfig", tileConfigV4(), Harness::roundTrip<RSDKv4::TileConfig> },
+        { "FormatHelpers::Gif", gif(scale), Harness::roundTrip<FormatHelpers::Gif> },
+        { "FormatHelpers::OBJ", obj(scale), nullptr },
+        { "FormatHelpers::PLY", ply(scale), nullptr },
+    };
+}
+
+QList<Corpus::Sample> Corpus::regressions()
+{
+    // a face list claiming 0x7FFFFFFF indices, the importer used to loop over all of them
+    QByteArray listHeader = "ply\nformat binary_little_endian 1.0\nelement face 1\n"
+                            "property list uint ushort vertex_indices\nend_header\n";
+    QByteArray asciiHeader = QByteArray(listHeader).replace("binary_little_endian", "ascii");
+
+    return {
+        { "FormatHelpers::PLY", listHeader + QByteArray("\xFF\xFF\xFF\x7F\1\0\2\0", 8), nullptr },
+        { "FormatHelpers::PLY", asciiHeader + "2147483647 1 2\n", nullptr },
+    };
+}
+
+QList<QByteArray> Corpus::truncations(const QByteArray &data, int step)
+{
+    QList<QByteArray> cuts;
+    for (int size = 0; size < data.size(); size += qMax(step, 1)) cuts.append(data.left(size));
+    return cuts;
+}
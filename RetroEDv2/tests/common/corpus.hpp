@@ -0,0 +1,53 @@
+#pragma once
+
+#include "includes.hpp"
+
+// synthetic files for the tests & benchmarks. they're built through each format's own write, so they're
+// valid by construction, & seeded so the same scale always gives the same bytes. scale grows the
+// parts of a format that grow in real files (layers, entities, frames, etc), 1 is roughly a small stage
+namespace Corpus
+{
+
+QByteArray sceneV5(int scale, quint32 seed = 1);
+QByteArray stageConfigV5(int scale, quint32 seed = 1);
+QByteArray tileConfigV5(quint32 seed = 1);
+QByteArray animationV5(int scale, quint32 seed = 1);
+// a minute of play at 60fps per scale
+QByteArray replayV5(int scale, bool packed = true, quint32 seed = 1);
+// 8 columns of random types & 0x80 rows per scale, up to the engine's 0x400
+QByteArray userDBV5(int scale, quint32 seed = 1);
+
+QByteArray sceneV4(int scale, quint32 seed = 1);
+QByteArray chunksV4(quint32 seed = 1);
+QByteArray tileConfigV4(quint32 seed = 1);
+
+// a sprite sheet, blocks of a few colours each on a blank background
+QByteArray gif(int scale, quint32 seed = 1);
+// a bumpy grid of quads with normals, uvs & colours, the way blender exports them. format is the one
+// named in the header: ascii, binary_little_endian or binary_big_endian
+QByteArray ply(int scale, const QByteArray &format = "binary_little_endian", quint32 seed = 1);
+// the same grid at vertexCount vertices (rounded up to whole rows) for the importer benchmarks. past
+// 0x10000 the indices don't fit the models' ushorts anymore, so these only time the parse
+QByteArray plyMesh(int vertexCount, const QByteArray &format = "binary_little_endian",
+                   quint32 seed = 1);
+// the grid again as blender writes obj, one object per frame (scale frames)
+QByteArray obj(int scale, quint32 seed = 1);
+QByteArray objMesh(int vertexCount, quint32 seed = 1);
+
+struct Sample {
+    QString format; // matches the fuzz target name for the format
+    QByteArray data;
+    // read into the format & written back out, nullptr for formats that are only ever read
+    QByteArray (*roundTrip)(const QByteArray &data);
+};
+
+// every format above at the given scale
+QList<Sample> samples(int scale);
+
+// inputs that once crashed or hung a reader, kept as fuzz seeds & read by the unit tests
+QList<Sample> regressions();
+
+// cut off at every step bytes, the way a partial download or a crash mid-save leaves a file
+QList<QByteArray> truncations(const QByteArray &data, int step);
+
+} // namespace Corpus
@@ -0,0 +1,166 @@
+#include "fuzztargets.hpp"
+#include "harness.hpp"
+
+#include <RSDKLegacy.hpp>
+#include <RSDKv5.hpp>
+
+template <typename T, typename Read>
+static int readFormatWith(const uint8_t *data, size_t size, Read read)
+{
+    Harness::MemoryReader memory(QByteArray::fromRawData((const char *)data, (int)size));
+
+    // some of these are a few hundred KB of fixed arrays, keep them off the stack
+    QScopedPointer<T> format(new T);
+    read(*format, memory.reader);
+    return 0;
+}
+
+template <typename T> static int readFormat(const uint8_t *data, size_t size)
+{
+    return readFormatWith<T>(data, size, [](T &format, Reader &reader) { format.read(reader); });
+}
+
+// formats that take more than the reader, each variant gets its own entry
+static int readAnimationV1DC(const uint8_t *data, size_t size)
+{
+    return readFormatWith<RSDKv1::Animation>(
+        data, size, [](RSDKv1::Animation &format, Reader &reader) { format.read(reader, true); });
+}
+
+static int readGFXV1DC(const uint8_t *data, size_t size)
+{
+    return readFormatWith<RSDKv1::GFX>(
+        data, size, [](RSDKv1::GFX &format, Reader &reader) { format.read(reader, true); });
+}
+
+static int readTileConfigV1DC(const uint8_t *data, size_t size)
+{
+    return readFormatWith<RSDKv1::TileConfig>(
+        data, size, [](RSDKv1::TileConfig &format, Reader &reader) { format.read(reader, true); });
+}
+
+static int readDatapackV4(const uint8_t *data, size_t size)
+{
+    return readFormatWith<RSDKv4::Datapack>(data, size, [](RSDKv4::Datapack &format, Reader &reader) {
+        format.read(reader, QList<QString>());
+    });
+}
+
+static int readDatapackV5(const uint8_t *data, size_t size)
+{
+    return readFormatWith<RSDKv5::Datapack>(data, size, [](RSDKv5::Datapack &format, Reader &reader) {
+        format.read(reader, QList<QString>());
+    });
+}
+
+static int readGameConfigV5Old(const uint8_t *data, size_t size)
+{
+    return readFormatWith<RSDKv5::GameConfig>(
+        data, size, [](RSDKv5::GameConfig &format, Reader &reader) { format.read(reader, true); });
+}
+
+// these only read from a path or bytes, not a Reader
+static int readOBJ(const uint8_t *data, size_t size)
+{
+    FormatHelpers::OBJ obj;
+    obj.read(QByteArray::fromRawData((const char *)data, (int)size));
+    return 0;
+}
+
+static int readPLY(const uint8_t *data, size_t size)
+{
+    FormatHelpers::PLY ply;
+    ply.read(QByteArray::fromRawData((const char *)data, (int)size));
+    return 0;
+}
+
+const QList<FuzzTargets::Entry> &FuzzTargets::entries()
+{
+    static const QList<Entry> list = {
+        { "RSDKv1::Animation", readFormat<RSDKv1::Animation> },
+        { "RSDKv1::Animation (DC)", readAnimationV1DC },
+        { "RSDKv1::Background", readFormat<RSDKv1::Background> },
+        { "RSDKv1::CharacterList", readFormat<RSDKv1::CharacterList> },
+        { "RSDKv1::Chunks", readFormat<RSDKv1::Chunks> },
+        { "RSDKv1::Datapack", readFormat<RSDKv1::Datapack> },
+        { "RSDKv1::GFX", readFormat<RSDKv1::GFX> },
+        { "RSDKv1::GFX (DC)", readGFXV1DC },
+        { "RSDKv1::SaveFile", readFormat<RSDKv1::SaveFile> },
+        { "RSDKv1::Scene", readFormat<RSDKv1::Scene> },
+        { "RSDKv1::Script", readFormat<RSDKv1::Script> },
+        { "RSDKv1::StageConfig", readFormat<RSDKv1::StageConfig> },
+        { "RSDKv1::StageList", readFormat<RSDKv1::StageList> },
+        { "RSDKv1::TileConfig", readFormat<RSDKv1::TileConfig> },
+        { "RSDKv1::TileConfig (DC)", readTileConfigV1DC },
+
+        { "RSDKv2::Animation", readFormat<RSDKv2::Animation> },
+        { "RSDKv2::Background", readFormat<RSDKv2::Background> },
+        { "RSDKv2::Bytecode", readFormat<RSDKv2::Bytecode> },
+        { "RSDKv2::Chunks", readFormat<RSDKv2::Chunks> },
+        { "RSDKv2::Datapack", readFormat<RSDKv2::Datapack> },
+        { "RSDKv2::GameConfig", readFormat<RSDKv2::GameConfig> },
+        { "RSDKv2::GFX", readFormat<RSDKv2::GFX> },
+        { "RSDKv2::Scene", readFormat<RSDKv2::Scene> },
+        { "RSDKv2::StageConfig", readFormat<RSDKv2::StageConfig> },
+        { "RSDKv2::TileConfig", readFormat<RSDKv2::TileConfig> },
+        { "RSDKv2::Video", readFormat<RSDKv2::Video> },
+
+        { "RSDKv3::Animation", readFormat<RSDKv3::Animation> },
+        { "RSDKv3::ArcContainer", readFormat<RSDKv3::ArcContainer> },
+        { "RSDKv3::Background", readFormat<RSDKv3::Background> },
+        { "RSDKv3::Bytecode", readFormat<RSDKv3::Bytecode> },
+        { "RSDKv3::Chunks", readFormat<RSDKv3::Chunks> },
+        { "RSDKv3::Config", readFormat<RSDKv3::Config> },
+        { "RSDKv3::Datapack", readFormat<RSDKv3::Datapack> },
+        { "RSDKv3::GameConfig", readFormat<RSDKv3::GameConfig> },
+        { "RSDKv3::GFX", readFormat<RSDKv3::GFX> },
+        { "RSDKv3::SaveFile", readFormat<RSDKv3::SaveFile> },
+        { "RSDKv3::Scene", readFormat<RSDKv3::Scene> },
+        { "RSDKv3::StageConfig", readFormat<RSDKv3::StageConfig> },
+        { "RSDKv3::TileConfig", readFormat<RSDKv3::TileConfig> },
+        { "RSDKv3::Video", readFormat<RSDKv3::Video> },
+
+        { "RSDKv4::Animation", readFormat<RSDKv4::Animation> },
+        { "RSDKv4::Background", readFormat<RSDKv4::Background> },
+        { "RSDKv4::Bytecode", readFormat<RSDKv4::Bytecode> },
+        { "RSDKv4::Chunks", readFormat<RSDKv4::Chunks> },
+        { "RSDKv4::Datapack", readDatapackV4 },
+        { "RSDKv4::GameConfig", readFormat<RSDKv4::GameConfig> },
+        { "RSDKv4::Model", readFormat<RSDKv4::Model> },
+        { "RSDKv4::SaveFile", readFormat<RSDKv4::SaveFile> },
+        { "RSDKv4::Scene", readFormat<RSDKv4::Scene> },
+        { "RSDKv4::StageConfig", readFormat<RSDKv4::StageConfig> },
+        { "RSDKv4::TileConfig", readFormat<RSDKv4::TileConfig> },
+
+        { "RSDKv5::Animation", readFormat<RSDKv5::Animation> },
+        { "RSDKv5::Datapack", readDatapackV5 },
+        { "RSDKv5::GameConfig", readFormat<RSDKv5::GameConfig> },
+        { "RSDKv5::GameConfig (old)", readGameConfigV5Old },
+        { "RSDKv5::Model", readFormat<RSDKv5::Model> },
+        { "RSDKv5::Palette", readFormat<RSDKv5::Palette> },
+        { "RSDKv5::Replay", readFormat<RSDKv5::Replay> },
+        { "RSDKv5::RSDKConfig", readFormat<RSDKv5::RSDKConfig> },
+        { "RSDKv5::SaveFile", readFormat<RSDKv5::SaveFile> },
+        { "RSDKv5::Scene", readFormat<RSDKv5::Scene> },
+        { "RSDKv5::StageConfig", readFormat<RSDKv5::StageConfig> },
+        { "RSDKv5::Stamps", readFormat<RSDKv5::Stamps> },
+        { "RSDKv5::StaticObject", readFormat<RSDKv5::StaticObject> },
+        { "RSDKv5::TileConfig", readFormat<RSDKv5::TileConfig> },
+        { "RSDKv5::UserDB", readFormat<RSDKv5::UserDB> },
+
+        { "FormatHelpers::Gif", readFormat<FormatHelpers::Gif> },
+        { "FormatHelpers::OBJ", readOBJ },
+        { "FormatHelpers::PLY", readPLY },
+        { "Palette", readFormat<Palette> },
+    };
+    return list;
+}
+
+FuzzTargets::Target FuzzTargets::find(const QByteArray &name)
+{
+    for (const Entry &entry : entries()) {
+        if (name == entry.name)
+            return entry.target;
+    }
+    return nullptr;
+}
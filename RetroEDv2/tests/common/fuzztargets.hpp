@@ -0,0 +1,23 @@
+#pragma once
+
+#include "includes.hpp"
+
+// one entry per format reader. they take any bytes at all & must come back without crashing, hanging or
+// blowing up the heap, whatever the result looks like. the fuzz target drives them with libFuzzer, the
+// unit tests run them over truncated corpus files
+namespace FuzzTargets
+{
+
+typedef int (*Target)(const uint8_t *data, size_t size);
+
+struct Entry {
+    const char *name;
+    Target target;
+};
+
+const QList<Entry> &entries();
+
+// nullptr if there's no target called name
+Target find(const QByteArray &name);
+
+} // namespace FuzzTargets
@@ -0,0 +1,89 @@
+#include "harness.hpp"
+
+#include <atomic>
+#include <limits>
+
+namespace Harness
+{
+// bumped by the operator new in alloccounter.cpp
+std::atomic<quint64> allocCount(0);
+std::atomic<quint64> allocBytes(0);
+bool allocCounterLinked = false;
+} // namespace Harness
+
+static QDataStream *openStream(QBuffer &buffer, QIODevice::OpenMode mode)
+{
+    buffer.open(mode);
+    return new QDataStream(&buffer);
+}
+
+Harness::MemoryReader::MemoryReader(const QByteArray &data)
+    : bytes(data), buffer(&bytes), reader(openStream(buffer, QIODevice::ReadOnly))
+{
+    reader.filesize = bytes.size();
+}
+
+QByteArray Harness::writeBytes(const std::function<void(Writer &)> &write)
+{
+    QByteArray bytes;
+    QBuffer buffer(&bytes);
+    Writer writer(openStream(buffer, QIODevice::WriteOnly));
+    write(writer);
+    return bytes;
+}
+
+bool Harness::countsAllocations() { return allocCounterLinked; }
+
+Harness::AllocStats Harness::allocStats()
+{
+    AllocStats stats;
+    stats.count = allocCount.load(std::memory_order_relaxed);
+    stats.bytes = allocBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+Harness::BenchResult Harness::measure(const QString &name, qint64 bytes,
+                                      const std::function<void()> &fn, int minRuns, int minMs)
+{
+    BenchResult result;
+    result.name  = name;
+    result.bytes = bytes;
+
+    // one run first so anything cached on first use doesn't land in the numbers
+    fn();
+
+    qint64 best      = std::numeric_limits<qint64>::max();
+    AllocStats start = allocStats();
+
+    QElapsedTimer total;
+    total.start();
+    while (result.runs < minRuns || total.elapsed() < minMs) {
+        QElapsedTimer timer;
+        timer.start();
+        fn();
+        best = qMin(best, timer.nsecsElapsed());
+        ++result.runs;
+    }
+
+    AllocStats end = allocStats();
+
+    result.msPerRun      = best / 1000000.0;
+    result.mbPerSec      = best > 0 ? (bytes / (1024.0 * 1024.0)) / (best / 1000000000.0) : 0.0;
+    result.allocsPerRun  = double(end.count - start.count) / result.runs;
+    result.kbAllocPerRun = double(end.bytes - start.bytes) / result.runs / 1024.0;
+    return result;
+}
+
+void Harness::report(const BenchResult &result)
+{
+    QString allocs = "-";
+    if (countsAllocations()) {
+        allocs = QString("%1 (%2 KB)")
+                     .arg(result.allocsPerRun, 0, 'f', 1)
+                     .arg(result.kbAllocPerRun, 0, 'f', 1);
+    }
+
+    printf("%-40s %10lld B %10.3f ms %10.1f MB/s   allocs/run %s\n", result.name.toLatin1().constData(),
+           result.bytes, result.msPerRun, result.mbPerSec, allocs.toLatin1().constData());
+    fflush(stdout);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "includes.hpp"
+
+#include <functional>
+
+namespace Harness
+{
+
+// a Reader over bytes in memory, Reader doesn't own the device it reads from so this keeps it alive
+class MemoryReader
+{
+public:
+    explicit MemoryReader(const QByteArray &data);
+
+private:
+    QByteArray bytes;
+    QBuffer buffer;
+
+public:
+    Reader reader;
+};
+
+// whatever write puts into the Writer it's given
+QByteArray writeBytes(const std::function<void(Writer &)> &write);
+
+// reads data into a fresh T & writes it straight back out
+template <typename T> QByteArray roundTrip(const QByteArray &data)
+{
+    MemoryReader memory(data);
+    T format;
+    format.read(memory.reader);
+    return writeBytes([&format](Writer &writer) { format.write(writer); });
+}
+
+// global allocations made so far. only counted in targets that link alloccounter.cpp, the fuzz target
+// leaves operator new alone for the sanitizers
+struct AllocStats {
+    quint64 count = 0;
+    quint64 bytes = 0;
+};
+
+bool countsAllocations();
+AllocStats allocStats();
+
+struct BenchResult {
+    QString name;
+    qint64 bytes         = 0;
+    int runs             = 0;
+    double msPerRun      = 0.0; // best run, the others are mostly noise from everything else
+    double mbPerSec      = 0.0;
+    double allocsPerRun  = 0.0;
+    double kbAllocPerRun = 0.0;
+};
+
+// runs fn until it's taken at least minMs & minRuns runs, bytes is how much a single run processes
+BenchResult measure(const QString &name, qint64 bytes, const std::function<void()> &fn, int minRuns = 5,
+                    int minMs = 200);
+void report(const BenchResult &result);
+
+} // namespace Harness
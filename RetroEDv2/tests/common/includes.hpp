@@ -0,0 +1,14 @@
+#pragma once
+
+// stands in for the editor's includes.hpp, so libRSDK & the self-contained tools/utils sources can be
+// built into the test targets without dragging the rest of the editor in with them
+#include "libRSDK.hpp"
+
+// the editor headers that only need libRSDK
+#include "utils/csvstream.hpp"
+#include "utils/frameprofiler.hpp"
+
+// the storage allocator only needs bool32 out of gamelink.hpp, the rest of it drags in the game's
+// draw & object code
+typedef uint bool32;
+#include "tools/gamelink/gamestorage.hpp"
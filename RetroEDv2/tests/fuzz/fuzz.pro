@@ -0,0 +1,14 @@
+# libFuzzer target over every format reader. RSDK_FUZZ_TARGET picks one reader by name (see
+# common/fuzztargets.cpp), otherwise every input goes through all of them
+#   qmake CONFIG+=fuzz QMAKE_CXX=clang++ QMAKE_LINK=clang++ && make
+#   RSDK_FUZZ_TARGET="RSDKv5::Scene" ./fuzz corpus/
+TARGET = fuzz
+TEMPLATE = app
+
+include(../common/common.pri)
+
+QMAKE_CXXFLAGS += -fsanitize=fuzzer,address,undefined -fno-omit-frame-pointer
+QMAKE_LFLAGS   += -fsanitize=fuzzer,address,undefined
+
+SOURCES += \
+    main.cpp
@@ -0,0 +1,31 @@
+#include "fuzztargets.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+// `bench --corpus <dir>` writes the synthetic files out as seeds for this
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    static FuzzTargets::Target target = nullptr;
+    static bool picked                = false;
+    if (!picked) {
+        picked = true;
+
+        QByteArray name = qgetenv("RSDK_FUZZ_TARGET");
+        if (!name.isEmpty()) {
+            target = FuzzTargets::find(name);
+            if (!target) {
+                fprintf(stderr, "no fuzz target called \"%s\", the targets are:\n", name.constData());
+                for (auto &entry : FuzzTargets::entries()) fprintf(stderr, "  %s\n", entry.name);
+                abort();
+            }
+        }
+    }
+
+    if (target)
+        return target(data, size);
+
+    for (auto &entry : FuzzTargets::entries()) entry.target(data, size);
+    return 0;
+}
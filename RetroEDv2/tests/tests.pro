@@ -0,0 +1,11 @@
+# standalone tests for libRSDK & the editor's self-contained helpers, none of them need the editor itself
+#   unit:  QtTest suites, run the binary (or `make check`)
+#   bench: throughput & allocation numbers over the synthetic corpus, `bench [filter]`
+#   fuzz:  libFuzzer target over every format reader, needs clang, `qmake CONFIG+=fuzz`
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    bench \
+    unit
+
+CONFIG(fuzz): SUBDIRS += fuzz
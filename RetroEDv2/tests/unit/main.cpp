@@ -0,0 +1,93 @@
+#include "tst_activeranges.hpp"
+#include "tst_chunkatlas.hpp"
+#include "tst_csvstream.hpp"
+#include "tst_entitycounts.hpp"
+#include "tst_filtervarindex.hpp"
+#include "tst_formats.hpp"
+#include "tst_frameprofiler.hpp"
+#include "tst_gamestorage.hpp"
+#include "tst_gif.hpp"
+#include "tst_modelmesh.hpp"
+#include "tst_obj.hpp"
+#include "tst_objectgroups.hpp"
+#include "tst_palettetexture.hpp"
+#include "tst_ply.hpp"
+#include "tst_quantizer.hpp"
+#include "tst_replayv5.hpp"
+#include "tst_scenev5.hpp"
+#include "tst_tileatlas.hpp"
+#include "tst_tilededuplicator.hpp"
+#include "tst_tileusageindex.hpp"
+#include "tst_userdbmodel.hpp"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    int status = 0;
+
+    TestActiveRanges activeRanges;
+    status |= QTest::qExec(&activeRanges, argc, argv);
+
+    TestChunkAtlas chunkAtlas;
+    status |= QTest::qExec(&chunkAtlas, argc, argv);
+
+    TestCSVStream csvStream;
+    status |= QTest::qExec(&csvStream, argc, argv);
+
+    TestEntityCounts entityCounts;
+    status |= QTest::qExec(&entityCounts, argc, argv);
+
+    TestFilterVarIndex filterVarIndex;
+    status |= QTest::qExec(&filterVarIndex, argc, argv);
+
+    TestFormats formats;
+    status |= QTest::qExec(&formats, argc, argv);
+
+    TestFrameProfiler frameProfiler;
+    status |= QTest::qExec(&frameProfiler, argc, argv);
+
+    TestGameStorage gameStorage;
+    status |= QTest::qExec(&gameStorage, argc, argv);
+
+    TestGif gif;
+    status |= QTest::qExec(&gif, argc, argv);
+
+    TestModelMesh modelMesh;
+    status |= QTest::qExec(&modelMesh, argc, argv);
+
+    TestOBJ obj;
+    status |= QTest::qExec(&obj, argc, argv);
+
+    TestObjectGroups objectGroups;
+    status |= QTest::qExec(&objectGroups, argc, argv);
+
+    TestPaletteTexture paletteTexture;
+    status |= QTest::qExec(&paletteTexture, argc, argv);
+
+    TestPLY ply;
+    status |= QTest::qExec(&ply, argc, argv);
+
+    TestQuantizer quantizer;
+    status |= QTest::qExec(&quantizer, argc, argv);
+
+    TestReplayV5 replayV5;
+    status |= QTest::qExec(&replayV5, argc, argv);
+
+    TestSceneV5 sceneV5;
+    status |= QTest::qExec(&sceneV5, argc, argv);
+
+    TestTileAtlas tileAtlas;
+    status |= QTest::qExec(&tileAtlas, argc, argv);
+
+    TestTileDeduplicator tileDeduplicator;
+    status |= QTest::qExec(&tileDeduplicator, argc, argv);
+
+    TestTileUsageIndex tileUsageIndex;
+    status |= QTest::qExec(&tileUsageIndex, argc, argv);
+
+    TestUserDBModel userDBModel;
+    status |= QTest::qExec(&userDBModel, argc, argv);
+
+    return status;
+}
@@ -0,0 +1,136 @@
+#include "tst_activeranges.hpp"
+#include "harness.hpp"
+
+#include "tools/utils/activeranges.hpp"
+
+// cull is checked against the engine's per entity switch, worked in 64 bits so it can't overflow itself
+
+struct TestEntity {
+    struct {
+        int x, y;
+    } position, updateRange;
+    byte active;
+};
+
+struct TestSlot {
+    void *gameEntity;
+    ushort type;
+};
+
+static bool engineInRange(int x, int y, int rx, int ry, byte mode, int screenX, int screenY,
+                          int boundsX, int boundsY)
+{
+    qint64 sx = qAbs((qint64)x - screenX);
+    qint64 sy = qAbs((qint64)y - screenY);
+
+    switch (mode) {
+        default:
+        case ACTIVE_NEVER: return false;
+        case ACTIVE_ALWAYS:
+        case ACTIVE_NORMAL:
+        case ACTIVE_PAUSED: return true;
+        case ACTIVE_BOUNDS: return sx <= (qint64)rx + boundsX && sy <= (qint64)ry + boundsY;
+        case ACTIVE_XBOUNDS: return sx <= (qint64)rx + boundsX;
+        case ACTIVE_YBOUNDS: return sy <= (qint64)ry + boundsY;
+        case ACTIVE_RBOUNDS:
+            return (sx >> 16) * (sx >> 16) + (sy >> 16) * (sy >> 16) <= (qint64)rx + boundsX;
+    }
+}
+
+void TestActiveRanges::cullMatchesTheEngine_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("spread"); // in pixels either side of the screen
+
+    QTest::newRow("one slot") << 1 << 0x200;
+    QTest::newRow("partial mask word") << 37 << 0x200;
+    QTest::newRow("a stage's worth") << 0x940 << 0x2000;
+    QTest::newRow("close to the screen") << 0x800 << 0x100;
+}
+
+void TestActiveRanges::cullMatchesTheEngine()
+{
+    QFETCH(int, count);
+    QFETCH(int, spread);
+
+    QRandomGenerator rng(count);
+
+    int screenX = (0x4000 + rng.bounded(0x100)) << 16;
+    int screenY = (0x1000 + rng.bounded(0x100)) << 16;
+    int boundsX = 212 << 16;
+    int boundsY = 120 << 16;
+
+    ActiveRangeList ranges;
+    ranges.resize(count);
+    for (int e = 0; e < count; ++e) {
+        int x      = screenX + ((int)rng.bounded(spread * 2) - spread) * 0x10000;
+        int y      = screenY + ((int)rng.bounded(spread * 2) - spread) * 0x10000;
+        byte mode  = rng.bounded(ACTIVE_RBOUNDS + 1);
+        // radius ranges are squared pixels, box ones are 16.16
+        int radius = rng.bounded(0x100) * rng.bounded(0x100);
+        int rx     = mode == ACTIVE_RBOUNDS ? radius : (int)rng.bounded(0x200) << 16;
+        ranges.set(e, x, y, rx, (int)rng.bounded(0x200) << 16, mode);
+    }
+    ranges.cull(screenX, screenY, boundsX, boundsY);
+
+    for (int e = 0; e < count; ++e) {
+        bool expected = engineInRange(ranges.posX[e], ranges.posY[e], ranges.rangeX[e],
+                                      ranges.rangeY[e], ranges.active[e], screenX, screenY, boundsX,
+                                      boundsY);
+        QCOMPARE(ranges.inRange(e), expected);
+    }
+}
+
+void TestActiveRanges::farRadiusChecksDontOverflow()
+{
+    // 35000 pixels apart on both axes squares to more than 2^31, which used to wrap negative & count as
+    // in range. the second one is too far apart to even subtract in 32 bits
+    int screen = -17500 * 0x10000;
+
+    ActiveRangeList ranges;
+    ranges.resize(3);
+    ranges.set(0, 17500 * 0x10000, 17500 * 0x10000, 0x100, 0, ACTIVE_RBOUNDS);
+    ranges.set(1, 30000 * 0x10000, screen, 0x100, 0, ACTIVE_RBOUNDS);
+    ranges.set(2, screen + 0x20 * 0x10000, screen, 0x100, 0, ACTIVE_RBOUNDS);
+
+    ranges.cull(screen, screen, 0, 0);
+    QVERIFY(!ranges.inRange(0));
+    QVERIFY(!ranges.inRange(1));
+    QVERIFY(!ranges.inRange(2));
+
+    // 0x10 pixels away squares to exactly the radius
+    ranges.cull(screen + 0x10 * 0x10000, screen, 0, 0);
+    QVERIFY(!ranges.inRange(0));
+    QVERIFY(!ranges.inRange(1));
+    QVERIFY(ranges.inRange(2));
+}
+
+void TestActiveRanges::gatherSkipsEmptySlots()
+{
+    TestEntity entities[3];
+    for (auto &entity : entities) {
+        entity.position    = { 0, 0 };
+        entity.updateRange = { 0, 0 };
+        entity.active      = ACTIVE_ALWAYS;
+    }
+
+    QList<TestSlot> slots = {
+        { &entities[0], 1 },
+        { nullptr, 1 },      // no game entity
+        { &entities[2], 0 }, // blank type
+        { &entities[1], 2 },
+    };
+
+    ActiveRangeList ranges;
+    ranges.gather<TestEntity>(slots, false);
+    ranges.cull(0, 0, 0, 0);
+    QVERIFY(ranges.inRange(0));
+    QVERIFY(!ranges.inRange(1));
+    QVERIFY(!ranges.inRange(2));
+    QVERIFY(ranges.inRange(3));
+
+    // nothing updates while drawing an image
+    ranges.gather<TestEntity>(slots, true);
+    ranges.cull(0, 0, 0, 0);
+    for (int e = 0; e < slots.count(); ++e) QVERIFY(!ranges.inRange(e));
+}
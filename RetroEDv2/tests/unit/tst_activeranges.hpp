@@ -0,0 +1,14 @@
+#pragma once
+
+#include <QtTest>
+
+class TestActiveRanges : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void cullMatchesTheEngine_data();
+    void cullMatchesTheEngine();
+    void farRadiusChecksDontOverflow();
+    void gatherSkipsEmptySlots();
+};
@@ -0,0 +1,100 @@
+#include "tst_chunkatlas.hpp"
+#include "harness.hpp"
+
+#include "tools/utils/chunkatlas.hpp"
+
+// each chunk a flat colour made from its id, so any pixel says which chunk landed there
+static QRgb chunkColor(int chunk) { return 0xFF000000 | (chunk * 0x10101 + 0x30507); }
+
+static QList<QImage> chunkImages(int count)
+{
+    QList<QImage> chunks;
+    for (int c = 0; c < count; ++c) {
+        QImage chunk(ChunkAtlas::CHUNK_SIZE, ChunkAtlas::CHUNK_SIZE, QImage::Format_ARGB32);
+        chunk.fill(chunkColor(c));
+        chunks.append(chunk);
+    }
+    return chunks;
+}
+
+void TestChunkAtlas::cellsTileTheAtlas()
+{
+    QRect bounds(0, 0, ChunkAtlas::COLUMNS * ChunkAtlas::CHUNK_SIZE,
+                 ChunkAtlas::ROWS * ChunkAtlas::CHUNK_SIZE);
+    QVERIFY(bounds.width() <= 0x1000 && bounds.height() <= 0x1000);
+    QCOMPARE((int)ChunkAtlas::CHUNK_COUNT, 0x200);
+
+    QRegion covered;
+    for (int c = 0; c < ChunkAtlas::CHUNK_COUNT; ++c) {
+        QRect rect = ChunkAtlas::rect(c);
+        QCOMPARE(rect.size(), QSize(ChunkAtlas::CHUNK_SIZE, ChunkAtlas::CHUNK_SIZE));
+        QVERIFY(bounds.contains(rect));
+        QVERIFY(!covered.intersects(rect));
+        covered += rect;
+    }
+    QCOMPARE(covered, QRegion(bounds));
+}
+
+void TestChunkAtlas::buildPlacesEveryChunk()
+{
+    // more chunks than fit, & a short list, both have to come out right
+    for (int count : { 0x40, ChunkAtlas::CHUNK_COUNT + 0x10 }) {
+        ChunkAtlas chunkAtlas;
+        QImage atlas = chunkAtlas.build(chunkImages(count), QColor(0xFFFF00FF));
+
+        for (int c = 0; c < ChunkAtlas::CHUNK_COUNT; ++c) {
+            QRect rect    = ChunkAtlas::rect(c);
+            QRgb expected = c < count ? chunkColor(c) : 0xFFFF00FF;
+            QCOMPARE(atlas.pixel(rect.topLeft()), expected);
+            QCOMPARE(atlas.pixel(rect.bottomRight()), expected);
+        }
+    }
+}
+
+void TestChunkAtlas::onlyReplacedChunksAreDirty()
+{
+    QList<QImage> chunks = chunkImages(0x40);
+
+    ChunkAtlas chunkAtlas;
+    QVERIFY(chunkAtlas.takeDirty(chunks).isEmpty()); // nothing's been built yet
+
+    chunkAtlas.build(chunks, Qt::black);
+    QVERIFY(chunkAtlas.takeDirty(chunks).isEmpty());
+
+    // a shared copy isn't a change, an edit or a new image is
+    QList<QImage> copies = chunks;
+    QVERIFY(chunkAtlas.takeDirty(copies).isEmpty());
+
+    chunks[5].setPixel(3, 3, 0xFF123456);
+    chunks[0x21] = chunkImages(1).first();
+    QCOMPARE(chunkAtlas.takeDirty(chunks), QList<int>({ 5, 0x21 }));
+
+    // taken once, so they're clean until they change again
+    QVERIFY(chunkAtlas.takeDirty(chunks).isEmpty());
+
+    chunks[5].setPixel(4, 4, 0xFF654321);
+    QCOMPARE(chunkAtlas.takeDirty(chunks), QList<int>({ 5 }));
+
+    // rebuilt, everything's clean again
+    chunks[7].fill(Qt::white);
+    chunkAtlas.build(chunks, Qt::black);
+    QVERIFY(chunkAtlas.takeDirty(chunks).isEmpty());
+
+    chunkAtlas.clear();
+    chunks[8].fill(Qt::white);
+    QVERIFY(chunkAtlas.takeDirty(chunks).isEmpty());
+}
+
+void TestChunkAtlas::cellsAreCropped()
+{
+    // v1 chunks are bigger than a cell, only the top left of them fits
+    QImage chunk(0x100, 0x100, QImage::Format_ARGB32);
+    chunk.fill(0xFF0000FF);
+    chunk.setPixel(0x7F, 0x7F, 0xFF00FF00);
+
+    QImage cell = ChunkAtlas::cell(chunk);
+    QCOMPARE(cell.size(), QSize(ChunkAtlas::CHUNK_SIZE, ChunkAtlas::CHUNK_SIZE));
+    QCOMPARE(cell.format(), QImage::Format_RGBA8888);
+    QCOMPARE(cell.pixel(0, 0), 0xFF0000FFu);
+    QCOMPARE(cell.pixel(0x7F, 0x7F), 0xFF00FF00u);
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <QtTest>
+
+class TestChunkAtlas : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void cellsTileTheAtlas();
+    void buildPlacesEveryChunk();
+    void onlyReplacedChunksAreDirty();
+    void cellsAreCropped();
+};
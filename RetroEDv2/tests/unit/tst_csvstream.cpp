@@ -0,0 +1,240 @@
+#include "tst_csvstream.hpp"
+#include "corpus.hpp"
+#include "harness.hpp"
+
+using UserDB      = RSDKv5::UserDB;
+using TableColumn = RSDKv5::UserDB::TableColumn;
+
+// every size up to a dozen bytes, so each quote, escape & line break lands on a buffer edge somewhere
+static const QList<int> bufferSizes = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 0x10000 };
+
+static QString writeFile(const QTemporaryDir &dir, const QByteArray &data)
+{
+    QString path = dir.filePath("test.csv");
+    QFile file(path);
+    file.open(QIODevice::WriteOnly);
+    file.write(data);
+    return path;
+}
+
+static QList<CSVRow> readRows(const QString &path, int bufferSize)
+{
+    CSVReader reader(path, bufferSize);
+
+    QList<CSVRow> rows;
+    CSVRow row;
+    while (reader.readRow(row)) rows.append(row);
+    return rows;
+}
+
+void TestCSVStream::quotesAreEscaped()
+{
+    QByteArray out;
+    CSVWriter::encodeRow(out, { "plain", "a,b", "say \"hi\"", "two\nlines", "cr\r", "" });
+    QCOMPARE(out, QByteArray("plain,\"a,b\",\"say \"\"hi\"\"\",\"two\nlines\",\"cr\r\",\n"));
+}
+
+void TestCSVStream::quotedFieldsReadBack()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString path = writeFile(dir, "a,\"b,c\",\"d\"\"e\"\n"
+                                  "\"multi\nline\",x\n"
+                                  "\"\",plain\"quote,\"\"\"\"\n");
+
+    // quotes only mean something at the start of a field, elsewhere they're kept as-is
+    QList<CSVRow> expected = {
+        { "a", "b,c", "d\"e" },
+        { "multi\nline", "x" },
+        { "", "plain\"quote", "\"" },
+    };
+
+    for (int bufferSize : bufferSizes) QCOMPARE(readRows(path, bufferSize), expected);
+}
+
+void TestCSVStream::lineEndingsSplitAcrossBuffers()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString path = writeFile(dir, "a,b\r\nc\rd\n\r\ne\r\n\"x\r\ny\",z\r\nlast");
+
+    // \r\n, \r & \n all end a row, line breaks inside quotes are part of the field & the last row
+    // doesn't need one
+    QList<CSVRow> expected = {
+        { "a", "b" }, { "c" }, { "d" }, { "" }, { "e" }, { "x\r\ny", "z" }, { "last" },
+    };
+
+    for (int bufferSize : bufferSizes) QCOMPARE(readRows(path, bufferSize), expected);
+}
+
+void TestCSVStream::writtenRowsReadBack()
+{
+    QRandomGenerator rng(1);
+    const char chars[] = "ab,\"\r\n ";
+
+    QList<CSVRow> rows;
+    for (int r = 0; r < 200; ++r) {
+        CSVRow row;
+        for (int f = 1 + rng.bounded(5); f > 0; --f) {
+            QByteArray field;
+            for (int c = rng.bounded(8); c > 0; --c) field.append(chars[rng.bounded(7)]);
+            row.append(field);
+        }
+        rows.append(row);
+    }
+
+    // a lone empty field is written as a blank line, it reads back the same way
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString path = dir.filePath("test.csv");
+    for (int bufferSize : { 1, 7, 0x10000 }) {
+        CSVWriter writer(path, bufferSize);
+        QVERIFY(writer.isOpen());
+        for (int r = 0; r < rows.count(); ++r) {
+            // every other row is encoded up front, the way the db conversion does it
+            if (r & 1) {
+                QByteArray encoded;
+                CSVWriter::encodeRow(encoded, rows[r]);
+                writer.writeEncoded(encoded);
+            }
+            else {
+                writer.writeRow(rows[r]);
+            }
+        }
+        QVERIFY(writer.close());
+
+        for (int readSize : { 1, 5, 0x10000 }) QCOMPARE(readRows(path, readSize), rows);
+    }
+}
+
+// no type row, so it goes straight from the names to the values
+static const QByteArray untypedCSV = "uuid,Creation Date,Modified Date,"
+                                     "flag,small,big,count,huge,ratio,name,empty\n"
+                                     "1,,,y,0x1F,0x1FFFFFFFF,-5,5000000000,1.5,abc,\n"
+                                     "2,,,N,0xFF,0x2,7,-1,2,3,\n";
+
+static const QList<byte> untypedTypes = {
+    TableColumn::Bool,  TableColumn::UInt32, TableColumn::UInt64, TableColumn::Int32,
+    TableColumn::Int64, TableColumn::Double, TableColumn::String, TableColumn::String,
+};
+
+void TestCSVStream::typesAreInferred()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    CSVReader reader(writeFile(dir, untypedCSV));
+
+    CSVRow names;
+    QVERIFY(reader.readRow(names));
+    QCOMPARE(InferCSVTypes(reader, untypedTypes.count()), untypedTypes);
+}
+
+void TestCSVStream::missingTypeRowIsInferred()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    CSVReader reader(writeFile(dir, untypedCSV));
+
+    UserDB db;
+    QVERIFY(ReadUserDBCSV(db, reader, 1));
+
+    QCOMPARE(db.columns.count(), untypedTypes.count());
+    for (int c = 0; c < untypedTypes.count(); ++c) QCOMPARE((byte)db.columns[c].type, untypedTypes[c]);
+    QCOMPARE(db.columns[0].name, QString("flag"));
+
+    // the inference pass rewinds, so the first row isn't lost to it
+    QCOMPARE(db.rows.count(), 2);
+    QCOMPARE(db.rows[0].uuid, 1u);
+    QCOMPARE(db.rows[1].uuid, 2u);
+    QCOMPARE(UserDB::valueToString(TableColumn::Bool, db.rows[1].entries[0].data), QString("n"));
+    QCOMPARE(UserDB::valueToString(TableColumn::Int64, db.rows[0].entries[4].data),
+             QString("5000000000"));
+    QCOMPARE(UserDB::valueToString(TableColumn::String, db.rows[1].entries[6].data), QString("3"));
+}
+
+// the corpus db with only what a csv holds exactly: bools are 0 or 1, there's no nans (they'd come back
+// as the default one) & each date's weekday & day of the year match it. strings get everything that
+// has to be quoted
+static QByteArray csvSafeDB(UserDB &db)
+{
+    Harness::MemoryReader memory(Corpus::userDBV5(8));
+    db.read(memory.reader);
+
+    const char *quoted[] = { "", ", with a comma", " \"quoted\"", " two\r\nlines" };
+    for (int r = 0; r < db.rows.count(); ++r) {
+        auto &row = db.rows[r];
+        row.createDate.fromDateString(row.createDate.toDateString());
+        row.modifyDate.fromDateString(row.modifyDate.toDateString());
+
+        for (int c = 0; c < db.columns.count(); ++c) {
+            QByteArray &data = row.entries[c].data;
+            switch (db.columns[c].type) {
+                default: break;
+
+                case TableColumn::Bool: data[0] = data[0] ? 1 : 0; break;
+
+                case TableColumn::Float: {
+                    float value = 0;
+                    memcpy(&value, data.constData(), sizeof(value));
+                    if (qIsNaN(value))
+                        data.fill(0);
+                    break;
+                }
+
+                case TableColumn::Double: {
+                    double value = 0;
+                    memcpy(&value, data.constData(), sizeof(value));
+                    if (qIsNaN(value))
+                        data.fill(0);
+                    break;
+                }
+
+                case TableColumn::String: data.append(quoted[r % 4]); break;
+            }
+        }
+    }
+
+    return Harness::writeBytes([&db](Writer &writer) { db.write(writer); });
+}
+
+void TestCSVStream::dbRoundTrips_data()
+{
+    QTest::addColumn<int>("chunkSize");
+    QTest::addColumn<int>("bufferSize");
+
+    QTest::newRow("a row per chunk") << 1 << 0x10000;
+    QTest::newRow("small chunks") << 7 << 0x10000;
+    QTest::newRow("default chunks") << 0x100 << 0x10000;
+    QTest::newRow("one chunk") << 0x400 << 0x10000;
+    QTest::newRow("small chunks, small buffers") << 7 << 7;
+}
+
+void TestCSVStream::dbRoundTrips()
+{
+    QFETCH(int, chunkSize);
+    QFETCH(int, bufferSize);
+
+    UserDB db;
+    QByteArray bytes = csvSafeDB(db);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString path = dir.filePath("db.csv");
+
+    CSVWriter writer(path, bufferSize);
+    QVERIFY(writer.isOpen());
+    WriteUserDBCSV(db, writer, chunkSize);
+    QVERIFY(writer.close());
+
+    CSVReader reader(path, bufferSize);
+    UserDB loaded;
+    QVERIFY(ReadUserDBCSV(loaded, reader, chunkSize));
+
+    // chunks finish in any order on the pool, the rows still have to come back in theirs
+    QCOMPARE(loaded.rows.count(), db.rows.count());
+    for (int r = 0; r < db.rows.count(); ++r) QCOMPARE(loaded.rows[r].uuid, db.rows[r].uuid);
+
+    QByteArray written = Harness::writeBytes([&loaded](Writer &writer) { loaded.write(writer); });
+    QCOMPARE(written.size(), bytes.size());
+    QVERIFY(written == bytes);
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <QtTest>
+
+class TestCSVStream : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void quotesAreEscaped();
+    void quotedFieldsReadBack();
+    void lineEndingsSplitAcrossBuffers();
+    void writtenRowsReadBack();
+
+    void typesAreInferred();
+    void missingTypeRowIsInferred();
+
+    void dbRoundTrips_data();
+    void dbRoundTrips();
+};
@@ -0,0 +1,163 @@
+#include "tst_entitycounts.hpp"
+#include "harness.hpp"
+
+#include "tools/utils/entitycounts.hpp"
+
+static SceneObject object(const QStringList &variables)
+{
+    SceneObject info;
+    for (int v = 0; v < variables.count(); ++v)
+        info.variables.append(VariableInfo(variables[v], RSDKv5::UINT8, v));
+    return info;
+}
+
+static SceneEntity entity(byte type, const QList<byte> &values)
+{
+    SceneEntity info;
+    info.type = type;
+    for (byte value : values) {
+        RSDKv5::Scene::VariableValue variable;
+        variable.type        = RSDKv5::UINT8;
+        variable.value_uint8 = value;
+        info.variables.append(variable);
+    }
+    return info;
+}
+
+// the loop SceneViewer ran over every entity before the counts were kept
+static int recount(const QList<SceneEntity> &entities, const FilterVarIndex &filterVars,
+                   int sceneFilter, int fallback)
+{
+    int count = 0;
+    for (auto &entity : entities) {
+        int filter = filterVars.filter(entity, fallback);
+        if ((filter & sceneFilter) || !filter)
+            ++count;
+    }
+    return count;
+}
+
+void TestEntityCounts::countsBySceneFilter()
+{
+    QList<SceneObject> objects  = { object({}), object({ "filter" }), object({ "type", "filter" }) };
+    QList<SceneEntity> entities = {
+        entity(0, {}), entity(1, { 0 }), entity(1, { 1 }), entity(1, { 2 }), entity(2, { 9, 3 }),
+    };
+
+    FilterVarIndex filterVars;
+    filterVars.ensure(objects);
+    EntityCounts counts;
+    counts.ensure(entities, filterVars);
+
+    QCOMPARE(counts.total(), 5);
+    QCOMPARE(counts.active(0xFF, 0), 5);
+    // filter 0 always shows, so does an object without a filter when it falls back to 0
+    QCOMPARE(counts.active(1, 0), 4);
+    QCOMPARE(counts.active(2, 0), 4);
+    QCOMPARE(counts.active(4, 0), 2);
+    // falling back to 0xFF the unfiltered entity shows whenever any bit is set
+    QCOMPARE(counts.active(4, 0xFF), 2);
+    QCOMPARE(counts.active(0, 0xFF), 1);
+}
+
+void TestEntityCounts::keptUntilInvalidated()
+{
+    QList<SceneObject> objects  = { object({ "filter" }) };
+    QList<SceneEntity> entities = { entity(0, { 1 }), entity(0, { 1 }) };
+
+    FilterVarIndex filterVars;
+    filterVars.ensure(objects);
+    EntityCounts counts;
+    counts.ensure(entities, filterVars);
+    QCOMPARE(counts.active(1, 0), 2);
+
+    // edited in place without telling it, so it's not looked at again, that's the point of it
+    entities[0].variables[0].value_uint8 = 2;
+    counts.ensure(entities, filterVars);
+    QCOMPARE(counts.active(1, 0), 2);
+
+    counts.invalidate();
+    counts.ensure(entities, filterVars);
+    QCOMPARE(counts.active(1, 0), 1);
+
+    // adding an entity is caught without invalidating
+    entities.append(entity(0, { 4 }));
+    counts.ensure(entities, filterVars);
+    QCOMPARE(counts.total(), 3);
+    QCOMPARE(counts.active(1, 0), 1);
+    QCOMPARE(counts.active(4, 0), 1);
+
+    // so is the filter variable changing
+    objects[0].variables[0].name = "type";
+    filterVars.invalidate();
+    filterVars.ensure(objects);
+    counts.ensure(entities, filterVars);
+    QCOMPARE(counts.active(4, 0), 3);
+}
+
+void TestEntityCounts::randomEditsMatchARecount()
+{
+    QRandomGenerator rng(32);
+
+    QList<SceneObject> objects = {
+        object({}),
+        object({ "filter" }),
+        object({ "type", "size", "filter" }),
+        object({ "type" }),
+    };
+    QList<SceneEntity> entities;
+
+    FilterVarIndex filterVars;
+    EntityCounts counts;
+    int sceneFilter = 0xFF;
+
+    for (int step = 0; step < 4000; ++step) {
+        switch (rng.bounded(6)) {
+            case 0:
+            case 1: {
+                byte type = rng.bounded(objects.count());
+                QList<byte> values;
+                for (int v = 0; v < objects[type].variables.count(); ++v)
+                    values.append(rng.bounded(0x100));
+                entities.append(entity(type, values));
+                break;
+            }
+
+            case 2:
+                if (!entities.isEmpty())
+                    entities.removeAt(rng.bounded(entities.count()));
+                break;
+
+            case 3:
+                // the property editor & updateType both invalidate after writing a value
+                if (!entities.isEmpty()) {
+                    auto &edited = entities[rng.bounded(entities.count())];
+                    if (!edited.variables.isEmpty()) {
+                        edited.variables[rng.bounded(edited.variables.count())].value_uint8 =
+                            rng.bounded(0x10);
+                        counts.invalidate();
+                    }
+                }
+                break;
+
+            case 4: sceneFilter ^= 1 << rng.bounded(8); break;
+
+            case 5: {
+                // renaming a variable to or from "filter", the game link does this on reload
+                auto &changed = objects[1 + rng.bounded(objects.count() - 1)];
+                auto &name    = changed.variables[rng.bounded(changed.variables.count())].name;
+
+                name = name == "filter" ? "other" : "filter";
+                filterVars.invalidate();
+                break;
+            }
+        }
+
+        filterVars.ensure(objects);
+        counts.ensure(entities, filterVars);
+
+        QCOMPARE(counts.total(), entities.count());
+        QCOMPARE(counts.active(sceneFilter, 0), recount(entities, filterVars, sceneFilter, 0));
+        QCOMPARE(counts.active(sceneFilter, 0xFF), recount(entities, filterVars, sceneFilter, 0xFF));
+    }
+}
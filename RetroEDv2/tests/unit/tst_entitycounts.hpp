@@ -0,0 +1,13 @@
+#pragma once
+
+#include <QtTest>
+
+class TestEntityCounts : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void countsBySceneFilter();
+    void keptUntilInvalidated();
+    void randomEditsMatchARecount();
+};
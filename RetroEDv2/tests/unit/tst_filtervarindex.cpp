@@ -0,0 +1,90 @@
+#include "tst_filtervarindex.hpp"
+#include "harness.hpp"
+
+#include "tools/utils/filtervarindex.hpp"
+
+static SceneObject object(const QStringList &variables)
+{
+    SceneObject info;
+    for (int v = 0; v < variables.count(); ++v)
+        info.variables.append(VariableInfo(variables[v], RSDKv5::UINT8, v));
+    return info;
+}
+
+static SceneEntity entity(byte type, const QList<byte> &values)
+{
+    SceneEntity info;
+    info.type = type;
+    for (byte value : values) {
+        RSDKv5::Scene::VariableValue variable;
+        variable.type        = RSDKv5::UINT8;
+        variable.value_uint8 = value;
+        info.variables.append(variable);
+    }
+    return info;
+}
+
+void TestFilterVarIndex::findsFilterVariables()
+{
+    QList<SceneObject> objects = {
+        object({}),
+        object({ "filter" }),
+        object({ "type", "size", "filter" }),
+        object({ "type", "filtered" }),
+    };
+
+    FilterVarIndex index;
+    index.ensure(objects);
+
+    QCOMPARE(index.find(0), -1);
+    QCOMPARE(index.find(1), 0);
+    QCOMPARE(index.find(2), 2);
+    QCOMPARE(index.find(3), -1);
+    QCOMPARE(index.find(4), -1);
+
+    QCOMPARE(index.filter(entity(1, { 5 }), 0xFF), 5);
+    QCOMPARE(index.filter(entity(2, { 1, 2, 3 }), 0xFF), 3);
+    QCOMPARE(index.filter(entity(3, { 1, 2 }), 0xFF), 0xFF);
+    // an entity that hasn't had its values filled in yet falls back too
+    QCOMPARE(index.filter(entity(2, { 1 }), 0), 0);
+}
+
+void TestFilterVarIndex::keptUntilInvalidated()
+{
+    QList<SceneObject> objects = { object({ "type" }), object({ "type", "size" }) };
+
+    FilterVarIndex index;
+    index.ensure(objects);
+    QCOMPARE(index.find(1), -1);
+
+    // the names aren't looked at again while it's valid, that's the point of it
+    objects[1].variables[1].name = "filter";
+    index.ensure(objects);
+    QCOMPARE(index.find(1), -1);
+
+    index.invalidate();
+    index.ensure(objects);
+    QCOMPARE(index.find(1), 1);
+
+    objects[1].variables.removeAt(0);
+    index.invalidate();
+    index.ensure(objects);
+    QCOMPARE(index.find(1), 0);
+}
+
+void TestFilterVarIndex::rebuiltWhenObjectsAreAddedOrRemoved()
+{
+    QList<SceneObject> objects = { object({ "type" }) };
+
+    FilterVarIndex index;
+    index.ensure(objects);
+
+    objects.append(object({ "filter" }));
+    index.ensure(objects);
+    QCOMPARE(index.find(1), 0);
+
+    objects.removeAt(0);
+    index.ensure(objects);
+    QCOMPARE(index.find(0), 0);
+    QCOMPARE(index.find(1), -1);
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <QtTest>
+
+class TestFilterVarIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void findsFilterVariables();
+    void keptUntilInvalidated();
+    void rebuiltWhenObjectsAreAddedOrRemoved();
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <QtTest>
+
+class TestFormats : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void roundTrip_data();
+    void roundTrip();
+
+    void truncated_data();
+    void truncated();
+
+    void emptyInput();
+    void regressions();
+};
@@ -0,0 +1,70 @@
+#include "tst_frameprofiler.hpp"
+#include "harness.hpp"
+
+void TestFrameProfiler::disabledScopesDontAllocate()
+{
+    if (!Harness::countsAllocations())
+        QSKIP("allocations aren't counted in this build");
+
+    FrameProfiler profiler;
+    QString layerName = "FG Low";
+
+    profiler.beginFrame();
+    Harness::AllocStats before = Harness::allocStats();
+    for (int i = 0; i < 1000; ++i) {
+        FrameProfiler::Scope scope(profiler, "drawScene", "Scene");
+        FrameProfiler::Scope layerScope(profiler, layerName, "Layer");
+        profiler.addCounter(FrameProfiler::COUNTER_DRAWCALLS, 1);
+    }
+    Harness::AllocStats after = Harness::allocStats();
+    profiler.endFrame();
+
+    QCOMPARE(after.count - before.count, 0ull);
+}
+
+void TestFrameProfiler::traceExport()
+{
+    FrameProfiler profiler;
+    profiler.setEnabled(true);
+
+    for (int f = 0; f < 3; ++f) {
+        profiler.beginFrame();
+        {
+            FrameProfiler::Scope scope(profiler, "drawScene", "Scene");
+            FrameProfiler::Scope layerScope(profiler, QString("FG Low"), "Layer");
+            profiler.addCounter(FrameProfiler::COUNTER_DRAWCALLS, 2);
+        }
+        profiler.endFrame();
+    }
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString path = dir.filePath("trace.json");
+    QVERIFY(profiler.exportTrace(path));
+
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    int frames = 0, scenes = 0, layers = 0, counters = 0;
+    for (auto value : doc.object()["traceEvents"].toArray()) {
+        QJsonObject event = value.toObject();
+        QString cat       = event["cat"].toString();
+        QString name      = event["name"].toString();
+        if (cat == "frame")
+            ++frames;
+        else if (cat == "Scene" && name == "drawScene")
+            ++scenes;
+        else if (cat == "Layer" && name == "FG Low")
+            ++layers;
+        else if (name == "Counters" && event["args"].toObject()["Draw Calls"].toInt() == 2)
+            ++counters;
+    }
+
+    QCOMPARE(frames, 3);
+    QCOMPARE(scenes, 3);
+    QCOMPARE(layers, 3);
+    QCOMPARE(counters, 3);
+}
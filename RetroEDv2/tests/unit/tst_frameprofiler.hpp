@@ -0,0 +1,12 @@
+#pragma once
+
+#include <QtTest>
+
+class TestFrameProfiler : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void disabledScopesDontAllocate();
+    void traceExport();
+};
@@ -0,0 +1,300 @@
+#include "tst_gamestorage.hpp"
+#include "harness.hpp"
+
+// each test gets its own reservations, the entry tables alone are too big to keep on the stack
+class Storages
+{
+public:
+    Storages() : sets(new DataStorage[DATASET_MAX]) { initStorage(sets.data()); }
+    ~Storages() { releaseStorage(sets.data()); }
+
+    inline DataStorage *data() { return sets.data(); }
+    inline DataStorage &operator[](int set) { return sets[set]; }
+
+    QByteArray bytes(StorageDataSets set)
+    {
+        return QByteArray((const char *)sets[set].memoryTable, sets[set].usedStorage * sizeof(int));
+    }
+
+private:
+    QScopedArrayPointer<DataStorage> sets;
+};
+
+static int *allocate(Storages &storages, uint size, int *&data, StorageDataSets set = DATASET_TMP)
+{
+    allocateStorage(storages.data(), size, (void **)&data, set, true);
+    return data;
+}
+
+static void fill(int *data, uint size, int value)
+{
+    for (uint i = 0; i < size / sizeof(int); ++i) data[i] = value + i;
+}
+
+static bool holds(const int *data, uint size, int value)
+{
+    for (uint i = 0; i < size / sizeof(int); ++i) {
+        if (data[i] != (int)(value + i))
+            return false;
+    }
+    return true;
+}
+
+void TestGameStorage::allocationsAreRoundedAndCleared()
+{
+    Storages storages;
+
+    int *data = nullptr;
+    QVERIFY(allocate(storages, 5, data));
+    QCOMPARE(data[0], 0);
+    QCOMPARE(data[1], 0);
+
+    DataStorageStats stats = getStorageStats(storages.data(), DATASET_TMP);
+    QCOMPARE(stats.usedBytes, (uint)(8 + STORAGE_HEADER_SIZE * sizeof(int)));
+    QCOMPARE(stats.liveBytes, stats.usedBytes);
+    QCOMPARE(stats.blockCount, 1u);
+    QCOMPARE(stats.entryCount, 1u);
+    QVERIFY(stats.committedBytes >= stats.usedBytes);
+}
+
+void TestGameStorage::statsLeaveTheHeadersAlone()
+{
+    Storages storages;
+
+    int *removed = nullptr, *moved = nullptr, *kept = nullptr;
+    allocate(storages, 0x40, removed);
+    allocate(storages, 0x40, moved);
+    allocate(storages, 0x40, kept);
+
+    removeStorageEntry(storages.data(), (void **)&removed);
+    int *stale = moved;
+    moved      = nullptr;
+
+    QByteArray before      = storages.bytes(DATASET_TMP);
+    DataStorageStats stats = getStorageStats(storages.data(), DATASET_TMP);
+    QVERIFY(storages.bytes(DATASET_TMP) == before);
+
+    QCOMPARE(stats.blockCount, 3u);
+    QCOMPARE(stats.liveBytes, (uint)(0x40 + STORAGE_HEADER_SIZE * sizeof(int)));
+    // the variable let go of it, but as far as the game's concerned the block's still active
+    QVERIFY(((DataStorageHeader *)(stale - STORAGE_HEADER_SIZE))->active);
+}
+
+void TestGameStorage::compactionKeepsLiveBlocks()
+{
+    Storages storages;
+
+    const int count = 64;
+    int *blocks[count];
+    for (int b = 0; b < count; ++b) {
+        allocate(storages, 0x10 + b * 4, blocks[b]);
+        fill(blocks[b], 0x10 + b * 4, b * 1000);
+    }
+
+    // every other block goes, half by removing the entry & half by pointing the variable elsewhere
+    uint liveBytes = 0;
+    for (int b = 0; b < count; ++b) {
+        if (b & 1) {
+            if (b & 2)
+                removeStorageEntry(storages.data(), (void **)&blocks[b]);
+            blocks[b] = nullptr;
+        }
+        else {
+            liveBytes += 0x10 + b * 4 + STORAGE_HEADER_SIZE * sizeof(int);
+        }
+    }
+
+    QCOMPARE(getStorageStats(storages.data(), DATASET_TMP).liveBytes, liveBytes);
+    clearUnusedStorage(storages.data(), DATASET_TMP);
+
+    DataStorageStats stats = getStorageStats(storages.data(), DATASET_TMP);
+    QCOMPARE(stats.usedBytes, liveBytes);
+    QCOMPARE(stats.liveBytes, liveBytes);
+    QCOMPARE(stats.blockCount, (uint)count / 2);
+    QCOMPARE(stats.fragmentation, 0.0f);
+
+    for (int b = 0; b < count; b += 2) QVERIFY(holds(blocks[b], 0x10 + b * 4, b * 1000));
+}
+
+void TestGameStorage::copiesKeepBlocksAlive()
+{
+    Storages storages;
+
+    int *first = nullptr, *copy = nullptr, *gap = nullptr;
+    allocate(storages, 0x20, gap);
+    allocate(storages, 0x20, first);
+    fill(first, 0x20, 7);
+    copyStorage(storages.data(), &copy, &first);
+    QCOMPARE(copy, first);
+
+    gap   = nullptr;
+    first = nullptr;
+    clearUnusedStorage(storages.data(), DATASET_TMP);
+
+    QCOMPARE(getStorageStats(storages.data(), DATASET_TMP).blockCount, 1u);
+    QCOMPARE(copy, storages[DATASET_TMP].memoryTable + STORAGE_HEADER_SIZE);
+    QVERIFY(holds(copy, 0x20, 7));
+}
+
+void TestGameStorage::fullEntryTablesAreCleaned()
+{
+    Storages storages;
+
+    QVector<int *> variables(STORAGE_ENTRY_COUNT, nullptr);
+    for (auto &variable : variables) QVERIFY(allocate(storages, 4, variable));
+    QCOMPARE(storages[DATASET_TMP].entryCount, (uint)STORAGE_ENTRY_COUNT);
+
+    int *extra = nullptr;
+    QVERIFY(!allocate(storages, 4, extra));
+
+    // once the variables are stale their entries can be dropped to make room
+    for (int v = 0; v < variables.count(); v += 2) variables[v] = nullptr;
+    QVERIFY(allocate(storages, 4, extra));
+    QCOMPARE(storages[DATASET_TMP].entryCount, (uint)STORAGE_ENTRY_COUNT / 2 + 1);
+}
+
+void TestGameStorage::compactionMakesRoom()
+{
+    Storages storages;
+
+    uint limit  = storages[DATASET_STR].storageLimit;
+    int *first  = nullptr;
+    int *second = nullptr;
+    QVERIFY(allocate(storages, limit / 2, first, DATASET_STR));
+    fill(first, limit / 2, 3);
+    QVERIFY(!allocate(storages, limit / 2, second, DATASET_STR));
+
+    first = nullptr;
+    QVERIFY(allocate(storages, limit / 2, second, DATASET_STR));
+    QCOMPARE(storages[DATASET_STR].clearCount, 2u);
+    QCOMPARE(getStorageStats(storages.data(), DATASET_STR).blockCount, 1u);
+
+    // cleared, not whatever the first block left behind
+    QCOMPARE(second[0], 0);
+}
+
+void TestGameStorage::randomUseMatchesAModel_data()
+{
+    QTest::addColumn<uint>("seed");
+
+    for (uint seed : { 1u, 2u, 3u }) QTest::newRow(qPrintable(QString("seed %1").arg(seed))) << seed;
+}
+
+// allocations, removals, variables let go of, copies & compactions in a random order, with the storage
+// checked against what each variable should point to after every step. compacting is left rare & the
+// blocks big so the set's limit has allocateStorage compact on its own too, while everything that's
+// live still fits
+void TestGameStorage::randomUseMatchesAModel()
+{
+    QFETCH(uint, seed);
+    QRandomGenerator rng(seed);
+
+    Storages storages;
+    DataStorage &storage = storages[DATASET_STR];
+    const uint header    = STORAGE_HEADER_SIZE * sizeof(int);
+
+    struct Block {
+        uint size = 0; // rounded up to whole ints
+        int value = 0;
+    };
+    QMap<int, Block> blocks; // every block in memory since the last compaction, by id
+    int nextID = 0;
+
+    // never resized, the storage holds on to their addresses
+    QVector<int *> variables(32, nullptr);
+    QVector<int> expected(variables.count(), -1); // block id per variable, -1 if it's null
+
+    // a compaction only keeps the blocks a variable still points to
+    auto compacted = [&] {
+        for (auto it = blocks.begin(); it != blocks.end();)
+            it = expected.contains(it.key()) ? std::next(it) : blocks.erase(it);
+    };
+
+    int ownCompactions = 0;
+    for (int step = 0; step < 2000; ++step) {
+        QString where = QString("step %1").arg(step);
+        int v         = rng.bounded(variables.count());
+        int action    = rng.bounded(0x100) ? rng.bounded(9) : 9;
+        uint clears   = storage.clearCount;
+
+        if (action < 4) {
+            // whatever the variable had is let go of before any compaction this sets off
+            uint size   = 1 + rng.bounded(0x8000);
+            expected[v] = -1;
+            QVERIFY2(allocate(storages, size, variables[v], DATASET_STR), qPrintable(where));
+            if (storage.clearCount != clears) {
+                compacted();
+                ++ownCompactions;
+            }
+
+            Block block;
+            block.size  = (size + 3) & ~3u;
+            block.value = nextID << 16;
+            fill(variables[v], block.size, block.value);
+            blocks.insert(nextID, block);
+            expected[v] = nextID++;
+        }
+        else if (action < 5) {
+            removeStorageEntry(storages.data(), (void **)&variables[v]);
+            variables[v] = nullptr;
+            expected[v]  = -1;
+        }
+        else if (action < 7) {
+            variables[v] = nullptr;
+            expected[v]  = -1;
+        }
+        else if (action < 9) {
+            int source = rng.bounded(variables.count());
+            if (variables[source]) {
+                copyStorage(storages.data(), &variables[v], &variables[source]);
+                expected[v] = expected[source];
+            }
+        }
+        else {
+            clearUnusedStorage(storages.data(), DATASET_STR);
+            compacted();
+        }
+
+        // every variable still sees its block's values & is tracked under its own address
+        QSet<int> counted;
+        uint liveBytes = 0;
+        for (int i = 0; i < variables.count(); ++i) {
+            if (expected[i] < 0) {
+                QVERIFY2(!variables[i], qPrintable(where));
+                continue;
+            }
+
+            const Block &block = blocks[expected[i]];
+            QVERIFY2(holds(variables[i], block.size, block.value), qPrintable(where));
+
+            auto slot = storage.entryLookup.constFind(&variables[i]);
+            QVERIFY2(slot != storage.entryLookup.cend(), qPrintable(where));
+            QVERIFY2(storage.storageEntries[slot.value()] == variables[i], qPrintable(where));
+
+            if (!counted.contains(expected[i])) {
+                counted.insert(expected[i]);
+                liveBytes += block.size + header;
+            }
+        }
+
+        uint usedBytes = 0;
+        for (auto &block : blocks) usedBytes += block.size + header;
+
+        DataStorageStats stats = getStorageStats(storages.data(), DATASET_STR);
+        QVERIFY2(stats.liveBytes == liveBytes, qPrintable(where));
+        QVERIFY2(stats.usedBytes == usedBytes, qPrintable(where));
+        QVERIFY2(stats.blockCount == (uint)blocks.count(), qPrintable(where));
+
+        // the lookup & the entry tables name the same variables, each at the slot it says
+        QVERIFY2((uint)storage.entryLookup.count() == storage.entryCount, qPrintable(where));
+        for (uint e = 0; e < storage.entryCount; ++e)
+            QVERIFY2(storage.entryLookup.value(storage.dataEntries[e], ~0u) == e, qPrintable(where));
+
+        // a compaction drops the stale entries along with their blocks
+        uint tracked = variables.count() - variables.count(nullptr);
+        if (storage.clearCount != clears)
+            QVERIFY2(storage.entryCount == tracked, qPrintable(where));
+    }
+
+    QVERIFY(ownCompactions > 0);
+}
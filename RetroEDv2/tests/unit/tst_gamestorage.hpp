@@ -0,0 +1,18 @@
+#pragma once
+
+#include <QtTest>
+
+class TestGameStorage : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void allocationsAreRoundedAndCleared();
+    void statsLeaveTheHeadersAlone();
+    void compactionKeepsLiveBlocks();
+    void copiesKeepBlocksAlive();
+    void fullEntryTablesAreCleaned();
+    void compactionMakesRoom();
+    void randomUseMatchesAModel_data();
+    void randomUseMatchesAModel();
+};
@@ -0,0 +1,320 @@
+#include "tst_gif.hpp"
+#include "harness.hpp"
+
+// the codec is checked against the textbook LZW below rather than stored files, that way every size &
+// code size can be covered & a failure points at the codec not at a fixture. the reference works a
+// code at a time, with a map for the dictionary & a string per entry, so it stays obviously right
+
+enum ImageKind { Noise, Gradient, Flat, Checker };
+
+struct ImageCase {
+    const char *name;
+    int width;
+    int height;
+    ImageKind kind;
+};
+
+static const ImageCase images[] = {
+    { "1x1", 1, 1, Noise },
+    { "odd width", 7, 3, Gradient },
+    { "tall & narrow", 13, 77, Checker },
+    { "one column", 1, 4096, Noise },
+    // long runs, so codes climb all the way to 4095 & the encoder has to clear
+    { "flat", 256, 256, Flat },
+    { "gradient", 320, 240, Gradient },
+    { "checker", 640, 480, Checker },
+    // nothing repeats, the dictionary fills every few thousand pixels
+    { "noise", 320, 240, Noise },
+};
+
+static FormatHelpers::Gif image(const ImageCase &source)
+{
+    QRandomGenerator rng(source.width * 31 + source.height);
+
+    FormatHelpers::Gif gif(source.width, source.height);
+    for (int c = 0; c < 0x100; ++c) gif.palette[c] = 0xFF000000 | rng.bounded(0x1000000);
+
+    byte *px = reinterpret_cast<byte *>(gif.pixels.data());
+    for (int y = 0; y < source.height; ++y) {
+        for (int x = 0; x < source.width; ++x) {
+            switch (source.kind) {
+                case Noise: *px++ = rng.bounded(0x100); break;
+                case Gradient: *px++ = x + y; break;
+                case Flat: *px++ = 5; break;
+                case Checker: *px++ = ((x / 8) ^ (y / 8)) * 17 + ((x * y) >> 6); break;
+            }
+        }
+    }
+    return gif;
+}
+
+static QByteArray maskedPixels(const FormatHelpers::Gif &gif, int codeSize)
+{
+    QByteArray pixels = gif.pixels;
+    for (char &px : pixels) px &= (1 << codeSize) - 1;
+    return pixels;
+}
+
+// the image data block: code size, the code stream in sub-blocks of up to 255 bytes & a terminator
+static QByteArray referenceEncode(const QByteArray &pixels, int codeSize)
+{
+    int clearCode = 1 << codeSize;
+    int eofCode   = clearCode + 1;
+    int nextCode  = eofCode + 1;
+    int codeBits  = codeSize + 1;
+
+    QByteArray stream;
+    uint bits    = 0;
+    int bitCount = 0;
+
+    auto put = [&](int code) {
+        bits |= (uint)code << bitCount;
+        bitCount += codeBits;
+        while (bitCount >= 8) {
+            stream.append((char)(bits & 0xFF));
+            bits >>= 8;
+            bitCount -= 8;
+        }
+
+        if (nextCode >= (1 << codeBits) && codeBits < 12)
+            ++codeBits;
+    };
+
+    QMap<uint, int> dictionary;
+    put(clearCode);
+
+    int mask = (1 << codeSize) - 1;
+    int cur  = (byte)pixels[0] & mask;
+    for (int p = 1; p < pixels.size(); ++p) {
+        int pixel = (byte)pixels[p] & mask;
+        uint key  = ((uint)cur << 8) | pixel;
+
+        auto entry = dictionary.constFind(key);
+        if (entry != dictionary.constEnd()) {
+            cur = entry.value();
+            continue;
+        }
+
+        put(cur);
+        cur = pixel;
+
+        if (nextCode >= 4095) {
+            put(clearCode);
+            dictionary.clear();
+            nextCode = eofCode + 1;
+            codeBits = codeSize + 1;
+        }
+        else {
+            dictionary.insert(key, nextCode++);
+        }
+    }
+    put(cur);
+    put(eofCode);
+    if (bitCount > 0)
+        stream.append((char)(bits & 0xFF));
+
+    QByteArray blocks(1, (char)codeSize);
+    for (int pos = 0; pos < stream.size(); pos += 0xFF) {
+        QByteArray block = stream.mid(pos, 0xFF);
+        blocks.append((char)block.size());
+        blocks.append(block);
+    }
+    blocks.append('\0');
+    return blocks;
+}
+
+static QByteArray referenceDecode(const QByteArray &blocks, int pixelCount)
+{
+    int codeSize = (byte)blocks[0];
+
+    QByteArray stream;
+    int pos = 1;
+    while (pos < blocks.size() && blocks[pos]) {
+        int size = (byte)blocks[pos++];
+        stream.append(blocks.mid(pos, size));
+        pos += size;
+    }
+
+    int clearCode = 1 << codeSize;
+    int eofCode   = clearCode + 1;
+    int nextCode  = eofCode + 1;
+    int codeBits  = codeSize + 1;
+
+    QVector<QByteArray> dictionary(4096);
+    for (int c = 0; c < clearCode; ++c) dictionary[c] = QByteArray(1, (char)c);
+
+    QByteArray pixels;
+    int prev       = -1;
+    qint64 bitPos  = 0;
+    qint64 bitSize = (qint64)stream.size() * 8;
+    while (bitPos + codeBits <= bitSize && pixels.size() < pixelCount) {
+        int code = 0;
+        for (int b = 0; b < codeBits; ++b, ++bitPos)
+            code |= (((byte)stream[(int)(bitPos >> 3)] >> (bitPos & 7)) & 1) << b;
+
+        if (code == clearCode) {
+            nextCode = eofCode + 1;
+            codeBits = codeSize + 1;
+            prev     = -1;
+            continue;
+        }
+        if (code == eofCode)
+            break;
+
+        QByteArray entry;
+        if (code < nextCode)
+            entry = dictionary[code];
+        else
+            entry = dictionary[prev] + dictionary[prev].left(1);
+
+        if (prev >= 0 && nextCode <= 4095) {
+            dictionary[nextCode] = dictionary[prev] + entry.left(1);
+            if (++nextCode == (1 << codeBits) && codeBits < 12)
+                ++codeBits;
+        }
+
+        pixels.append(entry);
+        prev = code;
+    }
+
+    pixels.resize(pixelCount);
+    return pixels;
+}
+
+// a whole file laid out the way Gif::write does it, plus the interlacing & smaller code sizes it never
+// writes itself
+static QByteArray referenceFile(const FormatHelpers::Gif &gif, int codeSize, bool useLocal,
+                                bool interlaced)
+{
+    int globalBits = useLocal ? 7 : codeSize;
+
+    QByteArray pixels = maskedPixels(gif, codeSize);
+    if (interlaced) {
+        const int initialRows[] = { 0, 4, 2, 1 };
+        const int rowInc[]      = { 8, 8, 4, 2 };
+
+        QByteArray rows;
+        for (int p = 0; p < 4; ++p) {
+            for (int y = initialRows[p]; y < gif.height; y += rowInc[p])
+                rows.append(pixels.mid(y * gif.width, gif.width));
+        }
+        pixels = rows;
+    }
+
+    auto writePalette = [&gif](Writer &writer, int first, int count) {
+        for (int c = first; c < first + count; ++c) {
+            writer.write<byte>(qRed(gif.palette[c]));
+            writer.write<byte>(qGreen(gif.palette[c]));
+            writer.write<byte>(qBlue(gif.palette[c]));
+        }
+    };
+
+    return Harness::writeBytes([&](Writer &writer) {
+        writer.write(QByteArray("GIF89a"));
+        writer.write<ushort>(gif.width);
+        writer.write<ushort>(gif.height);
+        writer.write<byte>(0x80 | ((globalBits - 1) << 4) | (globalBits - 1));
+        writer.write<byte>(0);
+        writer.write<byte>(0);
+        writePalette(writer, 0, 1 << globalBits);
+
+        writer.write<byte>(',');
+        writer.write<ushort>(0);
+        writer.write<ushort>(0);
+        writer.write<ushort>(gif.width);
+        writer.write<ushort>(gif.height);
+        writer.write<byte>((useLocal ? 0x80 | 6 : 0) | (interlaced ? 0x40 : 0));
+        if (useLocal)
+            writePalette(writer, 0x80, 0x80);
+
+        writer.write(referenceEncode(pixels, codeSize));
+        writer.write<byte>(';');
+    });
+}
+
+void TestGif::referenceIsLZW_data()
+{
+    QTest::addColumn<int>("index");
+    QTest::addColumn<int>("codeSize");
+
+    for (int i = 0; i < (int)(sizeof(images) / sizeof(images[0])); ++i) {
+        for (int codeSize : { 2, 4, 7, 8 })
+            QTest::addRow("%s, %d bit", images[i].name, codeSize) << i << codeSize;
+    }
+}
+
+void TestGif::referenceIsLZW()
+{
+    QFETCH(int, index);
+    QFETCH(int, codeSize);
+
+    // the checks below are only as good as the reference, so it has to undo itself first
+    FormatHelpers::Gif gif = image(images[index]);
+    QByteArray pixels      = maskedPixels(gif, codeSize);
+    QCOMPARE(referenceDecode(referenceEncode(pixels, codeSize), pixels.size()), pixels);
+}
+
+void TestGif::encodeMatchesReference_data()
+{
+    QTest::addColumn<int>("index");
+    QTest::addColumn<bool>("useLocal");
+
+    for (int i = 0; i < (int)(sizeof(images) / sizeof(images[0])); ++i) {
+        QTest::addRow("%s", images[i].name) << i << false;
+        QTest::addRow("%s, local palette", images[i].name) << i << true;
+    }
+}
+
+void TestGif::encodeMatchesReference()
+{
+    QFETCH(int, index);
+    QFETCH(bool, useLocal);
+
+    FormatHelpers::Gif gif = image(images[index]);
+    QByteArray written =
+        Harness::writeBytes([&gif, useLocal](Writer &writer) { gif.write(writer, false, useLocal); });
+    QByteArray expected = referenceFile(gif, useLocal ? 7 : 8, useLocal, false);
+
+    QCOMPARE(written.size(), expected.size());
+    QVERIFY(written == expected);
+}
+
+void TestGif::decodeMatchesReference_data()
+{
+    QTest::addColumn<int>("index");
+    QTest::addColumn<int>("codeSize");
+    QTest::addColumn<bool>("useLocal");
+    QTest::addColumn<bool>("interlaced");
+
+    for (int i = 0; i < (int)(sizeof(images) / sizeof(images[0])); ++i) {
+        for (bool interlaced : { false, true }) {
+            const char *order = interlaced ? "interlaced" : "linear";
+            for (int codeSize : { 2, 4, 8 })
+                QTest::addRow("%s, %d bit, %s", images[i].name, codeSize, order)
+                    << i << codeSize << false << interlaced;
+            QTest::addRow("%s, local palette, %s", images[i].name, order)
+                << i << 7 << true << interlaced;
+        }
+    }
+}
+
+void TestGif::decodeMatchesReference()
+{
+    QFETCH(int, index);
+    QFETCH(int, codeSize);
+    QFETCH(bool, useLocal);
+    QFETCH(bool, interlaced);
+
+    FormatHelpers::Gif source = image(images[index]);
+    Harness::MemoryReader memory(referenceFile(source, codeSize, useLocal, interlaced));
+
+    FormatHelpers::Gif gif;
+    gif.read(memory.reader);
+
+    QCOMPARE(gif.width, source.width);
+    QCOMPARE(gif.height, source.height);
+    QVERIFY(gif.pixels == maskedPixels(source, codeSize));
+
+    int colors = useLocal ? 0x100 : 1 << codeSize;
+    for (int c = 0; c < colors; ++c) QCOMPARE(gif.palette[c], source.palette[c]);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <QtTest>
+
+class TestGif : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void referenceIsLZW_data();
+    void referenceIsLZW();
+
+    void encodeMatchesReference_data();
+    void encodeMatchesReference();
+
+    void decodeMatchesReference_data();
+    void decodeMatchesReference();
+};
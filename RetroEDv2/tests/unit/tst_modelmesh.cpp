@@ -0,0 +1,105 @@
+#include "tst_modelmesh.hpp"
+#include "harness.hpp"
+
+#include "tools/utils/modelmesh.hpp"
+
+static RSDKv5::Model model(int faceVerts, const QList<ushort> &indices)
+{
+    RSDKv5::Model mdl;
+    mdl.faceVerticesCount = faceVerts;
+    mdl.indices           = indices;
+    return mdl;
+}
+
+static RSDKv5::Model::Frame frame(int vertexCount, float base)
+{
+    RSDKv5::Model::Frame frm;
+    for (int v = 0; v < vertexCount; ++v) {
+        RSDKv5::Model::Frame::Vertex vertex;
+        vertex.x  = base + v;
+        vertex.y  = base + v + 0.25f;
+        vertex.z  = base + v + 0.5f;
+        vertex.nx = -(base + v);
+        vertex.ny = -(base + v + 0.25f);
+        vertex.nz = -(base + v + 0.5f);
+        frm.vertices.append(vertex);
+    }
+    return frm;
+}
+
+void TestModelMesh::trianglesPassThrough()
+{
+    QList<ushort> indices = { 0, 3, 5, 2, 1, 4, 7, 6, 8 };
+    QCOMPARE(ModelMesh::triangulate(model(3, indices)), indices.toVector());
+}
+
+void TestModelMesh::quadsAreSplit()
+{
+    // each face becomes faceVerts - 1 triangles, all of them from the face's own vertices
+    QVector<ushort> quads = ModelMesh::triangulate(model(4, { 0, 3, 5, 4, 9, 8, 7, 6 }));
+    QCOMPARE(quads, QVector<ushort>({ 0, 3, 5, 3, 5, 4, 5, 4, 0, 9, 8, 7, 8, 7, 6, 7, 6, 9 }));
+
+    QVector<ushort> pentagon = ModelMesh::triangulate(model(5, { 1, 2, 3, 4, 5 }));
+    QCOMPARE(pentagon.count(), 4 * 3);
+    for (ushort index : pentagon) QVERIFY(index >= 1 && index <= 5);
+    for (ushort index : { 1, 2, 3, 4, 5 }) QVERIFY(pentagon.contains(index));
+}
+
+void TestModelMesh::partialFacesAreDropped()
+{
+    QCOMPARE(ModelMesh::triangulate(model(3, { 0, 1, 2, 3, 4 })), QVector<ushort>({ 0, 1, 2 }));
+    QCOMPARE(ModelMesh::triangulate(model(4, { 0, 1, 2 })), QVector<ushort>());
+    QCOMPARE(ModelMesh::triangulate(model(2, { 0, 1, 2, 3 })), QVector<ushort>());
+    QCOMPARE(ModelMesh::triangulate(model(3, {})), QVector<ushort>());
+}
+
+void TestModelMesh::framesArePackedAndPadded()
+{
+    RSDKv5::Model mdl;
+    mdl.frames = { frame(4, 0), frame(6, 100), frame(0, 200), frame(5, 300) };
+
+    int vc = ModelMesh::vertexCount(mdl);
+    QCOMPARE(vc, 6);
+
+    QVector<float> packed = ModelMesh::packFrames(mdl, vc);
+    QCOMPARE(packed.count(), mdl.frames.count() * vc * 6);
+
+    // frame f, vertex v lives at (f * vc + v) * 6, which is what paintGL points the attributes at
+    for (int f = 0; f < mdl.frames.count(); ++f) {
+        for (int v = 0; v < vc; ++v) {
+            const float *dst = packed.constData() + (f * vc + v) * 6;
+            if (v < mdl.frames[f].vertices.count()) {
+                auto &vertex = mdl.frames[f].vertices[v];
+                QCOMPARE(dst[0], vertex.x);
+                QCOMPARE(dst[1], vertex.y);
+                QCOMPARE(dst[2], vertex.z);
+                QCOMPARE(dst[3], vertex.nx);
+                QCOMPARE(dst[4], vertex.ny);
+                QCOMPARE(dst[5], vertex.nz);
+            }
+            else {
+                for (int c = 0; c < 6; ++c) QCOMPARE(dst[c], 0.0f);
+            }
+        }
+    }
+
+    QCOMPARE(ModelMesh::vertexCount(RSDKv5::Model()), 0);
+    QVERIFY(ModelMesh::packFrames(RSDKv5::Model(), 0).isEmpty());
+}
+
+void TestModelMesh::nextFrameLoops()
+{
+    QCOMPARE(ModelMesh::nextFrame(0, 4, 0), 1);
+    QCOMPARE(ModelMesh::nextFrame(2, 4, 0), 3);
+    QCOMPARE(ModelMesh::nextFrame(3, 4, 0), 0);
+    QCOMPARE(ModelMesh::nextFrame(3, 4, 2), 2);
+
+    // a loop point past the end holds on the last frame instead of reading past the list
+    QCOMPARE(ModelMesh::nextFrame(3, 4, 7), 3);
+    QCOMPARE(ModelMesh::nextFrame(3, 4, -1), 3);
+    QCOMPARE(ModelMesh::nextFrame(0, 1, 0), 0);
+
+    QCOMPARE(ModelMesh::nextFrame(-1, 4, 0), -1);
+    QCOMPARE(ModelMesh::nextFrame(4, 4, 0), -1);
+    QCOMPARE(ModelMesh::nextFrame(0, 0, 0), -1);
+}
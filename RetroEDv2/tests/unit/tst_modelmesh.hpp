@@ -0,0 +1,15 @@
+#pragma once
+
+#include <QtTest>
+
+class TestModelMesh : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void trianglesPassThrough();
+    void quadsAreSplit();
+    void partialFacesAreDropped();
+    void framesArePackedAndPadded();
+    void nextFrameLoops();
+};
@@ -0,0 +1,150 @@
+#include "tst_obj.hpp"
+#include "corpus.hpp"
+#include "harness.hpp"
+
+void TestOBJ::objectsAreFrames()
+{
+    FormatHelpers::OBJ obj;
+    QVERIFY(obj.read(Corpus::obj(3)));
+
+    QCOMPARE(obj.frames.count(), 3);
+    QCOMPARE(obj.vertexCount, 0x20 * 0x10);
+    QCOMPARE(obj.faceVerticesCount, 4);
+    QCOMPARE(obj.indices.count(), 0x1F * 0xF * 4);
+    QVERIFY(obj.hasNormals && obj.hasTextures && !obj.hasColors);
+
+    // every object's faces are indexed from the start of the file, they're taken back to the frame's
+    QCOMPARE(obj.indices.mid(0, 4), QVector<ushort>({ 0, 1, 0x21, 0x20 }));
+    QCOMPARE(obj.texCoords[0x21 * 2 + 0], 1 / 32.0f);
+    QCOMPARE(obj.texCoords[0x21 * 2 + 1], 1 / 16.0f);
+
+    for (auto &frame : obj.frames) {
+        QCOMPARE(frame.positions.count(), obj.vertexCount * 3);
+        QCOMPARE(frame.positions[0x21 * 3 + 0], 1.0f);
+        QCOMPARE(frame.positions[0x21 * 3 + 2], 1.0f);
+        QCOMPARE(frame.normals[0x21 * 3 + 1], 1.0f);
+    }
+
+    // the heights are random per frame
+    QVERIFY(obj.frames[0].positions != obj.frames[1].positions);
+}
+
+void TestOBJ::exportedFramesReadBack()
+{
+    RSDKv5::Model model;
+    model.hasNormals        = true;
+    model.hasTextures       = true;
+    model.faceVerticesCount = 3;
+    model.indices           = { 0, 1, 2, 2, 1, 3 };
+
+    for (int f = 0; f < 2; ++f) {
+        RSDKv5::Model::Frame frame;
+        for (int v = 0; v < 4; ++v) {
+            RSDKv5::Model::Frame::Vertex vertex;
+            vertex.x  = (v & 1) + f;
+            vertex.y  = 0.5f * f;
+            vertex.z  = v >> 1;
+            vertex.nx = 0;
+            vertex.ny = f ? -1 : 1;
+            vertex.nz = 0;
+            frame.vertices.append(vertex);
+        }
+        model.frames.append(frame);
+    }
+    for (int v = 0; v < 4; ++v) {
+        RSDKv5::Model::TexCoord texCoord;
+        texCoord.x = (v & 1) * 0.25f;
+        texCoord.y = (v >> 1) * 0.75f;
+        model.texCoords.append(texCoord);
+        model.colors.append(RSDKv5::Model::Color());
+    }
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    model.writeAsOBJ(dir.filePath("model.obj"));
+
+    // one file per frame, the way the editor's import takes them back
+    for (int f = 0; f < 2; ++f) {
+        RSDKv5::Model loaded;
+        loaded.loadOBJ(dir.filePath(QString("model Frame %1.obj").arg(f)));
+
+        QCOMPARE(loaded.frames.count(), 1);
+        QCOMPARE(loaded.indices, model.indices);
+        QCOMPARE(loaded.faceVerticesCount, (byte)3);
+        QVERIFY(loaded.hasNormals && loaded.hasTextures);
+
+        for (int v = 0; v < 4; ++v) {
+            auto &vertex   = loaded.frames[0].vertices[v];
+            auto &expected = model.frames[f].vertices[v];
+            QCOMPARE(vertex.x, expected.x);
+            QCOMPARE(vertex.y, expected.y);
+            QCOMPARE(vertex.z, expected.z);
+            QCOMPARE(vertex.ny, expected.ny);
+            QCOMPARE(loaded.texCoords[v].x, model.texCoords[v].x);
+            QCOMPARE(loaded.texCoords[v].y, model.texCoords[v].y);
+        }
+    }
+}
+
+void TestOBJ::cornersNameTheirOwnValues()
+{
+    QByteArray data = "v 0 0 0 1 0 0\n"
+                      "v 1 0 0 0 1 0\n"
+                      "v 1 1 0 0 0 1\n"
+                      "v 0 1 0 1 1 1\n"
+                      "v 0 2 0 0.5 0.5 0.5\n"
+                      "vt 0.25 0.5\n"
+                      "vn 0 0 1\n"
+                      "vn 0 0 -1\n"
+                      "# a pentagon, relative indices count back from the last value read\n"
+                      "f -5/1/2 -4//2 -3/-1/1 -2 -1/1\n";
+
+    FormatHelpers::OBJ obj;
+    QVERIFY(obj.read(data));
+    QCOMPARE(obj.frames.count(), 1);
+    QCOMPARE(obj.vertexCount, 5);
+
+    // the first face isn't a quad, so it's fanned into triangles
+    QCOMPARE(obj.faceVerticesCount, 3);
+    QCOMPARE(obj.indices, QVector<ushort>({ 0, 1, 2, 0, 2, 3, 0, 3, 4 }));
+
+    QVERIFY(obj.hasNormals && obj.hasTextures && obj.hasColors);
+    QCOMPARE(obj.frames[0].normals.mid(0, 9), QVector<float>({ 0, 0, -1, 0, 0, -1, 0, 0, 1 }));
+    QCOMPARE(obj.frames[0].normals.mid(9, 3), QVector<float>({ 0, 0, 0 }));
+    QCOMPARE(obj.texCoords.mid(0, 6), QVector<float>({ 0.25f, 0.5f, 0, 0, 0.25f, 0.5f }));
+    QCOMPARE(obj.texCoords.mid(8, 2), QVector<float>({ 0.25f, 0.5f }));
+
+    QCOMPARE(obj.colors.mid(0, 8), QVector<byte>({ 0xFF, 0, 0, 0xFF, 0, 0xFF, 0, 0xFF }));
+    QCOMPARE(obj.colors[4 * 4], (byte)127);
+}
+
+void TestOBJ::brokenFacesAreSkipped()
+{
+    QByteArray data = "o First\n"
+                      "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+                      "f 1 2 3 4\n"
+                      "f 1 2 9\n"   // past the vertices so far
+                      "f 0 1 2\n"   // obj counts from 1
+                      "f 1 2\n"     // not a face
+                      "f 4 x/2 1\n" // junk corner
+                      "f 2 3 4\n"
+                      "o Short\n"
+                      "v 0 0 0\n"
+                      "o Second\n"
+                      "v 0 0 1\nv 1 0 1\nv 1 1 1\nv 0 1 1\n"
+                      "f 6 7 8\n";
+
+    FormatHelpers::OBJ obj;
+    QVERIFY(obj.read(data));
+
+    // the object with a different count can't share the faces, the quad model keeps its triangle padded
+    QCOMPARE(obj.frames.count(), 2);
+    QCOMPARE(obj.frames[1].positions[2], 1.0f);
+    QCOMPARE(obj.faceVerticesCount, 4);
+    QCOMPARE(obj.indices, QVector<ushort>({ 0, 1, 2, 3, 1, 2, 3, 3 }));
+
+    // & nothing to read at all
+    QVERIFY(!obj.read(QByteArray("# empty\nf 1 2 3\n")));
+    QCOMPARE(obj.frames.count(), 0);
+    QVERIFY(obj.indices.isEmpty());
+}
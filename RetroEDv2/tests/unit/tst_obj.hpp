@@ -0,0 +1,14 @@
+#pragma once
+
+#include <QtTest>
+
+class TestOBJ : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void objectsAreFrames();
+    void exportedFramesReadBack();
+    void cornersNameTheirOwnValues();
+    void brokenFacesAreSkipped();
+};
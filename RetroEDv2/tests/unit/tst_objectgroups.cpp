@@ -0,0 +1,161 @@
+#include "tst_objectgroups.hpp"
+#include "harness.hpp"
+
+#include "tools/utils/objectgroups.hpp"
+
+// the same counts the scene viewer hands in, 16 draw layers & 0x104 type groups
+enum { DRAWGROUP_COUNT = 16, TYPEGROUP_COUNT = 0x104, FIRST_EXTRA_GROUP = 0x100 };
+
+struct Groups {
+    QVector<ushort> draw[DRAWGROUP_COUNT];
+    QVector<ushort> type[TYPEGROUP_COUNT];
+
+    ObjectGroups::Lists drawLists()
+    {
+        return [this](int g) -> QVector<ushort> & { return draw[g]; };
+    }
+    ObjectGroups::Lists typeLists()
+    {
+        return [this](int g) -> QVector<ushort> & { return type[g]; };
+    }
+
+    void update(ObjectGroups &groups)
+    {
+        groups.update(drawLists(), DRAWGROUP_COUNT, typeLists(), TYPEGROUP_COUNT);
+    }
+};
+
+// what processObjects used to do every frame, clear every list & append every slot back in
+static void rebuild(Groups &groups, const QVector<ObjectGroups::State> &states)
+{
+    for (auto &list : groups.draw) list.clear();
+    for (auto &list : groups.type) list.clear();
+
+    for (int e = 0; e < states.count(); ++e) {
+        const ObjectGroups::State &state = states[e];
+        if (state.drawGroup >= 0)
+            groups.draw[state.drawGroup].append(e);
+        if (state.classID >= 0) {
+            groups.type[0].append(e);
+            groups.type[state.classID].append(e);
+            if (state.group >= 0)
+                groups.type[state.group].append(e);
+        }
+    }
+}
+
+static ObjectGroups::State randomState(QRandomGenerator &rng)
+{
+    ObjectGroups::State state;
+    // culled & inactive entities are common, so plenty of -1s
+    state.drawGroup = rng.bounded(4) ? (short)rng.bounded(DRAWGROUP_COUNT) : -1;
+    if (rng.bounded(3)) {
+        state.classID = 1 + rng.bounded(0x20);
+        if (!rng.bounded(4))
+            state.group = FIRST_EXTRA_GROUP + rng.bounded(TYPEGROUP_COUNT - FIRST_EXTRA_GROUP);
+    }
+    return state;
+}
+
+static void compare(Groups &incremental, Groups &reference)
+{
+    for (int g = 0; g < DRAWGROUP_COUNT; ++g) QCOMPARE(incremental.draw[g], reference.draw[g]);
+    for (int g = 0; g < TYPEGROUP_COUNT; ++g) QCOMPARE(incremental.type[g], reference.type[g]);
+}
+
+void TestObjectGroups::firstUpdateBuildsEverything()
+{
+    QRandomGenerator rng(1);
+
+    ObjectGroups groups;
+    for (int e = 0; e < 500; ++e) groups.next.append(randomState(rng));
+
+    Groups incremental, reference;
+    incremental.update(groups);
+    rebuild(reference, groups.next);
+    compare(incremental, reference);
+}
+
+void TestObjectGroups::idleFramesChangeNothing()
+{
+    QRandomGenerator rng(2);
+
+    ObjectGroups groups;
+    for (int e = 0; e < 2000; ++e) groups.next.append(randomState(rng));
+
+    Groups lists;
+    lists.update(groups);
+
+    // nothing moved, so not even the list storage should be touched
+    const ushort *drawData = lists.draw[3].constData();
+    const ushort *typeData = lists.type[0].constData();
+    lists.update(groups);
+    QCOMPARE(lists.draw[3].constData(), drawData);
+    QCOMPARE(lists.type[0].constData(), typeData);
+}
+
+void TestObjectGroups::randomChangesMatchARebuild_data()
+{
+    QTest::addColumn<int>("entities");
+    QTest::addColumn<int>("changesPerFrame");
+
+    QTest::newRow("a few changes") << 2000 << 3;
+    QTest::newRow("half the scene") << 2000 << 1000;
+    QTest::newRow("tiny scene") << 4 << 2;
+}
+
+void TestObjectGroups::randomChangesMatchARebuild()
+{
+    QFETCH(int, entities);
+    QFETCH(int, changesPerFrame);
+
+    QRandomGenerator rng(entities + changesPerFrame);
+
+    ObjectGroups groups;
+    for (int e = 0; e < entities; ++e) groups.next.append(randomState(rng));
+
+    Groups incremental, reference;
+    for (int frame = 0; frame < 60; ++frame) {
+        for (int c = 0; c < changesPerFrame; ++c) {
+            ObjectGroups::State &state = groups.next[rng.bounded(groups.next.count())];
+            switch (rng.bounded(3)) {
+                case 0: state = randomState(rng); break;
+                // just the draw group, or just the type, so each half is checked on its own
+                case 1: state.drawGroup = rng.bounded(DRAWGROUP_COUNT); break;
+                case 2: state.classID = state.classID >= 0 ? -1 : 1 + rng.bounded(0x20); break;
+            }
+        }
+
+        // entities created or deleted now & then
+        if (!(frame % 20)) {
+            if (rng.bounded(2) && groups.next.count() > 1)
+                groups.next.removeAt(rng.bounded(groups.next.count()));
+            else
+                groups.next.insert(rng.bounded(groups.next.count() + 1), randomState(rng));
+        }
+
+        incremental.update(groups);
+        rebuild(reference, groups.next);
+        compare(incremental, reference);
+    }
+}
+
+void TestObjectGroups::resetDropsEverything()
+{
+    QRandomGenerator rng(3);
+
+    ObjectGroups groups;
+    for (int e = 0; e < 100; ++e) groups.next.append(randomState(rng));
+
+    Groups lists;
+    lists.update(groups);
+    groups.reset(lists.drawLists(), DRAWGROUP_COUNT, lists.typeLists(), TYPEGROUP_COUNT);
+    for (auto &list : lists.draw) QVERIFY(list.isEmpty());
+    for (auto &list : lists.type) QVERIFY(list.isEmpty());
+
+    // the same states again are a rebuild, not no change at all
+    Groups reference;
+    lists.update(groups);
+    rebuild(reference, groups.next);
+    compare(lists, reference);
+}
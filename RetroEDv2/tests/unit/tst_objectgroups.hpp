@@ -0,0 +1,15 @@
+#pragma once
+
+#include <QtTest>
+
+class TestObjectGroups : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void firstUpdateBuildsEverything();
+    void idleFramesChangeNothing();
+    void randomChangesMatchARebuild_data();
+    void randomChangesMatchARebuild();
+    void resetDropsEverything();
+};
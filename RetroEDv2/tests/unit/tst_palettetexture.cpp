@@ -0,0 +1,202 @@
+#include "tst_palettetexture.hpp"
+#include "harness.hpp"
+
+#include "tools/utils/palettetexture.hpp"
+
+// bake is what the shader's lookup has to come out as, so it's held to the image Qt converts the
+// indexed one to, which is what surfaces used to be uploaded as
+
+static QVector<QRgb> randomColors(QRandomGenerator &rng, int count, bool translucent)
+{
+    QVector<QRgb> colors;
+    for (int c = 0; c < count; ++c) {
+        QRgb color = 0xFF000000 | rng.bounded(0x1000000);
+        if (translucent && c % 3 == 0)
+            color = qRgba(qRed(color), qGreen(color), qBlue(color), rng.bounded(0x100));
+        colors.append(color);
+    }
+    return colors;
+}
+
+// a bank the way the engine keeps it, so every colour says where it started out
+static QVector<QRgb> bankColors(int bank)
+{
+    QVector<QRgb> colors;
+    for (int c = 0; c < PaletteTexture::COLOR_COUNT; ++c) colors.append(0xFF000000 | (bank << 16) | c);
+    return colors;
+}
+
+void TestPaletteTexture::bakeMatchesQt_data()
+{
+    QTest::addColumn<int>("colorCount");
+    QTest::addColumn<bool>("translucent");
+    QTest::addColumn<QSize>("size");
+
+    // no table is greyscale, a short one leaves the indices past it transparent
+    QTest::newRow("no table") << 0 << false << QSize(16, 16);
+    QTest::newRow("16 colours") << 16 << false << QSize(16, 16);
+    QTest::newRow("16 colours, translucent") << 16 << true << QSize(33, 7);
+    QTest::newRow("full table") << 0x100 << false << QSize(16, 0x400);
+    QTest::newRow("full table, translucent") << 0x100 << true << QSize(129, 65);
+    QTest::newRow("1 pixel") << 0x100 << false << QSize(1, 1);
+}
+
+void TestPaletteTexture::bakeMatchesQt()
+{
+    QFETCH(int, colorCount);
+    QFETCH(bool, translucent);
+    QFETCH(QSize, size);
+
+    QRandomGenerator rng(colorCount * 7 + size.width());
+
+    QImage image(size, QImage::Format_Indexed8);
+    image.setColorTable(randomColors(rng, colorCount, translucent));
+    for (int y = 0; y < size.height(); ++y) {
+        uchar *row = image.scanLine(y);
+        for (int x = 0; x < size.width(); ++x) row[x] = rng.bounded(0x100);
+    }
+
+    QByteArray indices;
+    QVector<QRgb> colors;
+    QVERIFY(PaletteTexture::splitImage(image, indices, colors));
+
+    QImage baked = PaletteTexture::bake((const uchar *)indices.constData(), size.width(), size.height(),
+                                        colors);
+    QImage expected = image.convertToFormat(QImage::Format_RGBA8888);
+
+    QCOMPARE(baked.size(), expected.size());
+    QCOMPARE(baked.format(), expected.format());
+    for (int y = 0; y < size.height(); ++y)
+        QVERIFY(!memcmp(baked.constScanLine(y), expected.constScanLine(y), size.width() * 4));
+}
+
+void TestPaletteTexture::splitPacksTheRows()
+{
+    // an odd width, so every scanline of the image is padded
+    QImage image(5, 3, QImage::Format_Indexed8);
+    image.setColorTable({ 0xFFFF00FF, 0xFF000000 });
+    QVERIFY(image.bytesPerLine() > image.width());
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x) image.scanLine(y)[x] = y * image.width() + x;
+    }
+
+    QByteArray indices;
+    QVector<QRgb> colors;
+    QVERIFY(PaletteTexture::splitImage(image, indices, colors));
+    QCOMPARE(indices.size(), 15);
+    for (int i = 0; i < indices.size(); ++i) QCOMPARE((int)(uchar)indices[i], i);
+    QCOMPARE(colors, image.colorTable());
+
+    // full rows, padded out to 256
+    QVector<QRgb> row = PaletteTexture::lookupRow(colors);
+    QCOMPARE(row.count(), (int)PaletteTexture::COLOR_COUNT);
+    QCOMPARE(row.mid(0, 2), colors);
+    QCOMPARE(row[2], 0u);
+
+    QVERIFY(!PaletteTexture::splitImage(image.convertToFormat(QImage::Format_ARGB32), indices, colors));
+}
+
+void TestPaletteTexture::copyMatchesTheEngine_data()
+{
+    QTest::addColumn<int>("srcBank");
+    QTest::addColumn<int>("srcStart");
+    QTest::addColumn<int>("dstBank");
+    QTest::addColumn<int>("dstStart");
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("a row") << 1 << 0x10 << 2 << 0x20 << 0x10;
+    QTest::newRow("whole bank") << 3 << 0 << 0 << 0 << 0x100;
+    // the indices are bytes, so they wrap around rather than stop at the end of the bank
+    QTest::newRow("source wraps") << 1 << 0xF8 << 2 << 0x00 << 0x10;
+    QTest::newRow("destination wraps") << 1 << 0x00 << 2 << 0xF0 << 0x20;
+    QTest::newRow("more than a bank") << 1 << 0x80 << 2 << 0x40 << 0x180;
+    // one colour at a time front to back, so copying up within a bank repeats the first few
+    QTest::newRow("overlap, forwards") << 4 << 0x10 << 4 << 0x14 << 0x20;
+    QTest::newRow("overlap, backwards") << 4 << 0x14 << 4 << 0x10 << 0x20;
+    QTest::newRow("nothing") << 1 << 0 << 2 << 0 << 0;
+}
+
+void TestPaletteTexture::copyMatchesTheEngine()
+{
+    QFETCH(int, srcBank);
+    QFETCH(int, srcStart);
+    QFETCH(int, dstBank);
+    QFETCH(int, dstStart);
+    QFETCH(int, count);
+
+    const int banks = 8;
+
+    PaletteTexture texture(banks);
+    QVector<QVector<QRgb>> reference;
+    for (int b = 0; b < banks; ++b) {
+        texture.setRow(b, bankColors(b));
+        reference.append(bankColors(b));
+    }
+
+    // RSDKv5's CopyPalette
+    for (int i = 0; i < count; ++i)
+        reference[dstBank][(byte)(dstStart + i)] = reference[srcBank][(byte)(srcStart + i)];
+
+    texture.copyColors(srcBank, srcStart, dstBank, dstStart, count);
+    for (int b = 0; b < banks; ++b) QCOMPARE(texture.getRow(b), reference[b]);
+}
+
+void TestPaletteTexture::rotateMatchesTheEngine()
+{
+    QRandomGenerator rng(5);
+    for (int i = 0; i < 200; ++i) {
+        int start  = rng.bounded(PaletteTexture::COLOR_COUNT);
+        int end    = start + rng.bounded(PaletteTexture::COLOR_COUNT - start);
+        bool right = rng.bounded(2);
+
+        PaletteTexture texture(1);
+        texture.setRow(0, bankColors(0));
+        QVector<QRgb> reference = bankColors(0);
+
+        // RSDKv5's RotatePalette
+        if (right) {
+            QRgb last = reference[end];
+            for (int c = end; c > start; --c) reference[c] = reference[c - 1];
+            reference[start] = last;
+        }
+        else {
+            QRgb first = reference[start];
+            for (int c = start; c < end; ++c) reference[c] = reference[c + 1];
+            reference[end] = first;
+        }
+
+        texture.rotate(0, start, end, right);
+        QCOMPARE(texture.getRow(0), reference);
+    }
+}
+
+void TestPaletteTexture::onlyChangesAreDirty()
+{
+    PaletteTexture texture(2);
+    QVERIFY(texture.isDirty()); // a new texture has to go up once
+    texture.clearDirty();
+
+    texture.setRow(1, bankColors(1));
+    QVERIFY(texture.isDirty());
+    texture.clearDirty();
+
+    // the same colours again don't need another upload
+    texture.setRow(1, bankColors(1));
+    texture.setColor(1, 5, texture.getColor(1, 5));
+    QVERIFY(!texture.isDirty());
+
+    // & bad rows or indices are ignored
+    texture.setRow(2, bankColors(2));
+    texture.setColor(0, PaletteTexture::COLOR_COUNT, 0xFFFFFFFF);
+    texture.setColor(-1, 0, 0xFFFFFFFF);
+    QVERIFY(!texture.isDirty());
+
+    texture.setColor(0, 3, 0xFF123456);
+    QVERIFY(texture.isDirty());
+    QCOMPARE(texture.getColor(0, 3), 0xFF123456u);
+
+    // whatever's there gets uploaded again, eg into a texture that's just been recreated
+    texture.clearDirty();
+    texture.markDirty();
+    QVERIFY(texture.isDirty());
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <QtTest>
+
+class TestPaletteTexture : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void bakeMatchesQt_data();
+    void bakeMatchesQt();
+    void splitPacksTheRows();
+
+    void copyMatchesTheEngine_data();
+    void copyMatchesTheEngine();
+    void rotateMatchesTheEngine();
+
+    void onlyChangesAreDirty();
+};
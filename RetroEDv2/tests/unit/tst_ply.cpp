@@ -0,0 +1,104 @@
+#include "tst_ply.hpp"
+#include "corpus.hpp"
+#include "harness.hpp"
+
+static QByteArray header(const QByteArray &format, const QByteArray &elements)
+{
+    return "ply\nformat " + format + " 1.0\n" + elements + "end_header\n";
+}
+
+void TestPLY::formatsReadTheSame()
+{
+    FormatHelpers::PLY little, big, ascii;
+    QVERIFY(little.read(Corpus::ply(2, "binary_little_endian")));
+    QVERIFY(big.read(Corpus::ply(2, "binary_big_endian")));
+    QVERIFY(ascii.read(Corpus::ply(2, "ascii")));
+
+    QCOMPARE(little.vertexCount, 0x20 * 0x20);
+    QCOMPARE(little.faceVerticesCount, 4);
+    QCOMPARE(little.indices.count(), 0x1F * 0x1F * 4);
+    QVERIFY(little.hasNormals && little.hasTextures && little.hasColors);
+
+    for (FormatHelpers::PLY *ply : { &big, &ascii }) {
+        QCOMPARE(ply->vertexCount, little.vertexCount);
+        QCOMPARE(ply->faceVerticesCount, little.faceVerticesCount);
+        QCOMPARE(ply->indices, little.indices);
+        QCOMPARE(ply->colors, little.colors);
+        QCOMPARE(ply->hasNormals, little.hasNormals);
+        QCOMPARE(ply->hasTextures, little.hasTextures);
+        QCOMPARE(ply->hasColors, little.hasColors);
+    }
+
+    // binary is exact either way round, ascii only has the 7 digits the corpus writes
+    QCOMPARE(big.positions, little.positions);
+    QCOMPARE(big.normals, little.normals);
+    QCOMPARE(big.texCoords, little.texCoords);
+    for (int i = 0; i < little.positions.count(); ++i)
+        QVERIFY(qAbs(ascii.positions[i] - little.positions[i]) < 1e-4f);
+    for (int i = 0; i < little.texCoords.count(); ++i)
+        QVERIFY(qAbs(ascii.texCoords[i] - little.texCoords[i]) < 1e-4f);
+}
+
+void TestPLY::unknownBinaryTypesFail()
+{
+    // a binary value with no known size can't be skipped, so nothing after it would line up
+    QByteArray vertex   = "element vertex 1\nproperty float x\nproperty int24 weight\n";
+    QByteArray sizeType = "element face 1\nproperty list int24 uint vertex_indices\n";
+    QByteArray itemType = "element face 1\nproperty list uchar int24 vertex_indices\n";
+
+    for (const QByteArray &elements : { vertex, sizeType, itemType }) {
+        FormatHelpers::PLY ply;
+        QVERIFY(!ply.read(header("binary_little_endian", elements) + QByteArray(0x20, '\1')));
+        QCOMPARE(ply.vertexCount, 0);
+        QVERIFY(ply.indices.isEmpty());
+    }
+
+    // ascii values are split by whitespace, the type isn't needed to get past one
+    FormatHelpers::PLY ply;
+    QVERIFY(ply.read(header("ascii", vertex) + "1.5 7\n"));
+    QCOMPARE(ply.vertexCount, 1);
+    QCOMPARE(ply.positions[0], 1.5f);
+}
+
+void TestPLY::countsAreClampedToTheFile()
+{
+    // 3 floats of data for 2 billion vertices
+    FormatHelpers::PLY binary;
+    QByteArray elements = "element vertex 2000000000\nproperty float x\nproperty float y\n";
+    QVERIFY(binary.read(header("binary_little_endian", elements) + QByteArray(12, '\0')));
+    QCOMPARE(binary.vertexCount, 1);
+    QCOMPARE(binary.positions.count(), 3);
+    QCOMPARE(binary.colors.count(), 4);
+
+    // "1 2 3" is the smallest 3 values can be
+    FormatHelpers::PLY ascii;
+    elements = "element vertex 2000000000\nproperty float x\n";
+    QVERIFY(ascii.read(header("ascii", elements) + "1 2 3"));
+    QCOMPARE(ascii.vertexCount, 3);
+    QCOMPARE(ascii.positions.count(), 9);
+    QCOMPARE(ascii.positions[6], 3.0f);
+
+    // with no properties at all a vertex takes nothing, it still can't outnumber the bytes left
+    FormatHelpers::PLY empty;
+    QVERIFY(empty.read(header("binary_little_endian", "element vertex 2147483647\n") + "abcd"));
+    QVERIFY(empty.vertexCount <= 4);
+
+    // & faces can't reserve more than the file could hold either
+    FormatHelpers::PLY faces;
+    elements = "element face 2000000000\nproperty list uchar ushort vertex_indices\n";
+    QByteArray face("\3\0\0\1\0\2\0", 7);
+    QVERIFY(faces.read(header("binary_little_endian", elements) + face));
+    QCOMPARE(faces.indices, QVector<ushort>({ 0, 1, 2 }));
+    QCOMPARE(faces.faceVerticesCount, 3);
+
+    // nor can a list's own size, these used to loop (& append) 0x7FFFFFFF times
+    elements = "element face 1\nproperty list uint ushort vertex_indices\n";
+    FormatHelpers::PLY list;
+    QByteArray longFace("\xFF\xFF\xFF\x7F\1\0\2\0", 8);
+    QVERIFY(list.read(header("binary_little_endian", elements) + longFace));
+    QCOMPARE(list.indices, QVector<ushort>({ 1, 2 }));
+
+    FormatHelpers::PLY asciiList;
+    QVERIFY(asciiList.read(header("ascii", elements) + "2147483647 1 2\n"));
+    QCOMPARE(asciiList.indices, QVector<ushort>({ 1, 2 }));
+}
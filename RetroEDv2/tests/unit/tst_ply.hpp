@@ -0,0 +1,13 @@
+#pragma once
+
+#include <QtTest>
+
+class TestPLY : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void formatsReadTheSame();
+    void unknownBinaryTypesFail();
+    void countsAreClampedToTheFile();
+};
@@ -0,0 +1,197 @@
+#include "tst_quantizer.hpp"
+#include "harness.hpp"
+
+#include <RSDKLegacy.hpp>
+
+// indexed & few colour images have to come out untouched, so those are checked exactly. anything the
+// quantizer has to approximate goes through the 6 bit lookup, which is checked against a plain scan of
+// the palette at the same precision
+
+// no repeats & never the magenta toIndexed puts in front, so every colour has exactly one index
+static QVector<QRgb> randomPalette(QRandomGenerator &rng, int count)
+{
+    QVector<QRgb> palette;
+    while (palette.count() < count) {
+        QRgb color = 0xFF000000 | rng.bounded(0x1000000);
+        if (color != qRgb(0xFF, 0x00, 0xFF) && !palette.contains(color))
+            palette.append(color);
+    }
+    return palette;
+}
+
+static QImage indexedImage(int width, int height, const QVector<QRgb> &palette, quint32 seed)
+{
+    QRandomGenerator rng(seed);
+
+    QImage image(width, height, QImage::Format_Indexed8);
+    image.setColorTable(palette);
+    for (int y = 0; y < height; ++y) {
+        uchar *line = image.scanLine(y);
+        for (int x = 0; x < width; ++x) line[x] = rng.bounded(palette.count());
+    }
+    return image;
+}
+
+static QByteArray imagePixels(const QImage &image)
+{
+    QByteArray pixels;
+    for (int y = 0; y < image.height(); ++y)
+        pixels.append((const char *)image.constScanLine(y), image.width());
+    return pixels;
+}
+
+// the same colour expansion & weights the lookup is built with
+static int nearest(QRgb color, const QVector<QRgb> &palette, int skipIndex)
+{
+    int r = qRed(color) >> 2, g = qGreen(color) >> 2, b = qBlue(color) >> 2;
+    r = (r << 2) | (r >> 4);
+    g = (g << 2) | (g >> 4);
+    b = (b << 2) | (b >> 4);
+
+    int best     = 0;
+    int bestDist = std::numeric_limits<int>::max();
+    for (int i = 0; i < palette.count(); ++i) {
+        if (i == skipIndex)
+            continue;
+
+        int dr   = r - qRed(palette[i]);
+        int dg   = g - qGreen(palette[i]);
+        int db   = b - qBlue(palette[i]);
+        int dist = dr * dr * 3 + dg * dg * 4 + db * db * 2;
+        if (dist < bestDist) {
+            bestDist = dist;
+            best     = i;
+        }
+    }
+    return best;
+}
+
+void TestQuantizer::indexedKeepsItsPalette_data()
+{
+    QTest::addColumn<int>("colors");
+    QTest::addColumn<int>("width");
+
+    QTest::newRow("2 colours") << 2 << 64;
+    QTest::newRow("16 colours, odd width") << 16 << 37;
+    QTest::newRow("255 colours") << 255 << 256;
+}
+
+void TestQuantizer::indexedKeepsItsPalette()
+{
+    QFETCH(int, colors);
+    QFETCH(int, width);
+
+    QRandomGenerator rng(colors);
+    QVector<QRgb> palette = randomPalette(rng, colors);
+    // repeats have to keep their own indices too, they're often there on purpose
+    palette[colors - 1] = palette[0];
+
+    QImage image = indexedImage(width, 48, palette, colors);
+
+    QVector<QRgb> result;
+    QByteArray pixels = Quantizer::toIndexed(image, result, 0xFF);
+    QCOMPARE(result, palette);
+    QVERIFY(pixels == imagePixels(image));
+}
+
+void TestQuantizer::gfxImportKeepsThePalette()
+{
+    QRandomGenerator rng(7);
+    QVector<QRgb> palette = randomPalette(rng, 200);
+    QImage image          = indexedImage(128, 96, palette, 7);
+
+    RSDKv3::GFX gfx;
+    gfx.importImage(image);
+    QImage exported = gfx.exportImage();
+
+    QCOMPARE(exported.size(), image.size());
+    QCOMPARE(exported.colorTable().mid(0, palette.count()), palette);
+    QVERIFY(imagePixels(exported) == imagePixels(image));
+}
+
+void TestQuantizer::fewColoursAreKeptExactly()
+{
+    QRandomGenerator rng(3);
+    QVector<QRgb> colors = randomPalette(rng, 254);
+
+    QImage image(200, 100, QImage::Format_ARGB32);
+    for (int y = 0; y < image.height(); ++y) {
+        QRgb *line = (QRgb *)image.scanLine(y);
+        for (int x = 0; x < image.width(); ++x) line[x] = colors[rng.bounded(colors.count())];
+    }
+
+    QVector<QRgb> palette;
+    QByteArray pixels = Quantizer::toIndexed(image, palette, 0xFF);
+    QCOMPARE(palette.count(), colors.count() + 1);
+
+    for (int y = 0, i = 0; y < image.height(); ++y) {
+        const QRgb *line = (const QRgb *)image.constScanLine(y);
+        for (int x = 0; x < image.width(); ++x, ++i) {
+            byte index = pixels[i];
+            QVERIFY(index != 0);
+            QCOMPARE(palette[index], line[x]);
+        }
+    }
+}
+
+void TestQuantizer::paletteColoursMapExactly()
+{
+    QRandomGenerator rng(5);
+    QVector<QRgb> palette = randomPalette(rng, 0x100);
+
+    QImage image(256, 64, QImage::Format_RGB32);
+    QByteArray expected;
+    for (int y = 0; y < image.height(); ++y) {
+        QRgb *line = (QRgb *)image.scanLine(y);
+        for (int x = 0; x < image.width(); ++x) {
+            int index = 1 + rng.bounded(0xFF);
+            line[x]   = palette[index];
+            expected.append((char)index);
+        }
+    }
+
+    // dithering only nudges the colours that aren't in the palette
+    QVERIFY(Quantizer::remap(image, palette, 0) == expected);
+    QVERIFY(Quantizer::remap(image, palette, 0, true) == expected);
+}
+
+void TestQuantizer::nearestMatchesAScan()
+{
+    QRandomGenerator rng(11);
+    QVector<QRgb> palette = randomPalette(rng, 64);
+
+    QImage image(128, 128, QImage::Format_RGB32);
+    for (int y = 0; y < image.height(); ++y) {
+        QRgb *line = (QRgb *)image.scanLine(y);
+        for (int x = 0; x < image.width(); ++x) line[x] = 0xFF000000 | rng.bounded(0x1000000);
+    }
+
+    QByteArray pixels = Quantizer::remap(image, palette, 0);
+    for (int y = 0, i = 0; y < image.height(); ++y) {
+        const QRgb *line = (const QRgb *)image.constScanLine(y);
+        for (int x = 0; x < image.width(); ++x, ++i) {
+            // a random colour can still land on a palette one exactly, that's matched as-is
+            if (palette.indexOf(line[x]) > 0)
+                continue;
+            QCOMPARE((byte)pixels[i], (byte)nearest(line[x], palette, 0));
+        }
+    }
+}
+
+void TestQuantizer::transparencyOnlyForTranslucentPixels()
+{
+    QVector<QRgb> palette = { qRgb(0xFF, 0x00, 0xFF), qRgb(0, 0, 0), qRgb(0xFF, 0xFF, 0xFF) };
+
+    QImage image(4, 1, QImage::Format_ARGB32);
+    QRgb *line = (QRgb *)image.scanLine(0);
+    line[0]    = qRgba(0xFF, 0x00, 0xFF, 0xFF); // opaque but the transparent colour
+    line[1]    = qRgba(0xFF, 0xFF, 0xFF, 0x7F);
+    line[2]    = qRgba(0x00, 0x00, 0x00, 0x80);
+    line[3]    = qRgba(0x00, 0x00, 0x00, 0x00);
+
+    QByteArray pixels = Quantizer::remap(image, palette, 0);
+    QVERIFY(pixels[0] != 0);
+    QCOMPARE((int)pixels[1], 0);
+    QCOMPARE((int)pixels[2], 1);
+    QCOMPARE((int)pixels[3], 0);
+}
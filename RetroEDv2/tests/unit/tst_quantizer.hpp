@@ -0,0 +1,18 @@
+#pragma once
+
+#include <QtTest>
+
+class TestQuantizer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void indexedKeepsItsPalette_data();
+    void indexedKeepsItsPalette();
+    void gfxImportKeepsThePalette();
+
+    void fewColoursAreKeptExactly();
+    void paletteColoursMapExactly();
+    void nearestMatchesAScan();
+    void transparencyOnlyForTranslucentPixels();
+};
@@ -0,0 +1,109 @@
+#include "tst_replayv5.hpp"
+#include "corpus.hpp"
+#include "harness.hpp"
+
+#include <RSDKv5.hpp>
+
+typedef RSDKv5::Replay::FrameColumns FrameColumns;
+
+static bool sameFrames(const FrameColumns &a, const FrameColumns &b)
+{
+    return a.info == b.info && a.flags == b.flags && a.inputs == b.inputs && a.direction == b.direction
+           && a.position == b.position && a.velocity == b.velocity && a.rotation == b.rotation
+           && a.anim == b.anim && a.frame == b.frame;
+}
+
+void TestReplayV5::longReplaysRoundTrip_data()
+{
+    QTest::addColumn<bool>("packed");
+
+    QTest::newRow("packed") << true;
+    QTest::newRow("unpacked") << false;
+}
+
+void TestReplayV5::longReplaysRoundTrip()
+{
+    QFETCH(bool, packed);
+
+    // 2 hours at 60fps
+    QByteArray data = Corpus::replayV5(120, packed);
+
+    Harness::MemoryReader memory(data);
+    RSDKv5::Replay replay;
+    replay.read(memory.reader);
+    QCOMPARE(replay.frames.count(), 120 * 60 * 60);
+    QCOMPARE(replay.frameCount(), replay.frames.count());
+
+    QByteArray written = Harness::writeBytes([&replay](Writer &writer) { replay.write(writer); });
+    QCOMPARE(written.size(), data.size());
+    QVERIFY(written == data);
+}
+
+void TestReplayV5::openedMatchesRead()
+{
+    QByteArray data = Corpus::replayV5(10);
+
+    Harness::MemoryReader readMemory(data);
+    RSDKv5::Replay read;
+    read.read(readMemory.reader);
+
+    Harness::MemoryReader openMemory(data);
+    RSDKv5::Replay opened;
+    QVERIFY(opened.open(openMemory.reader));
+    QVERIFY(opened.frames.count() == 0);
+    QCOMPARE(opened.frameCount(), read.frames.count());
+
+    // windows that start on, just before & just after seek points, plus the very end
+    int last = opened.frameCount();
+    for (int start : { 0, 0xFF, 0x100, 0x101, 0x1234, last / 2, last - 0x10 }) {
+        FrameColumns window = opened.decodeFrames(start, 0x180);
+        QCOMPARE(window.count(), qMin(0x180, last - start));
+        QVERIFY(sameFrames(window, read.frames.mid(start, 0x180)));
+    }
+
+    QCOMPARE(opened.decodeFrames(last, 0x10).count(), 0);
+    QCOMPARE(opened.decodeFrame(last - 1).position, read.frames.position.last());
+}
+
+void TestReplayV5::readKeepsOnlyDecodedFrames()
+{
+    QByteArray data = Corpus::replayV5(2);
+
+    Harness::MemoryReader memory(data);
+    RSDKv5::Replay replay;
+    replay.read(memory.reader);
+
+    // everything's in frames already, holding the inflated stream as well would double the memory
+    QVERIFY(!replay.isStreamed());
+
+    // the same queries still work, they're answered from frames instead
+    QCOMPARE(replay.frameCount(), replay.frames.count());
+    QVERIFY(sameFrames(replay.decodeFrames(0x300, 0x40), replay.frames.mid(0x300, 0x40)));
+
+    Harness::MemoryReader openMemory(data);
+    RSDKv5::Replay opened;
+    opened.open(openMemory.reader);
+    QVERIFY(opened.isStreamed());
+}
+
+void TestReplayV5::windowsDecodeInBoundedMemory()
+{
+    if (!Harness::countsAllocations())
+        QSKIP("allocations aren't counted in this build");
+
+    QByteArray data = Corpus::replayV5(120);
+
+    Harness::MemoryReader memory(data);
+    RSDKv5::Replay replay;
+    QVERIFY(replay.open(memory.reader));
+
+    // decoding starts at the nearest seek point, so a window costs the same anywhere in the replay
+    for (int start : { 0, replay.frameCount() / 2, replay.frameCount() - 0x100 }) {
+        Harness::AllocStats before = Harness::allocStats();
+        FrameColumns window        = replay.decodeFrames(start, 0x100);
+        Harness::AllocStats after  = Harness::allocStats();
+
+        QCOMPARE(window.count(), 0x100);
+        QVERIFY(after.bytes - before.bytes < 0x10000);
+    }
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <QtTest>
+
+class TestReplayV5 : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void longReplaysRoundTrip_data();
+    void longReplaysRoundTrip();
+    void openedMatchesRead();
+    void readKeepsOnlyDecodedFrames();
+    void windowsDecodeInBoundedMemory();
+};
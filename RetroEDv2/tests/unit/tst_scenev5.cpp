@@ -0,0 +1,185 @@
+#include "tst_scenev5.hpp"
+#include "corpus.hpp"
+#include "harness.hpp"
+
+#include <RSDKv5.hpp>
+
+void TestSceneV5::variableAddressesAreStable()
+{
+    // the property editors & the game link keep pointers to an entity's values while the scene is being
+    // edited, so growing the list (a variable added to the object) can't move the ones already there
+    RSDKv5::Scene::SceneEntity entity;
+
+    QList<RSDKv5::Scene::VariableValue *> addresses;
+    for (int v = 0; v < 4; ++v) {
+        RSDKv5::Scene::VariableValue value;
+        value.type        = RSDKv5::INT32;
+        value.value_int32 = v;
+        entity.variables.append(value);
+    }
+    for (auto &value : entity.variables) addresses.append(&value);
+
+    for (int v = 4; v < 0x400; ++v) {
+        RSDKv5::Scene::VariableValue value;
+        value.type        = RSDKv5::INT32;
+        value.value_int32 = v;
+        entity.variables.append(value);
+    }
+
+    for (int v = 0; v < addresses.count(); ++v) {
+        QCOMPARE(&entity.variables[v], addresses[v]);
+        QCOMPARE(addresses[v]->value_int32, v);
+    }
+
+    // writes through a held pointer land in the entity
+    *addresses[2] = entity.variables[0x3FF];
+    QCOMPARE(entity.variables[2].value_int32, 0x3FF);
+}
+
+// a scene packed at a different zlib level than Writer::compress uses, like files saved by other tools
+static QByteArray packedAtLevel(const QByteArray &data, int level)
+{
+    QByteArray packed = qCompress(data, level);
+    packed.remove(0, 4);
+    return packed;
+}
+
+static QByteArray foreignScene()
+{
+    RSDKv5::Scene scene;
+    QRandomGenerator rng(7);
+    for (int l = 0; l < 2; ++l) {
+        RSDKv5::Scene::SceneLayer layer;
+        layer.name   = QString("Layer %1").arg(l);
+        layer.width  = 0x40;
+        layer.height = 0x20;
+        layer.layout.resize(layer.height);
+        for (auto &row : layer.layout) {
+            row.resize(layer.width);
+            for (auto &tile : row) tile = rng.bounded(8) ? 0xFFFF : rng.bounded(0x400);
+        }
+
+        RSDKv5::Scene::ScrollIndexInfo info;
+        RSDKv5::Scene::ScrollInstance instance;
+        instance.length = layer.height * 0x10;
+        info.instances.append(instance);
+        layer.scrollInfos.append(info);
+
+        scene.layers.append(layer);
+    }
+
+    return Harness::writeBytes([&scene](Writer &writer) {
+        writer.write(scene.signature, 4);
+        scene.editorMetadata.write(writer);
+
+        writer.write((byte)scene.layers.count());
+        for (auto &layer : scene.layers) {
+            layer.scrollIndicesFromInfo();
+            layer.write(writer, packedAtLevel(layer.lineScroll, 1),
+                        packedAtLevel(layer.layoutBytes(), 1));
+        }
+
+        writer.write((byte)0);
+    });
+}
+
+// the scene with every block packed again, which is what a cached write has to match
+static QByteArray rebuilt(RSDKv5::Scene &scene)
+{
+    return Harness::writeBytes([&scene](Writer &writer) {
+        writer.write(scene.signature, 4);
+        scene.editorMetadata.write(writer);
+
+        writer.write((byte)scene.layers.count());
+        for (auto &layer : scene.layers) layer.write(writer);
+
+        writer.write((byte)scene.objects.count());
+        for (auto &object : scene.objects) object.write(writer);
+    });
+}
+
+static QByteArray written(RSDKv5::Scene &scene)
+{
+    return Harness::writeBytes([&scene](Writer &writer) { scene.write(writer); });
+}
+
+void TestSceneV5::layerNamesRoundTrip()
+{
+    // names are stored with a terminator, it used to be read back as part of the name & grow every save
+    QByteArray data = Corpus::sceneV5(1);
+
+    Harness::MemoryReader memory(data);
+    RSDKv5::Scene scene;
+    scene.read(memory.reader);
+    for (auto &layer : scene.layers) QVERIFY(!layer.name.contains(QChar('\0')));
+
+    QByteArray once = Harness::roundTrip<RSDKv5::Scene>(data);
+    QVERIFY(once == data);
+    QVERIFY(Harness::roundTrip<RSDKv5::Scene>(once) == data);
+}
+
+void TestSceneV5::cachedWritesMatchAFullRebuild()
+{
+    QByteArray data = foreignScene();
+
+    Harness::MemoryReader memory(data);
+    RSDKv5::Scene scene;
+    scene.read(memory.reader);
+
+    // after a load, nothing that was on disk is written back as is
+    QByteArray first = written(scene);
+    QVERIFY(first != data);
+    QVERIFY(first == rebuilt(scene));
+
+    // after an edit
+    scene.layers[1].layout[3][5] = 0x123;
+    scene.layers[1].modified     = true;
+    QByteArray second = written(scene);
+    QVERIFY(second != first);
+    QVERIFY(second == rebuilt(scene));
+
+    // & after saving again with nothing changed
+    QByteArray third = written(scene);
+    QVERIFY(third == second);
+    QVERIFY(third == rebuilt(scene));
+
+    Harness::MemoryReader rereader(third);
+    RSDKv5::Scene reread;
+    reread.read(rereader.reader);
+    QCOMPARE(reread.layers[1].layout[3][5], (ushort)0x123);
+    QVERIFY(reread.layers[0].layoutBytes() == scene.layers[0].layoutBytes());
+}
+
+void TestSceneV5::onlyModifiedLayoutsArePackedAgain()
+{
+    QByteArray data = Corpus::sceneV5(1);
+
+    Harness::MemoryReader memory(data);
+    RSDKv5::Scene scene;
+    scene.read(memory.reader);
+    written(scene);
+
+    // the flag is all that's looked at, an edit nobody marked keeps what was packed before
+    QByteArray packed = scene.layers[0].packedLayout;
+
+    scene.layers[0].layout[0][0] ^= 1;
+    written(scene);
+    QVERIFY(scene.layers[0].packedLayout == packed);
+    QVERIFY(packed != Writer::compress(scene.layers[0].layoutBytes()));
+
+    scene.layers[0].modified = true;
+    written(scene);
+    QVERIFY(scene.layers[0].packedLayout == Writer::compress(scene.layers[0].layoutBytes()));
+    QVERIFY(!scene.layers[0].modified);
+
+    // lineScroll is rebuilt from the scroll info on every write, so that's picked up without the flag
+    QByteArray lineScroll = scene.layers[1].packedLineScroll;
+
+    RSDKv5::Scene::ScrollIndexInfo band;
+    RSDKv5::Scene::ScrollInstance instance;
+    instance.length = 0x10;
+    band.instances.append(instance);
+    scene.layers[1].scrollInfos.append(band);
+    QVERIFY(written(scene) == rebuilt(scene));
+    QVERIFY(scene.layers[1].packedLineScroll != lineScroll);
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <QtTest>
+
+class TestSceneV5 : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void variableAddressesAreStable();
+
+    void layerNamesRoundTrip();
+    void cachedWritesMatchAFullRebuild();
+    void onlyModifiedLayoutsArePackedAgain();
+};
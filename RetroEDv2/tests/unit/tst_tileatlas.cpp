@@ -0,0 +1,213 @@
+#include "tst_tileatlas.hpp"
+#include "harness.hpp"
+
+#include "tools/utils/tileatlas.hpp"
+
+// every pixel made from its tile id & position, so any byte says where it came from
+static uchar tilePixel(int tile, int x, int y) { return (tile * 7 + x + y * 3) & 0xFF; }
+
+static QVector<QRgb> grayPalette()
+{
+    QVector<QRgb> palette;
+    for (int c = 0; c < 0x100; ++c) palette.append(qRgb(c, c, c));
+    return palette;
+}
+
+static QByteArray tileBytes(int tile)
+{
+    QByteArray bytes(TileAtlas::TILE_BYTES, '\0');
+    for (int y = 0; y < TileAtlas::TILE_SIZE; ++y) {
+        for (int x = 0; x < TileAtlas::TILE_SIZE; ++x)
+            bytes[y * TileAtlas::TILE_SIZE + x] = (char)tilePixel(tile, x, y);
+    }
+    return bytes;
+}
+
+static bool tileIs(const TileAtlas &atlas, int tile, const QByteArray &bytes)
+{
+    return !memcmp(atlas.tilePixels(tile), bytes.constData(), TileAtlas::TILE_BYTES);
+}
+
+// the runs worked out the slow way, one tile at a time
+static QList<QPair<int, int>> referenceRanges(const QSet<int> &tiles)
+{
+    QList<QPair<int, int>> ranges;
+    for (int t = 0; t < TileAtlas::TILE_COUNT; ++t) {
+        if (!tiles.contains(t))
+            continue;
+
+        if (!ranges.isEmpty() && ranges.last().first + ranges.last().second == t)
+            ++ranges.last().second;
+        else
+            ranges.append(QPair<int, int>(t, 1));
+    }
+    return ranges;
+}
+
+static TileAtlas loadedAtlas()
+{
+    // 0x20 tiles across, so rows of the sheet don't line up with the dirty words
+    const int across = 0x20;
+    const int down   = TileAtlas::TILE_COUNT / across;
+
+    QImage sheet(across * TileAtlas::TILE_SIZE, down * TileAtlas::TILE_SIZE, QImage::Format_Indexed8);
+    sheet.setColorTable(grayPalette());
+    for (int t = 0; t < TileAtlas::TILE_COUNT; ++t) {
+        int tx = (t % across) * TileAtlas::TILE_SIZE;
+        int ty = (t / across) * TileAtlas::TILE_SIZE;
+        for (int y = 0; y < TileAtlas::TILE_SIZE; ++y) {
+            uchar *row = sheet.scanLine(ty + y);
+            for (int x = 0; x < TileAtlas::TILE_SIZE; ++x) row[tx + x] = tilePixel(t, x, y);
+        }
+    }
+
+    TileAtlas atlas;
+    atlas.load(sheet);
+    return atlas;
+}
+
+void TestTileAtlas::loadSplitsTheSheet()
+{
+    TileAtlas atlas = loadedAtlas();
+    QCOMPARE(atlas.getPalette(), grayPalette());
+    QCOMPARE(atlas.getPixels().size(), TileAtlas::TILE_COUNT * TileAtlas::TILE_BYTES);
+
+    for (int t = 0; t < TileAtlas::TILE_COUNT; ++t) QVERIFY(tileIs(atlas, t, tileBytes(t)));
+
+    // a fresh load has to go up in one go
+    QCOMPARE(atlas.takeDirtyRanges(), (QList<QPair<int, int>>{ { 0, TileAtlas::TILE_COUNT } }));
+    QVERIFY(!atlas.isDirty());
+
+    // the per tile images are copies of the same bytes
+    QImage tile = atlas.tileImage(0x123);
+    QCOMPARE(tile.size(), QSize(TileAtlas::TILE_SIZE, TileAtlas::TILE_SIZE));
+    QCOMPARE(tile.format(), QImage::Format_Indexed8);
+    QCOMPARE(tile.pixelIndex(5, 9), (int)tilePixel(0x123, 5, 9));
+}
+
+void TestTileAtlas::editsOnlyTouchTheirTile()
+{
+    TileAtlas atlas = loadedAtlas();
+    atlas.takeDirtyRanges();
+
+    QByteArray edit = tileBytes(0x3FF);
+    atlas.setTile(0x40, (const uchar *)edit.constData());
+    atlas.copyTile(0x41, 0x10);
+    QVERIFY(tileIs(atlas, 0x40, edit));
+    QVERIFY(tileIs(atlas, 0x41, tileBytes(0x10)));
+    QVERIFY(tileIs(atlas, 0x10, tileBytes(0x10)));
+
+    // anything out of range, or copying a tile onto itself, is left alone
+    atlas.setTile(-1, (const uchar *)edit.constData());
+    atlas.setTile(TileAtlas::TILE_COUNT, (const uchar *)edit.constData());
+    atlas.copyTile(0x42, TileAtlas::TILE_COUNT);
+    atlas.copyTile(0x43, 0x43);
+
+    for (int t = 0; t < TileAtlas::TILE_COUNT; ++t) {
+        if (t != 0x40 && t != 0x41)
+            QVERIFY(tileIs(atlas, t, tileBytes(t)));
+    }
+    QCOMPARE(atlas.takeDirtyRanges(), (QList<QPair<int, int>>{ { 0x40, 2 } }));
+}
+
+void TestTileAtlas::dirtyRangesMatchTheFlags_data()
+{
+    QTest::addColumn<QList<int>>("tiles");
+
+    QTest::newRow("nothing") << QList<int>();
+    QTest::newRow("first & last") << QList<int>({ 0, TileAtlas::TILE_COUNT - 1 });
+    QTest::newRow("across a word") << QList<int>({ 30, 31, 32, 33 });
+    QTest::newRow("a whole word") << [] {
+        QList<int> tiles;
+        for (int t = 64; t < 96; ++t) tiles.append(t);
+        return tiles;
+    }();
+    QTest::newRow("marked twice") << QList<int>({ 5, 5, 6, 5 });
+
+    for (int seed = 1; seed <= 4; ++seed) {
+        QRandomGenerator rng(seed);
+        QList<int> tiles;
+        int count = rng.bounded(TileAtlas::TILE_COUNT);
+        for (int i = 0; i < count; ++i) tiles.append(rng.bounded(TileAtlas::TILE_COUNT));
+        QTest::addRow("random %d", seed) << tiles;
+    }
+}
+
+void TestTileAtlas::dirtyRangesMatchTheFlags()
+{
+    QFETCH(QList<int>, tiles);
+
+    TileAtlas atlas;
+    QSet<int> marked;
+    for (int t : tiles) {
+        atlas.markDirty(t);
+        marked.insert(t);
+    }
+
+    // bad ids don't count
+    atlas.markDirty(-1);
+    atlas.markDirty(TileAtlas::TILE_COUNT);
+
+    QCOMPARE(atlas.isDirty(), !marked.isEmpty());
+    for (int t = 0; t < TileAtlas::TILE_COUNT; ++t) QCOMPARE(atlas.isDirty(t), marked.contains(t));
+
+    QCOMPARE(atlas.takeDirtyRanges(), referenceRanges(marked));
+
+    // taken once, so they're clean until they change again
+    QVERIFY(!atlas.isDirty());
+    QVERIFY(atlas.takeDirtyRanges().isEmpty());
+}
+
+void TestTileAtlas::syncOnlyComparesWhatItsGiven()
+{
+    TileAtlas atlas = loadedAtlas();
+    atlas.takeDirtyRanges();
+
+    QList<QImage> tiles = atlas.tileImages();
+    tiles[3].setPixel(1, 1, 0xFE);
+    tiles[40].setPixel(2, 2, 0xFE);
+    tiles[900].setPixel(3, 3, 0xFE);
+
+    // an unedited tile in the list isn't a change, & the edits outside it aren't looked at
+    QList<int> ids = { 40, 41, -1, TileAtlas::TILE_COUNT };
+    QCOMPARE(atlas.syncFrom(tiles, ids), QList<int>({ 40 }));
+    QVERIFY(tileIs(atlas, 3, tileBytes(3)));
+    QVERIFY(tileIs(atlas, 900, tileBytes(900)));
+    QCOMPARE(atlas.takeDirtyRanges(), (QList<QPair<int, int>>{ { 40, 1 } }));
+
+    QCOMPARE(atlas.syncFrom(tiles, 0, 10), QList<int>({ 3 }));
+    QVERIFY(tileIs(atlas, 900, tileBytes(900)));
+
+    // the whole list only has the one left
+    QCOMPARE(atlas.syncFrom(tiles), QList<int>({ 900 }));
+    QCOMPARE(atlas.takeDirtyRanges(), (QList<QPair<int, int>>{ { 3, 1 }, { 900, 1 } }));
+
+    QCOMPARE(atlas.tileImage(40).pixelIndex(2, 2), 0xFE);
+    QVERIFY(atlas.syncFrom(tiles).isEmpty());
+
+    // a short list, or a range hanging off either end, only covers the tiles that are there
+    QList<QImage> few = tiles.mid(0, 8);
+    few[7].setPixel(0, 0, 0xFD);
+    QCOMPARE(atlas.syncFrom(few, 4, TileAtlas::TILE_COUNT), QList<int>({ 7 }));
+    few[0].setPixel(0, 0, 0xFD);
+    QCOMPARE(atlas.syncFrom(few, -4, 5), QList<int>({ 0 }));
+}
+
+void TestTileAtlas::syncRemapsTrueColourTiles()
+{
+    TileAtlas atlas = loadedAtlas();
+    atlas.takeDirtyRanges();
+
+    QList<QImage> tiles = atlas.tileImages();
+    tiles[0x80]         = tiles[0x80].convertToFormat(QImage::Format_ARGB32);
+    QVERIFY(atlas.syncFrom(tiles, QList<int>({ 0x80 })).isEmpty());
+
+    tiles[0x80].setPixel(6, 6, qRgb(0x42, 0x42, 0x42));
+    QCOMPARE(atlas.syncFrom(tiles, QList<int>({ 0x80 })), QList<int>({ 0x80 }));
+    QCOMPARE(atlas.tileImage(0x80).pixelIndex(6, 6), 0x42);
+
+    // anything that isn't a tile is skipped
+    tiles[0x81] = QImage(8, 8, QImage::Format_Indexed8);
+    QVERIFY(atlas.syncFrom(tiles, QList<int>({ 0x81 })).isEmpty());
+    QVERIFY(tileIs(atlas, 0x81, tileBytes(0x81)));
+}
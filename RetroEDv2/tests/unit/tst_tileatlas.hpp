@@ -0,0 +1,18 @@
+#pragma once
+
+#include <QtTest>
+
+class TestTileAtlas : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void loadSplitsTheSheet();
+    void editsOnlyTouchTheirTile();
+
+    void dirtyRangesMatchTheFlags_data();
+    void dirtyRangesMatchTheFlags();
+
+    void syncOnlyComparesWhatItsGiven();
+    void syncRemapsTrueColourTiles();
+};
@@ -0,0 +1,272 @@
+#include "tst_tilededuplicator.hpp"
+#include "harness.hpp"
+
+#include "tools/utils/tilededuplicator.hpp"
+
+// every match is checked by drawing it: the kept tile drawn with the match's flip has to be the exact
+// pixels of the tile it stands in for, so a wrong flip or a false merge can't slip through
+
+typedef QByteArray Pixels;
+
+static Pixels randomTile(QRandomGenerator &rng, int colors)
+{
+    Pixels pixels(TileAtlas::TILE_BYTES, '\0');
+    for (char &px : pixels) px = (char)(1 + rng.bounded(colors));
+    return pixels;
+}
+
+// what drawing the tile flipped looks like, the same way the layers & chunks flip them
+static Pixels flipped(const uchar *pixels, int flip)
+{
+    Pixels out(TileAtlas::TILE_BYTES, '\0');
+    for (int y = 0; y < TileAtlas::TILE_SIZE; ++y) {
+        for (int x = 0; x < TileAtlas::TILE_SIZE; ++x) {
+            int sx = (flip & TileDeduplicator::FLIP_X) ? 0x0F - x : x;
+            int sy = (flip & TileDeduplicator::FLIP_Y) ? 0x0F - y : y;
+            out[y * TileAtlas::TILE_SIZE + x] = (char)pixels[sy * TileAtlas::TILE_SIZE + sx];
+        }
+    }
+    return out;
+}
+
+static Pixels flipped(const Pixels &pixels, int flip)
+{
+    return flipped((const uchar *)pixels.constData(), flip);
+}
+
+static Pixels tile(const TileAtlas &atlas, int id)
+{
+    return Pixels((const char *)atlas.tilePixels(id), TileAtlas::TILE_BYTES);
+}
+
+static void setTile(TileAtlas &atlas, int id, const Pixels &pixels)
+{
+    atlas.setTile(id, (const uchar *)pixels.constData());
+}
+
+static void verifyDrawsTheSame(const TileAtlas &atlas, const QVector<TileDeduplicator::Match> &matches)
+{
+    for (int t = 0; t < matches.count(); ++t) {
+        auto &match = matches[t];
+        QVERIFY(match.tile <= t); // the first copy is always the one that's kept
+        QCOMPARE(matches[match.tile].tile, match.tile);
+        QCOMPARE(flipped(atlas.tilePixels(match.tile), match.flip), tile(atlas, t));
+    }
+}
+
+void TestTileDeduplicator::flippedCopiesMatch()
+{
+    QRandomGenerator rng(1);
+
+    TileAtlas atlas;
+    for (int t = 0; t < 0x40; ++t) setTile(atlas, t, randomTile(rng, 0xFF));
+
+    Pixels original = randomTile(rng, 0xFF);
+    setTile(atlas, 10, original);
+    setTile(atlas, 20, flipped(original, TileDeduplicator::FLIP_X));
+    setTile(atlas, 30, flipped(original, TileDeduplicator::FLIP_Y));
+    setTile(atlas, 40, flipped(original, TileDeduplicator::FLIP_XY));
+    setTile(atlas, 50, original);
+
+    auto matches = TileDeduplicator::findTiles(atlas, 0x40, QVector<QByteArray>());
+    QCOMPARE(matches[20].tile, (ushort)10);
+    QCOMPARE(matches[20].flip, (byte)TileDeduplicator::FLIP_X);
+    QCOMPARE(matches[30].tile, (ushort)10);
+    QCOMPARE(matches[30].flip, (byte)TileDeduplicator::FLIP_Y);
+    QCOMPARE(matches[40].tile, (ushort)10);
+    QCOMPARE(matches[40].flip, (byte)TileDeduplicator::FLIP_XY);
+    QCOMPARE(matches[50].tile, (ushort)10);
+    QCOMPARE(matches[50].flip, (byte)TileDeduplicator::FLIP_NONE);
+
+    QCOMPARE(TileDeduplicator::freedIDs(matches), QList<ushort>({ 20, 30, 40, 50 }));
+    verifyDrawsTheSame(atlas, matches);
+}
+
+void TestTileDeduplicator::remapDrawsTheSame()
+{
+    QRandomGenerator rng(2);
+
+    TileAtlas atlas;
+    for (int t = 0; t < 8; ++t) setTile(atlas, t, randomTile(rng, 0xFF));
+    for (int t = 8; t < 0x20; ++t)
+        setTile(atlas, t, flipped(tile(atlas, rng.bounded(8)), rng.bounded(4)));
+    auto matches = TileDeduplicator::findTiles(atlas, 0x20, QVector<QByteArray>());
+
+    // v5 layout values, flips that were already there have to stack with the merge's own
+    SceneHelpers::TileLayer layer;
+    layer.width  = 0x20;
+    layer.height = 4;
+    for (int y = 0; y < layer.height; ++y) {
+        QList<ushort> row;
+        for (int x = 0; x < layer.width; ++x) row.append(x | (y << 10) | (rng.bounded(4) << 12));
+        layer.layout.append(row);
+    }
+    layer.layout[3][5] = 0xFFFF;
+
+    QList<SceneHelpers::TileLayer> layers = { layer };
+    int changed = TileDeduplicator::remapLayers(layers, matches, 0x3FF, 0xFFFF);
+    QCOMPARE(changed, TileDeduplicator::freedIDs(matches).count() * 4 - (matches[5].tile != 5));
+
+    QCOMPARE(layers[0].layout[3][5], (ushort)0xFFFF);
+    for (int y = 0; y < layer.height; ++y) {
+        for (int x = 0; x < layer.width; ++x) {
+            ushort before = layer.layout[y][x];
+            ushort after  = layers[0].layout[y][x];
+            if (before == 0xFFFF)
+                continue;
+
+            // solidity is left as it was
+            QCOMPARE(after & 0xF000, before & 0xF000);
+            QCOMPARE(flipped(atlas.tilePixels(after & 0x3FF), (after >> 10) & 3),
+                     flipped(atlas.tilePixels(before & 0x3FF), (before >> 10) & 3));
+        }
+    }
+}
+
+void TestTileDeduplicator::collisionStopsFlips()
+{
+    QRandomGenerator rng(3);
+
+    TileAtlas atlas;
+    Pixels original = randomTile(rng, 0xFF);
+    setTile(atlas, 0, original);
+    setTile(atlas, 1, flipped(original, TileDeduplicator::FLIP_X));
+    setTile(atlas, 2, original);
+    setTile(atlas, 3, original);
+    setTile(atlas, 4, original);
+
+    RSDKv5::TileConfig config;
+    for (int t : { 0, 1, 2, 3 }) {
+        for (int c = 0; c < 2; ++c) {
+            for (int i = 0; i < 0x10; ++i) {
+                config.collisionPaths[c][t].collision[i].solid  = true;
+                config.collisionPaths[c][t].collision[i].height = i;
+            }
+        }
+    }
+    config.collisionPaths[0][3].floorAngle = 0x20;
+
+    auto keys = TileDeduplicator::collisionKeys(config);
+    QVERIFY(!keys[0].isEmpty());
+    QCOMPARE(keys[0], keys[2]);
+    QVERIFY(keys[0] != keys[3]);
+    QVERIFY(keys[4].isEmpty());
+
+    auto matches = TileDeduplicator::findTiles(atlas, 5, keys);
+    // a flipped copy would collide flipped, a different angle collides differently & no collision at
+    // all isn't the same as some
+    QCOMPARE(matches[1].tile, (ushort)1);
+    QCOMPARE(matches[2].tile, (ushort)0);
+    QCOMPARE(matches[2].flip, (byte)TileDeduplicator::FLIP_NONE);
+    QCOMPARE(matches[3].tile, (ushort)3);
+    QCOMPARE(matches[4].tile, (ushort)4);
+}
+
+void TestTileDeduplicator::blankAndExcludedStayPut()
+{
+    QRandomGenerator rng(4);
+
+    TileAtlas atlas; // starts out blank
+    Pixels original = randomTile(rng, 0xFF);
+    setTile(atlas, 0x10, original);
+    setTile(atlas, 0x11, original);
+    setTile(atlas, 0x12, original);
+    setTile(atlas, 0x13, flipped(original, TileDeduplicator::FLIP_Y));
+    QVERIFY(TileDeduplicator::isBlank(atlas.tilePixels(0)));
+    QVERIFY(!TileDeduplicator::isBlank(atlas.tilePixels(0x10)));
+
+    // 0x10 being left alone doesn't stop the copies that aren't from merging with each other
+    auto matches = TileDeduplicator::findTiles(atlas, 0x20, QVector<QByteArray>(), { 0x10, 0x12 });
+    QCOMPARE(TileDeduplicator::freedIDs(matches), QList<ushort>({ 0x13 }));
+    QCOMPARE(matches[0x13].tile, (ushort)0x11);
+    verifyDrawsTheSame(atlas, matches);
+
+    // ids past the tiles being looked at are ignored
+    matches = TileDeduplicator::findTiles(atlas, 0x20, QVector<QByteArray>(), { 0x3FF });
+    QCOMPARE(TileDeduplicator::freedIDs(matches), QList<ushort>({ 0x11, 0x12, 0x13 }));
+}
+
+void TestTileDeduplicator::matchesABruteForce_data()
+{
+    QTest::addColumn<int>("seed");
+    QTest::addColumn<int>("colors");
+
+    // 2 colours, so tiles that only differ by a pixel or two are common
+    for (int seed = 1; seed <= 3; ++seed) {
+        QTest::addRow("2 colours, %d", seed) << seed << 2;
+        QTest::addRow("full palette, %d", seed) << seed << 0xFF;
+    }
+}
+
+void TestTileDeduplicator::matchesABruteForce()
+{
+    QFETCH(int, seed);
+    QFETCH(int, colors);
+
+    QRandomGenerator rng(seed);
+
+    // a handful of originals, copied & flipped all over, with a few blanks & tiles that only differ by
+    // a pixel mixed in
+    TileAtlas atlas;
+    QList<Pixels> originals;
+    for (int o = 0; o < 0x20; ++o) {
+        Pixels pixels = randomTile(rng, colors);
+        if (o % 4 == 0) {
+            // the same upside down, so more than one flip is right
+            for (int y = TileAtlas::TILE_SIZE / 2; y < TileAtlas::TILE_SIZE; ++y) {
+                memcpy(pixels.data() + y * TileAtlas::TILE_SIZE,
+                       pixels.constData() + (0x0F - y) * TileAtlas::TILE_SIZE, TileAtlas::TILE_SIZE);
+            }
+        }
+        originals.append(pixels);
+    }
+    for (int t = 0; t < TileAtlas::TILE_COUNT; ++t) {
+        int kind = rng.bounded(16);
+        if (kind == 0)
+            continue;
+
+        Pixels pixels = flipped(originals[rng.bounded(originals.count())], rng.bounded(4));
+        if (kind == 1)
+            pixels[rng.bounded(TileAtlas::TILE_BYTES)] = (char)0xFF;
+        setTile(atlas, t, pixels);
+    }
+
+    QVector<QByteArray> keys(TileAtlas::TILE_COUNT);
+    for (int t = 0; t < TileAtlas::TILE_COUNT; ++t) {
+        if (rng.bounded(8) == 0)
+            keys[t] = QByteArray(1, (char)rng.bounded(2));
+    }
+
+    QList<ushort> excluded;
+    for (int i = 0; i < 0x20; ++i) excluded.append(rng.bounded(TileAtlas::TILE_COUNT));
+
+    auto matches = TileDeduplicator::findTiles(atlas, TileAtlas::TILE_COUNT, keys, excluded);
+    verifyDrawsTheSame(atlas, matches);
+
+    // every tile against every kept one before it, the first that matches any allowed way wins
+    QList<int> kept;
+    for (int t = 0; t < TileAtlas::TILE_COUNT; ++t) {
+        bool skipped = excluded.contains(t) || TileDeduplicator::isBlank(atlas.tilePixels(t));
+
+        int expected = t;
+        for (int c : kept) {
+            if (skipped || expected != t)
+                break;
+            if (keys[c] != keys[t])
+                continue;
+
+            int flips = keys[t].isEmpty() ? 4 : 1;
+            for (int f = 0; f < flips && expected == t; ++f) {
+                if (flipped(atlas.tilePixels(c), f) == tile(atlas, t))
+                    expected = c;
+            }
+        }
+
+        if (!skipped && expected == t)
+            kept.append(t);
+
+        QCOMPARE((int)matches[t].tile, expected);
+        if (!keys[t].isEmpty())
+            QCOMPARE(matches[t].flip, (byte)TileDeduplicator::FLIP_NONE);
+    }
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <QtTest>
+
+class TestTileDeduplicator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void flippedCopiesMatch();
+    void remapDrawsTheSame();
+    void collisionStopsFlips();
+    void blankAndExcludedStayPut();
+
+    void matchesABruteForce_data();
+    void matchesABruteForce();
+};
@@ -0,0 +1,167 @@
+#include "tst_tileusageindex.hpp"
+#include "harness.hpp"
+
+#include "tools/utils/tileusageindex.hpp"
+
+// v5 layouts: the tile id in the low 10 bits, flips & solidity on top, 0xFFFF for nothing
+enum { ID_MASK = 0x3FF, ID_COUNT = 0x400, EMPTY = 0xFFFF };
+
+typedef QList<SceneHelpers::TileLayer> Layers;
+
+static SceneHelpers::TileLayer randomLayer(QRandomGenerator &rng, int width, int height)
+{
+    SceneHelpers::TileLayer layer;
+    layer.width  = width;
+    layer.height = height;
+    for (int y = 0; y < height; ++y) {
+        QList<ushort> row;
+        for (int x = 0; x < width; ++x) {
+            // few enough ids that most of them get used more than once
+            ushort tile = rng.bounded(4) ? rng.bounded(0x40) | (rng.bounded(0x40) << 10) : EMPTY;
+            row.append(tile);
+        }
+        layer.layout.append(row);
+    }
+    return layer;
+}
+
+static Layers randomLayers(int seed)
+{
+    QRandomGenerator rng(seed);
+
+    Layers layers;
+    for (int l = 0; l < 4; ++l) {
+        int width  = 8 + rng.bounded(24);
+        int height = 8 + rng.bounded(24);
+        layers.append(randomLayer(rng, width, height));
+    }
+    return layers;
+}
+
+static quint64 placement(int layer, int x, int y) { return ((quint64)layer << 32) | (x << 16) | y; }
+
+// every placement of id the slow way
+static QList<quint64> scan(const Layers &layers, ushort id)
+{
+    QList<quint64> list;
+    for (int l = 0; l < layers.count(); ++l) {
+        for (int y = 0; y < layers[l].height; ++y) {
+            for (int x = 0; x < layers[l].width; ++x) {
+                ushort tile = layers[l].layout[y][x];
+                if (tile != EMPTY && (tile & ID_MASK) == id)
+                    list.append(placement(l, x, y));
+            }
+        }
+    }
+    return list;
+}
+
+static void compare(TileUsageIndex &index, const Layers &layers)
+{
+    index.ensure(layers);
+
+    QList<ushort> unused;
+    for (int id = 0; id < ID_COUNT; ++id) {
+        QList<quint64> found;
+        for (auto &use : index.find(id)) found.append(placement(use.layer, use.x, use.y));
+        std::sort(found.begin(), found.end());
+
+        QList<quint64> expected = scan(layers, id);
+        QCOMPARE(found, expected);
+        QCOMPARE(index.count(id), expected.count());
+
+        if (expected.isEmpty())
+            unused.append(id);
+    }
+    QCOMPARE(index.unused(), unused);
+}
+
+void TestTileUsageIndex::buildMatchesAScan()
+{
+    for (int seed = 1; seed <= 4; ++seed) {
+        Layers layers = randomLayers(seed);
+
+        TileUsageIndex index;
+        index.setup(ID_MASK, ID_COUNT, EMPTY);
+        compare(index, layers);
+    }
+}
+
+void TestTileUsageIndex::updatesMatchAScan()
+{
+    QRandomGenerator rng(7);
+    Layers layers = randomLayers(7);
+
+    TileUsageIndex index;
+    index.setup(ID_MASK, ID_COUNT, EMPTY);
+    index.ensure(layers);
+
+    // the same thing SceneViewer::setLayoutTile does
+    for (int i = 0; i < 2000; ++i) {
+        int l       = rng.bounded(layers.count());
+        auto &layer = layers[l];
+        int x       = rng.bounded((int)layer.width);
+        int y       = rng.bounded((int)layer.height);
+
+        ushort prev        = layer.layout[y][x];
+        ushort value       = rng.bounded(8) ? rng.bounded(0x40) | (rng.bounded(0x40) << 10) : EMPTY;
+        layer.layout[y][x] = value;
+        index.update(l, x, y, prev, value);
+    }
+
+    compare(index, layers);
+}
+
+void TestTileUsageIndex::layerChangesAreNoticed_data()
+{
+    QTest::addColumn<int>("change");
+
+    QTest::newRow("moved up") << 0;
+    QTest::newRow("moved down") << 1;
+    QTest::newRow("removed") << 2;
+    QTest::newRow("added") << 3;
+    QTest::newRow("resized") << 4;
+}
+
+void TestTileUsageIndex::layerChangesAreNoticed()
+{
+    QFETCH(int, change);
+
+    QRandomGenerator rng(change);
+    Layers layers = randomLayers(3);
+
+    TileUsageIndex index;
+    index.setup(ID_MASK, ID_COUNT, EMPTY);
+    index.ensure(layers);
+
+    // nothing's invalidated, ensure has to spot it by itself or the placements point at the wrong layer
+    switch (change) {
+        case 0: layers.move(2, 1); break;
+        case 1: layers.move(0, 3); break;
+        case 2: layers.removeAt(1); break;
+        case 3: layers.append(randomLayer(rng, 12, 12)); break;
+        case 4: layers[2] = randomLayer(rng, layers[2].width + 1, layers[2].height); break;
+    }
+
+    compare(index, layers);
+}
+
+void TestTileUsageIndex::rangesRoundTrip()
+{
+    QList<ushort> ids = { 0, 1, 2, 3, 7, 9, 10, 11, 12, 0x3FF };
+    QString text      = TileUsageIndex::formatRanges(ids);
+    QCOMPARE(text, QString("0-3, 7, 9-12, 1023"));
+
+    QList<ushort> parsed;
+    QVERIFY(TileUsageIndex::parseRanges(text, ID_COUNT, parsed));
+    QCOMPARE(parsed, ids);
+
+    // typed in by hand: any spacing, overlaps & nothing at all are fine
+    QVERIFY(TileUsageIndex::parseRanges(" 9 - 10,3,,9 ", ID_COUNT, parsed));
+    QCOMPARE(parsed, QList<ushort>({ 3, 9, 10 }));
+    QVERIFY(TileUsageIndex::parseRanges("", ID_COUNT, parsed));
+    QVERIFY(parsed.isEmpty());
+
+    for (const char *bad : { "x", "1-", "3-1", "1-2-3", "-1", "1024", "0-1024" })
+        QVERIFY2(!TileUsageIndex::parseRanges(bad, ID_COUNT, parsed), bad);
+}
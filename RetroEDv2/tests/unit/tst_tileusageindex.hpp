@@ -0,0 +1,15 @@
+#pragma once
+
+#include <QtTest>
+
+class TestTileUsageIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void buildMatchesAScan();
+    void updatesMatchAScan();
+    void layerChangesAreNoticed_data();
+    void layerChangesAreNoticed();
+    void rangesRoundTrip();
+};
@@ -0,0 +1,287 @@
+#include "tst_userdbmodel.hpp"
+#include "harness.hpp"
+
+#include "tools/utils/userdbmodel.hpp"
+
+// the model's filters binary search each column's sorted index, so every check here is made against a
+// plain scan over the values the rows were built from
+
+using TableColumn = RSDKv5::UserDB::TableColumn;
+
+enum TestColumns { SCORE = UserDBModel::COLUMN_FIXEDCOUNT, SPEED, BIG };
+
+struct TestDB {
+    RSDKv5::UserDB db;
+
+    QVector<int> scores;
+    QVector<float> speeds;
+    QVector<quint64> bigs;
+};
+
+template <typename T> static RSDKv5::UserDB::TableRow::Value value(T v)
+{
+    RSDKv5::UserDB::TableRow::Value entry;
+    entry.data = QByteArray(reinterpret_cast<const char *>(&v), sizeof(T));
+    return entry;
+}
+
+static void addColumn(RSDKv5::UserDB &db, const QString &name, TableColumn::Types type)
+{
+    TableColumn column;
+    column.name = name;
+    column.type = type;
+    db.columns.append(column);
+}
+
+// few distinct scores so there's plenty of ties, & bigs either side of the unsigned sign bit
+static void fill(TestDB &test, int count)
+{
+    QRandomGenerator rng(count);
+
+    addColumn(test.db, "score", TableColumn::Int32);
+    addColumn(test.db, "speed", TableColumn::Float);
+    addColumn(test.db, "big", TableColumn::UInt64);
+
+    for (int r = 0; r < count; ++r) {
+        int score   = rng.bounded(41) - 20;
+        float speed = rng.bounded(200) / 4.0f;
+        quint64 big = 0x7FFFFFFFFFFFFFF0ULL + rng.bounded(0x20);
+        test.scores.append(score);
+        test.speeds.append(speed);
+        test.bigs.append(big);
+
+        RSDKv5::UserDB::TableRow row;
+        row.uuid = r;
+        row.entries.append(value(score));
+        row.entries.append(value(speed));
+        row.entries.append(value(big));
+        test.db.rows.append(row);
+    }
+}
+
+static QList<int> visibleRows(const UserDBModel &model)
+{
+    QList<int> rows;
+    for (int r = 0; r < model.rowCount(); ++r) rows.append(model.dbRow(r));
+    return rows;
+}
+
+static bool scanMatches(const TestDB &test, int r, const UserDBModel::Filter &filter)
+{
+    bool equal   = filter.mode == UserDBModel::Filter::Equal;
+    bool hasMin  = equal || !filter.min.isEmpty();
+    bool hasMax  = equal || !filter.max.isEmpty();
+    QString high = equal ? filter.min : filter.max;
+
+    switch (filter.column) {
+        default:
+        case SCORE:
+            return (!hasMin || test.scores[r] >= filter.min.toInt())
+                   && (!hasMax || test.scores[r] <= high.toInt());
+        case SPEED:
+            return (!hasMin || test.speeds[r] >= filter.min.toFloat())
+                   && (!hasMax || test.speeds[r] <= high.toFloat());
+        case BIG:
+            return (!hasMin || test.bigs[r] >= filter.min.toULongLong())
+                   && (!hasMax || test.bigs[r] <= high.toULongLong());
+    }
+}
+
+void TestUserDBModel::descendingKeepsTiesInOrder()
+{
+    TestDB test;
+    fill(test, 500);
+
+    UserDBModel model;
+    model.setDB(&test.db);
+
+    for (Qt::SortOrder order : { Qt::AscendingOrder, Qt::DescendingOrder }) {
+        model.sort(SCORE, order);
+        QList<int> rows = visibleRows(model);
+        QCOMPARE(rows.count(), test.db.rows.count());
+
+        for (int r = 1; r < rows.count(); ++r) {
+            int prev = test.scores[rows[r - 1]];
+            int cur  = test.scores[rows[r]];
+            QVERIFY(order == Qt::AscendingOrder ? prev <= cur : prev >= cur);
+            // a reversed list would have ties the other way round
+            if (prev == cur)
+                QVERIFY(rows[r - 1] < rows[r]);
+        }
+    }
+}
+
+void TestUserDBModel::nansSortLast()
+{
+    TestDB test;
+    fill(test, 500);
+
+    // every 7th speed is a nan, which doesn't compare with anything
+    QList<int> nans;
+    for (int r = 0; r < test.db.rows.count(); r += 7) {
+        test.speeds[r]             = qQNaN();
+        test.db.rows[r].entries[1] = value(test.speeds[r]);
+        nans.append(r);
+    }
+
+    UserDBModel model;
+    model.setDB(&test.db);
+
+    for (Qt::SortOrder order : { Qt::AscendingOrder, Qt::DescendingOrder }) {
+        model.sort(SPEED, order);
+        QList<int> rows = visibleRows(model);
+        QCOMPARE(rows.count(), test.db.rows.count());
+        QCOMPARE(rows.mid(rows.count() - nans.count()), nans);
+
+        for (int r = 1; r < rows.count() - nans.count(); ++r) {
+            float prev = test.speeds[rows[r - 1]];
+            float cur  = test.speeds[rows[r]];
+            QVERIFY(order == Qt::AscendingOrder ? prev <= cur : prev >= cur);
+        }
+    }
+
+    // & no range takes them in, the same as comparing each value wouldn't
+    UserDBModel::Filter filter;
+    filter.column = SPEED;
+    filter.mode   = UserDBModel::Filter::Range;
+    filter.min    = "10";
+    QVERIFY(model.setFilters({ filter }));
+
+    QList<int> expected;
+    for (int r = 0; r < test.db.rows.count(); ++r) {
+        if (scanMatches(test, r, filter))
+            expected.append(r);
+    }
+    std::stable_sort(expected.begin(), expected.end(),
+                     [&test](int a, int b) { return test.speeds[b] < test.speeds[a]; });
+    QCOMPARE(visibleRows(model), expected);
+}
+
+void TestUserDBModel::filtersMatchALinearScan_data()
+{
+    QTest::addColumn<int>("column");
+    QTest::addColumn<int>("mode");
+    QTest::addColumn<QString>("min");
+    QTest::addColumn<QString>("max");
+
+    const int equal = UserDBModel::Filter::Equal;
+    const int range = UserDBModel::Filter::Range;
+
+    QTest::newRow("equal") << (int)SCORE << equal << "-3" << "";
+    QTest::newRow("equal, nothing has it") << (int)SCORE << equal << "100" << "";
+    QTest::newRow("range") << (int)SCORE << range << "-5" << "5";
+    QTest::newRow("only a min") << (int)SCORE << range << "10" << "";
+    QTest::newRow("only a max") << (int)SCORE << range << "" << "-10";
+    QTest::newRow("no bounds") << (int)SCORE << range << "" << "";
+    QTest::newRow("min above max") << (int)SCORE << range << "5" << "-5";
+    QTest::newRow("below everything") << (int)SCORE << range << "-100" << "-50";
+    QTest::newRow("float range") << (int)SPEED << range << "10.5" << "20.25";
+    QTest::newRow("float equal") << (int)SPEED << equal << "12.5" << "";
+    QTest::newRow("uint64 across the sign bit")
+        << (int)BIG << range << "9223372036854775800" << "9223372036854775815";
+}
+
+void TestUserDBModel::filtersMatchALinearScan()
+{
+    QFETCH(int, column);
+    QFETCH(int, mode);
+    QFETCH(QString, min);
+    QFETCH(QString, max);
+
+    TestDB test;
+    fill(test, 2000);
+
+    UserDBModel::Filter filter;
+    filter.column = column;
+    filter.mode   = mode;
+    filter.min    = min;
+    filter.max    = max;
+
+    UserDBModel model;
+    model.setDB(&test.db);
+    QVERIFY(model.setFilters({ filter }));
+
+    QList<int> expected;
+    for (int r = 0; r < test.db.rows.count(); ++r) {
+        if (scanMatches(test, r, filter))
+            expected.append(r);
+    }
+    QCOMPARE(visibleRows(model), expected);
+}
+
+void TestUserDBModel::filtersKeepTheSort()
+{
+    TestDB test;
+    fill(test, 2000);
+
+    UserDBModel::Filter scores;
+    scores.column = SCORE;
+    scores.mode   = UserDBModel::Filter::Range;
+    scores.min    = "-8";
+    scores.max    = "12";
+
+    UserDBModel::Filter speeds;
+    speeds.column = SPEED;
+    speeds.mode   = UserDBModel::Filter::Range;
+    speeds.min    = "5";
+
+    UserDBModel model;
+    model.setDB(&test.db);
+    model.sort(BIG, Qt::DescendingOrder);
+    QVERIFY(model.setFilters({ scores, speeds }));
+
+    QList<int> expected;
+    for (int r = 0; r < test.db.rows.count(); ++r) {
+        if (scanMatches(test, r, scores) && scanMatches(test, r, speeds))
+            expected.append(r);
+    }
+    std::stable_sort(expected.begin(), expected.end(),
+                     [&test](int a, int b) { return test.bigs[b] < test.bigs[a]; });
+    QCOMPARE(visibleRows(model), expected);
+}
+
+void TestUserDBModel::editsAreSeenByTheNextFilter()
+{
+    TestDB test;
+    fill(test, 100);
+
+    UserDBModel::Filter filter;
+    filter.column = SCORE;
+    filter.min    = "1000";
+
+    UserDBModel model;
+    model.setDB(&test.db);
+    QVERIFY(model.setFilters({ filter }));
+    QCOMPARE(model.rowCount(), 0);
+
+    // built the index for the filter above, the edit has to throw it away
+    model.clearFilters();
+    QVERIFY(model.setData(model.index(42, SCORE), "1000"));
+    QVERIFY(model.setFilters({ filter }));
+    QCOMPARE(visibleRows(model), QList<int>({ 42 }));
+}
+
+void TestUserDBModel::badFiltersAreRejected()
+{
+    TestDB test;
+    fill(test, 100);
+
+    UserDBModel::Filter good;
+    good.column = SCORE;
+    good.min    = "0";
+
+    UserDBModel model;
+    model.setDB(&test.db);
+    QVERIFY(model.setFilters({ good }));
+    QList<int> rows = visibleRows(model);
+
+    UserDBModel::Filter bad = good;
+    bad.min                 = "zero";
+    QVERIFY(!model.setFilters({ good, bad }));
+
+    UserDBModel::Filter outside = good;
+    outside.column              = model.columnCount();
+    QVERIFY(!model.setFilters({ outside }));
+
+    QCOMPARE(visibleRows(model), rows);
+}
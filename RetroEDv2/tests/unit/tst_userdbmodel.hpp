@@ -0,0 +1,19 @@
+#pragma once
+
+#include <QtTest>
+
+class TestUserDBModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void descendingKeepsTiesInOrder();
+    void nansSortLast();
+
+    void filtersMatchALinearScan_data();
+    void filtersMatchALinearScan();
+
+    void filtersKeepTheSort();
+    void editsAreSeenByTheNextFilter();
+    void badFiltersAreRejected();
+};
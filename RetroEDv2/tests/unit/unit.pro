@@ -0,0 +1,70 @@
+QT += testlib
+
+TARGET = unit
+TEMPLATE = app
+CONFIG += testcase
+
+include(../common/common.pri)
+
+HEADERS += \
+    ../../tools/utils/userdbmodel.hpp \
+    tst_activeranges.hpp \
+    tst_chunkatlas.hpp \
+    tst_csvstream.hpp \
+    tst_entitycounts.hpp \
+    tst_filtervarindex.hpp \
+    tst_formats.hpp \
+    tst_frameprofiler.hpp \
+    tst_gamestorage.hpp \
+    tst_gif.hpp \
+    tst_modelmesh.hpp \
+    tst_obj.hpp \
+    tst_objectgroups.hpp \
+    tst_palettetexture.hpp \
+    tst_ply.hpp \
+    tst_quantizer.hpp \
+    tst_replayv5.hpp \
+    tst_scenev5.hpp \
+    tst_tileatlas.hpp \
+    tst_tilededuplicator.hpp \
+    tst_tileusageindex.hpp \
+    tst_userdbmodel.hpp
+
+SOURCES += \
+    ../../tools/gamelink/gamestorage.cpp \
+    ../../tools/utils/activeranges.cpp \
+    ../../tools/utils/chunkatlas.cpp \
+    ../../tools/utils/entitycounts.cpp \
+    ../../tools/utils/filtervarindex.cpp \
+    ../../tools/utils/modelmesh.cpp \
+    ../../tools/utils/objectgroups.cpp \
+    ../../tools/utils/palettetexture.cpp \
+    ../../tools/utils/tileatlas.cpp \
+    ../../tools/utils/tilededuplicator.cpp \
+    ../../tools/utils/tileusageindex.cpp \
+    ../../tools/utils/userdbmodel.cpp \
+    ../../utils/csvstream.cpp \
+    ../../utils/frameprofiler.cpp \
+    ../common/alloccounter.cpp \
+    main.cpp \
+    tst_activeranges.cpp \
+    tst_chunkatlas.cpp \
+    tst_csvstream.cpp \
+    tst_entitycounts.cpp \
+    tst_filtervarindex.cpp \
+    tst_formats.cpp \
+    tst_frameprofiler.cpp \
+    tst_gamestorage.cpp \
+    tst_gif.cpp \
+    tst_modelmesh.cpp \
+    tst_obj.cpp \
+    tst_objectgroups.cpp \
+    tst_palettetexture.cpp \
+    tst_ply.cpp \
+    tst_quantizer.cpp \
+    tst_replayv5.cpp \
+    tst_scenev5.cpp \
+    tst_tileatlas.cpp \
+    tst_tilededuplicator.cpp \
+    tst_tileusageindex.cpp \
+    tst_userdbmodel.cpp
@@ -394,6 +394,54 @@ ushort FunctionTable::LoadSpriteSheet(const char *filename, int scope)
     return -1;
 }
 
+// palette banks are rows in the viewer's palette texture, so any of these is just a row re-upload.
+// bank 0 is the tileset's own palette though, so writes to it are kept as an overlay on the row &
+// never reach the tilePalette that gets saved
+void FunctionTable::SetPaletteEntry(byte bankID, byte index, uint color)
+{
+    if (!v5Editor || bankID >= v5_PALETTE_BANK_COUNT)
+        return;
+
+    SceneViewer *viewer = v5Editor->viewer;
+    viewer->surfacePalettes.setColor(viewer->paletteBankRow(bankID), index, 0xFF000000 | color);
+    if (!bankID)
+        viewer->storeGamePalette(index, 1);
+}
+
+uint FunctionTable::GetPaletteEntry(byte bankID, byte index)
+{
+    if (!v5Editor || bankID >= v5_PALETTE_BANK_COUNT)
+        return 0;
+
+    SceneViewer *viewer = v5Editor->viewer;
+    return viewer->surfacePalettes.getColor(viewer->paletteBankRow(bankID), index) & 0xFFFFFF;
+}
+
+void FunctionTable::CopyPalette(byte sourceBank, byte srcPaletteStart, byte destinationBank,
+                                byte destPaletteStart, ushort count)
+{
+    if (!v5Editor || sourceBank >= v5_PALETTE_BANK_COUNT || destinationBank >= v5_PALETTE_BANK_COUNT)
+        return;
+
+    SceneViewer *viewer = v5Editor->viewer;
+    int srcRow          = viewer->paletteBankRow(sourceBank);
+    int dstRow          = viewer->paletteBankRow(destinationBank);
+    viewer->surfacePalettes.copyColors(srcRow, srcPaletteStart, dstRow, destPaletteStart, count);
+    if (!destinationBank)
+        viewer->storeGamePalette(destPaletteStart, count);
+}
+
+void FunctionTable::RotatePalette(byte bankID, byte startIndex, byte endIndex, bool32 right)
+{
+    if (!v5Editor || bankID >= v5_PALETTE_BANK_COUNT)
+        return;
+
+    SceneViewer *viewer = v5Editor->viewer;
+    viewer->surfacePalettes.rotate(viewer->paletteBankRow(bankID), startIndex, endIndex, right);
+    if (!bankID && startIndex < endIndex)
+        viewer->storeGamePalette(startIndex, endIndex - startIndex + 1);
+}
+
 void FunctionTable::DrawLine(int x1, int y1, int x2, int y2, uint color, int alpha,
                              InkEffects inkEffect, bool32 screenRelative)
 {
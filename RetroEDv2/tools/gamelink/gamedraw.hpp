@@ -3,8 +3,9 @@
 #define v5_SPRFILE_COUNT     (0x400)
 #define v5_FRAMEHITBOX_COUNT (0x8)
 
-#define v5_SURFACE_MAX     (0x40)
-#define v5_DRAWGROUP_COUNT (16)
+#define v5_SURFACE_MAX       (0x40)
+#define v5_PALETTE_BANK_COUNT (0x8)
+#define v5_DRAWGROUP_COUNT   (16)
 
 struct SpriteAnimationEntry {
     uint hash[4];
@@ -31,10 +32,11 @@ struct GFXSurface {
     QString name;
     QOpenGLTexture *texturePtr;
     QColor transClr;
+    bool indexed = false; // texturePtr holds palette indices, coloured by the surface's palette row
 };
 
 struct DrawList {
-    QList<ushort> entries;
+    QVector<ushort> entries; // sorted by slot
     QList<ushort> layerDrawList;
     void (*callback)(void);
     bool32 sorted;
@@ -61,6 +63,12 @@ void SetSpriteString(ushort spriteIndex, ushort animID, TextInfo *info);
 
 ushort LoadSpriteSheet(const char *filename, int scope);
 
+void SetPaletteEntry(byte bankID, byte index, uint color);
+uint GetPaletteEntry(byte bankID, byte index);
+void CopyPalette(byte sourceBank, byte srcPaletteStart, byte destinationBank, byte destPaletteStart,
+                 ushort count);
+void RotatePalette(byte bankID, byte startIndex, byte endIndex, bool32 right);
+
 void DrawLine(int x1, int y1, int x2, int y2, uint color, int alpha, InkEffects inkEffect,
               bool32 screenRelative);
 void DrawRect(int x, int y, int width, int height, uint color, int alpha, InkEffects inkEffect,
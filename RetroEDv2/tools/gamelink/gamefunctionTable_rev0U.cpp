@@ -426,12 +426,12 @@ void InitFunctionTables()
     // Palettes & Colors
     ADD_RSDK_FUNCTION(FunctionTable_SetTintLookupTable, BlankFunction);
     ADD_RSDK_FUNCTION(FunctionTable_SetPaletteMask, BlankFunction);
-    ADD_RSDK_FUNCTION(FunctionTable_SetPaletteEntry, BlankFunction);
-    ADD_RSDK_FUNCTION(FunctionTable_GetPaletteEntry, BlankFunction);
+    ADD_RSDK_FUNCTION(FunctionTable_SetPaletteEntry, SetPaletteEntry);
+    ADD_RSDK_FUNCTION(FunctionTable_GetPaletteEntry, GetPaletteEntry);
     ADD_RSDK_FUNCTION(FunctionTable_SetActivePalette, BlankFunction);
-    ADD_RSDK_FUNCTION(FunctionTable_CopyPalette, BlankFunction);
+    ADD_RSDK_FUNCTION(FunctionTable_CopyPalette, CopyPalette);
     ADD_RSDK_FUNCTION(FunctionTable_LoadPalette, BlankFunction);
-    ADD_RSDK_FUNCTION(FunctionTable_RotatePalette, BlankFunction);
+    ADD_RSDK_FUNCTION(FunctionTable_RotatePalette, RotatePalette);
     ADD_RSDK_FUNCTION(FunctionTable_SetLimitedFade, BlankFunction);
     ADD_RSDK_FUNCTION(FunctionTable_BlendColors, BlankFunction);
 
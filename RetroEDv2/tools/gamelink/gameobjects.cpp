@@ -88,33 +88,7 @@ void FunctionTable::SetEditableVar(byte type, const char *name, byte object, int
             v5Editor->viewer->objects[object].variables[i] = VariableInfo(name, type, offset);
             for (auto &entity : v5Editor->viewer->entities) {
                 if (entity.type == object) {
-                    // if we can transfer values, we should
-                    if (entity.variables[i].type <= VAR_BOOL && type <= VAR_BOOL) {
-                        int value = 0;
-                        switch (entity.variables[i].type) {
-                            case VAR_UINT8: value = entity.variables[i].value_uint8; break;
-                            case VAR_INT8: value = entity.variables[i].value_int8; break;
-                            case VAR_UINT16: value = entity.variables[i].value_uint16; break;
-                            case VAR_INT16: value = entity.variables[i].value_int16; break;
-                            case VAR_UINT32: value = entity.variables[i].value_uint32; break;
-                            case VAR_INT32: value = entity.variables[i].value_int32; break;
-                            case VAR_ENUM: value = entity.variables[i].value_enum; break;
-                            case VAR_BOOL: value = entity.variables[i].value_bool ? 1 : 0; break;
-                        }
-
-                        switch (type) {
-                            case VAR_UINT8: entity.variables[i].value_uint8 = value; break;
-                            case VAR_INT8: entity.variables[i].value_int8 = value; break;
-                            case VAR_UINT16: entity.variables[i].value_uint16 = value; break;
-                            case VAR_INT16: entity.variables[i].value_int16 = value; break;
-                            case VAR_UINT32: entity.variables[i].value_uint32 = value; break;
-                            case VAR_INT32: entity.variables[i].value_int32 = value; break;
-                            case VAR_ENUM: entity.variables[i].value_enum = value; break;
-                            case VAR_BOOL: entity.variables[i].value_bool = value != 0; break;
-                        }
-                    }
-
-                    entity.variables[i].type = type;
+                    entity.variables[i].setType(type);
                 }
             }
             return;
@@ -142,6 +116,7 @@ void FunctionTable::SetEditableVar(byte type, const char *name, byte object, int
             }
         }
     }
+    v5Editor->viewer->filterVars.invalidate();
 }
 
 void FunctionTable::SetActiveVariable(int objectID, const char *name)
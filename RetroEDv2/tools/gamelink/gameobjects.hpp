@@ -13,23 +13,14 @@
 
 #define FOREACH_STACK_COUNT (0x400)
 
-enum ActiveFlags {
-    ACTIVE_NEVER,   // never update
-    ACTIVE_ALWAYS,  // always update (even if paused/frozen)
-    ACTIVE_NORMAL,  // always update (unless paused/frozen)
-    ACTIVE_PAUSED,  // update if paused
-    ACTIVE_BOUNDS,  // update if in x & y bounds
-    ACTIVE_XBOUNDS, // update only if in x bounds (y bounds dont matter)
-    ACTIVE_YBOUNDS, // update only if in y bounds (x bounds dont matter)
-    ACTIVE_RBOUNDS, // update based on radius boundaries (updateRange.x = radius)
-};
+#include "tools/utils/activeranges.hpp"
 
 struct ForeachStackInfo {
     int id;
 };
 
 struct TypeGroupList {
-    QList<ushort> entries;
+    QVector<ushort> entries; // sorted by slot
 };
 
 namespace FunctionTable
@@ -1,5 +1,130 @@
 #include "includes.hpp"
 
+#if defined(Q_OS_WIN)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+// the storage can't move once a game has pointers into it, so the whole limit is reserved as address
+// space and pages are only committed once they're actually used
+
+static int *reserveMemory(uint size)
+{
+#if defined(Q_OS_WIN)
+    return (int *)VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_NOACCESS);
+#else
+    void *memory = mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return memory == MAP_FAILED ? NULL : (int *)memory;
+#endif
+}
+
+static void releaseMemory(int *memory, uint size)
+{
+#if defined(Q_OS_WIN)
+    Q_UNUSED(size);
+    VirtualFree(memory, 0, MEM_RELEASE);
+#else
+    munmap(memory, size);
+#endif
+}
+
+static bool commitMemory(byte *memory, uint size)
+{
+#if defined(Q_OS_WIN)
+    return VirtualAlloc(memory, size, MEM_COMMIT, PAGE_READWRITE) != NULL;
+#else
+    return mprotect(memory, size, PROT_READ | PROT_WRITE) == 0;
+#endif
+}
+
+static void decommitMemory(byte *memory, uint size)
+{
+#if defined(Q_OS_WIN)
+    VirtualFree(memory, size, MEM_DECOMMIT);
+#else
+    // mapping over the range hands the pages back and leaves them reserved
+    mmap(memory, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+#endif
+}
+
+static bool commitStorage(DataStorage *storage, uint size)
+{
+    if (size <= storage->committedStorage)
+        return true;
+
+    uint commitSize = (size + STORAGE_COMMIT_SIZE - 1) & -STORAGE_COMMIT_SIZE;
+    commitSize      = qMin(commitSize, storage->storageLimit);
+
+    byte *memory = (byte *)storage->memoryTable;
+    if (!commitMemory(memory + storage->committedStorage, commitSize - storage->committedStorage))
+        return false;
+
+    storage->committedStorage = commitSize;
+    return true;
+}
+
+static void trimStorage(DataStorage *storage)
+{
+    // keep one step of slack around so allocating right after a compaction doesn't recommit
+    uint usedSize = sizeof(int) * storage->usedStorage;
+    uint keepSize = ((usedSize + STORAGE_COMMIT_SIZE - 1) & -STORAGE_COMMIT_SIZE) + STORAGE_COMMIT_SIZE;
+    keepSize      = qMin(keepSize, storage->committedStorage);
+
+    byte *memory = (byte *)storage->memoryTable;
+    if (keepSize < storage->committedStorage) {
+        decommitMemory(memory + keepSize, storage->committedStorage - keepSize);
+        storage->committedStorage = keepSize;
+    }
+}
+
+static bool setStorageEntry(DataStorage *storage, int **data)
+{
+    auto slot = storage->entryLookup.constFind(data);
+    if (slot != storage->entryLookup.cend()) {
+        storage->storageEntries[slot.value()] = *data;
+        return true;
+    }
+
+    if (storage->entryCount >= STORAGE_ENTRY_COUNT)
+        return false;
+
+    uint e                     = storage->entryCount++;
+    storage->dataEntries[e]    = data;
+    storage->storageEntries[e] = *data;
+    storage->entryLookup.insert(data, e);
+    return true;
+}
+
+static void removeEntry(DataStorage *storage, uint e)
+{
+    storage->entryLookup.remove(storage->dataEntries[e]);
+
+    // entry order doesn't matter, so the last entry just takes over the slot
+    uint last = --storage->entryCount;
+    if (e != last) {
+        storage->dataEntries[e]    = storage->dataEntries[last];
+        storage->storageEntries[e] = storage->storageEntries[last];
+        storage->entryLookup.insert(storage->dataEntries[e], e);
+    }
+
+    storage->dataEntries[last]    = NULL;
+    storage->storageEntries[last] = NULL;
+}
+
+static inline DataStorageHeader *getStorageHeader(int *data)
+{
+    return (DataStorageHeader *)(data - STORAGE_HEADER_SIZE);
+}
+
+static inline uint getBlockSize(DataStorageHeader *entry)
+{
+    return ((uint)entry->dataSize >> 2) + STORAGE_HEADER_SIZE; // size (in ints)
+}
+
 void initStorage(DataStorage *storages)
 {
     if (!storages)
@@ -11,11 +136,16 @@ void initStorage(DataStorage *storages)
     storages[DATASET_TMP].storageLimit = 8 * 0x100000;
 
     for (int s = 0; s < DATASET_MAX; ++s) {
-        storages[s].memoryTable = (int *)malloc(storages[s].storageLimit);
-
-        storages[s].usedStorage = 0;
-        storages[s].entryCount  = 0;
-        storages[s].clearCount  = 0;
+        storages[s].memoryTable = reserveMemory(storages[s].storageLimit);
+
+        storages[s].usedStorage      = 0;
+        storages[s].committedStorage = 0;
+        storages[s].peakStorage      = 0;
+        storages[s].entryCount       = 0;
+        storages[s].clearCount       = 0;
+        storages[s].lastCompactTime  = 0;
+        storages[s].totalCompactTime = 0;
+        storages[s].entryLookup.clear();
     }
 }
 
@@ -26,12 +156,34 @@ void releaseStorage(DataStorage *storages)
 
     for (int s = 0; s < DATASET_MAX; ++s) {
         if (storages[s].memoryTable)
-            free(storages[s].memoryTable);
+            releaseMemory(storages[s].memoryTable, storages[s].storageLimit);
+
+        storages[s].memoryTable      = NULL;
+        storages[s].usedStorage      = 0;
+        storages[s].committedStorage = 0;
+        storages[s].entryCount       = 0;
+        storages[s].clearCount       = 0;
+        storages[s].entryLookup.clear();
+    }
+}
 
-        storages[s].memoryTable = NULL;
+void resetStorage(DataStorage *storages)
+{
+    if (!storages)
+        return;
+
+    for (int s = 0; s < DATASET_MAX; ++s) {
         storages[s].usedStorage = 0;
         storages[s].entryCount  = 0;
         storages[s].clearCount  = 0;
+        storages[s].entryLookup.clear();
+        memset(storages[s].dataEntries, 0, sizeof(storages[s].dataEntries));
+        memset(storages[s].storageEntries, 0, sizeof(storages[s].storageEntries));
+
+        if (storages[s].memoryTable && storages[s].committedStorage) {
+            decommitMemory((byte *)storages[s].memoryTable, storages[s].committedStorage);
+            storages[s].committedStorage = 0;
+        }
     }
 }
 
@@ -51,65 +203,51 @@ void allocateStorage(DataStorage *storages, uint size, void **dataPtr, StorageDa
     int **data = (int **)dataPtr;
     *data      = NULL;
 
-    if ((uint)dataSet < DATASET_MAX) {
-        DataStorage *storage = &storages[dataSet];
-
-        if ((size & -4) < size)
-            size = (size & -4) + sizeof(int);
-
-        if (storage->entryCount < STORAGE_ENTRY_COUNT) {
-            if (size + sizeof(int) * storage->usedStorage >= storage->storageLimit) {
-                clearUnusedStorage(storages, dataSet);
-
-                if (size + sizeof(int) * storage->usedStorage >= storage->storageLimit) {
-                    if (storage->entryCount >= STORAGE_ENTRY_COUNT)
-                        cleanEmptyStorage(storages, dataSet);
-
-                    if (*data && clear)
-                        memset(*data, 0, size);
-                }
-                else {
-                    DataStorageHeader *entry =
-                        (DataStorageHeader *)&storage->memoryTable[storage->usedStorage];
-
-                    entry->active     = true;
-                    entry->setID      = dataSet;
-                    entry->dataOffset = storage->usedStorage + STORAGE_HEADER_SIZE;
-                    entry->dataSize   = size;
-
-                    storage->usedStorage += STORAGE_HEADER_SIZE;
-                    *data = &storage->memoryTable[storage->usedStorage];
-                    storage->usedStorage += size / sizeof(int);
-
-                    storage->dataEntries[storage->entryCount]    = data;
-                    storage->storageEntries[storage->entryCount] = *data;
-                }
-            }
-            else {
-                DataStorageHeader *entry =
-                    (DataStorageHeader *)&storage->memoryTable[storage->usedStorage];
-
-                entry->active     = true;
-                entry->setID      = dataSet;
-                entry->dataOffset = storage->usedStorage + STORAGE_HEADER_SIZE;
-                entry->dataSize   = size;
-
-                storage->usedStorage += STORAGE_HEADER_SIZE;
-                *data = &storage->memoryTable[storage->usedStorage];
-                storage->usedStorage += size / sizeof(int);
-
-                storage->dataEntries[storage->entryCount]    = data;
-                storage->storageEntries[storage->entryCount] = *data;
-            }
-
-            ++storage->entryCount;
-            if (storage->entryCount >= STORAGE_ENTRY_COUNT)
-                cleanEmptyStorage(storages, dataSet);
-
-            if (*data && clear)
-                memset(*data, 0, size);
-        }
+    if ((uint)dataSet >= DATASET_MAX)
+        return;
+
+    DataStorage *storage = &storages[dataSet];
+    if (!storage->memoryTable)
+        return;
+
+    if ((size & -4) < size)
+        size = (size & -4) + sizeof(int);
+
+    uint blockSize = size + STORAGE_HEADER_SIZE * sizeof(int);
+    if (blockSize + sizeof(int) * storage->usedStorage > storage->storageLimit) {
+        clearUnusedStorage(storages, dataSet);
+
+        if (blockSize + sizeof(int) * storage->usedStorage > storage->storageLimit)
+            return;
     }
+
+    // *data was cleared above, so whatever this variable used to point to is already stale
+    if (storage->entryCount >= STORAGE_ENTRY_COUNT && !storage->entryLookup.contains(data)) {
+        cleanEmptyStorage(storages, dataSet);
+
+        if (storage->entryCount >= STORAGE_ENTRY_COUNT)
+            return;
+    }
+
+    if (!commitStorage(storage, blockSize + sizeof(int) * storage->usedStorage))
+        return;
+
+    DataStorageHeader *entry = (DataStorageHeader *)&storage->memoryTable[storage->usedStorage];
+
+    entry->active     = true;
+    entry->setID      = dataSet;
+    entry->dataOffset = storage->usedStorage + STORAGE_HEADER_SIZE;
+    entry->dataSize   = size;
+
+    storage->usedStorage += STORAGE_HEADER_SIZE;
+    *data = &storage->memoryTable[storage->usedStorage];
+    storage->usedStorage += size / sizeof(int);
+    storage->peakStorage = qMax(storage->peakStorage, storage->usedStorage);
+
+    setStorageEntry(storage, data);
+
+    if (clear)
+        memset(*data, 0, size);
 }
 
 void removeStorageEntry(DataStorage *storages, void **dataPtr)
@@ -121,34 +259,12 @@ void removeStorageEntry(DataStorage *storages, void **dataPtr)
         if (*dataPtr) {
             int **data = (int **)dataPtr;
 
-            DataStorageHeader *entry = (DataStorageHeader *)(*data - STORAGE_HEADER_SIZE);
-            int set                  = entry->setID;
-
-            for (uint e = 0; e < storages[set].entryCount; ++e) {
-                if (data == storages[set].dataEntries[e])
-                    storages[set].dataEntries[e] = NULL;
-            }
-
-            uint newEntryCount = 0;
-            for (uint entryID = 0; entryID < storages[set].entryCount; ++entryID) {
-                if (storages[set].dataEntries[entryID]) {
-                    if (entryID != newEntryCount) {
-                        storages[set].dataEntries[newEntryCount] = storages[set].dataEntries[entryID];
-                        storages[set].storageEntries[newEntryCount] =
-                            storages[set].storageEntries[entryID];
-                        storages[set].dataEntries[entryID]    = NULL;
-                        storages[set].storageEntries[entryID] = NULL;
-                    }
-
-                    newEntryCount++;
-                }
-            }
-            storages[set].entryCount = newEntryCount;
-
-            for (int e = storages[set].entryCount; e < STORAGE_ENTRY_COUNT; ++e) {
-                storages[set].dataEntries[e]    = NULL;
-                storages[set].storageEntries[e] = NULL;
-            }
+            DataStorageHeader *entry = getStorageHeader(*data);
+            DataStorage *storage     = &storages[entry->setID];
+
+            auto slot = storage->entryLookup.constFind(data);
+            if (slot != storage->entryLookup.cend())
+                removeEntry(storage, slot.value());
 
             entry->active = false;
         }
@@ -157,92 +273,76 @@ void removeStorageEntry(DataStorage *storages, void **dataPtr)
 
 void clearUnusedStorage(DataStorage *storages, StorageDataSets set)
 {
-    if (!storages)
+    if (!storages || (uint)set >= DATASET_MAX)
+        return;
+
+    DataStorage *storage = &storages[set];
+    if (!storage->memoryTable)
         return;
 
-    ++storages[set].clearCount;
+    QElapsedTimer timer;
+    timer.start();
+
+    ++storage->clearCount;
 
     cleanEmptyStorage(storages, set);
 
-    if (storages[set].usedStorage) {
-        int curStorageSize = 0;
-        int newStorageSize = 0;
-        uint usedStorage   = 0;
-
-        int *curMemTablePtr = storages[set].memoryTable;
-        int *newMemTablePtr = storages[set].memoryTable;
-
-        for (uint memPos = 0; memPos < storages[set].usedStorage;) {
-            DataStorageHeader *curEntry = (DataStorageHeader *)curMemTablePtr;
-
-            int size         = ((uint)curEntry->dataSize >> 2) + STORAGE_HEADER_SIZE;
-            curEntry->active = false;
-
-            int *dataPtr = &storages[set].memoryTable[curEntry->dataOffset];
-
-            bool32 noCopy = true;
-            if (storages[set].entryCount) {
-                for (uint e = 0; e < storages[set].entryCount; ++e) {
-                    if (dataPtr == storages[set].storageEntries[e])
-                        curEntry->active = true;
-                }
-
-                if (curEntry->active) {
-                    noCopy = false;
-
-                    curStorageSize += size;
-                    memPos = curStorageSize;
-
-                    if (curMemTablePtr <= newMemTablePtr) {
-                        newMemTablePtr += size;
-                        curMemTablePtr += size;
-                    }
-                    else {
-                        for (; size; --size) {
-                            *newMemTablePtr++ = *curMemTablePtr++;
-                        }
-                    }
-
-                    usedStorage = newStorageSize;
-                }
-            }
-
-            if (noCopy) {
-                curMemTablePtr += size;
-                newStorageSize += size;
-                curStorageSize += size;
-
-                memPos      = curStorageSize;
-                usedStorage = newStorageSize;
-            }
+    int *memory = storage->memoryTable;
+
+    // a block is only worth keeping if something still points to it
+    for (uint memPos = 0; memPos < storage->usedStorage;) {
+        DataStorageHeader *entry = (DataStorageHeader *)&memory[memPos];
+        entry->active            = false;
+        memPos += getBlockSize(entry);
+    }
+
+    for (uint e = 0; e < storage->entryCount; ++e)
+        getStorageHeader(storage->storageEntries[e])->active = true;
+
+    // work out where every block ends up while all the headers are still in place...
+    uint newPos = 0;
+    for (uint memPos = 0; memPos < storage->usedStorage;) {
+        DataStorageHeader *entry = (DataStorageHeader *)&memory[memPos];
+        uint size                = getBlockSize(entry);
+
+        if (entry->active) {
+            entry->dataOffset = newPos + STORAGE_HEADER_SIZE;
+            newPos += size;
         }
+        memPos += size;
+    }
+
+    // ...point the variables at the new spots...
+    for (uint e = 0; e < storage->entryCount; ++e) {
+        int *dataPtr = &memory[getStorageHeader(storage->storageEntries[e])->dataOffset];
+
+        *storage->dataEntries[e]   = dataPtr;
+        storage->storageEntries[e] = dataPtr;
+    }
 
-        if (usedStorage) {
-            bool32 noEntriesRemoved = storages[set].usedStorage != usedStorage;
-            storages[set].usedStorage -= usedStorage;
-
-            int *memory = storages[set].memoryTable;
-            if (noEntriesRemoved) {
-                for (uint memPos = 0; memPos < storages[set].usedStorage;) {
-                    DataStorageHeader *entry = (DataStorageHeader *)memory;
-
-                    int *dataPtr = &storages[set].memoryTable[entry->dataOffset];
-                    int size     = ((uint)entry->dataSize >> 2) + STORAGE_HEADER_SIZE; // size (in ints)
-
-                    for (uint c = 0; c < storages[set].entryCount; ++c) {
-                        if (dataPtr == storages[set].storageEntries[c]) {
-                            *storages[set].dataEntries[c]   = memory + STORAGE_HEADER_SIZE;
-                            storages[set].storageEntries[c] = memory + STORAGE_HEADER_SIZE;
-                        }
-                    }
-
-                    entry->dataOffset = memPos + STORAGE_HEADER_SIZE;
-                    memPos += size;
-                    memory += size;
-                }
-            }
+    // ...then slide each run of live blocks down in one go
+    uint usedStorage = 0;
+    for (uint memPos = 0; memPos < storage->usedStorage;) {
+        DataStorageHeader *entry = (DataStorageHeader *)&memory[memPos];
+        if (!entry->active) {
+            memPos += getBlockSize(entry);
+            continue;
         }
+
+        uint runStart = memPos;
+        while (memPos < storage->usedStorage && ((DataStorageHeader *)&memory[memPos])->active)
+            memPos += getBlockSize((DataStorageHeader *)&memory[memPos]);
+
+        if (usedStorage != runStart)
+            memmove(&memory[usedStorage], &memory[runStart], (memPos - runStart) * sizeof(int));
+        usedStorage += memPos - runStart;
     }
+
+    storage->usedStorage = usedStorage;
+    trimStorage(storage);
+
+    storage->lastCompactTime = timer.nsecsElapsed();
+    storage->totalCompactTime += storage->lastCompactTime;
 }
 
 void copyStorage(DataStorage *storages, int **src, int **dst)
@@ -250,19 +350,15 @@ void copyStorage(DataStorage *storages, int **src, int **dst)
     if (!storages)
         return;
 
-    if (src) {
-        int *dstPtr = *dst;
-        *src        = *dst;
-
-        DataStorageHeader *entry = (DataStorageHeader *)(dstPtr - 4);
-        int setID                = entry->setID;
+    if (src && dst && *dst) {
+        *src = *dst;
 
-        if (storages[setID].entryCount < STORAGE_ENTRY_COUNT) {
-            storages[setID].dataEntries[storages[setID].entryCount]    = src;
-            storages[setID].storageEntries[storages[setID].entryCount] = *src;
+        DataStorageHeader *entry = getStorageHeader(*dst);
+        StorageDataSets setID    = (StorageDataSets)entry->setID;
 
-            if (storages[setID].entryCount >= STORAGE_ENTRY_COUNT)
-                cleanEmptyStorage(storages, (StorageDataSets)setID);
+        if (!setStorageEntry(&storages[setID], src)) {
+            cleanEmptyStorage(storages, setID);
+            setStorageEntry(&storages[setID], src);
         }
     }
 }
@@ -275,34 +371,88 @@ void cleanEmptyStorage(DataStorage *storages, StorageDataSets set)
     if ((uint)set < DATASET_MAX) {
         DataStorage *storage = &storages[set];
 
-        for (uint e = 0; e < storage->entryCount; ++e) {
+        for (uint e = 0; e < storage->entryCount;) {
             // So what's happening here is the engine is checking to see if the storage entry
             // (which is the pointer to the "memoryTable" offset that is allocated for this entry)
             // matches what the actual variable that allocated the storage is currently pointing to.
             // if they don't match, the storage entry is considered invalid and marked for removal.
 
-            if (storage->dataEntries[e] && *storage->dataEntries[e] != storage->storageEntries[e])
-                storage->dataEntries[e] = NULL;
+            if (*storage->dataEntries[e] != storage->storageEntries[e])
+                removeEntry(storage, e); // the last entry moved into "e", so check it again
+            else
+                ++e;
         }
+    }
+}
 
-        uint newEntryCount = 0;
-        for (uint entryID = 0; entryID < storage->entryCount; ++entryID) {
-            if (storage->dataEntries[entryID]) {
-                if (entryID != newEntryCount) {
-                    storage->dataEntries[newEntryCount]    = storage->dataEntries[entryID];
-                    storage->storageEntries[newEntryCount] = storage->storageEntries[entryID];
-                    storage->dataEntries[entryID]          = NULL;
-                    storage->storageEntries[entryID]       = NULL;
-                }
-
-                newEntryCount++;
-            }
-        }
-        storage->entryCount = newEntryCount;
+DataStorageStats getStorageStats(DataStorage *storages, StorageDataSets set)
+{
+    DataStorageStats stats;
+    if (!storages || (uint)set >= DATASET_MAX)
+        return stats;
+
+    DataStorage *storage = &storages[set];
+
+    stats.usedBytes        = storage->usedStorage * sizeof(int);
+    stats.committedBytes   = storage->committedStorage;
+    stats.reservedBytes    = storage->memoryTable ? storage->storageLimit : 0;
+    stats.peakBytes        = storage->peakStorage * sizeof(int);
+    stats.entryCount       = storage->entryCount;
+    stats.clearCount       = storage->clearCount;
+    stats.lastCompactTime  = storage->lastCompactTime;
+    stats.totalCompactTime = storage->totalCompactTime;
+
+    int *memory = storage->memoryTable;
+    if (!memory)
+        return stats;
+
+    // what the compaction would keep, worked out on the side since the game still owns the headers
+    QSet<int *> live;
+    live.reserve(storage->entryCount);
+    for (uint e = 0; e < storage->entryCount; ++e) {
+        if (*storage->dataEntries[e] == storage->storageEntries[e])
+            live.insert(storage->storageEntries[e]);
+    }
 
-        for (int e = storage->entryCount; e < STORAGE_ENTRY_COUNT; ++e) {
-            storage->dataEntries[e]    = NULL;
-            storage->storageEntries[e] = NULL;
-        }
+    for (uint memPos = 0; memPos < storage->usedStorage;) {
+        DataStorageHeader *entry = (DataStorageHeader *)&memory[memPos];
+        uint size                = getBlockSize(entry);
+
+        if (live.contains(&memory[memPos + STORAGE_HEADER_SIZE]))
+            stats.liveBytes += size * sizeof(int);
+        ++stats.blockCount;
+        memPos += size;
     }
+
+    if (stats.usedBytes)
+        stats.fragmentation = 1.0f - (stats.liveBytes / (float)stats.usedBytes);
+
+    return stats;
+}
+
+QStringList storageSummary(DataStorage *storages)
+{
+    QStringList lines;
+    if (!storages)
+        return lines;
+
+    const char *setNames[] = { "STG", "STR", "TMP" };
+    for (int s = 0; s < DATASET_MAX; ++s) {
+        DataStorageStats stats = getStorageStats(storages, (StorageDataSets)s);
+
+        lines.append(QString("%1: %2/%3 KB live, %4 KB committed, %5 KB peak, %6% fragmented")
+                         .arg(setNames[s])
+                         .arg(stats.liveBytes / 1024)
+                         .arg(stats.usedBytes / 1024)
+                         .arg(stats.committedBytes / 1024)
+                         .arg(stats.peakBytes / 1024)
+                         .arg(stats.fragmentation * 100.0f, 0, 'f', 1));
+        lines.append(QString("     %1 entries, %2 blocks, %3 compactions (last %4 ms)")
+                         .arg(stats.entryCount)
+                         .arg(stats.blockCount)
+                         .arg(stats.clearCount)
+                         .arg(stats.lastCompactTime / 1e6f, 0, 'f', 3));
+    }
+
+    return lines;
 }
@@ -2,6 +2,8 @@
 
 #define STORAGE_ENTRY_COUNT (0x1000)
 #define STORAGE_HEADER_SIZE (sizeof(DataStorageHeader) / sizeof(int))
+// the full limit is reserved up front, but memory is only committed in steps of this many bytes
+#define STORAGE_COMMIT_SIZE (0x10000)
 
 enum StorageDataSets {
     DATASET_STG,
@@ -11,13 +13,21 @@ enum StorageDataSets {
 };
 
 struct DataStorage {
-    int *memoryTable;
-    uint usedStorage;
-    uint storageLimit;
+    int *memoryTable      = NULL;
+    uint usedStorage      = 0; // in ints
+    uint storageLimit     = 0; // in bytes
+    uint committedStorage = 0; // in bytes
+    uint peakStorage      = 0; // in ints
     int **dataEntries[STORAGE_ENTRY_COUNT];   // pointer to the actual variable
     int *storageEntries[STORAGE_ENTRY_COUNT]; // pointer to the storage in "memoryTable"
-    uint entryCount;
-    uint clearCount;
+    uint entryCount = 0;
+    uint clearCount = 0;
+
+    // variable address -> index into dataEntries/storageEntries
+    QHash<int **, uint> entryLookup;
+
+    qint64 lastCompactTime  = 0; // nsecs
+    qint64 totalCompactTime = 0;
 };
 
 struct DataStorageHeader {
@@ -29,8 +39,25 @@ struct DataStorageHeader {
     // don't need to be here
 };
 
+struct DataStorageStats {
+    uint usedBytes      = 0; // headers included
+    uint liveBytes      = 0; // blocks that are still referenced by a variable
+    uint committedBytes = 0;
+    uint reservedBytes  = 0;
+    uint peakBytes      = 0;
+    uint entryCount     = 0;
+    uint blockCount     = 0;
+    uint clearCount     = 0;
+    float fragmentation = 0; // share of usedBytes the next compaction would reclaim
+
+    qint64 lastCompactTime  = 0;
+    qint64 totalCompactTime = 0;
+};
+
 void initStorage(DataStorage *dataStorage);
 void releaseStorage(DataStorage *dataStorage);
+// drops every entry and decommits the memory, but keeps the reservations around
+void resetStorage(DataStorage *dataStorage);
 
 void allocateStorage(DataStorage *dataStorage, uint size, void **dataPtr, StorageDataSets dataSet,
                      bool32 clear);
@@ -39,4 +66,5 @@ void removeStorageEntry(DataStorage *dataStorage, void **dataPtr);
 void copyStorage(DataStorage *dataStorage, int **src, int **dst);
 void cleanEmptyStorage(DataStorage *dataStorage, StorageDataSets dataSet);
 
-
+DataStorageStats getStorageStats(DataStorage *dataStorage, StorageDataSets set);
+QStringList storageSummary(DataStorage *dataStorage);
@@ -161,18 +161,43 @@ ModelManager::ModelManager(QString filePath, bool usev5Format, QWidget *parent)
     });
 
     connect(ui->impMDL, &QPushButton::pressed, [this] {
-        QFileDialog filedialog(this, tr("Load Model Frame"), "",
-                               tr(QString("PLY Models (*.ply)").toStdString().c_str()));
+        QString filters = "Models (*.ply *.obj);;PLY Models (*.ply);;OBJ Models (*.obj)";
+        QFileDialog filedialog(this, tr("Load Model Frames"), "", tr(filters.toStdString().c_str()));
         filedialog.setAcceptMode(QFileDialog::AcceptOpen);
+        filedialog.setFileMode(QFileDialog::ExistingFiles);
         if (filedialog.exec() == QDialog::Accepted) {
-            QString selFile = filedialog.selectedFiles()[0];
-
+            // every file adds its frames in order, the exporters write one file per frame
             RSDKv5::Model mdl;
-            // read
-            mdl.loadPLY(selFile);
+            for (QString &selFile : filedialog.selectedFiles()) {
+                RSDKv5::Model part;
+                // read
+                if (QFileInfo(selFile).suffix().toLower() == "obj")
+                    part.loadOBJ(selFile);
+                else
+                    part.loadPLY(selFile);
+
+                if (!mdl.frames.count()) {
+                    mdl = part;
+                    continue;
+                }
+
+                if (part.frames[0].vertices.count() != mdl.frames[0].vertices.count()) {
+                    QMessageBox msgBox(QMessageBox::Information, "RetroED",
+                                       QString("Different number of vertices between the "
+                                               "frames.\nExpected %1 vertices, but loaded %2 "
+                                               "vertices.\nAborting import.")
+                                           .arg(mdl.frames[0].vertices.count())
+                                           .arg(part.frames[0].vertices.count()),
+                                       QMessageBox::NoButton);
+                    msgBox.exec();
+                    return;
+                }
+
+                mdl.frames.append(part.frames);
+            }
             mdl.filePath = "Imported Model";
 
-            if (!mdl.frames.count()) {
+            if (!mdl.frames.count() || !mdl.frames[0].vertices.count()) {
                 QMessageBox msgBox(
                     QMessageBox::Information, "RetroED",
                     QString("No Vertices were loaded from the imported model.\nAborting import."),
@@ -181,6 +206,17 @@ ModelManager::ModelManager(QString filePath, bool usev5Format, QWidget *parent)
                 return;
             }
 
+            // indices are stored as ushorts
+            if (mdl.frames[0].vertices.count() > 0x10000) {
+                QMessageBox msgBox(QMessageBox::Information, "RetroED",
+                                   QString("Models can only hold 65536 vertices, but loaded %1 "
+                                           "vertices.\nAborting import.")
+                                       .arg(mdl.frames[0].vertices.count()),
+                                   QMessageBox::NoButton);
+                msgBox.exec();
+                return;
+            }
+
             if (viewer->model.frames.count() > 1 && mdl.frames.count() >= 1) {
                 if (mdl.frames[0].vertices.count() != viewer->model.frames[0].vertices.count()) {
                     QMessageBox msgBox(QMessageBox::Information, "RetroED",
@@ -216,9 +252,12 @@ ModelManager::ModelManager(QString filePath, bool usev5Format, QWidget *parent)
                 if (c >= (uint)viewer->model.frames.count())
                     c = 0;
 
+                // the first frame replaces the selected one, the rest go in after it
                 viewer->model.frames[c].vertices.clear();
                 for (auto &vertex : mdl.frames[0].vertices)
                     viewer->model.frames[c].vertices.append(vertex);
+                for (int f = 1; f < mdl.frames.count(); ++f)
+                    viewer->model.frames.insert(c + f, mdl.frames[f]);
 
                 viewer->setFrame(c);
             }
@@ -573,7 +612,7 @@ void ModelManager::ProcessAnimation()
         }
     }
 
-    viewer->setFrame(currentFrame);
+    viewer->setFrame(currentFrame, false);
     viewer->repaint();
 }
 
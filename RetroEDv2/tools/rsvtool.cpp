@@ -32,15 +32,33 @@ RSVTool::RSVTool(QWidget *parent) : QDialog(parent), ui(new Ui::RSVTool)
             QString path = filedialog.selectedFiles()[0];
             QDir(QDir::tempPath()).mkpath(path + "/Frames/");
             SetStatus("Loading RSV...", true);
-            RSDKv3::Video rsv(rsvPath);
+            Reader reader(rsvPath);
+            RSDKv3::Video rsv;
+            rsv.readIndex(reader);
 
-            int id = 0;
+            // frames are decoded & written a batch at a time so the whole video never has to be
+            // in memory at once
+            int frameCount = rsv.frameIndex.count();
+            ushort w = rsv.width, h = rsv.height;
             SetStatus("Extracting Frames...", true);
-            for (auto &f : rsv.frames) {
-                f.write(QString(path + "/Frames/Frame%1.gif").arg(id++, 6, 10, QLatin1Char('0')));
-                SetStatusProgress((float)id / rsv.frames.count());
+            for (int f = 0; f < frameCount; f += RSDKv3::Video::batchSize()) {
+                int count = qMin(RSDKv3::Video::batchSize(), frameCount - f);
+
+                QList<QFuture<void>> tasks;
+                for (int i = 0; i < count; ++i) {
+                    QByteArray data = rsv.readFrameData(reader, f + i);
+                    QString framePath =
+                        QString(path + "/Frames/Frame%1.gif").arg(f + i, 6, 10, QLatin1Char('0'));
+
+                    tasks.append(QtConcurrent::run([data, w, h, framePath] {
+                        RSDKv3::Video::decodeFrame(data, w, h).write(framePath);
+                    }));
+                }
+
+                for (auto &task : tasks) task.waitForFinished();
+                SetStatusProgress((float)(f + count) / frameCount);
             }
-            SetStatus(QString("Extracted %1 Frames to: %2/Frames/").arg(rsv.frames.count()).arg(path));
+            SetStatus(QString("Extracted %1 Frames to: %2/Frames/").arg(frameCount).arg(path));
         }
     });
 
@@ -74,31 +92,42 @@ RSVTool::RSVTool(QWidget *parent) : QDialog(parent), ui(new Ui::RSVTool)
             std::sort(framePaths.begin(), framePaths.end(),
                       [](const QString &a, const QString &b) -> bool { return a < b; });
 
-            SetStatus("Importing Frames...", true);
-            RSDKv3::Video rsv;
-            int w = -1, h = -1;
+            if (!framePaths.count()) {
+                SetStatus("No frames to import!");
+                return;
+            }
 
-            for (QString path : framePaths) {
-                FormatHelpers::Gif frame;
-                frame.read(path);
+            // the first frame decides the video size
+            FormatHelpers::Gif firstFrame;
+            firstFrame.read(framePaths[0]);
 
-                if (w == -1)
-                    w = rsv.width = frame.width;
-                // else if (w != frame.width)
-                //     throw new Exception($ "Frame sizes have to match! {f.Name} width did not
-                //     match!");
+            RSDKv3::Video rsv;
+            rsv.width  = firstFrame.width;
+            rsv.height = firstFrame.height;
 
-                if (h == -1)
-                    h = rsv.height = frame.height;
-                // else if (h != frame.height)
-                //     throw new Exception($ "Frame sizes have to match! {f.Name} height did not
-                //     match!");
+            Writer writer(savePath);
+            rsv.writeHeader(writer, framePaths.count());
 
-                rsv.frames.append(frame);
+            // frames are loaded & encoded a batch at a time, then written in order
+            SetStatus("Saving RSV...", true);
+            for (int f = 0; f < framePaths.count(); f += RSDKv3::Video::batchSize()) {
+                int count = qMin(RSDKv3::Video::batchSize(), framePaths.count() - f);
+
+                QList<QFuture<QByteArray>> tasks;
+                for (int i = 0; i < count; ++i) {
+                    QString framePath = framePaths[f + i];
+                    tasks.append(QtConcurrent::run([framePath] {
+                        FormatHelpers::Gif frame;
+                        frame.read(framePath);
+                        return RSDKv3::Video::encodeFrame(frame);
+                    }));
+                }
+
+                for (auto &task : tasks) RSDKv3::Video::writeFrameData(writer, task.result());
+                SetStatusProgress((float)(f + count) / framePaths.count());
             }
+            writer.flush();
 
-            SetStatus("Saving RSV...", true);
-            rsv.write(savePath);
             SetStatus(QString("Saved RSV %1").arg(savePath));
         }
     });
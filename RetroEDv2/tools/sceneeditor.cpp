@@ -28,6 +28,8 @@
 #include "sceneproperties/createscene.hpp"
 #include "sceneproperties/syncgcdetails.hpp"
 
+#include "utils/tilededuplicator.hpp"
+
 #include <RSDKv1/gfxv1.hpp>
 #include <RSDKv1/tileconfigv1.hpp>
 #include <RSDKv4/tileconfigv4.hpp>
@@ -291,6 +293,7 @@ SceneEditor::SceneEditor(QWidget *parent) : QWidget(parent), ui(new Ui::SceneEdi
         SceneObject info;
         info.name = "New Object";
         viewer->objects.append(info);
+        viewer->filterVars.invalidate();
 
         auto *item = new QListWidgetItem();
         item->setText("New Object");
@@ -312,6 +315,7 @@ SceneEditor::SceneEditor(QWidget *parent) : QWidget(parent), ui(new Ui::SceneEdi
             globalCount = gameConfig.objects.count() + 1;
         viewer->objects.removeAt(c);
         stageConfig.objects.removeAt(c - globalCount);
+        viewer->filterVars.invalidate();
         ui->objectList->blockSignals(true);
         ui->objectList->setCurrentRow(n);
         ui->objectList->blockSignals(false);
@@ -731,6 +735,7 @@ SceneEditor::SceneEditor(QWidget *parent) : QWidget(parent), ui(new Ui::SceneEdi
         stageConfig.loadGlobalScripts = b;
         viewer->disableObjects   = true;
         viewer->disableDrawScene = true;
+        viewer->filterVars.invalidate();
 
         if (stageConfig.loadGlobalScripts) { // assume we had no globals & are now adding em
             viewer->objects.removeAt(0);
@@ -816,6 +821,7 @@ SceneEditor::SceneEditor(QWidget *parent) : QWidget(parent), ui(new Ui::SceneEdi
                     }
                 }
             }
+            viewer->tileUsage.invalidate();
             viewer->chunkset = chunkset;
             viewer->updateChunkColMap();
             chkProp->RefreshList();
@@ -900,6 +906,7 @@ SceneEditor::SceneEditor(QWidget *parent) : QWidget(parent), ui(new Ui::SceneEdi
 
             ++id;
         }
+        viewer->filterVars.invalidate();
 
         for (int o = viewer->entities.count() - 1; o >= 0; --o) {
             SceneEntity &obj = viewer->entities[o];
@@ -945,28 +952,13 @@ SceneEditor::SceneEditor(QWidget *parent) : QWidget(parent), ui(new Ui::SceneEdi
         viewer->disableDrawScene = true;
 
         SetStatus("Rebuilding tiles...", true);
-        viewer->gfxSurface[0].texturePtr = nullptr;
-
-        QImage tileset(0x10, 0x400 * 0x10, QImage::Format_Indexed8);
-
-        QVector<QRgb> pal;
-        for (PaletteColor &col : viewer->tilePalette) pal.append(col.toQColor().rgb());
-        tileset.setColorTable(pal);
         AddStatusProgress(1. / 5); // finished setup
 
-        uchar *pixels = tileset.bits();
-        for (int i = 0; i < 0x400; ++i) {
-            uchar *src = viewer->tiles[i].bits();
-            for (int y = 0; y < 16; ++y) {
-                for (int x = 0; x < 16; ++x) {
-                    *pixels++ = *src++;
-                }
-            }
-        }
+        // only the slots the editor moved or imported over are compared, & only the ones that actually
+        // changed get re-uploaded on the next frame
+        viewer->syncTileAtlas(edit->editedTiles());
         AddStatusProgress(1. / 5); // finished copying tiles
 
-        viewer->gfxSurface[0].texturePtr = viewer->createTexture(tileset, QOpenGLTexture::Target2D);
-
         for (int i = 0; i < 0x200; ++i) {
             for (int y = 0; y < 8; ++y) {
                 for (int x = 0; x < 8; ++x) {
@@ -985,9 +977,7 @@ SceneEditor::SceneEditor(QWidget *parent) : QWidget(parent), ui(new Ui::SceneEdi
         }
         AddStatusProgress(1. / 5); // finished updating collision masks
 
-        viewer->chunks.clear();
-        for (FormatHelpers::Chunks::Chunk &c : viewer->chunkset.chunks)
-            viewer->chunks.append(c.getImage(viewer->tiles));
+        viewer->chunks = viewer->chunkset.getImages(viewer->tiles);
 
         chkProp->RefreshList();
 
@@ -1132,6 +1122,7 @@ SceneEditor::SceneEditor(QWidget *parent) : QWidget(parent), ui(new Ui::SceneEdi
 
             ++id;
         }
+        viewer->filterVars.invalidate();
 
         for (int o = viewer->entities.count() - 1; o >= 0; --o) {
             SceneEntity &obj = viewer->entities[o];
@@ -1206,6 +1197,7 @@ SceneEditor::SceneEditor(QWidget *parent) : QWidget(parent), ui(new Ui::SceneEdi
 
             ++id;
         }
+        viewer->filterVars.invalidate();
 
         for (int o = viewer->entities.count() - 1; o >= 0; --o) {
             SceneEntity &obj = viewer->entities[o];
@@ -1284,6 +1276,15 @@ SceneEditor::SceneEditor(QWidget *parent) : QWidget(parent), ui(new Ui::SceneEdi
         });
     });
 
+    connect(tileProp->findChunk, &QPushButton::clicked, [this] {
+        if (viewer->selectedChunk != 0xFFFF)
+            FindNextPlacement(viewer->selectedChunk);
+    });
+
+    connect(tileProp->unusedChunks, &QPushButton::clicked, [this] { ShowUnusedChunks(); });
+
+    connect(tileProp->mergeDuplicates, &QPushButton::clicked, [this] { MergeDuplicates(); });
+
     connect(tileProp->replaceTile, &QPushButton::clicked, [this] {
         TileReplaceOptions *dlg = new TileReplaceOptions;
         if (!dlg->exec())
@@ -1393,38 +1394,10 @@ SceneEditor::SceneEditor(QWidget *parent) : QWidget(parent), ui(new Ui::SceneEdi
         AddStatusProgress(1. / 3); // finished updating collision
 
         if (replaceGraphics) {
-            auto &dstTileImg = viewer->tiles[dstTile];
-            auto &srcTileImg = viewer->tiles[srcTile];
-
-            uchar *dstPixels = dstTileImg.bits();
-            uchar *srcPixels = srcTileImg.bits();
-            for (int y = 0; y < 16; ++y) {
-                for (int x = 0; x < 16; ++x) {
-                    *dstPixels++ = *srcPixels++;
-                }
-            }
+            viewer->tileAtlas.copyTile(dstTile, srcTile);
+            viewer->tiles[dstTile] = viewer->tileAtlas.tileImage(dstTile);
         }
 
-        viewer->gfxSurface[0].texturePtr = nullptr;
-
-        QImage tileset(0x10, 0x400 * 0x10, QImage::Format_Indexed8);
-
-        QVector<QRgb> pal;
-        for (PaletteColor &col : viewer->tilePalette) pal.append(col.toQColor().rgb());
-        tileset.setColorTable(pal);
-
-        uchar *pixels = tileset.bits();
-        for (int i = 0; i < 0x400; ++i) {
-            uchar *src = viewer->tiles[i].bits();
-            for (int y = 0; y < 16; ++y) {
-                for (int x = 0; x < 16; ++x) {
-                    *pixels++ = *src++;
-                }
-            }
-        }
-
-        viewer->gfxSurface[0].texturePtr = viewer->createTexture(tileset, QOpenGLTexture::Target2D);
-
         tileProp->setupUI(dstTile, viewer->tiles, viewer, viewer->gameType);
         SetStatus("Finished replacing Tile Info!"); // finished updating graphics
 
@@ -2070,17 +2043,11 @@ bool SceneEditor::eventFilter(QObject *object, QEvent *event)
                             viewer->selectedEntities.clear();
                             viewer->selectedEntitiesXPos.clear();
                             viewer->selectedEntitiesYPos.clear();
+                            viewer->updateFilterVars();
                             for (int e = 0; e < viewer->entities.count(); ++e) {
                                 SceneEntity &entity = viewer->entities[e];
 
-                                int filter = 0xFF;
-                                for (int v = 0; v < viewer->objects[entity.type].variables.count(); ++v) {
-                                    if (viewer->objects[entity.type].variables[v].name == "filter") {
-                                        if (v < entity.variables.count())
-                                            filter = entity.variables[v].value_uint8;
-                                        break;
-                                    }
-                                }
+                                int filter = viewer->entityFilter(entity);
 
                                 if (!(filter & viewer->sceneFilter) && filter)
                                     continue;
@@ -2590,6 +2557,7 @@ void SceneEditor::CreateNewScene(QString scnPath, byte scnVer, bool loadGC, QStr
 
     viewer->objects.clear();
     viewer->entities.clear();
+    viewer->filterVars.invalidate();
 
     SceneObject blankInfo;
     blankInfo.name = "Blank Object";
@@ -2997,6 +2965,7 @@ void SceneEditor::LoadScene(QString scnPath, QString gcfPath, byte gameType)
 
     viewer->objects.clear();
     viewer->entities.clear();
+    viewer->filterVars.invalidate();
 
     SceneObject blankInfo;
     blankInfo.name = "Blank Object";
@@ -3228,15 +3197,10 @@ bool SceneEditor::SaveScene(bool forceSaveAs)
     FormatHelpers::Gif tileset(16, 0x400 * 16);
 
     int c = 0;
-    for (PaletteColor &col : viewer->tilePalette) tileset.palette[c++] = col.toQColor();
+    for (PaletteColor &col : viewer->tilePalette) tileset.palette[c++] = col.toQColor().rgb();
 
-    int pos = 0;
-    for (int i = 0; i < 0x400; ++i) {
-        uchar *src = viewer->tiles[i].bits();
-        for (int y = 0; y < 16; ++y) {
-            for (int x = 0; x < 16; ++x) tileset.pixels[pos++] = *src++;
-        }
-    }
+    // every tile edit goes through the atlas, so its buffer already is the tileset
+    tileset.pixels = viewer->tileAtlas.getPixels();
     AddStatusProgress(1.f / 5); // created tileset
 
     // FG Layer
@@ -3457,6 +3421,135 @@ void SceneEditor::UnloadGameLinks()
     compilerv4->ClearScriptData();
 }
 
+void SceneEditor::FocusCamera(float x, float y)
+{
+    viewer->cameraPos.x = x - ((viewer->storedW / 2) * viewer->invZoom());
+    viewer->cameraPos.y = y - ((viewer->storedH / 2) * viewer->invZoom());
+    if (viewer->cameraPos.x < 0) viewer->cameraPos.x = 0;
+    if (viewer->cameraPos.y < 0) viewer->cameraPos.y = 0;
+    viewer->screens->position.x = viewer->cameraPos.x;
+    viewer->screens->position.y = viewer->cameraPos.y;
+
+    ui->horizontalScrollBar->blockSignals(true);
+    ui->horizontalScrollBar->setValue(viewer->cameraPos.x);
+    ui->horizontalScrollBar->blockSignals(false);
+
+    ui->verticalScrollBar->blockSignals(true);
+    ui->verticalScrollBar->setValue(viewer->cameraPos.y);
+    ui->verticalScrollBar->blockSignals(false);
+}
+
+void SceneEditor::FindNextPlacement(ushort id)
+{
+    viewer->tileUsage.ensure(viewer->layers);
+    auto &placements = viewer->tileUsage.find(id);
+    if (!placements.count()) {
+        SetStatus(QString("Chunk %1 isn't used in any layer").arg(id));
+        return;
+    }
+
+    // pressing it again moves on to the next one
+    if (findID != id) {
+        findID  = id;
+        findPos = 0;
+    }
+    findPos %= placements.count();
+    auto &use = placements[findPos++];
+
+    FocusCamera(use.x * 0x80 + (0x80 / 2), use.y * 0x80 + (0x80 / 2));
+    SetStatus(QString("Chunk %1: %2 of %3, at (%4, %5) on %6")
+                  .arg(id)
+                  .arg(findPos)
+                  .arg(placements.count())
+                  .arg(use.x)
+                  .arg(use.y)
+                  .arg(viewer->layers[use.layer].name));
+}
+
+void SceneEditor::ShowUnusedChunks()
+{
+    viewer->tileUsage.ensure(viewer->layers);
+    QList<ushort> unused = viewer->tileUsage.unused();
+
+    int chunkCount = viewer->gameType == ENGINE_v1 ? 0x100 : 0x200;
+
+    QMessageBox msgBox = QMessageBox(
+        QMessageBox::Information, "Unused Chunks",
+        QString("%1 of %2 chunks aren't used in any layer.").arg(unused.count()).arg(chunkCount),
+        QMessageBox::Ok, this);
+    msgBox.setDetailedText(TileUsageIndex::formatRanges(unused));
+    msgBox.exec();
+}
+
+void SceneEditor::MergeDuplicates()
+{
+    QString text = "Every copy of a tile (flipped copies too) will be replaced with the first one in "
+                   "every chunk, then every copy of a chunk with the first one in every layer. Tiles "
+                   "with collision only merge with unflipped copies that collide the same way, & blank "
+                   "tiles are never merged.\n\nThis changes the stage's chunks, which every scene in "
+                   "the stage shares, & they're saved along with this scene. Tiles that scripts draw "
+                   "into (animated tiles) have to be listed here to be left alone, eg \"0-15, 200\":";
+
+    bool ok       = false;
+    QString input = QInputDialog::getText(this, "Merge Duplicates", text, QLineEdit::Normal,
+                                          mergeExcluded, &ok);
+    if (!ok)
+        return;
+
+    QList<ushort> excluded;
+    if (!TileUsageIndex::parseRanges(input, 0x400, excluded)) {
+        QMessageBox::critical(this, "Merge Duplicates",
+                              QString("\"%1\" isn't a list of tile ids, eg \"0-15, 200\".").arg(input),
+                              QMessageBox::Ok);
+        return;
+    }
+    mergeExcluded = TileUsageIndex::formatRanges(excluded);
+
+    viewer->stopTimer();
+    SetStatus("Merging duplicate tiles...", true);
+
+    auto keys = viewer->gameType == ENGINE_v1 ? TileDeduplicator::collisionKeys(viewer->tileconfigv1)
+                                              : TileDeduplicator::collisionKeys(viewer->tileconfig);
+    AddStatusProgress(1. / 4); // finished setup
+
+    int chunkCount   = viewer->gameType == ENGINE_v1 ? 0x100 : 0x200;
+    auto tileMatches = TileDeduplicator::findTiles(viewer->tileAtlas, 0x400, keys, excluded);
+    int tilesChanged = TileDeduplicator::remapChunks(viewer->chunkset, chunkCount, tileMatches);
+    AddStatusProgress(1. / 4); // finished merging tiles
+
+    // chunks that only differed by which copy of a tile they used match now too
+    auto chunkMatches = TileDeduplicator::findChunks(viewer->chunkset, chunkCount);
+    int chunksChanged = TileDeduplicator::remapLayers(viewer->layers, chunkMatches, 0xFFFF, 0xFFFF);
+    viewer->tileUsage.invalidate();
+    AddStatusProgress(1. / 4); // finished merging chunks
+
+    chunkset       = viewer->chunkset;
+    viewer->chunks = viewer->chunkset.getImages(viewer->tiles);
+    chkProp->RefreshList();
+
+    QList<ushort> freedTiles  = TileDeduplicator::freedIDs(tileMatches);
+    QList<ushort> freedChunks = TileDeduplicator::freedIDs(chunkMatches);
+    if (tilesChanged || chunksChanged)
+        DoAction("Merged Duplicates");
+    SetStatus(QString("Merged %1 duplicate tiles & %2 duplicate chunks")
+                  .arg(freedTiles.count())
+                  .arg(freedChunks.count()));
+
+    viewer->startTimer();
+
+    if (freedTiles.count() || freedChunks.count()) {
+        QMessageBox msgBox = QMessageBox(
+            QMessageBox::Information, "Merge Duplicates",
+            QString("%1 tiles & %2 chunks were copies of another & aren't used by this scene anymore.")
+                .arg(freedTiles.count())
+                .arg(freedChunks.count()),
+            QMessageBox::Ok, this);
+        msgBox.setDetailedText("Tiles: " + TileUsageIndex::formatRanges(freedTiles) + "\nChunks: "
+                               + TileUsageIndex::formatRanges(freedChunks));
+        msgBox.exec();
+    }
+}
+
 void SceneEditor::InitGameLink()
 {
     UnloadGameLinks();
@@ -3868,6 +3961,7 @@ void SceneEditor::InitGameLink()
     compilerv2->objectLoop      = ENTITY_COUNT_v2 - 1;
     compilerv3->objectLoop      = ENTITY_COUNT_v3 - 1;
     compilerv4->objectEntityPos = ENTITY_COUNT_v4 - 1;
+    viewer->filterVars.invalidate();
     for (int o = 0; o < viewer->objects.count(); ++o) {
         viewer->objects[o].variables.clear();
         viewer->objects[o].variablesAliases[VAR_ALIAS_PROPVAL] = "propertyValue";
@@ -3944,7 +4038,7 @@ void SceneEditor::SetChunk(float x, float y)
     ypos /= 0x80;
     if (ypos >= 0 && ypos < viewer->layers[viewer->selectedLayer].height) {
         if (xpos >= 0 && xpos < viewer->layers[viewer->selectedLayer].width) {
-            viewer->layers[viewer->selectedLayer].layout[ypos][xpos] = viewer->selectedChunk;
+            viewer->setLayoutTile(viewer->selectedLayer, xpos, ypos, viewer->selectedChunk);
         }
     }
 }
@@ -4023,6 +4117,8 @@ bool SceneEditor::HandleKeyPress(QKeyEvent *event)
             switch (clipboardType) {
                 default: break;
                 case COPY_ENTITY_SELECT: {
+                    // entity scripts rewrite variables on any property edit here, so recount first
+                    viewer->entityCounts.invalidate();
                     if (viewer->activeEntityCount() + clipboardIDs.count() >= FormatHelpers::Scene::entityLimit){
                         QMessageBox msgBox =
                             QMessageBox(QMessageBox::Information, "RetroED",
@@ -4080,25 +4176,14 @@ bool SceneEditor::HandleKeyPress(QKeyEvent *event)
         }
     }
 
+    if (viewerActive)
+        viewer->profilerKeyPress(event);
+
     if ((event->modifiers() & Qt::ControlModifier) == Qt::ControlModifier
         && event->key() == Qt::Key_G && viewerActive) {
         auto *sel = new GoToPos(viewer->layers[viewer->selectedLayer].width * viewer->tileSize, viewer->layers[viewer->selectedLayer].height * viewer->tileSize, viewer->layers[viewer->selectedLayer].name, this);
-        if (sel->exec() == QDialog::Accepted) {
-            viewer->cameraPos.x = sel->posX - ((viewer->storedW / 2) * viewer->invZoom());
-            viewer->cameraPos.y = sel->posY - ((viewer->storedH / 2) * viewer->invZoom());
-            if (viewer->cameraPos.x < 0) viewer->cameraPos.x = 0;
-            if (viewer->cameraPos.y < 0) viewer->cameraPos.y = 0;
-            viewer->screens->position.x = viewer->cameraPos.x;
-            viewer->screens->position.y = viewer->cameraPos.y;
-
-            ui->horizontalScrollBar->blockSignals(true);
-            ui->horizontalScrollBar->setValue(viewer->cameraPos.x);
-            ui->horizontalScrollBar->blockSignals(false);
-
-            ui->verticalScrollBar->blockSignals(true);
-            ui->verticalScrollBar->setValue(viewer->cameraPos.y);
-            ui->verticalScrollBar->blockSignals(false);
-        }
+        if (sel->exec() == QDialog::Accepted)
+            FocusCamera(sel->posX, sel->posY);
     }
 
     byte prevTool = viewer->curTool;
@@ -4215,7 +4300,7 @@ bool SceneEditor::HandleKeyPress(QKeyEvent *event)
                                 (viewer->tilePos.x * viewer->invZoom()) + viewer->cameraPos.x,
                                 (viewer->tilePos.y * viewer->invZoom()) + viewer->cameraPos.y);
                             if (box.contains(pos)) {
-                                viewer->layers[viewer->selectedLayer].layout[y][x] = 0;
+                                viewer->setLayoutTile(viewer->selectedLayer, x, y, 0);
                                 DoAction(QString("Erased Tile: (%1, %2)").arg(pos.x).arg(pos.y));
 
                                 // reset context
@@ -5099,6 +5184,7 @@ void SceneEditor::ResetAction()
     viewer->tilePalette = actions[actionIndex].tilePalette;
     viewer->tiles       = actions[actionIndex].tiles;
     viewer->chunks      = actions[actionIndex].chunks;
+    viewer->syncTileAtlas();
 
     gameConfig = actions[actionIndex].gameConfig;
 
@@ -5111,6 +5197,7 @@ void SceneEditor::ResetAction()
 
     viewer->objects  = actions[actionIndex].objects;
     viewer->entities = actions[actionIndex].entities;
+    viewer->entityCounts.invalidate();
 
     // General Editing
     // viewer->curTool   = actions[actionIndex].curTool;
@@ -5386,6 +5473,7 @@ void SceneEditor::ReadXMLLayout(QXmlStreamReader &xmlReader, int layerID, byte m
                         ++id;
                     }
                 }
+                viewer->tileUsage.invalidate();
 
                 mode += 2;
             }
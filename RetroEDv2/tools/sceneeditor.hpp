@@ -197,6 +197,15 @@ private:
 
     void CreateEntityList(int startSlot = -1);
 
+    // chunk usage, see SceneViewer::tileUsage
+    void FocusCamera(float x, float y);
+    void FindNextPlacement(ushort id);
+    void ShowUnusedChunks();
+    void MergeDuplicates();
+    int findID  = -1;
+    int findPos = 0;
+    QString mergeExcluded; // the last list of tiles merging was told to leave alone
+
     // XML Management
     void ParseGameXML(QString path);
 
@@ -25,6 +25,8 @@
 
 #include "sceneproperties/confirmgamelink.hpp"
 
+#include "utils/tilededuplicator.hpp"
+
 TileSelector::TileSelector(QWidget *parent) : QWidget(parent), parentPtr((SceneEditorv5 *)parent)
 {
     QScrollArea *scrollArea = new QScrollArea(this);
@@ -37,24 +39,23 @@ TileSelector::TileSelector(QWidget *parent) : QWidget(parent), parentPtr((SceneE
     tileLayout->setContentsMargins(0, 0, 0, 0);
     tileLayout->setSpacing(1);
 
-    int i = 0;
     int x = 0, y = 0;
-    for (auto &&tile : parentPtr->viewer->tiles) {
+    for (int i = 0; i < parentPtr->viewer->tiles.count(); ++i) {
         TileLabel *label = new TileLabel(&parentPtr->viewer->selectedTile, i, tileArea);
-        label->setPixmap(QPixmap::fromImage(tile).scaled(tile.width() * 2, tile.height() * 2));
         label->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
-        label->resize(tile.width(), tile.height());
+        label->resize(TileAtlas::TILE_SIZE, TileAtlas::TILE_SIZE);
         tileLayout->addWidget(label, y, x);
         x++;
         if (x >= 4) {
             x = 0;
             y += 1;
         }
-        label->setFixedSize(tile.width() * 2, tile.height() * 2);
+        label->setFixedSize(TileAtlas::TILE_SIZE * 2, TileAtlas::TILE_SIZE * 2);
         connect(label, &TileLabel::requestRepaint, tileArea, QOverload<>::of(&QWidget::update));
         connect(label, &TileLabel::requestRepaint, parentPtr, QOverload<>::of(&SceneEditorv5::updateTileSel));
-        tiles[i++] = label;
+        tiles[i] = label;
     }
+    RefreshList();
 
     tileArea->setLayout(tileLayout);
     scrollArea->setWidget(tileArea);
@@ -65,10 +66,21 @@ TileSelector::TileSelector(QWidget *parent) : QWidget(parent), parentPtr((SceneE
 
 void TileSelector::RefreshList()
 {
-    int t = 0;
-    for (auto &&tile : parentPtr->viewer->tiles) {
-        tiles[t++]->setPixmap(QPixmap::fromImage(tile).scaled(tile.width() * 2, tile.height() * 2));
-    }
+    for (int t = 0; t < parentPtr->viewer->tiles.count(); ++t) RefreshTile(t);
+}
+
+void TileSelector::RefreshTiles(const QList<int> &ids)
+{
+    for (int t : ids) RefreshTile(t);
+}
+
+void TileSelector::RefreshTile(int id)
+{
+    if (id < 0 || id >= parentPtr->viewer->tiles.count())
+        return;
+
+    QImage tile = parentPtr->viewer->tileAtlas.tileImage(id);
+    tiles[id]->setPixmap(QPixmap::fromImage(tile).scaled(tile.width() * 2, tile.height() * 2));
 }
 
 SceneEditorv5::SceneEditorv5(QWidget *parent) : QWidget(parent), ui(new Ui::SceneEditorv5)
@@ -249,6 +261,7 @@ SceneEditorv5::SceneEditorv5(QWidget *parent) : QWidget(parent), ui(new Ui::Scen
         layer.name = "New Layer " + QString::number(c);
         layer.type = SceneHelpers::TileLayer::LAYER_HSCROLL;
         viewer->layers.append(layer);
+        viewer->tileUsage.invalidate();
 
         QListWidgetItem *item = new QListWidgetItem(layer.name, ui->layerList);
         item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
@@ -266,6 +279,8 @@ SceneEditorv5::SceneEditorv5(QWidget *parent) : QWidget(parent), ui(new Ui::Scen
         int n = ui->layerList->currentRow() == ui->layerList->count() - 1 ? c - 1 : c;
         delete ui->layerList->item(c);
         viewer->layers.removeAt(c);
+        viewer->tileUsage.invalidate(); // placements are kept by layer index
+        viewer->markLayersModified();   // so are the layers kept from the last save
         ui->layerList->blockSignals(true);
         ui->layerList->setCurrentRow(n);
         ui->layerList->blockSignals(false);
@@ -280,6 +295,8 @@ SceneEditorv5::SceneEditorv5(QWidget *parent) : QWidget(parent), ui(new Ui::Scen
         uint c     = ui->layerList->currentRow();
         auto *item = ui->layerList->takeItem(c);
         viewer->layers.move(c, c - 1);
+        viewer->tileUsage.invalidate();
+        viewer->markLayersModified();
         ui->layerList->insertItem(c - 1, item);
         ui->layerList->setCurrentRow(c - 1);
     });
@@ -288,6 +305,8 @@ SceneEditorv5::SceneEditorv5(QWidget *parent) : QWidget(parent), ui(new Ui::Scen
         uint c     = ui->layerList->currentRow();
         auto *item = ui->layerList->takeItem(c);
         viewer->layers.move(c, c + 1);
+        viewer->tileUsage.invalidate();
+        viewer->markLayersModified();
         ui->layerList->insertItem(c + 1, item);
         ui->layerList->setCurrentRow(c + 1);
     });
@@ -468,6 +487,7 @@ SceneEditorv5::SceneEditorv5(QWidget *parent) : QWidget(parent), ui(new Ui::Scen
         objProp->unsetUI();
         CreateEntityList();
         viewer->objects.removeAt(objectID);
+        viewer->filterVars.invalidate();
 
         for (int i = 0; i < viewer->objects.count(); ++i) {
             GameObjectInfo *info = GetObjectInfo(viewer->objects[i].name);
@@ -630,6 +650,7 @@ SceneEditorv5::SceneEditorv5(QWidget *parent) : QWidget(parent), ui(new Ui::Scen
                 }
             }
         }
+        viewer->filterVars.invalidate();
     };
 
     connect(ui->objectFilter, &QLineEdit::textChanged, [this](QString s) { FilterObjectList(s.toUpper()); });
@@ -732,6 +753,7 @@ SceneEditorv5::SceneEditorv5(QWidget *parent) : QWidget(parent), ui(new Ui::Scen
 
                     viewer->objects.append(obj);
                     stageConfig.objects.append(obj.name);
+                    viewer->filterVars.invalidate();
 
                     auto *item = new QListWidgetItem();
                     item->setText(obj.name);
@@ -1154,6 +1176,7 @@ SceneEditorv5::SceneEditorv5(QWidget *parent) : QWidget(parent), ui(new Ui::Scen
 
             objProp->unsetUI();
         }
+        viewer->filterVars.invalidate();
 
         ui->objectList->blockSignals(true);
         ui->objectList->clear();
@@ -1216,28 +1239,13 @@ SceneEditorv5::SceneEditorv5(QWidget *parent) : QWidget(parent), ui(new Ui::Scen
         viewer->disableDrawScene = true;
 
         SetStatus("Rebuilding tiles...", true);
-        viewer->gfxSurface[0].texturePtr = nullptr;
-
-        QImage tileset(0x10, 0x400 * 0x10, QImage::Format_Indexed8);
-
-        QVector<QRgb> pal;
-        for (PaletteColor &col : viewer->tilePalette) pal.append(col.toQColor().rgb());
-        tileset.setColorTable(pal);
         AddStatusProgress(1. / 4); // finished setup
 
-        uchar *pixels = tileset.bits();
-        for (int i = 0; i < 0x400; ++i) {
-            uchar *src = viewer->tiles[i].bits();
-            for (int y = 0; y < 16; ++y) {
-                for (int x = 0; x < 16; ++x) {
-                    *pixels++ = *src++;
-                }
-            }
-        }
+        // only the slots the editor moved or imported over are compared, & only the ones that actually
+        // changed get re-uploaded on the next frame
+        QList<int> changedTiles = viewer->syncTileAtlas(edit->editedTiles());
         AddStatusProgress(1. / 4); // finished copying tiles
 
-        viewer->gfxSurface[0].texturePtr = viewer->createTexture(tileset, QOpenGLTexture::Target2D);
-
         for (int i = 0; i < viewer->layers.count(); ++i) {
             auto &layer = viewer->layers[i];
             for (int y = 0; y < layer.height; ++y) {
@@ -1248,6 +1256,8 @@ SceneEditorv5::SceneEditorv5(QWidget *parent) : QWidget(parent), ui(new Ui::Scen
                 }
             }
         }
+        viewer->markLayersModified();
+        viewer->tileUsage.invalidate();
         AddStatusProgress(1. / 4); // finished updating layout
 
         RSDKv5::TileConfig configStore = tileconfig;
@@ -1257,7 +1267,7 @@ SceneEditorv5::SceneEditorv5(QWidget *parent) : QWidget(parent), ui(new Ui::Scen
             tileconfig.collisionPaths[1][id] = configStore.collisionPaths[1][i];
         }
 
-        tileSel->RefreshList();
+        tileSel->RefreshTiles(changedTiles);
 
         DoAction("Edited Tiles");
         SetStatus("Finished rebuilding tiles!"); // done !
@@ -1308,6 +1318,7 @@ SceneEditorv5::SceneEditorv5(QWidget *parent) : QWidget(parent), ui(new Ui::Scen
             }
         }
         delete edit;
+        SetupPaletteBanks();
         DoAction("Edited Palette");
     });
 
@@ -1457,6 +1468,15 @@ SceneEditorv5::SceneEditorv5(QWidget *parent) : QWidget(parent), ui(new Ui::Scen
         SetStatus("Game Link reloaded successfully!");
     });
 
+    connect(tileProp->findTile, &QPushButton::clicked, [this] {
+        if (viewer->selectedTile != 0xFFFF)
+            FindNextPlacement(viewer->selectedTile & 0x3FF);
+    });
+
+    connect(tileProp->unusedTiles, &QPushButton::clicked, [this] { ShowUnusedTiles(); });
+
+    connect(tileProp->mergeDuplicates, &QPushButton::clicked, [this] { MergeDuplicateTiles(); });
+
     connect(tileProp->replaceTile, &QPushButton::clicked, [this] {
         TileReplaceOptions *dlg = new TileReplaceOptions;
         dlg->replaceVisualPlane->setDisabled(true);
@@ -1492,33 +1512,29 @@ SceneEditorv5::SceneEditorv5(QWidget *parent) : QWidget(parent), ui(new Ui::Scen
         // Replace Tile Layer info
         if (replaceIndex || replaceFlipX || replaceFlipY || replaceSolidATop || replaceSolidALRB
             || replaceSolidBTop || replaceSolidBLRB) {
-            for (int i = 0; i < viewer->layers.count(); ++i) {
-                auto &layer = viewer->layers[i];
-                for (int y = 0; y < layer.height; ++y) {
-                    for (int x = 0; x < layer.width; ++x) {
-                        ushort tile = layer.layout[y][x];
-
-                        if ((tile & 0x3FF) == dstTile) {
-                            bool flipX     = replaceFlipX ? hasFlipX : Utils::getBit(tile, 10);
-                            bool flipY     = replaceFlipY ? hasFlipY : Utils::getBit(tile, 11);
-                            bool solidATop = replaceSolidATop ? hasSolidATop : Utils::getBit(tile, 12);
-                            bool solidALRB = replaceSolidALRB ? hasSolidALRB : Utils::getBit(tile, 13);
-                            bool solidBTop = replaceSolidBTop ? hasSolidBTop : Utils::getBit(tile, 14);
-                            bool solidBLRB = replaceSolidBLRB ? hasSolidBLRB : Utils::getBit(tile, 15);
-
-                            ushort newTile = replaceIndex ? srcTile : dstTile;
-
-                            Utils::setBit(newTile, flipX, 10);
-                            Utils::setBit(newTile, flipY, 11);
-                            Utils::setBit(newTile, solidATop, 12);
-                            Utils::setBit(newTile, solidALRB, 13);
-                            Utils::setBit(newTile, solidBTop, 14);
-                            Utils::setBit(newTile, solidBLRB, 15);
-
-                            layer.layout[y][x] = newTile;
-                        }
-                    }
-                }
+            // only visits the placements of dstTile, copied since setLayoutTile moves them around
+            viewer->tileUsage.ensure(viewer->layers);
+            QVector<TileUsageIndex::Usage> placements = viewer->tileUsage.find(dstTile);
+            for (auto &use : placements) {
+                ushort tile = viewer->layers[use.layer].layout[use.y][use.x];
+
+                bool flipX     = replaceFlipX ? hasFlipX : Utils::getBit(tile, 10);
+                bool flipY     = replaceFlipY ? hasFlipY : Utils::getBit(tile, 11);
+                bool solidATop = replaceSolidATop ? hasSolidATop : Utils::getBit(tile, 12);
+                bool solidALRB = replaceSolidALRB ? hasSolidALRB : Utils::getBit(tile, 13);
+                bool solidBTop = replaceSolidBTop ? hasSolidBTop : Utils::getBit(tile, 14);
+                bool solidBLRB = replaceSolidBLRB ? hasSolidBLRB : Utils::getBit(tile, 15);
+
+                ushort newTile = replaceIndex ? srcTile : dstTile;
+
+                Utils::setBit(newTile, flipX, 10);
+                Utils::setBit(newTile, flipY, 11);
+                Utils::setBit(newTile, solidATop, 12);
+                Utils::setBit(newTile, solidALRB, 13);
+                Utils::setBit(newTile, solidBTop, 14);
+                Utils::setBit(newTile, solidBLRB, 15);
+
+                viewer->setLayoutTile(use.layer, use.x, use.y, newTile);
             }
         }
         AddStatusProgress(1. / 3); // finished updating layers
@@ -1555,16 +1571,9 @@ SceneEditorv5::SceneEditorv5(QWidget *parent) : QWidget(parent), ui(new Ui::Scen
         AddStatusProgress(1. / 3); // finished updating collision
 
         if (replaceGraphics) {
-            auto &dstTileImg = viewer->tiles[dstTile];
-            auto &srcTileImg = viewer->tiles[srcTile];
-
-            uchar *dstPixels = dstTileImg.bits();
-            uchar *srcPixels = srcTileImg.bits();
-            for (int y = 0; y < 16; ++y) {
-                for (int x = 0; x < 16; ++x) {
-                    *dstPixels++ = *srcPixels++;
-                }
-            }
+            viewer->tileAtlas.copyTile(dstTile, srcTile);
+            viewer->tiles[dstTile] = viewer->tileAtlas.tileImage(dstTile);
+            tileSel->RefreshTile(dstTile);
         }
         SetStatus("Finished replacing Tile Info!"); // finished updating graphics
 
@@ -1808,6 +1817,7 @@ void SceneEditorv5::updateType(SceneEntity *entity, byte type, bool keepVals)
             }
         }
     }
+    viewer->entityCounts.invalidate();
     objProp->setupUI(&viewer->entities[c]); // maybe make it use updateUI?
     DoAction("Object Property Updated");
 }
@@ -2052,6 +2062,7 @@ bool SceneEditorv5::eventFilter(QObject *object, QEvent *event)
                             Rect<float> box;
                             int selectedEntity = -1;
                             int entPos = 0;
+                            viewer->updateFilterVars();
                             for (auto o : viewer->selectedEntities) {
                                 int left   = viewer->entities[o].pos.x + viewer->entities[o].box.x;
                                 int top    = viewer->entities[o].pos.y + viewer->entities[o].box.y;
@@ -2064,17 +2075,7 @@ bool SceneEditorv5::eventFilter(QObject *object, QEvent *event)
                                     (mEvent->pos().y() * viewer->invZoom()) + viewer->cameraPos.y);
 
 
-                                int filter = 0xFF;
-                                for (int v = 0;
-                                     v < viewer->objects[viewer->entities[o].type].variables.count();
-                                     ++v) {
-                                    if (viewer->objects[viewer->entities[o].type].variables[v].name
-                                        == "filter") {
-                                        if (v < viewer->entities[o].variables.count())
-                                            filter = viewer->entities[o].variables[v].value_uint8;
-                                        break;
-                                    }
-                                }
+                                int filter = viewer->entityFilter(viewer->entities[o]);
 
                                 bool filterFlag = true;
                                 if (!(filter & viewer->sceneFilter) && filter)
@@ -2162,6 +2163,7 @@ bool SceneEditorv5::eventFilter(QObject *object, QEvent *event)
                             int selectedEntity = -1;
                             viewer->sceneInfo.listPos   = -1;
                             viewer->sceneInfoV1.listPos = viewer->sceneInfo.listPos;
+                            viewer->updateFilterVars();
                             for (int o = 0; o < viewer->entities.count(); ++o) {
                                 int left   = viewer->entities[o].pos.x + viewer->entities[o].box.x;
                                 int top    = viewer->entities[o].pos.y + viewer->entities[o].box.y;
@@ -2173,17 +2175,7 @@ bool SceneEditorv5::eventFilter(QObject *object, QEvent *event)
                                     (mEvent->pos().x() * viewer->invZoom()) + viewer->cameraPos.x,
                                     (mEvent->pos().y() * viewer->invZoom()) + viewer->cameraPos.y);
 
-                                int filter = 0xFF;
-                                for (int v = 0;
-                                     v < viewer->objects[viewer->entities[o].type].variables.count();
-                                     ++v) {
-                                    if (viewer->objects[viewer->entities[o].type].variables[v].name
-                                        == "filter") {
-                                        if (v < viewer->entities[o].variables.count())
-                                            filter = viewer->entities[o].variables[v].value_uint8;
-                                        break;
-                                    }
-                                }
+                                int filter = viewer->entityFilter(viewer->entities[o]);
 
                                 bool filterFlag = true;
                                 if (!(filter & viewer->sceneFilter) && filter)
@@ -2334,6 +2326,7 @@ bool SceneEditorv5::eventFilter(QObject *object, QEvent *event)
                         int firstSel = -1;
                         Vector2<float> firstPos;
 
+                        viewer->updateFilterVars();
                         for (int o = 0; o < viewer->entities.count(); ++o) {
                             int left   = viewer->entities[o].pos.x + viewer->entities[o].box.x;
                             int top    = viewer->entities[o].pos.y + viewer->entities[o].box.y;
@@ -2345,16 +2338,7 @@ bool SceneEditorv5::eventFilter(QObject *object, QEvent *event)
                                 (mEvent->pos().x() * viewer->invZoom()) + viewer->cameraPos.x,
                                 (mEvent->pos().y() * viewer->invZoom()) + +viewer->cameraPos.y);
 
-                            int filter = 0xFF;
-                            for (int v = 0;
-                                 v < viewer->objects[viewer->entities[o].type].variables.count(); ++v) {
-                                if (viewer->objects[viewer->entities[o].type].variables[v].name
-                                    == "filter") {
-                                    if (v < viewer->entities[o].variables.count())
-                                        filter = viewer->entities[o].variables[v].value_uint8;
-                                    break;
-                                }
-                            }
+                            int filter = viewer->entityFilter(viewer->entities[o]);
 
                             bool filterFlag = true;
                             if (!(filter & viewer->sceneFilter) && filter)
@@ -2574,17 +2558,11 @@ bool SceneEditorv5::eventFilter(QObject *object, QEvent *event)
                             viewer->selectedEntities.clear();
                             viewer->selectedEntitiesXPos.clear();
                             viewer->selectedEntitiesYPos.clear();
+                            viewer->updateFilterVars();
                             for (int e = 0; e < viewer->entities.count(); ++e) {
                                 SceneEntity &entity = viewer->entities[e];
 
-                                int filter = 0xFF;
-                                for (int v = 0; v < viewer->objects[entity.type].variables.count(); ++v) {
-                                    if (viewer->objects[entity.type].variables[v].name == "filter") {
-                                        if (v < entity.variables.count())
-                                            filter = entity.variables[v].value_uint8;
-                                        break;
-                                    }
-                                }
+                                int filter = viewer->entityFilter(entity);
 
                                 if (!(filter & viewer->sceneFilter) && filter)
                                     continue;
@@ -3123,6 +3101,7 @@ void SceneEditorv5::CreateNewScene(QString scnPath, bool prePlus, bool loadGC, Q
     }
 
     viewer->initScene(tileset);
+    SetupPaletteBanks();
 
     AddStatusProgress(1. / 6); // finish tileset loading
 
@@ -3319,6 +3298,105 @@ void SceneEditorv5::LoadScene(QString scnPath, QString gcfPath, byte sceneVer)
     initStorage(dataStorage);
     AddStatusProgress(1. / 6); // finish unloading
 
+    QString pth      = scnPath;
+    QString basePath = pth.replace(QFileInfo(pth).fileName(), "");
+
+    viewer->currentFolder  = QDir(basePath).dirName();
+    viewer->currentSceneID = QFileInfo(scnPath).baseName().toLower().replace("scene", "");
+
+    // load the base data folder for game launch / game.dll failsafe
+    if (!appConfig.baseDataManager[ENGINE_v5].dataPath.isEmpty())
+        WorkingDirManager::workingDir = appConfig.baseDataManager[ENGINE_v5].dataPath + "/";
+
+    // the stage files don't depend on each other, so they're read & decoded on the thread pool while
+    // the game config and game links load here. anything touching GL or the game link stays on this
+    // thread and waits for the results below
+    QString stageFolder = "Stages/" + viewer->currentFolder + "/";
+    QString pathTCF = WorkingDirManager::GetPath(stageFolder + "TileConfig.bin", basePath + "TileConfig.bin");
+    QString pathSCF = WorkingDirManager::GetPath(stageFolder + "StageConfig.bin", basePath + "StageConfig.bin");
+
+    QList<SceneHelpers::TileLayer> loadedLayers;
+    RSDKv5::Stamps loadedStamps;
+
+    QFuture<void> sceneTask = QtConcurrent::run([&] {
+        scene.read(scnPath);
+
+        for (auto &layer : scene.layers) {
+            SceneHelpers::TileLayer viewLayer;
+
+            viewLayer.name           = layer.name;
+            viewLayer.width          = layer.width;
+            viewLayer.height         = layer.height;
+            viewLayer.drawGroup      = layer.drawGroup;
+            viewLayer.visible        = layer.visible;
+            viewLayer.parallaxFactor = layer.parallaxFactor / 256.0f;
+            viewLayer.scrollSpeed    = layer.scrollSpeed / 256.0f;
+
+            viewLayer.type = SceneHelpers::TileLayer::LAYER_NONE;
+            switch (layer.type) {
+                case 0: viewLayer.type = SceneHelpers::TileLayer::LAYER_HSCROLL; break;
+                case 1: viewLayer.type = SceneHelpers::TileLayer::LAYER_VSCROLL; break;
+                case 2: viewLayer.type = SceneHelpers::TileLayer::LAYER_ROTOZOOM; break;
+                case 3: viewLayer.type = SceneHelpers::TileLayer::LAYER_BASIC; break;
+            }
+
+            viewLayer.scrollInfos.clear();
+            for (auto &info : layer.scrollInfos) {
+                SceneHelpers::TileLayer::ScrollIndexInfo scroll;
+
+                scroll.parallaxFactor = info.parallaxFactor;
+                scroll.scrollSpeed    = info.scrollSpeed;
+                scroll.deform         = info.deform;
+                scroll.unknown        = info.unknown;
+
+                for (auto &instance : info.instances) {
+                    SceneHelpers::TileLayer::ScrollInstance inst;
+
+                    inst.startLine = instance.startLine;
+                    inst.length    = instance.length;
+                    inst.layerID   = 0xFF; // for v5, we don't care about layer ID
+                    scroll.instances.append(inst);
+                }
+
+                viewLayer.scrollInfos.append(scroll);
+            }
+
+            viewLayer.layout.clear();
+            viewLayer.layout.reserve(layer.height);
+            for (int y = 0; y < layer.height; ++y) {
+                viewLayer.layout.append(QList<ushort>());
+                viewLayer.layout[y].reserve(layer.width);
+                for (int x = 0; x < layer.width; ++x) viewLayer.layout[y].append(layer.layout[y][x]);
+            }
+
+            loadedLayers.append(viewLayer);
+        }
+
+        // the stamp list's name comes from the scene, so it has to wait for it anyways
+        QString stampName = scene.editorMetadata.stampName;
+        if (stampName == "")
+            stampName = "StampList.bin";
+
+        QString pathSTP = WorkingDirManager::GetPath(stageFolder + stampName, basePath + stampName);
+        if (QFile::exists(pathSTP))
+            loadedStamps.read(pathSTP);
+    });
+
+    QFuture<void> tileConfigTask  = QtConcurrent::run([&] { tileconfig.read(pathTCF); });
+    QFuture<void> stageConfigTask = QtConcurrent::run([&] { stageConfig.read(pathSCF); });
+
+    QFuture<QImage> tilesetTask = QtConcurrent::run([basePath] {
+        QImage tileset(16, 0x400 * 16, QImage::Format_Indexed8);
+        for (int i = 0; i < 256; ++i)
+            tileset.setColor(i, QRgb(0xFFFF00FF));
+        tileset.fill(0);
+        if (QFile::exists(basePath + "16x16Tiles.gif")) {
+            QGifImage tilesetGif(basePath + "16x16Tiles.gif");
+            tileset = tilesetGif.frame(0);
+        }
+        return tileset;
+    });
+
     if (gcfPath != gameConfig.filePath) {
         if (QFileInfo(gcfPath).suffix().toLower().contains("xml"))
             ParseGameXML(gcfPath);
@@ -3334,10 +3412,6 @@ void SceneEditorv5::LoadScene(QString scnPath, QString gcfPath, byte sceneVer)
 
     gameLinkPath = dataPath + "/../";
 
-    // load the base data folder for game launch / game.dll failsafe
-    if (!appConfig.baseDataManager[ENGINE_v5].dataPath.isEmpty())
-        WorkingDirManager::workingDir = appConfig.baseDataManager[ENGINE_v5].dataPath + "/";
-
     LoadGameLinks();
 
     // As a fail-safe, try loading a game.dll from the game manager path
@@ -3346,104 +3420,38 @@ void SceneEditorv5::LoadScene(QString scnPath, QString gcfPath, byte sceneVer)
         LoadGameLinks();
     }
 
-    // loading
-    QString pth      = scnPath;
-    QString basePath = pth.replace(QFileInfo(pth).fileName(), "");
-
-    viewer->currentFolder  = QDir(basePath).dirName();
-    viewer->currentSceneID = QFileInfo(scnPath).baseName().toLower().replace("scene", "");
-
-
     AddStatusProgress(1. / 6); // finish initial setup
 
-    scene.read(scnPath);
+    sceneTask.waitForFinished();
     viewer->metadata = scene.editorMetadata;
 
     viewer->useLayerScrollInfo = true; // use v5 style scroll Info
-
-    viewer->layers.clear();
-    for (auto &layer : scene.layers) {
-        SceneHelpers::TileLayer viewLayer;
-
-        viewLayer.name           = layer.name;
-        viewLayer.width          = layer.width;
-        viewLayer.height         = layer.height;
-        viewLayer.drawGroup      = layer.drawGroup;
-        viewLayer.visible        = layer.visible;
-        viewLayer.parallaxFactor = layer.parallaxFactor / 256.0f;
-        viewLayer.scrollSpeed    = layer.scrollSpeed / 256.0f;
-
-        viewLayer.type = SceneHelpers::TileLayer::LAYER_NONE;
-        switch (layer.type) {
-            case 0: viewLayer.type = SceneHelpers::TileLayer::LAYER_HSCROLL; break;
-            case 1: viewLayer.type = SceneHelpers::TileLayer::LAYER_VSCROLL; break;
-            case 2: viewLayer.type = SceneHelpers::TileLayer::LAYER_ROTOZOOM; break;
-            case 3: viewLayer.type = SceneHelpers::TileLayer::LAYER_BASIC; break;
-        }
-
-        viewLayer.scrollInfos.clear();
-        for (auto &info : layer.scrollInfos) {
-            SceneHelpers::TileLayer::ScrollIndexInfo scroll;
-
-            scroll.parallaxFactor = info.parallaxFactor;
-            scroll.scrollSpeed    = info.scrollSpeed;
-            scroll.deform         = info.deform;
-            scroll.unknown        = info.unknown;
-
-            for (auto &instance : info.instances) {
-                SceneHelpers::TileLayer::ScrollInstance inst;
-
-                inst.startLine = instance.startLine;
-                inst.length    = instance.length;
-                inst.layerID   = 0xFF; // for v5, we don't care about layer ID
-                scroll.instances.append(inst);
-            }
-
-            viewLayer.scrollInfos.append(scroll);
-        }
-
-        viewLayer.layout.clear();
-        for (int y = 0; y < layer.height; ++y) {
-            viewLayer.layout.append(QList<ushort>());
-            for (int x = 0; x < layer.width; ++x) viewLayer.layout[y].append(layer.layout[y][x]);
-        }
-
-        viewer->layers.append(viewLayer);
-    }
-
-    QString pathTCF = WorkingDirManager::GetPath("Stages/" + viewer->currentFolder + "/TileConfig.bin",
-                                                 basePath + "TileConfig.bin");
-    QString pathSCF = WorkingDirManager::GetPath("Stages/" + viewer->currentFolder + "/StageConfig.bin",
-                                                 basePath + "StageConfig.bin");
-
-    tileconfig.read(pathTCF);
-    viewer->tileconfig = tileconfig;
-
-    stageConfig.read(pathSCF);
+    viewer->layers             = loadedLayers;
 
     if (viewer->metadata.stampName == "")
         viewer->metadata.stampName = "StampList.bin";
+    viewer->stamps = loadedStamps;
 
-    QString pathSTP = WorkingDirManager::GetPath("Stages/" + viewer->currentFolder + "/" + viewer->metadata.stampName,
-                                                 basePath + viewer->metadata.stampName);
+    tileConfigTask.waitForFinished();
+    viewer->tileconfig = tileconfig;
 
-    if (QFile::exists(pathSTP))
-        viewer->stamps.read(pathSTP);
-    else
-        viewer->stamps = RSDKv5::Stamps();
+    stageConfigTask.waitForFinished();
 
     AddStatusProgress(1. / 6); // finish scene loading
 
     // Tile Texture
-    QImage tileset(16, 0x400 * 16, QImage::Format_Indexed8);
-    for (int i = 0; i < 256; ++i)
-        tileset.setColor(i, QRgb(0xFFFF00FF));
-    tileset.fill(0);
-    if (QFile::exists(basePath + "16x16Tiles.gif")) {
-        QGifImage tilesetGif(basePath + "16x16Tiles.gif");
-        tileset = tilesetGif.frame(0);
+    viewer->initScene(tilesetTask.result());
+    SetupPaletteBanks();
+
+    // show the tile layers while the objects & game link get set up
+    viewer->resetObjectGroups();
+    viewer->entities.clear();
+    if (viewer->layers.count()) {
+        viewer->selectedLayer    = 0;
+        viewer->disableDrawScene = false;
+        viewer->repaint();
+        viewer->disableDrawScene = true;
     }
-    viewer->initScene(tileset);
 
     AddStatusProgress(1. / 6); // finish tileset loading
 
@@ -3612,6 +3620,7 @@ void SceneEditorv5::LoadScene(QString scnPath, QString gcfPath, byte sceneVer)
                             QString varBackup = txtreader.readLine();
                             if (hash == Utils::getMd5HashByteArray(varBackup)){
                                 viewer->objects[i].variables[v].name = varBackup;
+                                viewer->filterVars.invalidate();
                                 break;
                             }
                         }
@@ -3658,9 +3667,19 @@ void SceneEditorv5::SaveScene(QString path)
 
     scene.editorMetadata = viewer->metadata;
 
-    scene.layers.clear();
-    for (auto &viewLayer : viewer->layers) {
+    // layers that weren't modified since the last save keep their layout & what scene.write packed it to,
+    // so only the edited ones are copied over & compressed again
+    QList<RSDKv5::Scene::SceneLayer> savedLayers;
+    savedLayers.swap(scene.layers);
+    for (int l = 0; l < viewer->layers.count(); ++l) {
+        auto &viewLayer = viewer->layers[l];
+        bool unchanged  = !viewLayer.modified && l < savedLayers.count()
+                          && savedLayers[l].width == viewLayer.width
+                          && savedLayers[l].height == viewLayer.height;
+
         RSDKv5::Scene::SceneLayer layer;
+        if (unchanged)
+            layer = savedLayers[l];
 
         layer.name           = viewLayer.name;
         layer.width          = viewLayer.width;
@@ -3698,10 +3717,14 @@ void SceneEditorv5::SaveScene(QString path)
             layer.scrollInfos.append(scroll);
         }
 
-        layer.layout.clear();
-        for (int y = 0; y < viewLayer.height; ++y) {
-            layer.layout.append(QVector<ushort>());
-            for (int x = 0; x < viewLayer.width; ++x) layer.layout[y].append(viewLayer.layout[y][x]);
+        if (!unchanged) {
+            layer.layout.resize(viewLayer.height);
+            for (int y = 0; y < viewLayer.height; ++y) {
+                QVector<ushort> &row = layer.layout[y];
+                row.resize(viewLayer.width);
+                for (int x = 0; x < viewLayer.width; ++x) row[x] = viewLayer.layout[y][x];
+            }
+            layer.modified = true;
         }
 
         scene.layers.append(layer);
@@ -3731,10 +3754,9 @@ void SceneEditorv5::SaveScene(QString path)
             ent.position.x = entity.pos.x * 65536.0f;
             ent.position.y = entity.pos.y * 65536.0f;
 
-            ent.variables.clear();
-            for (int v = 0; v < entity.variables.count(); ++v) {
-                ent.variables.append(entity.variables[v]);
-            }
+            // make sure the entity keeps its own buffer, property editors hold pointers into it
+            ent.variables = entity.variables;
+            ent.variables.detach();
 
             ent.parent = &scene.objects[entity.type];
             scene.objects[entity.type].entities.append(ent);
@@ -3748,18 +3770,14 @@ void SceneEditorv5::SaveScene(QString path)
     FormatHelpers::Gif tileset(16, 0x400 * 16);
 
     int c = 0;
-    for (PaletteColor &col : viewer->tilePalette) tileset.palette[c++] = col.toQColor();
+    for (PaletteColor &col : viewer->tilePalette) tileset.palette[c++] = col.toQColor().rgb();
 
-    int pos = 0;
-    for (int i = 0; i < 0x400; ++i) {
-        uchar *src = viewer->tiles[i].bits();
-        for (int y = 0; y < 16; ++y) {
-            for (int x = 0; x < 16; ++x) tileset.pixels[pos++] = *src++;
-        }
-    }
+    // every tile edit goes through the atlas, so its buffer already is the tileset
+    tileset.pixels = viewer->tileAtlas.getPixels();
     AddStatusProgress(1.f / 5); // generated tileset
 
     scene.write(path);
+    for (auto &layer : viewer->layers) layer.modified = false;
     tileconfig.write(basePath + "TileConfig.bin");
     stageConfig.write(basePath + "StageConfig.bin");
     viewer->stamps.write(basePath + viewer->metadata.stampName);
@@ -3860,6 +3878,7 @@ void SceneEditorv5::SetupObjects()
 {
     viewer->objects.clear();
     viewer->entities.clear();
+    viewer->filterVars.invalidate();
 
     QList<QString> objNames;
     objNames.append("Blank Object");
@@ -3933,9 +3952,7 @@ void SceneEditorv5::SetupObjects()
                 entity.pos.x    = Utils::fixedToFloat(ent.position.x);
                 entity.pos.y    = Utils::fixedToFloat(ent.position.y);
 
-                for (int v = 0; v < ent.variables.count(); ++v) {
-                    entity.variables.append(ent.variables[v]);
-                }
+                entity.variables = ent.variables;
 
                 viewer->entities.append(entity);
             }
@@ -3950,9 +3967,7 @@ void SceneEditorv5::SetupObjects()
                 entity.pos.x    = Utils::fixedToFloat(ent.position.x);
                 entity.pos.y    = Utils::fixedToFloat(ent.position.y);
 
-                for (int v = 0; v < ent.variables.count(); ++v) {
-                    entity.variables.append(ent.variables[v]);
-                }
+                entity.variables = ent.variables;
 
                 viewer->entities.append(entity);
             }
@@ -4022,7 +4037,7 @@ void SceneEditorv5::SetupObjects()
         preSortID[0] = 0;
 
         viewer->objects.clear();
-
+        viewer->filterVars.invalidate();
 
         int objTypeID = 0;
 
@@ -4083,23 +4098,7 @@ void SceneEditorv5::UnloadGameLinks()
     }
     gameLinks.clear();
 
-    dataStorage[DATASET_STG].usedStorage = 0;
-    dataStorage[DATASET_STG].entryCount  = 0;
-    dataStorage[DATASET_STG].clearCount  = 0;
-    memset(dataStorage[DATASET_STG].dataEntries, 0, sizeof(dataStorage[DATASET_STG].dataEntries));
-    memset(dataStorage[DATASET_STG].storageEntries, 0, sizeof(dataStorage[DATASET_STG].storageEntries));
-
-    dataStorage[DATASET_STR].usedStorage = 0;
-    dataStorage[DATASET_STR].entryCount  = 0;
-    dataStorage[DATASET_STR].clearCount  = 0;
-    memset(dataStorage[DATASET_STR].dataEntries, 0, sizeof(dataStorage[DATASET_STR].dataEntries));
-    memset(dataStorage[DATASET_STR].storageEntries, 0, sizeof(dataStorage[DATASET_STR].storageEntries));
-
-    dataStorage[DATASET_TMP].usedStorage = 0;
-    dataStorage[DATASET_TMP].entryCount  = 0;
-    dataStorage[DATASET_TMP].clearCount  = 0;
-    memset(dataStorage[DATASET_TMP].dataEntries, 0, sizeof(dataStorage[DATASET_TMP].dataEntries));
-    memset(dataStorage[DATASET_TMP].storageEntries, 0, sizeof(dataStorage[DATASET_TMP].storageEntries));
+    resetStorage(dataStorage);
 }
 
 void SceneEditorv5::LoadGameLinks()
@@ -4127,6 +4126,141 @@ void SceneEditorv5::LoadGameLinks()
 
 }
 
+void SceneEditorv5::FocusCamera(float x, float y)
+{
+    viewer->cameraPos.x = x - ((viewer->storedW / 2) * viewer->invZoom());
+    viewer->cameraPos.y = y - ((viewer->storedH / 2) * viewer->invZoom());
+    if (viewer->cameraPos.x < 0) viewer->cameraPos.x = 0;
+    if (viewer->cameraPos.y < 0) viewer->cameraPos.y = 0;
+    viewer->screens->position.x = viewer->cameraPos.x;
+    viewer->screens->position.y = viewer->cameraPos.y;
+
+    ui->horizontalScrollBar->blockSignals(true);
+    ui->horizontalScrollBar->setValue(viewer->cameraPos.x);
+    ui->horizontalScrollBar->blockSignals(false);
+
+    ui->verticalScrollBar->blockSignals(true);
+    ui->verticalScrollBar->setValue(viewer->cameraPos.y);
+    ui->verticalScrollBar->blockSignals(false);
+}
+
+void SceneEditorv5::FindNextPlacement(ushort id)
+{
+    viewer->tileUsage.ensure(viewer->layers);
+    auto &placements = viewer->tileUsage.find(id);
+    if (!placements.count()) {
+        SetStatus(QString("Tile %1 isn't used in any layer").arg(id));
+        return;
+    }
+
+    // pressing it again moves on to the next one
+    if (findID != id) {
+        findID  = id;
+        findPos = 0;
+    }
+    findPos %= placements.count();
+    auto &use = placements[findPos++];
+
+    FocusCamera(use.x * 0x10 + (0x10 / 2), use.y * 0x10 + (0x10 / 2));
+    SetStatus(QString("Tile %1: %2 of %3, at (%4, %5) on %6")
+                  .arg(id)
+                  .arg(findPos)
+                  .arg(placements.count())
+                  .arg(use.x)
+                  .arg(use.y)
+                  .arg(viewer->layers[use.layer].name));
+}
+
+void SceneEditorv5::ShowUnusedTiles()
+{
+    viewer->tileUsage.ensure(viewer->layers);
+    QList<ushort> unused = viewer->tileUsage.unused();
+
+    QMessageBox msgBox = QMessageBox(
+        QMessageBox::Information, "Unused Tiles",
+        QString("%1 of %2 tiles aren't used in any layer.").arg(unused.count()).arg(0x400),
+        QMessageBox::Ok, this);
+    msgBox.setDetailedText(TileUsageIndex::formatRanges(unused));
+    msgBox.exec();
+}
+
+void SceneEditorv5::MergeDuplicateTiles()
+{
+    QString text = "Every copy of a tile (flipped copies too) will be replaced with the first one in "
+                   "every layer. Tiles with collision only merge with unflipped copies that collide "
+                   "the same way, & blank tiles are never merged.\n\nThe tileset itself isn't "
+                   "changed, but the layers will draw the first copy from now on. Tiles that "
+                   "objects draw into (animated tiles) have to be listed here to be left alone, eg "
+                   "\"0-15, 200\":";
+
+    bool ok       = false;
+    QString input = QInputDialog::getText(this, "Merge Duplicates", text, QLineEdit::Normal,
+                                          mergeExcluded, &ok);
+    if (!ok)
+        return;
+
+    QList<ushort> excluded;
+    if (!TileUsageIndex::parseRanges(input, 0x400, excluded)) {
+        QMessageBox::critical(this, "Merge Duplicates",
+                              QString("\"%1\" isn't a list of tile ids, eg \"0-15, 200\".").arg(input),
+                              QMessageBox::Ok);
+        return;
+    }
+    mergeExcluded = TileUsageIndex::formatRanges(excluded);
+
+    viewer->stopTimer();
+    SetStatus("Merging duplicate tiles...", true);
+
+    auto keys = TileDeduplicator::collisionKeys(tileconfig);
+    AddStatusProgress(1. / 3); // finished setup
+
+    auto matches = TileDeduplicator::findTiles(viewer->tileAtlas, 0x400, keys, excluded);
+    AddStatusProgress(1. / 3); // finished matching tiles
+
+    int changed = TileDeduplicator::remapLayers(viewer->layers, matches, 0x3FF, 0xFFFF);
+    viewer->tileUsage.invalidate();
+
+    QList<ushort> freed = TileDeduplicator::freedIDs(matches);
+    if (changed)
+        DoAction("Merged Duplicate Tiles");
+    SetStatus(QString("Merged %1 duplicate tiles, %2 placements updated")
+                  .arg(freed.count())
+                  .arg(changed));
+
+    viewer->startTimer();
+
+    if (freed.count()) {
+        QMessageBox msgBox = QMessageBox(
+            QMessageBox::Information, "Merge Duplicates",
+            QString("%1 tiles were copies of another tile & aren't used by this scene anymore.")
+                .arg(freed.count()),
+            QMessageBox::Ok, this);
+        msgBox.setDetailedText(TileUsageIndex::formatRanges(freed));
+        msgBox.exec();
+    }
+}
+
+void SceneEditorv5::SetupPaletteBanks()
+{
+    // same as the engine, the game config's palettes with the stage config's rows on top.
+    // bank 0 is left as the tileset's own palette so the stage looks the same as it's saved
+    for (int b = 1; b < v5_PALETTE_BANK_COUNT; ++b) {
+        int row = viewer->paletteBankRow(b);
+        for (int r = 0; r < 0x10; ++r) {
+            RSDKv5::Palette *pal = nullptr;
+            if (stageConfig.palettes[b].activeRows[r])
+                pal = &stageConfig.palettes[b];
+            else if (gameConfig.palettes[b].activeRows[r])
+                pal = &gameConfig.palettes[b];
+            else
+                continue;
+
+            for (int c = 0; c < 0x10; ++c)
+                viewer->surfacePalettes.setColor(row, (r << 4) + c, pal->colors[r][c].rgb());
+        }
+    }
+}
+
 void SceneEditorv5::InitGameLink()
 {
     viewer->gameEntityList = NULL;
@@ -4194,33 +4328,7 @@ void SceneEditorv5::InitGameLink()
                 for (int v = 0; v < obj.variables.count(); ++v) {
                     // if lower, update the type
                     if (v < entity.variables.count()) {
-                        // if we can transfer values, we should
-                        if (entity.variables[v].type <= VAR_BOOL && obj.variables[v].type <= VAR_BOOL) {
-                            int value = 0;
-                            switch (entity.variables[v].type) {
-                                case VAR_UINT8: value = entity.variables[v].value_uint8; break;
-                                case VAR_INT8: value = entity.variables[v].value_int8; break;
-                                case VAR_UINT16: value = entity.variables[v].value_uint16; break;
-                                case VAR_INT16: value = entity.variables[v].value_int16; break;
-                                case VAR_UINT32: value = entity.variables[v].value_uint32; break;
-                                case VAR_INT32: value = entity.variables[v].value_int32; break;
-                                case VAR_ENUM: value = entity.variables[v].value_enum; break;
-                                case VAR_BOOL: value = entity.variables[v].value_bool ? 1 : 0; break;
-                            }
-
-                            switch (obj.variables[v].type) {
-                                case VAR_UINT8: entity.variables[v].value_uint8 = value; break;
-                                case VAR_INT8: entity.variables[v].value_int8 = value; break;
-                                case VAR_UINT16: entity.variables[v].value_uint16 = value; break;
-                                case VAR_INT16: entity.variables[v].value_int16 = value; break;
-                                case VAR_UINT32: entity.variables[v].value_uint32 = value; break;
-                                case VAR_INT32: entity.variables[v].value_int32 = value; break;
-                                case VAR_ENUM: entity.variables[v].value_enum = value; break;
-                                case VAR_BOOL: entity.variables[v].value_bool = value != 0; break;
-                            }
-                        }
-
-                        entity.variables[v].type = obj.variables[v].type;
+                        entity.variables[v].setType(obj.variables[v].type);
                     }
                     else { // otherwise we'll need to add new vars
                         RSDKv5::Scene::VariableValue variable;
@@ -4238,33 +4346,7 @@ void SceneEditorv5::InitGameLink()
                 }
                 // update remaining variables
                 for (int v = 0; v < obj.variables.count(); ++v) {
-                    // if we can transfer values, we should
-                    if (entity.variables[v].type <= VAR_BOOL && obj.variables[v].type <= VAR_BOOL) {
-                        int value = 0;
-                        switch (entity.variables[v].type) {
-                            case VAR_UINT8: value = entity.variables[v].value_uint8; break;
-                            case VAR_INT8: value = entity.variables[v].value_int8; break;
-                            case VAR_UINT16: value = entity.variables[v].value_uint16; break;
-                            case VAR_INT16: value = entity.variables[v].value_int16; break;
-                            case VAR_UINT32: value = entity.variables[v].value_uint32; break;
-                            case VAR_INT32: value = entity.variables[v].value_int32; break;
-                            case VAR_ENUM: value = entity.variables[v].value_enum; break;
-                            case VAR_BOOL: value = entity.variables[v].value_bool ? 1 : 0; break;
-                        }
-
-                        switch (obj.variables[v].type) {
-                            case VAR_UINT8: entity.variables[v].value_uint8 = value; break;
-                            case VAR_INT8: entity.variables[v].value_int8 = value; break;
-                            case VAR_UINT16: entity.variables[v].value_uint16 = value; break;
-                            case VAR_INT16: entity.variables[v].value_int16 = value; break;
-                            case VAR_UINT32: entity.variables[v].value_uint32 = value; break;
-                            case VAR_INT32: entity.variables[v].value_int32 = value; break;
-                            case VAR_ENUM: entity.variables[v].value_enum = value; break;
-                            case VAR_BOOL: entity.variables[v].value_bool = value != 0; break;
-                        }
-                    }
-
-                    entity.variables[v].type = obj.variables[v].type;
+                    entity.variables[v].setType(obj.variables[v].type);
                 }
             }
         }
@@ -4288,6 +4370,7 @@ void SceneEditorv5::InitGameLink()
             }
         }
     }
+    viewer->filterVars.invalidate();
 
     // EditorLoad should have all the info before being called
     for (int i = 0; i < viewer->objects.count() && gameLinks.count(); ++i) {
@@ -4339,7 +4422,7 @@ void SceneEditorv5::SetTile(float x, float y)
 
     if (ypos >= 0 && ypos < viewer->layers[viewer->selectedLayer].height) {
         if (xpos >= 0 && xpos < viewer->layers[viewer->selectedLayer].width) {
-            viewer->layers[viewer->selectedLayer].layout[ypos][xpos] = tile;
+            viewer->setLayoutTile(viewer->selectedLayer, xpos, ypos, tile);
         }
     }
 
@@ -4390,7 +4473,7 @@ void SceneEditorv5::SetStamp(float x, float y)
             if (tile != 0xFFFF) {
                 if (ypos + y >= 0 && ypos + y < viewer->layers[viewer->selectedLayer].height) {
                     if (xpos + x >= 0 && xpos + x < viewer->layers[viewer->selectedLayer].width) {
-                        viewer->layers[viewer->selectedLayer].layout[ypos + y][xpos + x] = tile;
+                        viewer->setLayoutTile(viewer->selectedLayer, xpos + x, ypos + y, tile);
                     }
                 }
             }
@@ -4610,25 +4693,14 @@ bool SceneEditorv5::HandleKeyPress(QKeyEvent *event)
         }
     }
 
+    if (viewerActive)
+        viewer->profilerKeyPress(event);
+
     if ((event->modifiers() & Qt::ControlModifier) == Qt::ControlModifier
         && event->key() == Qt::Key_G && viewerActive) {
         auto *sel = new GoToPos(viewer->layers[viewer->selectedLayer].width * viewer->tileSize, viewer->layers[viewer->selectedLayer].height * viewer->tileSize, viewer->layers[viewer->selectedLayer].name, this);
-        if (sel->exec() == QDialog::Accepted) {
-            viewer->cameraPos.x = sel->posX - ((viewer->storedW / 2) * viewer->invZoom());
-            viewer->cameraPos.y = sel->posY - ((viewer->storedH / 2) * viewer->invZoom());
-            if (viewer->cameraPos.x < 0) viewer->cameraPos.x = 0;
-            if (viewer->cameraPos.y < 0) viewer->cameraPos.y = 0;
-            viewer->screens->position.x = viewer->cameraPos.x;
-            viewer->screens->position.y = viewer->cameraPos.y;
-
-            ui->horizontalScrollBar->blockSignals(true);
-            ui->horizontalScrollBar->setValue(viewer->cameraPos.x);
-            ui->horizontalScrollBar->blockSignals(false);
-
-            ui->verticalScrollBar->blockSignals(true);
-            ui->verticalScrollBar->setValue(viewer->cameraPos.y);
-            ui->verticalScrollBar->blockSignals(false);
-        }
+        if (sel->exec() == QDialog::Accepted)
+            FocusCamera(sel->posX, sel->posY);
     }
 
     byte prevTool = viewer->curTool;
@@ -4758,7 +4830,7 @@ bool SceneEditorv5::HandleKeyPress(QKeyEvent *event)
                                 (viewer->tilePos.x * viewer->invZoom()) + viewer->cameraPos.x,
                                 (viewer->tilePos.y * viewer->invZoom()) + viewer->cameraPos.y);
                             if (box.contains(pos)) {
-                                viewer->layers[viewer->selectedLayer].layout[y][x] = 0xFFFF;
+                                viewer->setLayoutTile(viewer->selectedLayer, x, y, 0xFFFF);
 
                                 DoAction(QString("Erased Tile: (%1, %2)").arg(pos.x).arg(pos.y));
 
@@ -4854,8 +4926,8 @@ void SceneEditorv5::SetGameEntityVariables(SceneEntity *entity, void *gameEntity
     byte *entityBytes = (byte *)gameEntity;
 
     for (int o = 0; o < entity->variables.length(); o++) {
-        auto var    = viewer->objects[entity->type].variables[o];
-        auto val    = entity->variables[o];
+        auto &var   = viewer->objects[entity->type].variables[o];
+        auto &val   = entity->variables[o];
         auto offset = &entityBytes[var.offset];
 
         switch (var.type) {
@@ -4893,7 +4965,7 @@ void SceneEditorv5::GetGameEntityVariables(SceneEntity *entity, void *gameEntity
     byte *entityBytes = (byte *)gameEntity;
 
     for (int o = 0; o < entity->variables.length(); o++) {
-        auto var    = viewer->objects[entity->type].variables[o];
+        auto &var   = viewer->objects[entity->type].variables[o];
         auto &val   = entity->variables[o];
         auto offset = &entityBytes[var.offset];
         switch (var.type) {
@@ -5293,6 +5365,7 @@ void SceneEditorv5::ResetAction()
 #if RE_USE_UNSTABLE
     viewer->tilePalette = actions[actionIndex].tilePalette;
     viewer->tiles       = actions[actionIndex].tiles;
+    tileSel->RefreshTiles(viewer->syncTileAtlas());
 
     gameConfig = actions[actionIndex].gameConfig;
 
@@ -5303,6 +5376,7 @@ void SceneEditorv5::ResetAction()
     // Objects & Entities
     viewer->objects  = actions[actionIndex].objects;
     viewer->entities = actions[actionIndex].entities;
+    viewer->entityCounts.invalidate();
 
     // General Editing
     // viewer->curTool     = actions[actionIndex].curTool;
@@ -197,6 +197,16 @@ private:
     void UnloadGameLinks();
     void LoadGameLinks();
     void InitGameLink();
+    void SetupPaletteBanks();
+
+    // tile usage, see SceneViewer::tileUsage
+    void FocusCamera(float x, float y);
+    void FindNextPlacement(ushort id);
+    void ShowUnusedTiles();
+    void MergeDuplicateTiles();
+    int findID  = -1;
+    int findPos = 0;
+    QString mergeExcluded; // the last list of tiles merging was told to leave alone
 
     void SetGameEntityVariables(SceneEntity *entity, void *gameEntity);
     void GetGameEntityVariables(SceneEntity *entity, void *gameEntity);
@@ -258,6 +268,8 @@ public:
     TileSelector(QWidget *parent = nullptr);
 
     void RefreshList();
+    void RefreshTiles(const QList<int> &ids);
+    void RefreshTile(int id);
 
 private:
     TileLabel *tiles[0x400];
@@ -149,8 +149,8 @@ ChunkReplaceOptions::ChunkReplaceOptions(byte gameVer, FormatHelpers::Chunks *ch
                 }
 
                 chunkImgList[replacedChunk + i] = chunks->chunks[replacedChunk + i].getImage(tileList);
-                ui->srcChunkList->item(replacedChunk + i)->setIcon(QPixmap::fromImage(chunks->chunks[replacedChunk + i].getImage((tileList))));
-                ui->dstChunkList->item(replacedChunk + i)->setIcon(QPixmap::fromImage(chunks->chunks[replacedChunk + i].getImage((tileList))));
+                ui->srcChunkList->item(replacedChunk + i)->setIcon(QPixmap::fromImage(chunkImgList[replacedChunk + i]));
+                ui->dstChunkList->item(replacedChunk + i)->setIcon(QPixmap::fromImage(chunkImgList[replacedChunk + i]));
             }
             modified = true;
         } else {
@@ -193,8 +193,8 @@ ChunkReplaceOptions::ChunkReplaceOptions(byte gameVer, FormatHelpers::Chunks *ch
             modified = true;
 
             chunkImgList[replacedChunk] = chunks->chunks[replacedChunk].getImage(tileList);
-            ui->srcChunkList->item(replacedChunk)->setIcon(QPixmap::fromImage(chunks->chunks[replacedChunk].getImage((tileList))));
-            ui->dstChunkList->item(replacedChunk)->setIcon(QPixmap::fromImage(chunks->chunks[replacedChunk].getImage((tileList))));
+            ui->srcChunkList->item(replacedChunk)->setIcon(QPixmap::fromImage(chunkImgList[replacedChunk]));
+            ui->dstChunkList->item(replacedChunk)->setIcon(QPixmap::fromImage(chunkImgList[replacedChunk]));
         }
     });
 }
@@ -67,6 +67,8 @@ public:
     QList<ScrollIndexInfo> scrollInfos;
 
     QList<QList<ushort>> layout;
+    // set whenever layout changes, the v5 editor only copies & packs modified layers when saving
+    bool modified = true;
 };
 
 } // namespace SceneHelpers
@@ -118,7 +120,7 @@ struct SceneEntity {
     Vector2<float> pos = Vector2<float>(0, 0);
     void *gameEntity   = nullptr; // for v5
     int gameEntitySlot = -1;      // for v4 and below
-    QList<RSDKv5::Scene::VariableValue> variables;
+    QList<RSDKv5::Scene::VariableValue> variables; // editors hold pointers to values, keep it a QList
     Rect<int> box = Rect<int>(-0x10, -0x10, 0x10, 0x10); // selection box
 
     // for <= v4
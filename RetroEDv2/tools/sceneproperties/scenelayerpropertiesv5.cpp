@@ -52,7 +52,8 @@ void SceneLayerPropertiesv5::setupUI(SceneViewer *viewer, byte lID)
             }
         }
 
-        tileLayer->width = (short)v;
+        tileLayer->width    = (short)v;
+        tileLayer->modified = true;
     });
 
     connect(ui->height, QOverload<int>::of(&QSpinBox::valueChanged), [tileLayer](int v) {
@@ -69,7 +70,8 @@ void SceneLayerPropertiesv5::setupUI(SceneViewer *viewer, byte lID)
                 tileLayer->layout.removeAt(h);
         }
 
-        tileLayer->height = (short)v;
+        tileLayer->height   = (short)v;
+        tileLayer->modified = true;
     });
 
     connect(ui->type, QOverload<int>::of(&QComboBox::currentIndexChanged), [this, tileLayer](int v) {
@@ -145,6 +145,8 @@ void SceneObjectPropertiesv5::setupUI(SceneEntity *entity)
                     Property *prop = valGroup.last();
                     disconnect(prop, nullptr, nullptr, nullptr);
                     connect(prop, &Property::changed, [prop, v, entity, object] {
+                        // filters are uint8s
+                        v5Editor->viewer->entityCounts.invalidate();
                         if (object && entity->gameEntity) {
                             byte *dataPtr = &((byte *)entity->gameEntity)[object->variables[v].offset];
                             memcpy(dataPtr, prop->valuePtr, sizeof(byte));
@@ -13,8 +13,11 @@ SceneTileProperties::SceneTileProperties(QWidget *parent)
 {
     ui->setupUi(this);
 
-    replaceTile  = ui->replaceTile;
-    edit.tileImg = QImage(16,16, QImage::Format_Indexed8);
+    replaceTile     = ui->replaceTile;
+    findChunk       = ui->findChunk;
+    unusedChunks    = ui->unusedChunks;
+    mergeDuplicates = ui->mergeDuplicates;
+    edit.tileImg    = QImage(16,16, QImage::Format_Indexed8);
     ui->tileFrame->layout()->addWidget(&edit);
 }
 
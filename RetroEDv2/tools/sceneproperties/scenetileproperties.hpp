@@ -56,7 +56,10 @@ public:
     void tileSelected(ushort tile);
     void unsetUI();
 
-    QPushButton *replaceTile  = nullptr;
+    QPushButton *replaceTile     = nullptr;
+    QPushButton *findChunk       = nullptr;
+    QPushButton *unusedChunks    = nullptr;
+    QPushButton *mergeDuplicates = nullptr;
 
 signals:
     void updateChunkColMap();
@@ -9,8 +9,11 @@ SceneTilePropertiesv5::SceneTilePropertiesv5(QWidget *parent)
 {
     ui->setupUi(this);
 
-    replaceTile  = ui->replaceTile;
-    edit.tileImg = QImage(16, 16, QImage::Format_Indexed8);
+    replaceTile     = ui->replaceTile;
+    findTile        = ui->findTile;
+    unusedTiles     = ui->unusedTiles;
+    mergeDuplicates = ui->mergeDuplicates;
+    edit.tileImg    = QImage(16, 16, QImage::Format_Indexed8);
     ui->frame->layout()->addWidget(&edit);
 }
 
@@ -50,7 +50,10 @@ public:
     void updatePropFlags(bool c, byte pos);
     int collisionLyr = 0;
 
-    QPushButton *replaceTile  = nullptr;
+    QPushButton *replaceTile     = nullptr;
+    QPushButton *findTile        = nullptr;
+    QPushButton *unusedTiles     = nullptr;
+    QPushButton *mergeDuplicates = nullptr;
 
 signals:
     void updateTileFlags(bool c, byte pos);
@@ -211,6 +211,16 @@ TilesetEditor::TilesetEditor(QList<QImage> &tileList, QList<PaletteColor> &pal,
 
 TilesetEditor::~TilesetEditor() { delete ui; }
 
+QList<int> TilesetEditor::editedTiles() const
+{
+    QList<int> edited;
+    for (int t = 0; t < tileIDs.count(); ++t) {
+        if (tileIDs[t] != t || changedTiles[t])
+            edited.append(t);
+    }
+    return edited;
+}
+
 bool TilesetEditor::event(QEvent *e)
 {
     switch (e->type()) {
@@ -56,6 +56,9 @@ public:
     QList<ushort> tileIDs;
     QList<bool> changedTiles;
 
+    // slots that were moved or imported over, the only ones the scene has to re-sync
+    QList<int> editedTiles() const;
+
     QList<PaletteColor> &palette;
     QList<QImage> &tiles;
 
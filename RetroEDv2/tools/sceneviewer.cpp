@@ -208,6 +208,12 @@ void SceneViewer::dispose()
     VAO->destroy();
     fbpVAO->destroy();
 
+    if (paletteTexPtr) {
+        paletteTexPtr->destroy();
+        delete paletteTexPtr;
+        paletteTexPtr = nullptr;
+    }
+
     argInitStage  = "";
     argInitScene  = "";
     argInitFilter = "";
@@ -223,78 +229,57 @@ void SceneViewer::initScene(QImage tileset)
     unloadScene();
 
     // Get Tiles (for tile list, tileset editing and collision viewer)
-    tiles.clear();
     colTexStore = new QImage(0x80, 0x400 * 0x10, QImage::Format_Indexed8);
     colTexStore->setColorTable({ 0xFFFF00FF, 0xFFFFFF00, 0xFFFF0000, 0xFFFFFFFF, 0xFF808000});
     colTexStore->fill(0);
-    for (int i = 0; i < 0x400; ++i) {
-        int tx         = ((i % (tileset.width() / 0x10)) * 0x10);
-        int ty         = ((i / (tileset.width() / 0x10)) * 0x10);
-        QImage tileTex = tileset.copy(tx, ty, 0x10, 0x10);
-
-        tiles.append(tileTex);
-
-        for (int c = 0; c < 2; c++){
-            for (byte y = 0; y < 16; ++y) {
-                for (byte x = 0; x < 16; ++x) {
-                    if (gameType != ENGINE_v1){
-                        RSDKv5::TileConfig::CollisionMask &cmask = tileconfig.collisionPaths[c][i];
-                        // draw pixel collision
-                        int dir = !cmask.direction ? y : abs(y - 15);
-                        if ((!cmask.direction ? cmask.collision[x].height <= dir : cmask.collision[x].height >= dir) && cmask.collision[x].solid){
-                            for (byte m = 0; m < 4; ++m)
-                                colTexStore->setPixel(x + tx + c * 0x40 + m * 0x10, dir + ty, m + 1);
-                        }
-                    } else {
-                        RSDKv1::TileConfig::CollisionMask &cmask = tileconfigv1.collisionPaths[c][i];
-                        // draw pixel collision
-                        for (byte m = 0; m < 4; ++m){
-                            int dirX = (m & 1) == 0 ? x : abs(x - 15);
-                            int dirY = (m & 2) == 0 ? y : abs(y - 15);
-                            if (((m & 2) == 0 ? cmask.collision[m][dirX].height <= dirY : cmask.collision[m][dirX].height >= dirY) && cmask.collision[m][dirX].solid) {
-                                colTexStore->setPixel(dirX + tx + c * 0x40 + m * 0x10, dirY + ty, 3);
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
+
+    tileAtlas.load(tileset);
+    tiles = tileAtlas.tileImages();
 
     // Get Tile Palette (for tileset editing)
-    auto pal = tileset.colorTable();
+    auto pal = tileAtlas.getPalette();
     tilePalette.clear();
     for (QRgb &col : pal) {
         tilePalette.append(PaletteColor(col));
     }
 
     chunks.clear();
-    if (gameType != ENGINE_v5) {
-        for (FormatHelpers::Chunks::Chunk &c : chunkset.chunks) {
-            chunks.append(c.getImage(tiles));
-        }
-    }
+    if (gameType != ENGINE_v5)
+        chunks = chunkset.getImages(tiles);
+
+    // v1-v4 layers hold chunk IDs as is, v5 layers hold tiles with flip & solidity bits on top
+    if (gameType == ENGINE_v5)
+        tileUsage.setup(0x3FF, 0x400, 0xFFFF);
+    else
+        tileUsage.setup(0xFFFF, gameType == ENGINE_v1 ? 0x100 : 0x200, 0xFFFF);
 
     // Tile Texture
     GLint active;
     glFuncs->glGetIntegerv(GL_ACTIVE_TEXTURE, &active);
     gfxSurface[0].scope      = SCOPE_STAGE;
     gfxSurface[0].name       = "Tileset";
-    gfxSurface[0].width      = tileset.width();
-    gfxSurface[0].height     = tileset.height();
-    gfxSurface[0].texturePtr = createTexture(tileset, QOpenGLTexture::Target2D);
+    gfxSurface[0].width      = TileAtlas::TILE_SIZE;
+    gfxSurface[0].height     = TileAtlas::TILE_SIZE * TileAtlas::TILE_COUNT;
+    gfxSurface[0].texturePtr = createIndexTexture((const uchar *)tileAtlas.getPixels().constData(),
+                                                  gfxSurface[0].width, gfxSurface[0].height);
+    tileAtlas.takeDirtyRanges(); // everything was just uploaded
+    gfxSurface[0].indexed    = true;
     gfxSurface[0].transClr   = tilePalette[0].toQColor();
+    setSurfacePalette(0, pal);
 
     glFuncs->glActiveTexture(GL_TEXTURE30);
     glFuncs->glBindTexture(GL_TEXTURE_RECTANGLE, gfxSurface[0].texturePtr->textureId());
     glFuncs->glActiveTexture(active);
 
+    drawColMap();
+
     gfxSurface[1].scope      = SCOPE_STAGE;
     gfxSurface[1].name       = "Collision A";
     gfxSurface[1].width      = colTexStore->width();
     gfxSurface[1].height     = colTexStore->height();
     gfxSurface[1].texturePtr = createTexture(*colTexStore, QOpenGLTexture::Target2D);
     gfxSurface[1].transClr   = QColor(0xFFFF00FF);
+    gfxSurface[1].indexed    = false;
 
     gfxSurface[2].scope      = SCOPE_STAGE;
     gfxSurface[2].name       = "Collision B";
@@ -302,6 +287,7 @@ void SceneViewer::initScene(QImage tileset)
     gfxSurface[2].height     = colTexStore->height();
     gfxSurface[2].texturePtr = createTexture(*colTexStore, QOpenGLTexture::Target2D);
     gfxSurface[2].transClr   = QColor(0xFFFF00FF);
+    gfxSurface[2].indexed    = false;
 
     // Default Texture
     if (gfxSurface[3].scope == SCOPE_NONE) {
@@ -313,6 +299,7 @@ void SceneViewer::initScene(QImage tileset)
         gfxSurface[3].width    = missingObj.width();
         gfxSurface[3].height   = missingObj.height();
         gfxSurface[3].transClr = QColor(0xFFFF00FF);
+        gfxSurface[3].indexed  = false;
     }
 
     // Default Player Texture
@@ -325,7 +312,11 @@ void SceneViewer::initScene(QImage tileset)
         gfxSurface[4].width    = missingObj.width();
         gfxSurface[4].height   = missingObj.height();
         gfxSurface[4].transClr = QColor(0xFFFF00FF);
+        gfxSurface[4].indexed  = false;
     }
+
+    if (gameType != ENGINE_v5)
+        initChunkAtlas();
 }
 
 void SceneViewer::updateScene()
@@ -413,22 +404,9 @@ void SceneViewer::updateScene()
 
     if (v5Editor) {
         if (v5Editor->scnProp) {
-            int activeCount = 0, inactiveCount = 0;
-            for (auto &entity : entities) {
-                int filter = 0xFF;
-                for (int v = 0; v < objects[entity.type].variables.count(); ++v) {
-                    if (objects[entity.type].variables[v].name == "filter") {
-                        if (v < entity.variables.count())
-                            filter = entity.variables[v].value_uint8;
-                        break;
-                    }
-                }
-
-                if (!(filter & sceneFilter) && filter)
-                    ++inactiveCount;
-                else
-                    ++activeCount;
-            }
+            updateEntityCounts();
+            int activeCount   = entityCounts.active(sceneFilter, 0xFF);
+            int inactiveCount = entityCounts.total() - activeCount;
 
             v5Editor->scnProp->layerCnt->setText(
                 QString("Tile Layer Count: %1 Layers").arg(layers.count()));
@@ -450,115 +428,260 @@ void SceneViewer::updateScene()
 }
 
 
-void SceneViewer::updateTileColMap(RSDKv5::TileConfig::CollisionMask *cmask, ushort sel, int colLyr)
+QRect SceneViewer::colTileRect(ushort tile, int colLyr)
 {
-    int tx         = ((sel % (gfxSurface[0].width / 0x10)) * 0x10);
-    int ty         = ((sel / (gfxSurface[0].width / 0x10)) * 0x10);
-    // draw pixel collision
-    for (byte x = 0; x < 16; x++){
-        for (byte y = 0; y < 16; y++){
-            int dir = !cmask->direction ? y : abs(y - 15);
-            for (byte m = 0; m < 4; ++m){
-                int pos = x + tx + colLyr * 0x40 + m * 0x10;
-                colTexStore->setPixel(pos, dir + ty, 0);
-                if (!cmask->direction ? cmask->collision[x].height <= dir : cmask->collision[x].height >= dir) {
-                    if (cmask->collision[x].solid)
-                        colTexStore->setPixel(pos, dir + ty, m + 1);
-                }
-            }
-        }
+    int tx = ((tile % (gfxSurface[0].width / 0x10)) * 0x10);
+    int ty = ((tile / (gfxSurface[0].width / 0x10)) * 0x10);
+    return QRect(tx + colLyr * 0x40, ty, 0x40, 0x10);
+}
+
+void SceneViewer::drawColTile(uchar *bits, int pitch, RSDKv5::TileConfig::CollisionMask &cmask,
+                              ushort tile, int colLyr)
+{
+    QRect rect = colTileRect(tile, colLyr);
+
+    // work out the solid span of each column once, then write whole rows for all 4 variants
+    int top[0x10], bottom[0x10];
+    for (int x = 0; x < 0x10; ++x) {
+        top[x]    = !cmask.direction ? cmask.collision[x].height : 0;
+        bottom[x] = !cmask.direction ? 0xF : cmask.collision[x].height;
+        if (!cmask.collision[x].solid)
+            top[x] = 0x10;
     }
 
-    delete gfxSurface[colLyr + 1].texturePtr;
-    gfxSurface[colLyr + 1].texturePtr = createTexture(*colTexStore, QOpenGLTexture::Target2D);
+    for (int y = 0; y < 0x10; ++y) {
+        byte row[0x10];
+        for (int x = 0; x < 0x10; ++x) row[x] = y >= top[x] && y <= bottom[x];
+
+        uchar *line = bits + (rect.y() + y) * pitch + rect.x();
+        for (int m = 0; m < 4; ++m, line += 0x10) {
+            for (int x = 0; x < 0x10; ++x) line[x] = row[x] * (m + 1);
+        }
+    }
 }
 
-void SceneViewer::updateChunkColMap()
+void SceneViewer::drawColTilev1(uchar *bits, int pitch, RSDKv1::TileConfig::CollisionMask &cmask,
+                                ushort tile, int colLyr)
 {
-    colTexStore->fill(0);
-    for (int i = 0; i < 0x400; ++i){
-        int tx         = ((i % (gfxSurface[0].width / 0x10)) * 0x10);
-        int ty         = ((i / (gfxSurface[0].width / 0x10)) * 0x10);
-        for (int c = 0; c < 2; ++c){
-            // draw pixel collision
-            for (byte x = 0; x < 16; x++){
-                for (byte y = 0; y < 16; y++){
-                    if (gameType != ENGINE_v1){
-                        RSDKv5::TileConfig::CollisionMask &cmask = tileconfig.collisionPaths[c][i];
-                        // draw pixel collision
-                        int dir = !cmask.direction ? y : abs(y - 15);
-                        for (byte m = 0; m < 4; ++m){
-                            int pos = x + tx + c * 0x40 + m * 0x10;
-                            colTexStore->setPixel(pos, dir + ty, 0);
-                            if ((!cmask.direction ? cmask.collision[x].height <= dir : cmask.collision[x].height >= dir) && cmask.collision[x].solid)
-                                colTexStore->setPixel(pos, dir + ty, m + 1);
-                        }
-                    } else {
-                        RSDKv1::TileConfig::CollisionMask &cmask = tileconfigv1.collisionPaths[c][i];
-                        // draw pixel collision
-                        for (byte m = 0; m < 4; ++m){
-                            int dirX = (m & 1) == 0 ? x : abs(x - 15);
-                            int dirY = (m & 2) == 0 ? y : abs(y - 15);
-                            int pos = dirX + tx + c * 0x40 + m * 0x10;
-                            colTexStore->setPixel(pos, dirY + ty, 0);
-                            if (((m & 2) == 0 ? cmask.collision[m][dirX].height <= dirY : cmask.collision[m][dirX].height >= dirY) && cmask.collision[m][dirX].solid)
-                                colTexStore->setPixel(pos, dirY + ty, 3);
-                        }
-                    }
-                }
-            }
+    QRect rect = colTileRect(tile, colLyr);
+
+    // each variant is its own side, floors fill downwards & roofs fill upwards
+    for (int m = 0; m < 4; ++m) {
+        int top[0x10], bottom[0x10];
+        for (int x = 0; x < 0x10; ++x) {
+            top[x]    = (m & 2) == 0 ? cmask.collision[m][x].height : 0;
+            bottom[x] = (m & 2) == 0 ? 0xF : cmask.collision[m][x].height;
+            if (!cmask.collision[m][x].solid)
+                top[x] = 0x10;
+        }
+
+        for (int y = 0; y < 0x10; ++y) {
+            uchar *line = bits + (rect.y() + y) * pitch + rect.x() + m * 0x10;
+            for (int x = 0; x < 0x10; ++x) line[x] = y >= top[x] && y <= bottom[x] ? 3 : 0;
         }
     }
-    delete gfxSurface[1].texturePtr;
-    delete gfxSurface[2].texturePtr;
-    gfxSurface[1].texturePtr = createTexture(*colTexStore, QOpenGLTexture::Target2D);
-    gfxSurface[2].texturePtr = createTexture(*colTexStore, QOpenGLTexture::Target2D);
+}
+
+void SceneViewer::drawColMap()
+{
+    // grab the pointer up front, workers can't call bits() since it may detach
+    uchar *bits = colTexStore->bits();
+    int pitch   = colTexStore->bytesPerLine();
+
+    QList<int> tileIDs;
+    tileIDs.reserve(0x400);
+    for (int i = 0; i < 0x400; ++i) tileIDs.append(i);
+
+    QtConcurrent::blockingMap(tileIDs, [this, bits, pitch](int &tile) {
+        for (int c = 0; c < 2; ++c) {
+            if (gameType != ENGINE_v1)
+                drawColTile(bits, pitch, tileconfig.collisionPaths[c][tile], tile, c);
+            else
+                drawColTilev1(bits, pitch, tileconfigv1.collisionPaths[c][tile], tile, c);
+        }
+    });
+}
+
+void SceneViewer::uploadColRect(int colLyr, QRect rect)
+{
+    QOpenGLTexture *tex = gfxSurface[colLyr + 1].texturePtr;
+    if (!tex)
+        return;
+
+    // mipmaps aren't refreshed, they're never sampled with nearest filtering anyways
+    QImage region = colTexStore->copy(rect).convertToFormat(QImage::Format_RGBA8888);
+    tex->bind();
+    tex->setData(rect.x(), rect.y(), 0, rect.width(), rect.height(), 1, QOpenGLTexture::RGBA,
+                 QOpenGLTexture::UInt8, region.constBits());
+}
+
+void SceneViewer::updateTileColMap(RSDKv5::TileConfig::CollisionMask *cmask, ushort sel, int colLyr)
+{
+    drawColTile(colTexStore->bits(), colTexStore->bytesPerLine(), *cmask, sel, colLyr);
+    uploadColRect(colLyr, colTileRect(sel, colLyr));
+}
+
+void SceneViewer::updateChunkColMap()
+{
+    drawColMap();
+    uploadColRect(0, colTexStore->rect());
+    uploadColRect(1, colTexStore->rect());
 }
 
 void SceneViewer::updateChunkColTile(RSDKv5::TileConfig::CollisionMask *cmask, ushort sel, int colLyr)
 {
-    int tx         = ((sel % (gfxSurface[0].width / 0x10)) * 0x10);
-    int ty         = ((sel / (gfxSurface[0].width / 0x10)) * 0x10);
-    // draw pixel collision
-    for (byte x = 0; x < 16; x++){
-        for (byte y = 0; y < 16; y++){
-            int dir = !cmask->direction ? y : abs(y - 15);
-            for (byte m = 0; m < 4; ++m){
-                int pos = x + tx + colLyr * 0x40 + m * 0x10;
-                colTexStore->setPixel(pos, dir + ty, 0);
-                if ((!cmask->direction ? cmask->collision[x].height <= dir : cmask->collision[x].height >= dir) && cmask->collision[x].solid) {
-                    colTexStore->setPixel(pos, dir + ty, m + 1);
-                }
+    drawColTile(colTexStore->bits(), colTexStore->bytesPerLine(), *cmask, sel, colLyr);
+    uploadColRect(colLyr, colTileRect(sel, colLyr));
+}
+
+void SceneViewer::updateChunkColTilev1(RSDKv1::TileConfig::CollisionMask *cmask, ushort sel, int colLyr)
+{
+    drawColTilev1(colTexStore->bits(), colTexStore->bytesPerLine(), *cmask, sel, colLyr);
+    uploadColRect(colLyr, colTileRect(sel, colLyr));
+}
+
+void SceneViewer::initChunkAtlas()
+{
+    QImage atlas =
+        chunkAtlas.build(chunks, tilePalette.count() ? tilePalette[0].toQColor() : QColor(0xFFFF00FF));
+
+    if (chunkSurface < 0) {
+        for (int s = 3; s < v5_SURFACE_MAX; ++s) {
+            if (gfxSurface[s].scope == SCOPE_NONE) {
+                chunkSurface = s;
+                break;
             }
         }
+
+        if (chunkSurface < 0)
+            return;
+    }
+    else if (gfxSurface[chunkSurface].texturePtr) {
+        delete gfxSurface[chunkSurface].texturePtr;
     }
 
-    delete gfxSurface[colLyr + 1].texturePtr;
-    gfxSurface[colLyr + 1].texturePtr = createTexture(*colTexStore, QOpenGLTexture::Target2D);
+    gfxSurface[chunkSurface].scope      = SCOPE_STAGE;
+    gfxSurface[chunkSurface].name       = "Chunks";
+    gfxSurface[chunkSurface].width      = atlas.width();
+    gfxSurface[chunkSurface].height     = atlas.height();
+    gfxSurface[chunkSurface].texturePtr = createTexture(atlas, QOpenGLTexture::Target2D);
+    gfxSurface[chunkSurface].transClr   = gfxSurface[0].transClr;
+    gfxSurface[chunkSurface].indexed    = false;
+    memset(gfxSurface[chunkSurface].hash, 0, sizeof(gfxSurface[chunkSurface].hash));
 }
 
-void SceneViewer::updateChunkColTilev1(RSDKv1::TileConfig::CollisionMask *cmask, ushort sel, int colLyr)
+void SceneViewer::updateChunkAtlas()
 {
-    int tx         = ((sel % (gfxSurface[0].width / 0x10)) * 0x10);
-    int ty         = ((sel / (gfxSurface[0].width / 0x10)) * 0x10);
-    // draw pixel collision
-    for (byte x = 0; x < 16; x++){
-        for (byte y = 0; y < 16; y++){
-            // draw pixel collision
-            for (byte m = 0; m < 4; ++m){
-                int dirX = (m & 1) == 0 ? x : abs(x - 15);
-                int dirY = (m & 2) == 0 ? y : abs(y - 15);
-                int pos = dirX + tx + colLyr * 0x40 + m * 0x10;
-                colTexStore->setPixel(pos, dirY + ty, 0);
-                if (((m & 2) == 0 ? cmask->collision[m][dirX].height <= dirY : cmask->collision[m][dirX].height >= dirY) && cmask->collision[m][dirX].solid) {
-                    colTexStore->setPixel(pos, dirY + ty, 3);
-                }
-            }
+    if (chunkSurface < 0 || !gfxSurface[chunkSurface].texturePtr)
+        return;
+
+    QOpenGLTexture *tex = gfxSurface[chunkSurface].texturePtr;
+    for (int c : chunkAtlas.takeDirty(chunks)) {
+        QRect rect   = ChunkAtlas::rect(c);
+        QImage chunk = ChunkAtlas::cell(chunks[c]);
+        tex->bind();
+        tex->setData(rect.x(), rect.y(), 0, rect.width(), rect.height(), 1, QOpenGLTexture::RGBA,
+                     QOpenGLTexture::UInt8, chunk.constBits());
+    }
+}
+
+QList<int> SceneViewer::syncTileAtlas(const QList<int> &ids)
+{
+    syncTilePalette();
+    return tileAtlas.syncFrom(tiles, ids);
+}
+
+QList<int> SceneViewer::syncTileAtlas()
+{
+    syncTilePalette();
+    return tileAtlas.syncFrom(tiles);
+}
+
+void SceneViewer::syncTilePalette()
+{
+    QVector<QRgb> pal;
+    for (PaletteColor &col : tilePalette) pal.append(col.toQColor().rgb());
+    tileAtlas.setPalette(pal);
+    setSurfacePalette(0, pal);
+
+    // only the row that gets drawn sees the game's colours
+    for (auto it = gamePalette.cbegin(); it != gamePalette.cend(); ++it)
+        surfacePalettes.setColor(0, it.key(), it.value());
+    gfxSurface[0].transClr = QColor(surfacePalettes.getColor(0, 0));
+
+    // v1-v4 stage sheets share the upper half of the stage palette
+    if (gameType != ENGINE_v5 && pal.count() == 256) {
+        for (int s = 1; s < v5_SURFACE_MAX; ++s) {
+            if (gfxSurface[s].scope != SCOPE_STAGE || !gfxSurface[s].indexed)
+                continue;
+
+            for (int i = 128; i < 256; ++i) surfacePalettes.setColor(s, i, pal[i]);
         }
     }
+}
+
+void SceneViewer::storeGamePalette(int start, int count)
+{
+    // indices wrap around the row as bytes, same as the calls that wrote them
+    count = qMin(count, (int)PaletteTexture::COLOR_COUNT);
+    for (int i = 0; i < count; ++i) {
+        byte index         = (byte)(start + i);
+        gamePalette[index] = surfacePalettes.getColor(0, index);
+    }
+    gfxSurface[0].transClr = QColor(surfacePalettes.getColor(0, 0));
+}
+
+void SceneViewer::updateTileAtlas()
+{
+    if (!tileAtlas.isDirty() || !gfxSurface[0].texturePtr)
+        return;
 
-    delete gfxSurface[colLyr + 1].texturePtr;
-    gfxSurface[colLyr + 1].texturePtr = createTexture(*colTexStore, QOpenGLTexture::Target2D);
+    QOpenGLTexture *tex = gfxSurface[0].texturePtr;
+    tex->bind();
+    for (auto &range : tileAtlas.takeDirtyRanges()) {
+        tex->setData(0, range.first * TileAtlas::TILE_SIZE, 0, TileAtlas::TILE_SIZE,
+                     range.second * TileAtlas::TILE_SIZE, 1, QOpenGLTexture::Red, QOpenGLTexture::UInt8,
+                     tileAtlas.tilePixels(range.first));
+    }
+}
+
+void SceneViewer::setLayoutTile(int layer, int x, int y, ushort value)
+{
+    if (layer < 0 || layer >= layers.count())
+        return;
+
+    auto &layout = layers[layer].layout;
+    if (y < 0 || y >= layout.count() || x < 0 || x >= layout[y].count())
+        return;
+
+    ushort prev = layout[y][x];
+    if (prev == value)
+        return;
+
+    layout[y][x]           = value;
+    layers[layer].modified = true;
+    tileUsage.update(layer, x, y, prev, value);
+}
+
+void SceneViewer::setSurfacePalette(int surface, const QVector<QRgb> &colors)
+{
+    if (surface < 0 || surface >= v5_SURFACE_MAX)
+        return;
+
+    surfacePalettes.setRow(surface, colors);
+    gfxSurface[surface].transClr = QColor(surfacePalettes.getColor(surface, 0));
+}
+
+void SceneViewer::updatePalettes()
+{
+    if (!surfacePalettes.isDirty() || !paletteTexPtr)
+        return;
+
+    // every row goes up at once, it's only 256 colours a row
+    paletteTexPtr->bind();
+    paletteTexPtr->setData(QOpenGLTexture::BGRA, QOpenGLTexture::UInt32_RGBA8_Rev,
+                           surfacePalettes.constData());
+    surfacePalettes.clearDirty();
 }
 
 void SceneViewer::drawScene()
@@ -614,6 +737,11 @@ void SceneViewer::drawScene()
             drawLayers[drawOrder].layerDrawList.append(t);
     }
 
+    updateTileAtlas();
+    updatePalettes();
+    if (gameType != ENGINE_v5)
+        updateChunkAtlas();
+
     // if (fileRender)
     //     addStatusProgress(0.2); // finished rendering bg
 
@@ -631,6 +759,8 @@ void SceneViewer::drawScene()
             if (!layers[l].visible)
                 continue;
 
+            FrameProfiler::Scope layerScope(profiler, layers[l].name, "Layer");
+
             // TILE LAYERS
             int camX = cameraPos.x;
             int camY = cameraPos.y;
@@ -693,44 +823,35 @@ void SceneViewer::drawScene()
             }
             else {
                 // Draw Chunk-Based TileMap
-                for (int y = basedY; y < countY; ++y) {
+                GFXSurface *surface = chunkSurface >= 0 ? &gfxSurface[chunkSurface] : nullptr;
+                for (int y = basedY; y < countY && surface; ++y) {
                     const QList<ushort> *row = &layers[l].layout.at(y);
                     for (int x = basedX; x < countX; ++x) {
                         ushort chunkID = row->at(x);
                         if (chunkID != 0x0 && chunkID < 0x200) {
-                            for (int ty = 0; ty < 8; ++ty) {
-                                for (int tx = 0; tx < 8; ++tx) {
-                                    FormatHelpers::Chunks::Tile &info =
-                                        chunkset.chunks[chunkID].tiles[ty][tx];
-
-                                    ++count;
-                                    float xp = ((x * tileSize) + (tx * 0x10)) - cameraPos.x;
-                                    float yp = ((y * tileSize) + (ty * 0x10)) - cameraPos.y;
-
-                                    ushort point = (info.tileIndex << 2) | (info.direction << 12);
-                                    addPoly(xp, yp, tileUVArray[point], tileUVArray[point + 1], 0,
-                                            gfxSurface);
-                                    addPoly(xp + 0x10, yp, tileUVArray[point + 2],
-                                            tileUVArray[point + 1], 0, gfxSurface);
-                                    addPoly(xp, yp + 0x10, tileUVArray[point], tileUVArray[point + 3],
-                                            0, gfxSurface);
-                                    addPoly(xp + 0x10, yp + 0x10, tileUVArray[point + 2],
-                                            tileUVArray[point + 3], 0, gfxSurface);
+                            ++count;
+                            float xp = (x * tileSize) - cameraPos.x;
+                            float yp = (y * tileSize) - cameraPos.y;
 
-                                    // safety pass
-                                    if (renderCount >= vertexListLimit - 8) {
-                                        PlaceArgs args;
-                                        args.texID = 0;
+                            QRect uv = ChunkAtlas::rect(chunkID);
+                            addPoly(xp, yp, uv.left(), uv.top(), 0, surface);
+                            addPoly(xp + tileSize, yp, uv.left() + tileSize, uv.top(), 0, surface);
+                            addPoly(xp, yp + tileSize, uv.left(), uv.top() + tileSize, 0, surface);
+                            addPoly(xp + tileSize, yp + tileSize, uv.left() + tileSize,
+                                    uv.top() + tileSize, 0, surface);
 
-                                        renderCount -= count * 4;
-                                        addRenderState((selectedLayer == l || fileRender) ? INK_NONE
-                                                                                          : INK_BLEND,
-                                                       count * 4, count * 6, &args, 0xFF, &placeShader);
-                                        renderCount += count * 4;
-                                        renderRenderStates();
-                                        count = 0;
-                                    }
-                                }
+                            // safety pass
+                            if (renderCount >= vertexListLimit - 8) {
+                                PlaceArgs args;
+                                args.texID = chunkSurface;
+
+                                renderCount -= count * 4;
+                                addRenderState((selectedLayer == l || fileRender) ? INK_NONE
+                                                                                  : INK_BLEND,
+                                               count * 4, count * 6, &args, 0xFF, &placeShader);
+                                renderCount += count * 4;
+                                renderRenderStates();
+                                count = 0;
                             }
                         }
                     }
@@ -739,7 +860,7 @@ void SceneViewer::drawScene()
 
             renderCount -= count * 4;
             PlaceArgs args;
-            args.texID = 0;
+            args.texID = gameType == ENGINE_v5 ? 0 : chunkSurface;
             addRenderState((selectedLayer == l || fileRender) ? INK_NONE : INK_BLEND, count * 4,
                            count * 6, &args, 0xFF, &placeShader);
             renderCount += count * 4;
@@ -1048,6 +1169,7 @@ void SceneViewer::drawScene()
     // ENTITIES
     Rect<float> viewArea = Rect<float>(cameraPos.x - 32, cameraPos.y - 32,
                                        storedW * invZoom() + cameraPos.x + 32, storedH * invZoom() + cameraPos.y + 32);
+    updateFilterVars();
     for (int p = 0; p < v5_DRAWGROUP_COUNT; ++p) {
         sceneInfo.currentDrawGroup   = p;
         sceneInfoV1.currentDrawGroup = p;
@@ -1061,14 +1183,7 @@ void SceneViewer::drawScene()
             if (!objects[entity->type].visible)
                 continue;
 
-            int filter = 0xFF;
-            for (int v = 0; v < objects[entity->type].variables.count(); ++v) {
-                if (objects[entity->type].variables[v].name == "filter") {
-                    if (v < entity->variables.count())
-                        filter = entity->variables[v].value_uint8;
-                    break;
-                }
-            }
+            int filter = entityFilter(*entity);
 
             if (!(filter & sceneFilter) && filter)
                 continue;
@@ -1078,6 +1193,7 @@ void SceneViewer::drawScene()
                 continue;
 
             if (entity->type != 0) {
+                FrameProfiler::Scope drawScope(profiler, objects[entity->type].name, "Draw");
                 if (gameType == ENGINE_v5)
                     emit callGameEventv5(objects[entity->type].name, EVENT_DRAW, entity);
                 else
@@ -1124,6 +1240,7 @@ void SceneViewer::drawScene()
         validDraw = false;
 
         if (entity->type != 0) {
+            FrameProfiler::Scope drawScope(profiler, objects[entity->type].name, "Draw");
             if (gameType == ENGINE_v5)
                 emit callGameEventv5(objects[entity->type].name, EVENT_DRAW, entity);
             else
@@ -1166,6 +1283,7 @@ void SceneViewer::drawScene()
             validDraw = false;
 
             if (entity->type != 0) {
+                FrameProfiler::Scope drawScope(profiler, objects[entity->type].name, "Draw");
                 if (gameType == ENGINE_v5)
                     emit callGameEventv5(objects[entity->type].name, EVENT_DRAW, entity);
                 else
@@ -1592,6 +1710,8 @@ void SceneViewer::unloadScene()
     disableObjects = true;
 
     tiles.clear();
+    tileAtlas.clear();
+    gamePalette.clear();
     if (colTexStore) {
         delete colTexStore;
         colTexStore = nullptr;
@@ -1603,8 +1723,11 @@ void SceneViewer::unloadScene()
                 delete gfxSurface[o].texturePtr;
             gfxSurface[o].texturePtr = nullptr;
             gfxSurface[o].scope      = SCOPE_NONE;
+            gfxSurface[o].indexed    = false;
         }
     }
+    chunkSurface = -1;
+    chunkAtlas.clear();
 
     for (int a = 0; a < v5_SPRFILE_COUNT; ++a) {
         spriteAnimationList[a].scope = SCOPE_NONE;
@@ -1638,21 +1761,26 @@ void SceneViewer::unloadScene()
 
 void SceneViewer::processObjects(bool isImage)
 {
-    for (int i = 0; i < v5_DRAWGROUP_COUNT; ++i) {
-        drawLayers[i].entries.clear();
-    }
+    // work out where every entity belongs, then only touch the lists for the ones that moved
+    objectGroups.next.fill(ObjectGroups::State(), entities.count());
 
     sceneInfo.entitySlot   = 0;
     sceneInfoV1.entitySlot = 0;
     int centerX            = screens->centerX * invZoom();
     int centerY            = screens->centerY * invZoom();
+    int screenX            = (screens->position.x + centerX) << 16;
+    int screenY            = (screens->position.y + centerY) << 16;
 
     if (gameType == ENGINE_v5) {
         switch (v5Editor->viewer->engineRevision) {
             case 1: {
+                // pack what the range checks need so they can run over flat arrays in one go
+                activeRanges.gather<GameEntityv1>(entities, isImage);
+                activeRanges.cull(screenX, screenY, centerX << 16, centerY << 16);
+
                 for (int e = 0; e < entities.count(); ++e) {
                     if (!entities[e].gameEntity || !entities[e].type || isImage) {
-                        drawLayers[15].entries.append(sceneInfo.entitySlot++);
+                        objectGroups.next[sceneInfo.entitySlot++].drawGroup = 15;
                         sceneInfoV1.entitySlot = sceneInfo.entitySlot;
                         continue;
                     }
@@ -1661,58 +1789,7 @@ void SceneViewer::processObjects(bool isImage)
                     sceneInfoV1.entity   = entities[e].gameEntity;
                     GameEntityv1 *entity = AS_ENTITY(sceneInfo.entity, GameEntityv1);
                     if (entities[e].type) {
-                        entity->inRange = false;
-
-                        int rangeX = entity->updateRange.x;
-                        int rangeY = entity->updateRange.y;
-
-                        switch (entity->active) {
-                            case ACTIVE_NEVER:
-                            case ACTIVE_PAUSED:
-                            case ACTIVE_ALWAYS:
-                            case ACTIVE_NORMAL: entity->inRange = true; break;
-                            case ACTIVE_BOUNDS: {
-                                int sx =
-                                    abs(entity->position.x - ((screens->position.x + centerX) << 16));
-                                int sy =
-                                    abs(entity->position.y - ((screens->position.y + centerY) << 16));
-                                if (sx <= rangeX + (centerX << 16) && sy <= rangeY + (centerY << 16)) {
-                                    entity->inRange = true;
-                                }
-                                break;
-                            }
-                            case ACTIVE_XBOUNDS: {
-                                int sx =
-                                    abs(entity->position.x - ((screens->position.x + centerX) << 16));
-                                if (sx <= rangeX + (centerX << 16)) {
-                                    entity->inRange = true;
-                                    break;
-                                }
-                                break;
-                            }
-                            case ACTIVE_YBOUNDS: {
-                                int sy =
-                                    abs(entity->position.y - ((screens->position.y + centerY) << 16));
-                                if (sy <= rangeY + (centerY << 16)) {
-                                    entity->inRange = true;
-                                    break;
-                                }
-                                break;
-                            }
-                            case ACTIVE_RBOUNDS: {
-                                int sx =
-                                    abs(entity->position.x - ((screens->position.x + centerX) << 16))
-                                    >> 16;
-                                int sy =
-                                    abs(entity->position.y - ((screens->position.y + centerY) << 16))
-                                    >> 16;
-                                if (sx * sx + sy * sy <= rangeX + (centerX << 16)) {
-                                    entity->inRange = true;
-                                    break;
-                                }
-                                break;
-                            }
-                        }
+                        entity->inRange = activeRanges.inRange(e);
 
                         if (entity->inRange) {
                             // emit
@@ -1721,7 +1798,7 @@ void SceneViewer::processObjects(bool isImage)
                             //              &entities[e]);
 
                             if (entity->drawGroup < v5_DRAWGROUP_COUNT)
-                                drawLayers[entity->drawGroup].entries.append(sceneInfo.entitySlot);
+                                objectGroups.next[sceneInfo.entitySlot].drawGroup = entity->drawGroup;
                         }
                     }
                     else {
@@ -1731,10 +1808,6 @@ void SceneViewer::processObjects(bool isImage)
                     sceneInfoV1.entitySlot++;
                 }
 
-                for (int i = 0; i < TYPEGROUP_COUNT_v5; ++i) {
-                    typeGroups[i].entries.clear();
-                }
-
                 sceneInfo.entitySlot   = 0;
                 sceneInfoV1.entitySlot = 0;
                 for (int e = 0; e < entities.count(); ++e) {
@@ -1743,10 +1816,9 @@ void SceneViewer::processObjects(bool isImage)
                     GameEntityv1 *entity = AS_ENTITY(sceneInfo.entity, GameEntityv1);
 
                     if (sceneInfo.entity && entity->inRange && entity->interaction) {
-                        typeGroups[0].entries.append(e);               // All active objects
-                        typeGroups[entity->classID].entries.append(e); // type-based slots
+                        objectGroups.next[e].classID = entity->classID; // type-based slots
                         if (entity->group >= TYPE_COUNT) {
-                            typeGroups[entity->group].entries.append(e); // extra slots
+                            objectGroups.next[e].group = entity->group; // extra slots
                         }
                     }
                     sceneInfo.entitySlot++;
@@ -1766,67 +1838,20 @@ void SceneViewer::processObjects(bool isImage)
 
             case 2: {
 
+                // pack what the range checks need so they can run over flat arrays in one go
+                activeRanges.gather<GameEntityv2>(entities, isImage);
+                activeRanges.cull(screenX, screenY, centerX << 16, centerY << 16);
+
                 for (int e = 0; e < entities.count(); ++e) {
                     if (!entities[e].gameEntity || !entities[e].type || isImage) {
-                        drawLayers[15].entries.append(sceneInfo.entitySlot++);
+                        objectGroups.next[sceneInfo.entitySlot++].drawGroup = 15;
                         continue;
                     }
 
                     sceneInfo.entity     = entities[e].gameEntity;
                     GameEntityv2 *entity = AS_ENTITY(sceneInfo.entity, GameEntityv2);
                     if (entities[e].type) {
-                        entity->inRange = false;
-
-                        int rangeX = entity->updateRange.x;
-                        int rangeY = entity->updateRange.y;
-
-                        switch (entity->active) {
-                            case ACTIVE_NEVER:
-                            case ACTIVE_PAUSED:
-                            case ACTIVE_ALWAYS:
-                            case ACTIVE_NORMAL: entity->inRange = true; break;
-                            case ACTIVE_BOUNDS: {
-                                int sx =
-                                    abs(entity->position.x - ((screens->position.x + centerX) << 16));
-                                int sy =
-                                    abs(entity->position.y - ((screens->position.y + centerY) << 16));
-                                if (sx <= rangeX + (centerX << 16) && sy <= rangeY + (centerY << 16)) {
-                                    entity->inRange = true;
-                                }
-                                break;
-                            }
-                            case ACTIVE_XBOUNDS: {
-                                int sx =
-                                    abs(entity->position.x - ((screens->position.x + centerX) << 16));
-                                if (sx <= rangeX + (centerX << 16)) {
-                                    entity->inRange = true;
-                                    break;
-                                }
-                                break;
-                            }
-                            case ACTIVE_YBOUNDS: {
-                                int sy =
-                                    abs(entity->position.y - ((screens->position.y + centerY) << 16));
-                                if (sy <= rangeY + (centerY << 16)) {
-                                    entity->inRange = true;
-                                    break;
-                                }
-                                break;
-                            }
-                            case ACTIVE_RBOUNDS: {
-                                int sx =
-                                    abs(entity->position.x - ((screens->position.x + centerX) << 16))
-                                    >> 16;
-                                int sy =
-                                    abs(entity->position.y - ((screens->position.y + centerY) << 16))
-                                    >> 16;
-                                if (sx * sx + sy * sy <= rangeX + (centerX << 16)) {
-                                    entity->inRange = true;
-                                    break;
-                                }
-                                break;
-                            }
-                        }
+                        entity->inRange = activeRanges.inRange(e);
 
                         if (entity->inRange) {
                             // emit
@@ -1835,7 +1860,7 @@ void SceneViewer::processObjects(bool isImage)
                             //              &entities[e]);
 
                             if (entity->drawGroup < v5_DRAWGROUP_COUNT)
-                                drawLayers[entity->drawGroup].entries.append(sceneInfo.entitySlot);
+                                objectGroups.next[sceneInfo.entitySlot].drawGroup = entity->drawGroup;
                         }
                     }
                     else {
@@ -1844,20 +1869,15 @@ void SceneViewer::processObjects(bool isImage)
                     sceneInfo.entitySlot++;
                 }
 
-                for (int i = 0; i < TYPEGROUP_COUNT_v5; ++i) {
-                    typeGroups[i].entries.clear();
-                }
-
                 sceneInfo.entitySlot = 0;
                 for (int e = 0; e < entities.count(); ++e) {
                     sceneInfo.entity     = entities[e].gameEntity;
                     GameEntityv2 *entity = AS_ENTITY(sceneInfo.entity, GameEntityv2);
 
                     if (sceneInfo.entity && entity->inRange && entity->interaction) {
-                        typeGroups[0].entries.append(e);               // All active objects
-                        typeGroups[entity->classID].entries.append(e); // type-based slots
+                        objectGroups.next[e].classID = entity->classID; // type-based slots
                         if (entity->group >= TYPE_COUNT) {
-                            typeGroups[entity->group].entries.append(e); // extra slots
+                            objectGroups.next[e].group = entity->group; // extra slots
                         }
                     }
                     sceneInfo.entitySlot++;
@@ -1875,67 +1895,20 @@ void SceneViewer::processObjects(bool isImage)
 
             default:
             case 3: {
+                // pack what the range checks need so they can run over flat arrays in one go
+                activeRanges.gather<GameEntityvU>(entities, isImage);
+                activeRanges.cull(screenX, screenY, centerX << 16, centerY << 16);
+
                 for (int e = 0; e < entities.count(); ++e) {
                     if (!entities[e].gameEntity || !entities[e].type || isImage) {
-                        drawLayers[15].entries.append(sceneInfo.entitySlot++);
+                        objectGroups.next[sceneInfo.entitySlot++].drawGroup = 15;
                         continue;
                     }
 
                     sceneInfo.entity     = entities[e].gameEntity;
                     GameEntityvU *entity = AS_ENTITY(sceneInfo.entity, GameEntityvU);
                     if (entities[e].type) {
-                        entity->inRange = false;
-
-                        int rangeX = entity->updateRange.x;
-                        int rangeY = entity->updateRange.y;
-
-                        switch (entity->active) {
-                            case ACTIVE_NEVER:
-                            case ACTIVE_PAUSED:
-                            case ACTIVE_ALWAYS:
-                            case ACTIVE_NORMAL: entity->inRange = true; break;
-                            case ACTIVE_BOUNDS: {
-                                int sx =
-                                    abs(entity->position.x - ((screens->position.x + centerX) << 16));
-                                int sy =
-                                    abs(entity->position.y - ((screens->position.y + centerY) << 16));
-                                if (sx <= rangeX + (centerX << 16) && sy <= rangeY + (centerY << 16)) {
-                                    entity->inRange = true;
-                                }
-                                break;
-                            }
-                            case ACTIVE_XBOUNDS: {
-                                int sx =
-                                    abs(entity->position.x - ((screens->position.x + centerX) << 16));
-                                if (sx <= rangeX + (centerX << 16)) {
-                                    entity->inRange = true;
-                                    break;
-                                }
-                                break;
-                            }
-                            case ACTIVE_YBOUNDS: {
-                                int sy =
-                                    abs(entity->position.y - ((screens->position.y + centerY) << 16));
-                                if (sy <= rangeY + (centerY << 16)) {
-                                    entity->inRange = true;
-                                    break;
-                                }
-                                break;
-                            }
-                            case ACTIVE_RBOUNDS: {
-                                int sx =
-                                    abs(entity->position.x - ((screens->position.x + centerX) << 16))
-                                    >> 16;
-                                int sy =
-                                    abs(entity->position.y - ((screens->position.y + centerY) << 16))
-                                    >> 16;
-                                if (sx * sx + sy * sy <= rangeX + (centerX << 16)) {
-                                    entity->inRange = true;
-                                    break;
-                                }
-                                break;
-                            }
-                        }
+                        entity->inRange = activeRanges.inRange(e);
 
                         if (entity->inRange) {
                             // emit
@@ -1944,7 +1917,7 @@ void SceneViewer::processObjects(bool isImage)
                             //              &entities[e]);
 
                             if (entity->drawGroup < v5_DRAWGROUP_COUNT)
-                                drawLayers[entity->drawGroup].entries.append(sceneInfo.entitySlot);
+                                objectGroups.next[sceneInfo.entitySlot].drawGroup = entity->drawGroup;
                         }
                     }
                     else {
@@ -1953,20 +1926,15 @@ void SceneViewer::processObjects(bool isImage)
                     sceneInfo.entitySlot++;
                 }
 
-                for (int i = 0; i < TYPEGROUP_COUNT_v5; ++i) {
-                    typeGroups[i].entries.clear();
-                }
-
                 sceneInfo.entitySlot = 0;
                 for (int e = 0; e < entities.count(); ++e) {
                     sceneInfo.entity     = entities[e].gameEntity;
                     GameEntityvU *entity = AS_ENTITY(sceneInfo.entity, GameEntityvU);
 
                     if (sceneInfo.entity && entity->inRange && entity->interaction) {
-                        typeGroups[0].entries.append(e);               // All active objects
-                        typeGroups[entity->classID].entries.append(e); // type-based slots
+                        objectGroups.next[e].classID = entity->classID; // type-based slots
                         if (entity->group >= TYPE_COUNT) {
-                            typeGroups[entity->group].entries.append(e); // extra slots
+                            objectGroups.next[e].group = entity->group; // extra slots
                         }
                     }
                     sceneInfo.entitySlot++;
@@ -1984,15 +1952,16 @@ void SceneViewer::processObjects(bool isImage)
         }
     }
     else {
+        activeRanges.resize(entities.count());
         for (int e = 0; e < entities.count(); ++e) {
             if (!entities[e].type || isImage) {
-                drawLayers[15].entries.append(sceneInfo.entitySlot++);
+                objectGroups.next[sceneInfo.entitySlot++].drawGroup = 15;
                 sceneInfoV1.entitySlot = sceneInfo.entitySlot;
+                activeRanges.set(e, 0, 0, 0, 0, ACTIVE_NEVER);
                 continue;
             }
 
             if (entities[e].type) {
-                bool inBounds   = false;
                 byte activeType = ACTIVE_NEVER;
                 byte drawOrder  = 0;
 
@@ -2037,44 +2006,21 @@ void SceneViewer::processObjects(bool isImage)
                     case 7: activeType = ACTIVE_NORMAL; break;
                 }
 
-                switch (activeType) {
-                    case ACTIVE_NEVER:
-                    case ACTIVE_PAUSED:
-                    case ACTIVE_ALWAYS:
-                    case ACTIVE_NORMAL: inBounds = true; break;
-                    case ACTIVE_BOUNDS: {
-                        int sx = abs(posX - ((screens->position.x + centerX) << 16));
-                        int sy = abs(posY - ((screens->position.y + centerY) << 16));
-                        if (sx <= rangeX + (centerX << 16) && sy <= rangeY + (centerY << 16)) {
-                            inBounds = true;
-                        }
-                        break;
-                    }
-                    case ACTIVE_XBOUNDS: {
-                        int sx = abs(posX - ((screens->position.x + centerX) << 16));
-                        if (sx <= rangeX + (centerX << 16)) {
-                            inBounds = true;
-                            break;
-                        }
-                        break;
-                    }
-                }
-
-                if (inBounds) {
-                    // emit callGameEvent(gameLink.GetObjectInfo(objects[entities[e].type].name),
-                    // EVENT_UPDATE,
-                    //              &entities[e]);
+                activeRanges.set(e, posX, posY, rangeX, rangeY, activeType);
 
-                    if (drawOrder < v5_DRAWGROUP_COUNT)
-                        drawLayers[drawOrder].entries.append(sceneInfo.entitySlot);
-                }
+                // dropped again below if it turns out to be out of range
+                if (drawOrder < v5_DRAWGROUP_COUNT)
+                    objectGroups.next[sceneInfo.entitySlot].drawGroup = drawOrder;
             }
             sceneInfo.entitySlot++;
             sceneInfoV1.entitySlot++;
         }
 
-        for (int i = 0; i < TYPEGROUP_COUNT_v5; ++i) {
-            typeGroups[i].entries.clear();
+        activeRanges.cull(screenX, screenY, centerX << 16, centerY << 16);
+
+        for (int e = 0; e < entities.count(); ++e) {
+            if (entities[e].type && !isImage && !activeRanges.inRange(e))
+                objectGroups.next[e].drawGroup = -1;
         }
 
         // sceneInfo.entitySlot = 0;
@@ -2094,6 +2040,19 @@ void SceneViewer::processObjects(bool isImage)
         //     sceneInfoV1.entitySlot++;
         // }
     }
+
+    objectGroups.update([this](int g) -> QVector<ushort> & { return drawLayers[g].entries; },
+                        v5_DRAWGROUP_COUNT,
+                        [this](int g) -> QVector<ushort> & { return typeGroups[g].entries; },
+                        TYPEGROUP_COUNT_v5);
+}
+
+void SceneViewer::resetObjectGroups()
+{
+    objectGroups.reset([this](int g) -> QVector<ushort> & { return drawLayers[g].entries; },
+                       v5_DRAWGROUP_COUNT,
+                       [this](int g) -> QVector<ushort> & { return typeGroups[g].entries; },
+                       TYPEGROUP_COUNT_v5);
 }
 
 void SceneViewer::initializeGL()
@@ -2150,12 +2109,36 @@ void SceneViewer::initializeGL()
             QColor tc = gfxSurface[args->texID].transClr;
             self->setValue("transColor",
                            QVector3D({ (float)tc.redF(), (float)tc.greenF(), (float)tc.blueF() }));
+            self->setValue("indexed", gfxSurface[args->texID].indexed);
+            if (gfxSurface[args->texID].indexed) {
+                self->setValue("paletteRow", (int)args->texID);
+                glFuncs->glActiveTexture(GL_TEXTURE1);
+                glFuncs->glBindTexture(GL_TEXTURE_2D, paletteTexPtr->textureId());
+                glFuncs->glActiveTexture(GL_TEXTURE0);
+            }
         }
         else
             self->setValue("useColor", true);
     };
     placeShader.use();
     placeShader.setValue("sprite", 0);
+    placeShader.setValue("palette", 1);
+
+    // the context can be set up again (eg when the widget gets reparented), the old texture went with it
+    if (paletteTexPtr) {
+        paletteTexPtr->destroy();
+        delete paletteTexPtr;
+    }
+
+    paletteTexPtr = new QOpenGLTexture(QOpenGLTexture::Target2D);
+    paletteTexPtr->create();
+    paletteTexPtr->bind();
+    paletteTexPtr->setWrapMode(QOpenGLTexture::ClampToEdge);
+    paletteTexPtr->setMinMagFilters(QOpenGLTexture::Nearest, QOpenGLTexture::Nearest);
+    paletteTexPtr->setFormat(QOpenGLTexture::RGBA8_UNorm);
+    paletteTexPtr->setSize(PaletteTexture::COLOR_COUNT, surfacePalettes.rowCount());
+    paletteTexPtr->allocateStorage(QOpenGLTexture::BGRA, QOpenGLTexture::UInt32_RGBA8_Rev);
+    surfacePalettes.markDirty(); // a new texture starts out empty
 
     circleShader.loadShader(":/shaders/pre/default.vert", QOpenGLShader::Vertex);
     circleShader.loadShader(":/shaders/pre/circle.frag", QOpenGLShader::Fragment);
@@ -2462,26 +2445,41 @@ void SceneViewer::paintGL()
     matView.scale(zoom, zoom);
     matView.translate(-invZoom(), invZoom());
 
+    profiler.beginFrame();
+
     outFB->bind();
     glFuncs->glClearColor(metadata.backgroundColor1.red() / 255.0f,
                           metadata.backgroundColor1.green() / 255.0f,
                           metadata.backgroundColor1.blue() / 255.0f, 1.0f);
     glFuncs->glClear(GL_COLOR_BUFFER_BIT);
 
-    if (!disableObjects)
+    if (!disableObjects) {
+        FrameProfiler::Scope scope(profiler, "processObjects", "Scene");
         processObjects(false);
+    }
 
-    if (!disableDrawScene)
+    if (!disableDrawScene) {
+        FrameProfiler::Scope scope(profiler, "drawScene", "Scene");
         drawScene();
+    }
 
     // swap FB0
-    glFuncs->glBindFramebuffer(GL_FRAMEBUFFER, defaultFramebufferObject());
-    finalFBShader.use();
-    fbpVAO->bind();
-    fbpVBO->bind();
-    fbiVBO->bind();
-    glFuncs->glBlendFunc(GL_ONE, GL_ZERO);
-    glFuncs->glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0);
+    {
+        FrameProfiler::Scope scope(profiler, "Blit", "Render");
+        glFuncs->glBindFramebuffer(GL_FRAMEBUFFER, defaultFramebufferObject());
+        finalFBShader.use();
+        fbpVAO->bind();
+        fbpVBO->bind();
+        fbiVBO->bind();
+        glFuncs->glBlendFunc(GL_ONE, GL_ZERO);
+        glFuncs->glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0);
+        profiler.addCounter(FrameProfiler::COUNTER_DRAWCALLS, 1);
+    }
+
+    profiler.endFrame();
+
+    if (profiler.showOverlay)
+        drawProfilerOverlay();
 
     sumFps += fpsTimer.nsecsElapsed();
     fpsTimer.restart();
@@ -2495,6 +2493,59 @@ void SceneViewer::paintGL()
     }
 }
 
+void SceneViewer::drawProfilerOverlay()
+{
+    QStringList lines = profiler.summary();
+    if (gameType == ENGINE_v5 && v5Editor && v5Editor->viewer == this)
+        lines.append(storageSummary(v5Editor->dataStorage));
+
+    QPainter p(this);
+    QFont font("Consolas");
+    font.setStyleHint(QFont::Monospace);
+    font.setPointSize(9);
+    p.setFont(font);
+
+    QFontMetrics metrics(font);
+    int lineH = metrics.height();
+    int w     = 0;
+    for (auto &line : lines) w = qMax(w, metrics.horizontalAdvance(line));
+
+    p.fillRect(QRect(4, 4, w + 8, lines.count() * lineH + 8), QColor(0, 0, 0, 0xC0));
+    p.setPen(Qt::white);
+    for (int i = 0; i < lines.count(); ++i) p.drawText(8, 8 + metrics.ascent() + i * lineH, lines[i]);
+    p.end();
+
+    // QPainter leaves its own state behind, restore what the next frame expects
+    glFuncs->glViewport(0, 0, storedW, storedH);
+    glFuncs->glEnable(GL_BLEND);
+    glFuncs->glDisable(GL_DEPTH_TEST);
+    glFuncs->glDisable(GL_SCISSOR_TEST);
+}
+
+void SceneViewer::profilerKeyPress(QKeyEvent *event)
+{
+    if (event->key() != Qt::Key_F3 || event->isAutoRepeat())
+        return;
+
+    if ((event->modifiers() & Qt::ControlModifier) == Qt::ControlModifier) {
+        QFileDialog filedialog(this, tr("Export Profiler Trace"), "", tr("Chrome Trace Files (*.json)"));
+        filedialog.setAcceptMode(QFileDialog::AcceptSave);
+        if (filedialog.exec() == QDialog::Accepted) {
+            QString filepath = filedialog.selectedFiles()[0];
+            if (CheckOverwrite(filepath, ".json", this)) {
+                if (profiler.exportTrace(filepath))
+                    SetStatus("Exported profiler trace to " + filepath);
+                else
+                    SetStatus("Failed to export profiler trace!");
+            }
+        }
+    }
+    else {
+        profiler.showOverlay = !profiler.showOverlay;
+        profiler.setEnabled(profiler.showOverlay);
+    }
+}
+
 int SceneViewer::addGraphicsFile(QString sheetPath, int sheetID, byte scope)
 {
     if (sheetID >= 0 && sheetID < v5_SURFACE_MAX) {
@@ -2519,11 +2570,23 @@ int SceneViewer::addGraphicsFile(QString sheetPath, int sheetID, byte scope)
         }
         gfxSurface[sheetID].name = QString(sheetPath);
         Utils::getHashInt(sheetPath, gfxSurface[sheetID].hash);
-        gfxSurface[sheetID].texturePtr = createTexture(sheet);
-        gfxSurface[sheetID].scope      = scope;
-        gfxSurface[sheetID].width      = sheet.width();
-        gfxSurface[sheetID].height     = sheet.height();
-        gfxSurface[sheetID].transClr   = transClr;
+        gfxSurface[sheetID].scope    = scope;
+        gfxSurface[sheetID].width    = sheet.width();
+        gfxSurface[sheetID].height   = sheet.height();
+        gfxSurface[sheetID].transClr = transClr;
+
+        QByteArray indices;
+        QVector<QRgb> colors;
+        if (PaletteTexture::splitImage(sheet, indices, colors)) {
+            gfxSurface[sheetID].texturePtr =
+                createIndexTexture((const uchar *)indices.constData(), sheet.width(), sheet.height());
+            gfxSurface[sheetID].indexed = true;
+            setSurfacePalette(sheetID, colors);
+        }
+        else {
+            gfxSurface[sheetID].texturePtr = createTexture(sheet);
+            gfxSurface[sheetID].indexed    = false;
+        }
         return sheetID;
     }
     return -1;
@@ -2534,14 +2597,16 @@ void SceneViewer::removeGraphicsFile(QString sheetPath, int slot)
     if (slot >= 0) {
         gfxSurface[slot].texturePtr->destroy();
         delete gfxSurface[slot].texturePtr;
-        gfxSurface[slot].scope = SCOPE_NONE;
+        gfxSurface[slot].scope   = SCOPE_NONE;
+        gfxSurface[slot].indexed = false;
     }
     else {
         for (int i = 3; i < v5_SURFACE_MAX; ++i) {
             if (QString(sheetPath) == gfxSurface[i].name) {
                 gfxSurface[i].texturePtr->destroy();
                 delete gfxSurface[i].texturePtr;
-                gfxSurface[i].scope = SCOPE_NONE;
+                gfxSurface[i].scope   = SCOPE_NONE;
+                gfxSurface[i].indexed = false;
             }
         }
     }
@@ -3036,6 +3101,10 @@ void SceneViewer::renderRenderStates()
     if (!renderCount)
         return;
 
+    FrameProfiler::Scope scope(profiler, "renderRenderStates", "Render");
+    profiler.addCounter(FrameProfiler::COUNTER_VERTICES, renderCount);
+    profiler.addCounter(FrameProfiler::COUNTER_RENDERSTATES, renderStateCount);
+
     VAO->bind();
     attribVBO->bind();
     attribVBO->write(0, vertexList, renderCount * sizeof(DrawVertex));
@@ -3076,6 +3145,7 @@ void SceneViewer::renderRenderStates()
         indexVBO->write(0, renderState.indices, renderState.indexCount * sizeof(ushort));
         glFuncs->glDrawElements(lines ? GL_LINES : GL_TRIANGLES, renderState.indexCount,
                                 GL_UNSIGNED_SHORT, 0);
+        profiler.addCounter(FrameProfiler::COUNTER_DRAWCALLS, 1);
 
         fbpVAO->bind();
         fbpVBO->bind();
@@ -3105,6 +3175,7 @@ void SceneViewer::renderRenderStates()
                 renderState.fbShader->setValue("dest", 21);
                 renderState.fbShader->setArgs(&renderState);
                 glFuncs->glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0);
+                profiler.addCounter(FrameProfiler::COUNTER_COMPOSITEPASSES, 1);
                 renderState.fbShader = renderState.fbShader2;
             }
             // render to the out FB, clear t2
@@ -3115,6 +3186,7 @@ void SceneViewer::renderRenderStates()
             renderState.fbShader->setArgs(&renderState);
 
             glFuncs->glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0);
+            profiler.addCounter(FrameProfiler::COUNTER_COMPOSITEPASSES, 1);
             t2FB->bind();
             glFuncs->glClear(GL_COLOR_BUFFER_BIT);
         }
@@ -3127,6 +3199,7 @@ void SceneViewer::renderRenderStates()
                 renderState.fbShader2->setValue("dest", 21);
                 renderState.fbShader2->setArgs(&renderState);
                 glFuncs->glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0);
+                profiler.addCounter(FrameProfiler::COUNTER_COMPOSITEPASSES, 1);
             }
         }
         VAO->bind();
@@ -3143,6 +3216,7 @@ void SceneViewer::addEditorVariable(QString name)
     VariableInfo var;
     var.name = name;
     objects[activeVarObj].variables.append(var);
+    filterVars.invalidate();
 }
 void SceneViewer::setActiveVariable(QString name)
 {
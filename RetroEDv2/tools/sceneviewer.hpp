@@ -4,6 +4,13 @@
 #include <RSDKv1.hpp>
 
 #include "sceneproperties/sceneincludesv5.hpp"
+#include "tools/utils/chunkatlas.hpp"
+#include "tools/utils/entitycounts.hpp"
+#include "tools/utils/filtervarindex.hpp"
+#include "tools/utils/objectgroups.hpp"
+#include "tools/utils/palettetexture.hpp"
+#include "tools/utils/tileatlas.hpp"
+#include "tools/utils/tileusageindex.hpp"
 
 #define AS_ENTITY(var, type) ((type *)var)
 
@@ -73,6 +80,8 @@ public:
     void unloadScene();
 
     void processObjects(bool isImage);
+    // drops every draw & type group entry, for when the entity list is replaced wholesale
+    void resetObjectGroups();
 
     void dispose();
 
@@ -88,6 +97,12 @@ public:
     double avgFps = 0.0;
     QElapsedTimer fpsTimer;
 
+    // per-frame phase timings, toggled with F3
+    FrameProfiler profiler;
+    void drawProfilerOverlay();
+    // F3 toggles the overlay, ctrl+F3 exports a trace of the recorded frames
+    void profilerKeyPress(QKeyEvent *event);
+
     byte gameType = ENGINE_NONE;
 
     QString dataPath = "";
@@ -101,6 +116,15 @@ public:
     byte tileSize = 0x10;
     QList<SceneHelpers::TileLayer> layers;
     FormatHelpers::Chunks chunkset;
+    // where each tile (chunk for v1-v4) is placed, call ensure() before asking it anything
+    TileUsageIndex tileUsage;
+    // writes a single layout entry, keeping tileUsage & the layer's modified flag up to date
+    void setLayoutTile(int layer, int x, int y, ushort value);
+    // after layers are rewritten in bulk, or moved around so they don't line up with the last save
+    inline void markLayersModified()
+    {
+        for (auto &layer : layers) layer.modified = true;
+    }
 
     bool useLayerScrollInfo = true;
     QList<SceneHelpers::TileLayer::ScrollIndexInfo> hScroll;
@@ -131,24 +155,28 @@ public:
     AnalogStateV1 stickLV1[5];
     TouchMouseDataV1 touchMouseV1;
 
+    // each object's "filter" variable, invalidate it whenever objects or their variables change & call
+    // updateFilterVars() before looping over entities
+    FilterVarIndex filterVars;
+    inline void updateFilterVars() { filterVars.ensure(objects); }
+
+    inline int entityFilter(const SceneEntity &entity, int fallback = 0xFF)
+    {
+        return filterVars.filter(entity, fallback);
+    }
+
+    // invalidate it whenever an entity's variables are edited in place
+    EntityCounts entityCounts;
+    inline void updateEntityCounts()
+    {
+        updateFilterVars();
+        entityCounts.ensure(entities, filterVars);
+    }
+
     inline int activeEntityCount()
     {
-        int count = 0;
-        for (int i = 0; i < entities.count(); ++i) {
-            SceneEntity &entity = entities[i];
-            int filter          = 0;
-            for (int v = 0; v < objects[entity.type].variables.count(); ++v) {
-                if (objects[entity.type].variables[v].name == "filter") {
-                    if (v < entity.variables.count())
-                        filter = entity.variables[v].value_uint8;
-                    break;
-                }
-            }
-
-            if ((filter & sceneFilter) || !filter)
-                ++count;
-        }
-        return count;
+        updateEntityCounts();
+        return entityCounts.active(sceneFilter, 0);
     }
 
     QString currentSceneID = "1";
@@ -207,7 +235,18 @@ public:
     Vector2<float> cameraPos = Vector2<float>(0.0f, 0.0f);
 
     QList<PaletteColor> tilePalette;
-    QList<QImage> tiles;
+    QList<QImage> tiles; // per tile copies for the editors, tileAtlas is what gets drawn & saved
+    TileAtlas tileAtlas;
+    // picks up edits made to tilePalette & the given tiles, returns the tiles that changed. the no
+    // argument version compares every tile, it's only for when the whole list got swapped out
+    QList<int> syncTileAtlas(const QList<int> &ids);
+    QList<int> syncTileAtlas();
+    void syncTilePalette();
+    // palette bank 0 is the tileset's palette. the game's writes to it only go into the palette
+    // texture's row, call this after one so the colours it set are kept as an overlay every sync puts
+    // back on top. tilePalette stays the editor's, it's what gets saved & undone
+    void storeGamePalette(int start, int count);
+    QMap<int, QRgb> gamePalette; // bank 0 colours set by the game, by index
     QList<QImage> chunks;
     QImage missingObj;
 
@@ -253,12 +292,22 @@ public:
 
     DrawList drawLayers[v5_DRAWGROUP_COUNT];
 
+    ActiveRangeList activeRanges;
+
+    ObjectGroups objectGroups;
+
     SpriteAnimation spriteAnimationList[v5_SPRFILE_COUNT];
     GFXSurface gfxSurface[v5_SURFACE_MAX];
 
     int addGraphicsFile(QString sheetPath, int sheetID, byte scope);
     void removeGraphicsFile(QString sheetPath, int slot);
 
+    // a row per surface, followed by the palette banks the game can edit (bank 0 is the tileset's row)
+    PaletteTexture surfacePalettes = PaletteTexture(v5_SURFACE_MAX + v5_PALETTE_BANK_COUNT - 1);
+    QOpenGLTexture *paletteTexPtr  = nullptr;
+    void setSurfacePalette(int surface, const QVector<QRgb> &colors);
+    inline int paletteBankRow(byte bank) const { return bank ? v5_SURFACE_MAX + bank - 1 : 0; }
+
     ushort tileUVArray[0x400 * 4 * 4];
 
     inline QOpenGLTexture *
@@ -278,6 +327,26 @@ public:
         return tex;
     }
 
+    // R8 texture of palette indices, the colours come from surfacePalettes when it's drawn
+    inline QOpenGLTexture *createIndexTexture(const uchar *indices, int width, int height)
+    {
+        QOpenGLTexture *tex = new QOpenGLTexture(QOpenGLTexture::Target2D);
+        tex->create();
+        tex->bind();
+        tex->setWrapMode(QOpenGLTexture::DirectionS, QOpenGLTexture::WrapMode::Repeat);
+        tex->setWrapMode(QOpenGLTexture::DirectionT, QOpenGLTexture::WrapMode::Repeat);
+        tex->setMinMagFilters(QOpenGLTexture::Nearest, QOpenGLTexture::Nearest);
+        tex->setFormat(QOpenGLTexture::R8_UNorm);
+        tex->setSize(width, height);
+        tex->allocateStorage(QOpenGLTexture::Red, QOpenGLTexture::UInt8);
+
+        // sheet widths aren't always a multiple of 4
+        QOpenGLPixelTransferOptions options;
+        options.setAlignment(1);
+        tex->setData(QOpenGLTexture::Red, QOpenGLTexture::UInt8, indices, &options);
+        return tex;
+    }
+
     Shader placeShader  = Shader("Place");
     Shader circleShader = Shader("Circle");
     Shader tileShader   = Shader("Tile");
@@ -378,6 +447,25 @@ private:
     QMatrix4x4 matWorld;
     QMatrix4x4 matView;
 
+    // collision atlas, each tile is 0x40 wide per path (4 variants of 16px)
+    QRect colTileRect(ushort tile, int colLyr);
+    void drawColTile(uchar *bits, int pitch, RSDKv5::TileConfig::CollisionMask &cmask, ushort tile,
+                     int colLyr);
+    void drawColTilev1(uchar *bits, int pitch, RSDKv1::TileConfig::CollisionMask &cmask, ushort tile,
+                       int colLyr);
+    void drawColMap();
+    void uploadColRect(int colLyr, QRect rect);
+
+    // v1-v4 chunk atlas, every chunk is drawn into it once so a visible chunk is a single quad
+    int chunkSurface = -1;
+    ChunkAtlas chunkAtlas;
+    void initChunkAtlas();
+    void updateChunkAtlas();
+
+    // re-uploads the rows of any tiles that were edited since the last frame
+    void updateTileAtlas();
+    void updatePalettes();
+
     friend class SceneEditorv5;
 };
 
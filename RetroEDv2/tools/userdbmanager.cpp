@@ -3,10 +3,6 @@
 
 #include "userdbmanager.hpp"
 
-#include <time.h>
-#include <iomanip>
-#include <sstream>
-
 #include <RSDKv5/userdbv5.hpp>
 using namespace RSDKv5;
 
@@ -14,9 +10,66 @@ UserDBManager::UserDBManager(QWidget *parent) : QDialog(parent), ui(new Ui::User
 {
     ui->setupUi(this);
 
-    // remove question mark from the title bar & disable resizing
+    // remove question mark from the title bar
     setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint);
-    this->setFixedSize(QSize(this->width(), this->height()));
+
+    // the model only formats what's on screen, so keep the view from measuring every row
+    dbModel = new UserDBModel(this);
+    ui->dbTable->setModel(dbModel);
+    ui->dbTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    ui->dbTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    ui->dbTable->sortByColumn(-1, Qt::AscendingOrder);
+
+    connect(ui->openDB, &QPushButton::pressed, [this] {
+        QFileDialog filedialog(this, tr("Open UserDB file"), "", tr("RSDKv5 UserDB files (*.bin)"));
+        filedialog.setAcceptMode(QFileDialog::AcceptOpen);
+        if (filedialog.exec() == QDialog::Accepted)
+            LoadDB(filedialog.selectedFiles()[0]);
+    });
+    connect(ui->saveDB, &QPushButton::pressed, [this] {
+        QFileDialog filedialog(this, tr("Save UserDB file"), "", tr("RSDKv5 UserDB files (*.bin)"));
+        filedialog.setAcceptMode(QFileDialog::AcceptSave);
+        filedialog.selectFile(userDB.filePath);
+        if (filedialog.exec() == QDialog::Accepted) {
+            QString dbPath = filedialog.selectedFiles()[0];
+            if (!CheckOverwrite(dbPath, ".bin", this))
+                return;
+
+            userDB.write(dbPath);
+        }
+    });
+
+    connect(ui->filterMode, QOverload<int>::of(&QComboBox::currentIndexChanged), [this](int mode) {
+        ui->filterMax->setEnabled(mode == UserDBModel::Filter::Range);
+        ui->filterMin->setPlaceholderText(mode == UserDBModel::Filter::Range ? "Min" : "Value");
+    });
+    connect(ui->addFilter, &QPushButton::pressed, [this] {
+        if (ui->filterColumn->currentIndex() < 0)
+            return;
+
+        UserDBModel::Filter filter;
+        filter.column = ui->filterColumn->currentIndex();
+        filter.mode   = ui->filterMode->currentIndex();
+        filter.min    = ui->filterMin->text();
+        filter.max    = ui->filterMax->text();
+
+        QList<UserDBModel::Filter> list = filters;
+        list.append(filter);
+        if (!dbModel->setFilters(list)) {
+            QMessageBox::warning(this, "UserDB Manager",
+                                 QString("Invalid value for a %1 column.")
+                                     .arg(dbModel->columnTypeName(filter.column)));
+            return;
+        }
+
+        filters = list;
+        UpdateRowCount();
+    });
+    connect(ui->clearFilters, &QPushButton::pressed, [this] {
+        filters.clear();
+        dbModel->clearFilters();
+        UpdateRowCount();
+    });
 
     connect(ui->exportCSV, &QPushButton::pressed, [this] {
         QFileDialog filedialog(this, tr("Open UserDB file"), "", tr("RSDKv5 UserDB files (*.bin)"));
@@ -56,361 +109,54 @@ UserDBManager::UserDBManager(QWidget *parent) : QDialog(parent), ui(new Ui::User
 
 UserDBManager::~UserDBManager() { delete ui; }
 
-char *UserDBManager::strptime(const char *s, const char *f, struct tm *tm)
+void UserDBManager::LoadDB(QString dbPath)
 {
-    std::istringstream input(s);
-    input.imbue(std::locale(setlocale(LC_ALL, nullptr)));
-    input >> std::get_time(tm, f);
-    if (input.fail()) {
-        return nullptr;
-    }
-    return (char *)(s + input.tellg());
-}
+    userDB = UserDB();
+    userDB.read(dbPath);
 
-void UserDBManager::ConvertDBToCSV(QString dbPath, QString csvPath)
-{
-    UserDB userDB(dbPath);
-
-    Writer writer(csvPath);
-
-    writer.writeText("uuid");
-    writer.writeText(",");
-    writer.writeText("Creation Date");
-    writer.writeText(",");
-    writer.writeText("Modified Date");
-    writer.writeText(",");
-    for (auto &col : userDB.columns) {
-        writer.writeText(col.name);
-        writer.writeText(",");
-    }
-    writer.writeLine();
+    filters.clear();
+    dbModel->setDB(&userDB);
+    ui->dbTable->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
 
-    writer.writeText("uint32");
-    writer.writeText(",");
-    writer.writeText("string");
-    writer.writeText(",");
-    writer.writeText("string");
-    writer.writeText(",");
-    QList<QString> types = { "invalid", "bool",    "uint8",   "uint16", "uint32", "uint64",
-                             "int8",    "int16",   "int32",   "int64",  "float",  "double",
-                             "vector2", "vector3", "vector4", "color",  "string", "hashMD5" };
-    for (auto &col : userDB.columns) {
-        writer.writeText(types[col.type]);
-        writer.writeText(",");
+    ui->filterColumn->clear();
+    for (int c = 0; c < dbModel->columnCount(); ++c) {
+        QString name = dbModel->columnName(c);
+        ui->filterColumn->addItem(QString("%1 (%2)").arg(name).arg(dbModel->columnTypeName(c)));
     }
-    writer.writeLine();
-
-    for (auto &row : userDB.rows) {
-        int c = 0;
-        writer.writeText("0x" + QString::number(row.uuid, 0x10).toUpper());
-        writer.writeText(",");
-
-        char timeBuffer[24];
-        strftime(timeBuffer, 23, "%Y/%m/%d %H:%M:%S", (tm *)&row.createDate);
-        writer.writeText(timeBuffer);
-        writer.writeText(",");
-
-        strftime(timeBuffer, 23, "%Y/%m/%d %H:%M:%S", (tm *)&row.modifyDate);
-        writer.writeText(timeBuffer);
-        writer.writeText(",");
-
-        for (auto &val : row.entries) {
-            QDataStream stream(val.data);
-            switch (userDB.columns[c].type) {
-                default:
-                case UserDB::TableColumn::Invalid: writer.writeText("[Invalid]"); break;
-
-                case UserDB::TableColumn::Bool: {
-                    byte value = false;
-                    stream >> value;
-                    writer.writeText(value ? "y" : "n");
-                    break;
-                }
-
-                case UserDB::TableColumn::UInt8: {
-                    byte value = 0;
-                    stream >> value;
-                    writer.writeText(QString::number(value));
-                    break;
-                }
-
-                case UserDB::TableColumn::UInt16: {
-                    ushort value = 0;
-                    stream >> value;
-                    writer.writeText(QString::number(value));
-                    break;
-                }
-
-                case UserDB::TableColumn::UInt32:
-                case UserDB::TableColumn::Color: {
-                    uint value = 0;
-                    stream >> value;
-                    writer.writeText("0x" + QString::number(value, 0x10).toUpper());
-                    break;
-                }
-
-                case UserDB::TableColumn::UInt64: {
-                    uint64 value = 0;
-                    stream >> value;
-                    writer.writeText(QString::number(value));
-                    break;
-                }
-
-                case UserDB::TableColumn::Int8: {
-                    sbyte value = 0;
-                    stream >> value;
-                    writer.writeText(QString::number(value));
-                    break;
-                }
-
-                case UserDB::TableColumn::Int16: {
-                    short value = 0;
-                    stream >> value;
-                    writer.writeText(QString::number(value));
-                    break;
-                }
-
-                case UserDB::TableColumn::Int32: {
-                    int value = 0;
-                    stream >> value;
-                    writer.writeText("0x" + QString::number(value, 0x10).toUpper());
-                    break;
-                }
-
-                case UserDB::TableColumn::Int64: {
-                    int64 value = 0;
-                    stream >> value;
-                    writer.writeText(QString::number(value));
-                    break;
-                }
-
-                case UserDB::TableColumn::Float: {
-                    float value = 0;
-                    stream >> value;
-                    writer.writeText(QString::number(value));
-                    break;
-                }
 
-                case UserDB::TableColumn::Double: {
-                    double value = 0;
-                    stream >> value;
-                    writer.writeText(QString::number(value));
-                    break;
-                }
-
-                case UserDB::TableColumn::Vector2: {
-                    QString value(val.data);
-                    writer.writeText("[Unimplemented]");
-                    break;
-                }
-
-                case UserDB::TableColumn::Vector3: {
-                    QString value(val.data);
-                    writer.writeText("[Unimplemented]");
-                    break;
-                }
+    ui->saveDB->setEnabled(true);
+    UpdateRowCount();
+}
 
-                case UserDB::TableColumn::Vector4: {
-                    QString value(val.data);
-                    writer.writeText("[Unimplemented]");
-                    break;
-                }
+void UserDBManager::UpdateRowCount()
+{
+    ui->rowCount->setText(
+        QString("%1 of %2 rows").arg(dbModel->rowCount()).arg(userDB.rows.count()));
+}
 
-                case UserDB::TableColumn::String: {
-                    QString value(val.data);
-                    writer.writeText(value);
-                    break;
-                }
+void UserDBManager::ConvertDBToCSV(QString dbPath, QString csvPath)
+{
+    UserDB userDB(dbPath);
 
-                case UserDB::TableColumn::HashMD5: {
-                    QString value(val.data);
-                    writer.writeText("[Unimplemented]");
-                    break;
-                }
-            }
-            writer.writeText(",");
-            ++c;
-        }
-        writer.writeLine();
-    }
+    CSVWriter writer(csvPath);
+    if (!writer.isOpen())
+        return;
 
-    writer.flush();
+    WriteUserDBCSV(userDB, writer);
+    writer.close();
 }
 
 void UserDBManager::ConvertCSVToDB(QString dbPath, QString csvPath)
 {
     UserDB userDB;
 
-    Reader reader(csvPath);
-
-    QList<QString> types = { "invalid", "bool",    "uint8",   "uint16", "uint32", "uint64",
-                             "int8",    "int16",   "int32",   "int64",  "float",  "double",
-                             "vector2", "vector3", "vector4", "color",  "string", "hashMD5" };
-
-    int mode = 0;
-    while (!reader.isEOF()) {
-        QString line    = reader.readLine();
-        QStringList sep = line.split(",");
-        if (line[line.length() - 1] == ",")
-            sep.removeLast();
-
-        switch (mode) {
-            default: break;
-
-            case 0: // read names
-                if (sep.length() < 3) {
-                    // invalid formatted file!
-                    mode = 3;
-                }
-                for (int i = 3; i < sep.count(); ++i) {
-                    UserDB::TableColumn column;
-                    column.name = sep[i];
-                    userDB.columns.append(column);
-                }
-                ++mode;
-                break;
-
-            case 1: // read types
-                if (sep.length() < 3) {
-                    // invalid formatted file!
-                    mode = 3;
-                }
-
-                for (int i = 3; i < sep.count(); ++i) {
-                    userDB.columns[i - 3].type = (UserDB::TableColumn::Types)types.indexOf(sep[i]);
-                }
-                ++mode;
-                break;
-
-            case 2: // read values
-            {
-                UserDB::TableRow row;
-                for (int i = 0; i < sep.count(); ++i) {
-                    QString value = sep[i];
-                    tm tmBuf;
-                    switch (i) {
-                        case 0:
-                            if (value.startsWith("0x"))
-                                row.uuid = value.toUInt(nullptr, 0x10);
-                            else
-                                row.uuid = value.toUInt(nullptr, 10);
-                            break;
-
-                        case 1:
-                            strptime(value.toStdString().c_str(), "%Y/%m/%d %H:%M:%S", &tmBuf);
-                            *(tm *)&row.createDate = *&tmBuf;
-                            break;
-
-                        case 2:
-                            strptime(value.toStdString().c_str(), "%Y/%m/%d %H:%M:%S", &tmBuf);
-                            *(tm *)&row.modifyDate = *&tmBuf;
-                            break;
+    CSVReader reader(csvPath);
+    if (!reader.isOpen())
+        return;
 
-                        default: {
-                            UserDB::TableRow::Value entry;
-                            entry.data.clear();
-                            QDataStream stream(&entry.data, QIODevice::ReadWrite);
-                            switch (userDB.columns[i - 3].type) {
-                                default:
-                                case UserDB::TableColumn::Invalid:
-                                    // Invalid, do nothing
-                                    break;
-
-                                case UserDB::TableColumn::Bool:
-                                    stream << (byte)(value.toLower().startsWith("y") ? 1 : 0);
-                                    break;
-
-                                case UserDB::TableColumn::UInt8:
-                                    if (value.startsWith("0x"))
-                                        stream << (byte)value.toInt(nullptr, 0x10);
-                                    else
-                                        stream << (byte)value.toInt(nullptr, 10);
-                                    break;
-
-                                case UserDB::TableColumn::UInt16:
-                                    if (value.startsWith("0x"))
-                                        stream << value.toUShort(nullptr, 0x10);
-                                    else
-                                        stream << value.toUShort(nullptr, 10);
-                                    break;
-
-                                case UserDB::TableColumn::UInt32:
-                                case UserDB::TableColumn::Color:
-                                    if (value.startsWith("0x"))
-                                        stream << value.toUInt(nullptr, 0x10);
-                                    else
-                                        stream << value.toUInt(nullptr, 10);
-                                    break;
-
-                                case UserDB::TableColumn::UInt64:
-                                    if (value.startsWith("0x"))
-                                        stream << value.toULongLong(nullptr, 0x10);
-                                    else
-                                        stream << value.toULongLong(nullptr, 10);
-                                    break;
-
-                                case UserDB::TableColumn::Int8:
-                                    if (value.startsWith("0x"))
-                                        stream << (sbyte)value.toInt(nullptr, 0x10);
-                                    else
-                                        stream << (sbyte)value.toInt(nullptr, 10);
-                                    break;
-
-                                case UserDB::TableColumn::Int16:
-                                    if (value.startsWith("0x"))
-                                        stream << value.toShort(nullptr, 0x10);
-                                    else
-                                        stream << value.toShort(nullptr, 10);
-                                    break;
-
-                                case UserDB::TableColumn::Int32:
-                                    if (value.startsWith("0x"))
-                                        stream << value.toInt(nullptr, 0x10);
-                                    else
-                                        stream << value.toInt(nullptr, 10);
-                                    break;
-
-                                case UserDB::TableColumn::Int64:
-                                    if (value.startsWith("0x"))
-                                        stream << value.toLongLong(nullptr, 0x10);
-                                    else
-                                        stream << value.toLongLong(nullptr, 10);
-                                    break;
-
-                                case UserDB::TableColumn::Float: stream << value.toFloat(); break;
-
-                                case UserDB::TableColumn::Double: stream << value.toDouble(); break;
-
-                                case UserDB::TableColumn::Vector2:
-                                    // Unimplemented, do nothing
-                                    break;
-
-                                case UserDB::TableColumn::Vector3:
-                                    // Unimplemented, do nothing
-                                    break;
-
-                                case UserDB::TableColumn::Vector4:
-                                    // Unimplemented, do nothing
-                                    break;
-
-                                case UserDB::TableColumn::String: stream << value; break;
-
-                                case UserDB::TableColumn::HashMD5:
-                                    // Unimplemented, do nothing
-                                    break;
-                            }
-                            row.entries.append(entry);
-                            break;
-                        }
-                    }
-                }
-                userDB.rows.append(row);
-                break;
-            }
-        }
-    }
+    // invalid formatted file!
+    if (!ReadUserDBCSV(userDB, reader))
+        return;
 
-    // if we didn't get to mode 2, we didn't make a valid DB
-    if (mode == 2)
-        userDB.write(dbPath);
+    userDB.write(dbPath);
 }
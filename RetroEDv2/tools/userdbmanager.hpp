@@ -2,6 +2,8 @@
 
 #include <QDialog>
 
+#include "tools/utils/userdbmodel.hpp"
+
 namespace Ui
 {
 class UserDBManager;
@@ -16,10 +18,15 @@ public:
     ~UserDBManager();
 
 private:
-    char *strptime(const char *s, const char *f, struct tm *tm);
-
     void ConvertDBToCSV(QString dbPath, QString csvPath);
     void ConvertCSVToDB(QString dbPath, QString csvPath);
 
+    void LoadDB(QString dbPath);
+    void UpdateRowCount();
+
     Ui::UserDBManager *ui;
+
+    RSDKv5::UserDB userDB;
+    UserDBModel *dbModel = nullptr;
+    QList<UserDBModel::Filter> filters;
 };
@@ -0,0 +1,56 @@
+#include "includes.hpp"
+
+#include "activeranges.hpp"
+
+void ActiveRangeList::resize(int count)
+{
+    posX.resize(count);
+    posY.resize(count);
+    rangeX.resize(count);
+    rangeY.resize(count);
+    active.resize(count);
+    results.resize(count);
+    inRangeMask.resize((count + 0x1F) >> 5);
+    radiusSlots.clear();
+}
+
+void ActiveRangeList::cull(int screenX, int screenY, int boundsX, int boundsY)
+{
+    int count         = active.count();
+    const int *x      = posX.constData();
+    const int *y      = posY.constData();
+    const int *rx     = rangeX.constData();
+    const int *ry     = rangeY.constData();
+    const byte *modes = active.constData();
+    byte *result      = results.data();
+
+    // every box mode gets checked for every slot, keeping this free of branches lets it vectorize
+    for (int i = 0; i < count; ++i) {
+        int sx = abs(x[i] - screenX);
+        int sy = abs(y[i] - screenY);
+
+        byte inX = sx <= rx[i] + boundsX;
+        byte inY = sy <= ry[i] + boundsY;
+
+        byte mode = modes[i];
+        result[i] = (mode <= ACTIVE_PAUSED) | ((mode == ACTIVE_BOUNDS) & inX & inY)
+                    | ((mode == ACTIVE_XBOUNDS) & inX) | ((mode == ACTIVE_YBOUNDS) & inY);
+    }
+
+    // the squared distance is in whole pixels, but a pixel distance past 0xB504 squares out of an int
+    for (int i : radiusSlots) {
+        qint64 sx = qAbs((qint64)x[i] - screenX) >> 16;
+        qint64 sy = qAbs((qint64)y[i] - screenY) >> 16;
+        result[i] = sx * sx + sy * sy <= (qint64)rx[i] + boundsX;
+    }
+
+    uint *mask = inRangeMask.data();
+    for (int w = 0; w < inRangeMask.count(); ++w) {
+        int start = w << 5;
+        int end   = qMin(count - start, 0x20);
+
+        uint bits = 0;
+        for (int b = 0; b < end; ++b) bits |= (uint)result[start + b] << b;
+        mask[w] = bits;
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+enum ActiveFlags {
+    ACTIVE_NEVER,   // never update
+    ACTIVE_ALWAYS,  // always update (even if paused/frozen)
+    ACTIVE_NORMAL,  // always update (unless paused/frozen)
+    ACTIVE_PAUSED,  // update if paused
+    ACTIVE_BOUNDS,  // update if in x & y bounds
+    ACTIVE_XBOUNDS, // update only if in x bounds (y bounds dont matter)
+    ACTIVE_YBOUNDS, // update only if in y bounds (x bounds dont matter)
+    ACTIVE_RBOUNDS, // update based on radius boundaries (updateRange.x = radius)
+};
+
+// packed copy of what the activity checks need, one entry per entity slot, so they can run as a
+// single branchless pass over flat arrays instead of going through every entity struct
+struct ActiveRangeList {
+    QVector<int> posX;
+    QVector<int> posY;
+    QVector<int> rangeX;
+    QVector<int> rangeY;
+    QVector<byte> active;
+    QVector<uint> inRangeMask; // 1 bit per slot, filled by cull()
+
+    void resize(int count);
+
+    inline void set(int slot, int x, int y, int rx, int ry, byte activeMode)
+    {
+        posX[slot]   = x;
+        posY[slot]   = y;
+        rangeX[slot] = rx;
+        rangeY[slot] = ry;
+        active[slot] = activeMode;
+        if (activeMode == ACTIVE_RBOUNDS)
+            radiusSlots.append(slot);
+    }
+
+    // fills every slot from a scene's entities, Entity being the revision's entity struct. slots with
+    // no game entity or type never update, & neither does anything while drawing an image
+    template <typename Entity, typename Entities> void gather(const Entities &entities, bool isImage)
+    {
+        resize(entities.count());
+        for (int e = 0; e < entities.count(); ++e) {
+            Entity *entity = (Entity *)entities[e].gameEntity;
+            if (!entity || !entities[e].type || isImage)
+                set(e, 0, 0, 0, 0, ACTIVE_NEVER);
+            else
+                set(e, entity->position.x, entity->position.y, entity->updateRange.x,
+                    entity->updateRange.y, entity->active);
+        }
+    }
+
+    // screenX/Y is the center of the screen & boundsX/Y half its size, all in 16.16 fixed point
+    void cull(int screenX, int screenY, int boundsX, int boundsY);
+
+    inline bool inRange(int slot) const { return (inRangeMask[slot >> 5] >> (slot & 0x1F)) & 1; }
+
+private:
+    QVector<byte> results;
+    QVector<int> radiusSlots; // the few ACTIVE_RBOUNDS slots, checked on their own after the main pass
+};
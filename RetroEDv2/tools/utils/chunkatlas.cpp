@@ -0,0 +1,41 @@
+#include "includes.hpp"
+
+#include "chunkatlas.hpp"
+
+QImage ChunkAtlas::build(const QList<QImage> &chunks, QColor background)
+{
+    // keeps the atlas within 4096px on either side
+    QImage atlas(COLUMNS * CHUNK_SIZE, ROWS * CHUNK_SIZE, QImage::Format_ARGB32);
+    atlas.fill(background);
+
+    keys.fill(0, CHUNK_COUNT);
+    for (int c = 0; c < chunks.count() && c < CHUNK_COUNT; ++c) {
+        QImage chunk = chunks[c].convertToFormat(QImage::Format_ARGB32);
+        QRect cell   = rect(c);
+        for (int y = 0; y < cell.height() && y < chunk.height(); ++y) {
+            memcpy(atlas.scanLine(cell.y() + y) + cell.x() * sizeof(QRgb), chunk.constScanLine(y),
+                   qMin(cell.width(), chunk.width()) * sizeof(QRgb));
+        }
+        keys[c] = chunks[c].cacheKey();
+    }
+
+    return atlas;
+}
+
+QList<int> ChunkAtlas::takeDirty(const QList<QImage> &chunks)
+{
+    QList<int> dirty;
+    for (int c = 0; c < chunks.count() && c < keys.count(); ++c) {
+        if (chunks[c].cacheKey() == keys[c])
+            continue;
+
+        dirty.append(c);
+        keys[c] = chunks[c].cacheKey();
+    }
+    return dirty;
+}
+
+QImage ChunkAtlas::cell(const QImage &chunk)
+{
+    return chunk.copy(0, 0, CHUNK_SIZE, CHUNK_SIZE).convertToFormat(QImage::Format_RGBA8888);
+}
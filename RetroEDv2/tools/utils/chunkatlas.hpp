@@ -0,0 +1,27 @@
+#pragma once
+
+// every v1-v4 chunk drawn once into a single image, 16 across & 32 down, so a visible chunk is one
+// quad. chunk images get replaced whenever they're edited, so a changed cacheKey() is a dirty chunk
+class ChunkAtlas
+{
+public:
+    enum { CHUNK_SIZE = 0x80, COLUMNS = 0x10, ROWS = 0x20, CHUNK_COUNT = COLUMNS * ROWS };
+
+    static inline QRect rect(int chunk)
+    {
+        return QRect((chunk % COLUMNS) * CHUNK_SIZE, (chunk / COLUMNS) * CHUNK_SIZE, CHUNK_SIZE,
+                     CHUNK_SIZE);
+    }
+
+    // the whole atlas, anything past CHUNK_COUNT is left out. every chunk counts as uploaded after
+    QImage build(const QList<QImage> &chunks, QColor background);
+    // the chunks whose images were replaced since they were built or last taken
+    QList<int> takeDirty(const QList<QImage> &chunks);
+    // a chunk cropped to its cell, the way it's uploaded
+    static QImage cell(const QImage &chunk);
+
+    inline void clear() { keys.clear(); }
+
+private:
+    QVector<qint64> keys; // cacheKey() of each chunk image as it was last uploaded
+};
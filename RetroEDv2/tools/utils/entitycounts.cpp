@@ -0,0 +1,33 @@
+#include "includes.hpp"
+
+#include "entitycounts.hpp"
+
+void EntityCounts::ensure(const QList<SceneEntity> &entities, const FilterVarIndex &filterVars)
+{
+    if (valid && entityCount == entities.count() && revision == filterVars.revision())
+        return;
+
+    memset(perFilter, 0, sizeof(perFilter));
+    unfiltered = 0;
+    for (auto &entity : entities) {
+        int filter = filterVars.filter(entity, -1);
+        if (filter < 0)
+            ++unfiltered;
+        else
+            ++perFilter[filter & 0xFF];
+    }
+
+    entityCount = entities.count();
+    revision    = filterVars.revision();
+    valid       = true;
+}
+
+int EntityCounts::active(int sceneFilter, int fallback) const
+{
+    int count = (fallback & sceneFilter) || !fallback ? unfiltered : 0;
+    for (int f = 0; f < 0x100; ++f) {
+        if ((f & sceneFilter) || !f)
+            count += perFilter[f];
+    }
+    return count;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "tools/sceneproperties/sceneincludesv5.hpp"
+#include "tools/utils/filtervarindex.hpp"
+
+// how many entities the scene filter lets through. the status bar & scene properties ask every repaint,
+// so entities are only tallied per filter value again after they've changed, & toggling scene filter
+// bits just sums the tally
+class EntityCounts
+{
+public:
+    // call after editing an entity's variables in place, added or removed entities are caught anyway
+    inline void invalidate() { valid = false; }
+    // recounts if it's been invalidated, the entity count changed or filterVars was rebuilt since
+    void ensure(const QList<SceneEntity> &entities, const FilterVarIndex &filterVars);
+
+    // entities with a filter of 0 or one sharing a bit with sceneFilter, those without a filter
+    // variable count as if their filter was fallback
+    int active(int sceneFilter, int fallback) const;
+    inline int total() const { return entityCount; }
+
+private:
+    int perFilter[0x100] = {};
+    int unfiltered  = 0; // entities whose object has no filter variable
+    int entityCount = 0;
+    int revision    = -1;
+    bool valid      = false;
+};
@@ -0,0 +1,21 @@
+#include "includes.hpp"
+
+#include "filtervarindex.hpp"
+
+void FilterVarIndex::ensure(const QList<SceneObject> &objects)
+{
+    if (valid && vars.count() == objects.count())
+        return;
+
+    vars.fill(-1, objects.count());
+    for (int o = 0; o < objects.count(); ++o) {
+        for (int v = 0; v < objects[o].variables.count(); ++v) {
+            if (objects[o].variables[v].name == "filter") {
+                vars[o] = v;
+                break;
+            }
+        }
+    }
+    valid = true;
+    ++rebuilds;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "tools/sceneproperties/sceneincludesv5.hpp"
+
+// which variable of each object is its "filter". entities are filtered every frame & on every pick, so
+// the names are only looked through again after the objects or their variables change
+class FilterVarIndex
+{
+public:
+    inline void invalidate() { valid = false; }
+    // rebuilds if it's been invalidated or any object was added or removed since
+    void ensure(const QList<SceneObject> &objects);
+
+    // bumped every time the index is rebuilt, so anything derived from it knows to rebuild too
+    inline int revision() const { return rebuilds; }
+
+    // -1 if the object has no filter variable
+    inline int find(int type) const { return type >= 0 && type < vars.count() ? vars[type] : -1; }
+
+    // the entity's filter value, or fallback if its object has no filter variable
+    inline int filter(const SceneEntity &entity, int fallback) const
+    {
+        int v = find(entity.type);
+        if (v >= 0 && v < entity.variables.count())
+            return entity.variables.at(v).value_uint8;
+        return fallback;
+    }
+
+private:
+    QVector<int> vars; // per object
+    bool valid   = false;
+    int rebuilds = 0;
+};
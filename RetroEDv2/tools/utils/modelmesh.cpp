@@ -0,0 +1,70 @@
+#include "includes.hpp"
+
+#include "modelmesh.hpp"
+
+QVector<ushort> ModelMesh::triangulate(const RSDKv5::Model &model)
+{
+    int faceVerts = model.faceVerticesCount;
+    if (faceVerts < 3)
+        return QVector<ushort>();
+
+    // 0 3 5 turned to 3:   0 3 5
+    // 0 3 5 4 turned to 3: 0 3 5 3 5 4 5 4 0
+    // etc
+    int count = 3 * faceVerts - 3;
+    QVector<ushort> indices(count * (model.indices.count() / faceVerts));
+    ushort *current = indices.data();
+
+    for (int i = 0; i + faceVerts <= model.indices.count(); i += faceVerts) {
+        for (int j = 0; j < faceVerts - 1; ++j) {
+            current[j * 3 + 0] = model.indices[i + j];
+            current[j * 3 + 1] = model.indices[i + j + 1];
+            if (j + 1 < faceVerts - 1)
+                current[j * 3 + 2] = model.indices[i + j + 2];
+        }
+        current[count - 1] = model.indices[i];
+        current            = &current[count];
+    }
+
+    return indices;
+}
+
+int ModelMesh::vertexCount(const RSDKv5::Model &model)
+{
+    int count = 0;
+    for (auto &frame : model.frames) count = qMax(count, (int)frame.vertices.count());
+    return count;
+}
+
+QVector<float> ModelMesh::packFrames(const RSDKv5::Model &model, int vertexCount)
+{
+    QVector<float> frames(model.frames.count() * vertexCount * 6, 0.0f);
+
+    float *dst = frames.data();
+    for (auto &frame : model.frames) {
+        int count = qMin(vertexCount, (int)frame.vertices.count());
+        for (int v = 0; v < count; ++v) {
+            auto &vertex   = frame.vertices.at(v);
+            dst[v * 6 + 0] = vertex.x;
+            dst[v * 6 + 1] = vertex.y;
+            dst[v * 6 + 2] = vertex.z;
+            dst[v * 6 + 3] = vertex.nx;
+            dst[v * 6 + 4] = vertex.ny;
+            dst[v * 6 + 5] = vertex.nz;
+        }
+        dst += vertexCount * 6;
+    }
+
+    return frames;
+}
+
+int ModelMesh::nextFrame(int frameID, int frameCount, int loopIndex)
+{
+    if (frameID < 0 || frameID >= frameCount)
+        return -1;
+
+    int next = frameID + 1 >= frameCount ? loopIndex : frameID + 1;
+    if (next < 0 || next >= frameCount)
+        next = frameID;
+    return next;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <RSDKv5/modelv5.hpp>
+
+// the CPU side of ModelViewer's upload, kept away from GL so it can be checked without a context
+namespace ModelMesh
+{
+
+// faces of any size as triangles, (faceVerts - 1) per face
+QVector<ushort> triangulate(const RSDKv5::Model &model);
+
+// the most vertices any frame has, every frame gets padded out to it
+int vertexCount(const RSDKv5::Model &model);
+// every frame's vertices as pos + normal, vertexCount per frame (padded with empty vertices)
+QVector<float> packFrames(const RSDKv5::Model &model, int vertexCount);
+
+// the frame playback blends into, after the last one it goes back to loopIndex (or holds if that's out
+// of range). -1 if frameID isn't a frame
+int nextFrame(int frameID, int frameCount, int loopIndex);
+
+} // namespace ModelMesh
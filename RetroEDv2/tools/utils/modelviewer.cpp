@@ -66,6 +66,7 @@ void ModelViewer::setModel(RSDKv4::Model m, QString tex)
     model.hasNormals = true;
 
     texFile = tex;
+    reload  = true;
 }
 
 RSDKv4::Model ModelViewer::getModelv4()
@@ -134,17 +135,20 @@ void ModelViewer::loadTexture(QString texturePath)
     repaint();
 }
 
-void ModelViewer::setFrame(int frameID)
+void ModelViewer::setFrame(int frameID, bool reloadModel)
 {
-    curFrame = nullptr;
+    curFrame    = nullptr;
+    curFrameID  = -1;
+    nextFrameID = -1;
     if (frameID >= 0 && frameID < model.frames.count()) {
-        curFrame = &model.frames[frameID];
-        if (frameID + 1 >= model.frames.count())
-            nextFrame = &model.frames[loopIndex];
-        else
-            nextFrame = &model.frames[frameID + 1];
+        curFrameID  = frameID;
+        nextFrameID = ModelMesh::nextFrame(frameID, model.frames.count(), loopIndex);
+
+        curFrame  = &model.frames[curFrameID];
+        nextFrame = &model.frames[nextFrameID];
 
-        reload = true;
+        if (reloadModel)
+            reload = true;
     }
 
     repaint();
@@ -220,19 +224,15 @@ void ModelViewer::initializeGL()
     VAO->create();
     VAO->bind();
 
-    vertVBO = new QOpenGLBuffer(QOpenGLBuffer::VertexBuffer);
-    vertVBO->create();
-    vertVBO->bind();
-    vertVBO->setUsagePattern(QOpenGLBuffer::DynamicDraw);
-    shader.setAttributeBuffer("in_pos", GL_FLOAT, 0, 3);
+    // all frames live in here, the current & next frame are picked with attribute offsets
+    frameVBO = new QOpenGLBuffer(QOpenGLBuffer::VertexBuffer);
+    frameVBO->create();
+    frameVBO->bind();
+    frameVBO->setUsagePattern(QOpenGLBuffer::StaticDraw);
     shader.enableAttributeArray("in_pos");
-
-    normalVBO = new QOpenGLBuffer(QOpenGLBuffer::VertexBuffer);
-    normalVBO->create();
-    normalVBO->bind();
-    normalVBO->setUsagePattern(QOpenGLBuffer::DynamicDraw);
-    shader.setAttributeBuffer("in_norm", GL_FLOAT, 0, 3);
     shader.enableAttributeArray("in_norm");
+    shader.enableAttributeArray("in_nextPos");
+    shader.enableAttributeArray("in_nextNorm");
 
     colorVBO = new QOpenGLBuffer(QOpenGLBuffer::VertexBuffer);
     colorVBO->create();
@@ -288,61 +288,35 @@ void ModelViewer::paintGL()
     shader.use();
 
     if (reload) {
-        reload      = false;
-        int vc      = curFrame->vertices.count();
-        vertBuf     = new float[vc * 3];
-        normBuf     = new float[vc * 3];
-        auto colors = new RSDKv5::Model::Color[vc];
-        auto uvs    = new RSDKv5::Model::TexCoord[vc];
-
-        int i = 0;
-        for (auto &c : model.colors) colors[i++] = c;
-
-        i = 0;
-        for (auto &uv : model.texCoords) uvs[i++] = uv;
-
-        // 0 3 5 turned to 3:   0 3 5
-        // 0 3 5 4 turned to 3: 0 3 5 5 4 0
-        // etc
-        int count       = 3 * model.faceVerticesCount - 3;
-        int total       = count * (model.indices.count() / model.faceVerticesCount);
-        auto indices    = new ushort[total];
-        ushort *current = indices;
-
-        i = 0;
-        for (; i < model.indices.count() - 1; i += model.faceVerticesCount) {
-            for (int j = 0; j < model.faceVerticesCount - 1; ++j) {
-                current[j * 3 + 0] = model.indices[i + j];
-                current[j * 3 + 1] = model.indices[i + j + 1];
-                if (j + 1 < model.faceVerticesCount - 1)
-                    current[j * 3 + 2] = model.indices[i + j + 2];
-            }
-            // if (model.faceVerticesCount != 3)
-            current[count - 1] = model.indices[i];
-            current            = &current[count];
-        }
+        reload = false;
+
+        int vc = ModelMesh::vertexCount(model);
+
+        QVector<RSDKv5::Model::Color> colors(vc);
+        for (int i = 0; i < vc && i < model.colors.count(); ++i) colors[i] = model.colors[i];
 
-        vertVBO->bind();
-        vertVBO->allocate(vc * sizeof(float) * 3);
-        normalVBO->bind();
-        normalVBO->allocate(vc * sizeof(float) * 3);
+        QVector<RSDKv5::Model::TexCoord> uvs(vc);
+        for (int i = 0; i < vc && i < model.texCoords.count(); ++i) uvs[i] = model.texCoords[i];
+
+        QVector<ushort> indices = ModelMesh::triangulate(model);
+        QVector<float> frames   = ModelMesh::packFrames(model, vc);
+
+        frameStride = vc * 6 * sizeof(float);
+        indexCount  = indices.count();
+
+        frameVBO->bind();
+        frameVBO->allocate(frames.constData(), frames.count() * sizeof(float));
         colorVBO->bind();
-        colorVBO->allocate(colors, vc * sizeof(RSDKv5::Model::Color));
+        colorVBO->allocate(colors.constData(), vc * sizeof(RSDKv5::Model::Color));
         texVBO->bind();
-        texVBO->allocate(uvs, vc * sizeof(RSDKv5::Model::TexCoord));
+        texVBO->allocate(uvs.constData(), vc * sizeof(RSDKv5::Model::TexCoord));
         indexVBO->bind();
-        indexVBO->allocate(indices, total * sizeof(ushort));
-
-        shader.setValue("useColor", model.hasColors);
-        shader.setValue("useTextures", model.hasTextures);
-        shader.setValue("useNormals", model.hasNormals);
-
-        delete[] indices;
-        delete[] colors;
-        delete[] uvs;
+        indexVBO->allocate(indices.constData(), indexCount * sizeof(ushort));
     }
 
     if (texFile != curTex) {
+        curTex = texFile;
+
         delete tex;
         QImage src(texFile);
         tex = new QOpenGLTexture(QOpenGLTexture::Target2D);
@@ -358,24 +332,20 @@ void ModelViewer::paintGL()
         glFuncs->glBindTexture(GL_TEXTURE_2D, tex->textureId());
     }
 
-    // handle interpolation, set vertVBO properly using vertVBO->write
-
-    for (int i = 0; i < curFrame->vertices.count(); ++i) {
-        auto &cv           = curFrame->vertices.at(i);
-        auto &nv           = nextFrame->vertices.at(i);
-        float interp       = 1 - animTimer;
-        float interp2      = animTimer;
-        vertBuf[i * 3 + 0] = cv.x * interp + nv.x * interp2;
-        vertBuf[i * 3 + 1] = cv.y * interp + nv.y * interp2;
-        vertBuf[i * 3 + 2] = cv.z * interp + nv.z * interp2;
-        normBuf[i * 3 + 0] = cv.nx * interp + nv.nx * interp2;
-        normBuf[i * 3 + 1] = cv.ny * interp + nv.ny * interp2;
-        normBuf[i * 3 + 2] = cv.nz * interp + nv.nz * interp2;
-    }
-    vertVBO->bind();
-    vertVBO->write(0, vertBuf, curFrame->vertices.count() * sizeof(float) * 3);
-    normalVBO->bind();
-    normalVBO->write(0, normBuf, curFrame->vertices.count() * sizeof(float) * 3);
+    // interpolation happens in the vertex shader, so playback is just offsets and a uniform
+    int stride = 6 * sizeof(float);
+    int cur    = curFrameID * frameStride;
+    int next   = nextFrameID * frameStride;
+    frameVBO->bind();
+    shader.setAttributeBuffer("in_pos", GL_FLOAT, cur, 3, stride);
+    shader.setAttributeBuffer("in_norm", GL_FLOAT, cur + 3 * sizeof(float), 3, stride);
+    shader.setAttributeBuffer("in_nextPos", GL_FLOAT, next, 3, stride);
+    shader.setAttributeBuffer("in_nextNorm", GL_FLOAT, next + 3 * sizeof(float), 3, stride);
+    shader.setValue("interp", animTimer);
+
+    shader.setValue("useColor", model.hasColors);
+    shader.setValue("useTextures", model.hasTextures);
+    shader.setValue("useNormals", model.hasNormals);
 
     matModel.setToIdentity();
     matModel.scale(zoom, zoom, zoom);
@@ -387,8 +357,7 @@ void ModelViewer::paintGL()
     shader.setValue("view", camera.toMatrix());
     shader.setValue("model", matModel);
 
-    glFuncs->glDrawElements(wireframe ? GL_LINES : GL_TRIANGLES, indexVBO->size() / sizeof(ushort),
-                            GL_UNSIGNED_SHORT, 0);
+    glFuncs->glDrawElements(wireframe ? GL_LINES : GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, 0);
 }
 
 #include "moc_modelviewer.cpp"
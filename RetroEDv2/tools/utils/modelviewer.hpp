@@ -3,6 +3,8 @@
 #include <RSDKv4/modelv4.hpp>
 #include <RSDKv5/modelv5.hpp>
 
+#include "tools/utils/modelmesh.hpp"
+
 class ModelViewer : public QOpenGLWidget
 {
     Q_OBJECT
@@ -303,7 +305,8 @@ public:
 
     void loadTexture(QString texturePath);
 
-    void setFrame(int frameID);
+    // reloadModel re-uploads the whole mesh, playback only needs to pick frames
+    void setFrame(int frameID, bool reloadModel = true);
     void setWireframe(bool wireframe);
     void setNormalsVisible(bool show);
     void setZoom(float zoom);
@@ -312,9 +315,6 @@ public:
     byte modelFormat = 0;
     bool reload      = false;
 
-    float *vertBuf;
-    float *normBuf;
-
     bool wireframe = false;
 
 protected:
@@ -329,9 +329,14 @@ private:
     QMatrix4x4 matWorld;
 
     QOpenGLFramebufferObject *outFB = nullptr;
-    QOpenGLBuffer *vertVBO, *colorVBO, *normalVBO, *texVBO, *indexVBO;
+    QOpenGLBuffer *frameVBO, *colorVBO, *texVBO, *indexVBO;
     QOpenGLVertexArrayObject *VAO = nullptr;
 
+    int curFrameID  = -1;
+    int nextFrameID = -1;
+    int frameStride = 0; // bytes per frame in frameVBO
+    int indexCount  = 0;
+
     QString curTex      = "";
     QOpenGLTexture *tex = nullptr;
 
@@ -0,0 +1,79 @@
+#include "includes.hpp"
+
+#include "objectgroups.hpp"
+
+static inline void addEntry(QVector<ushort> &entries, ushort slot)
+{
+    entries.insert(std::upper_bound(entries.begin(), entries.end(), slot), slot);
+}
+
+static inline void removeEntry(QVector<ushort> &entries, ushort slot)
+{
+    auto it = std::lower_bound(entries.begin(), entries.end(), slot);
+    if (it != entries.end() && *it == slot)
+        entries.erase(it);
+}
+
+void ObjectGroups::reset(const Lists &drawLists, int drawCount, const Lists &typeLists, int typeCount)
+{
+    for (int i = 0; i < drawCount; ++i) drawLists(i).clear();
+    for (int i = 0; i < typeCount; ++i) typeLists(i).clear();
+
+    current.clear();
+}
+
+void ObjectGroups::update(const Lists &drawLists, int drawCount, const Lists &typeLists, int typeCount)
+{
+    // created or deleted entities shift every slot after them, so that's a rebuild
+    if (current.count() != next.count()) {
+        reset(drawLists, drawCount, typeLists, typeCount);
+
+        int count = next.count();
+        for (int i = 0; i < drawCount; ++i) drawLists(i).reserve(count);
+        typeLists(0).reserve(count);
+
+        for (int e = 0; e < count; ++e) {
+            const State &state = next[e];
+            if (state.drawGroup >= 0)
+                drawLists(state.drawGroup).append(e);
+            if (state.classID >= 0) {
+                typeLists(0).append(e);             // All active objects
+                typeLists(state.classID).append(e); // type-based slots
+                if (state.group >= 0)
+                    typeLists(state.group).append(e); // extra slots
+            }
+        }
+
+        current = next;
+        return;
+    }
+
+    for (int e = 0; e < current.count(); ++e) {
+        State &state           = current[e];
+        const State &nextState = next[e];
+
+        if (state.drawGroup != nextState.drawGroup) {
+            if (state.drawGroup >= 0)
+                removeEntry(drawLists(state.drawGroup), e);
+            if (nextState.drawGroup >= 0)
+                addEntry(drawLists(nextState.drawGroup), e);
+        }
+
+        if (state.classID != nextState.classID || state.group != nextState.group) {
+            if (state.classID >= 0) {
+                removeEntry(typeLists(0), e);
+                removeEntry(typeLists(state.classID), e);
+                if (state.group >= 0)
+                    removeEntry(typeLists(state.group), e);
+            }
+            if (nextState.classID >= 0) {
+                addEntry(typeLists(0), e);
+                addEntry(typeLists(nextState.classID), e);
+                if (nextState.group >= 0)
+                    addEntry(typeLists(nextState.group), e);
+            }
+        }
+
+        state = nextState;
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+// keeps the draw layer & type group lists in step with where each entity slot belongs. processObjects
+// fills in next each frame, update then only touches the lists for slots that moved. the lists stay
+// sorted by slot, so they come out the same as a rebuild from scratch would
+class ObjectGroups
+{
+public:
+    struct State {
+        short drawGroup = -1;
+        short classID   = -1; // -1 if it isn't in any type group
+        short group     = -1; // extra type group, if any
+    };
+
+    // lists are looked up by index, so the game's DrawList/TypeGroupList don't need to be known here
+    typedef std::function<QVector<ushort> &(int)> Lists;
+
+    // where every slot belongs this frame
+    QVector<State> next;
+
+    void update(const Lists &drawLists, int drawCount, const Lists &typeLists, int typeCount);
+    // drops every entry, for when the entity list is replaced wholesale
+    void reset(const Lists &drawLists, int drawCount, const Lists &typeLists, int typeCount);
+
+private:
+    QVector<State> current; // as of the last update
+};
@@ -0,0 +1,117 @@
+#include "includes.hpp"
+
+#include "palettetexture.hpp"
+
+PaletteTexture::PaletteTexture(int rows) { resize(rows); }
+
+void PaletteTexture::resize(int rows)
+{
+    this->rows = qMax(rows, 1);
+    table.fill(0, this->rows * COLOR_COUNT);
+    dirty = true;
+}
+
+void PaletteTexture::setRow(int row, const QVector<QRgb> &colors)
+{
+    if (row < 0 || row >= rows)
+        return;
+
+    QVector<QRgb> lookup = lookupRow(colors);
+    QRgb *dst = table.data() + row * COLOR_COUNT;
+    if (memcmp(dst, lookup.constData(), COLOR_COUNT * sizeof(QRgb))) {
+        memcpy(dst, lookup.constData(), COLOR_COUNT * sizeof(QRgb));
+        dirty = true;
+    }
+}
+
+QVector<QRgb> PaletteTexture::getRow(int row) const
+{
+    if (row < 0 || row >= rows)
+        return QVector<QRgb>();
+
+    return table.mid(row * COLOR_COUNT, COLOR_COUNT);
+}
+
+void PaletteTexture::setColor(int row, int index, QRgb color)
+{
+    if (row < 0 || row >= rows || index < 0 || index >= COLOR_COUNT)
+        return;
+
+    QRgb &entry = table[row * COLOR_COUNT + index];
+    if (entry != color) {
+        entry = color;
+        dirty = true;
+    }
+}
+
+void PaletteTexture::copyColors(int srcRow, int srcIndex, int dstRow, int dstIndex, int count)
+{
+    if (srcRow < 0 || srcRow >= rows || dstRow < 0 || dstRow >= rows || count <= 0)
+        return;
+
+    QRgb *dst       = table.data() + dstRow * COLOR_COUNT;
+    const QRgb *src = table.constData() + srcRow * COLOR_COUNT;
+    for (int i = 0; i < count; ++i) dst[(byte)(dstIndex + i)] = src[(byte)(srcIndex + i)];
+    dirty = true;
+}
+
+void PaletteTexture::rotate(int row, int startIndex, int endIndex, bool right)
+{
+    if (row < 0 || row >= rows)
+        return;
+    if (startIndex < 0 || endIndex >= COLOR_COUNT || startIndex >= endIndex)
+        return;
+
+    QRgb *colors = table.data() + row * COLOR_COUNT;
+    if (right)
+        std::rotate(colors + startIndex, colors + endIndex, colors + endIndex + 1);
+    else
+        std::rotate(colors + startIndex, colors + startIndex + 1, colors + endIndex + 1);
+    dirty = true;
+}
+
+QVector<QRgb> PaletteTexture::lookupRow(const QVector<QRgb> &colors)
+{
+    QVector<QRgb> lookup(COLOR_COUNT, 0);
+    if (colors.isEmpty()) {
+        for (int i = 0; i < COLOR_COUNT; ++i) lookup[i] = qRgb(i, i, i);
+    }
+    else {
+        memcpy(lookup.data(), colors.constData(), qMin<int>(colors.count(), COLOR_COUNT) * sizeof(QRgb));
+    }
+    return lookup;
+}
+
+bool PaletteTexture::splitImage(const QImage &image, QByteArray &indices, QVector<QRgb> &colors)
+{
+    if (image.format() != QImage::Format_Indexed8)
+        return false;
+
+    indices.resize(image.width() * image.height());
+    uchar *dst = (uchar *)indices.data();
+    for (int y = 0; y < image.height(); ++y) {
+        memcpy(dst, image.constScanLine(y), image.width());
+        dst += image.width();
+    }
+
+    colors = image.colorTable();
+    return true;
+}
+
+QImage PaletteTexture::bake(const uchar *indices, int width, int height, const QVector<QRgb> &colors)
+{
+    QVector<QRgb> lookup = lookupRow(colors);
+
+    QImage baked(width, height, QImage::Format_RGBA8888);
+    for (int y = 0; y < height; ++y) {
+        uchar *dst = baked.scanLine(y);
+        for (int x = 0; x < width; ++x) {
+            QRgb color = lookup[*indices++];
+            *dst++     = qRed(color);
+            *dst++     = qGreen(color);
+            *dst++     = qBlue(color);
+            *dst++     = qAlpha(color);
+        }
+    }
+    return baked;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+// the colours for every indexed surface, one 256 colour row each. sheets only upload their indices,
+// the shader looks the colour up in here, so palette edits only need this (tiny) texture re-uploaded
+class PaletteTexture
+{
+public:
+    enum { COLOR_COUNT = 0x100 };
+
+    PaletteTexture(int rows = 1);
+
+    void resize(int rows);
+    inline int rowCount() const { return rows; }
+
+    void setRow(int row, const QVector<QRgb> &colors);
+    QVector<QRgb> getRow(int row) const;
+    void setColor(int row, int index, QRgb color);
+    inline QRgb getColor(int row, int index) const { return table[row * COLOR_COUNT + index]; }
+
+    // same as the engine's CopyPalette: indices wrap around the row as bytes, & it goes a colour at a time
+    // front to back, so an overlapping copy within a row repeats colours rather than shifting them
+    void copyColors(int srcRow, int srcIndex, int dstRow, int dstIndex, int count);
+    // shifts [startIndex, endIndex] by one, wrapping around, same as the engine's RotatePalette
+    void rotate(int row, int startIndex, int endIndex, bool right);
+
+    // QRgb values, so upload as BGRA/UInt32_RGBA8_Rev
+    inline const QRgb *constData() const { return table.constData(); }
+    inline bool isDirty() const { return dirty; }
+    inline void markDirty() { dirty = true; }
+    inline void clearDirty() { dirty = false; }
+
+    // what a colour table turns into once it's a full row, matches what Qt does when it converts an
+    // Indexed8 image: no table means greyscale, anything missing is transparent black
+    static QVector<QRgb> lookupRow(const QVector<QRgb> &colors);
+    // splits an indexed image into tightly packed indices & its colour table, false if it isn't indexed
+    static bool splitImage(const QImage &image, QByteArray &indices, QVector<QRgb> &colors);
+    // the RGBA image the shader's lookup produces, same as baking the indexed image like we used to
+    static QImage bake(const uchar *indices, int width, int height, const QVector<QRgb> &colors);
+
+private:
+    QVector<QRgb> table;
+    int rows   = 0;
+    bool dirty = false;
+};
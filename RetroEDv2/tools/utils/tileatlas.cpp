@@ -0,0 +1,180 @@
+#include "includes.hpp"
+
+#include "tileatlas.hpp"
+
+TileAtlas::TileAtlas() { clear(); }
+
+void TileAtlas::clear()
+{
+    pixels.fill(0, TILE_COUNT * TILE_BYTES);
+    palette.clear();
+
+    dirty.fill(0, TILE_COUNT / 32);
+    dirtyCount = 0;
+}
+
+void TileAtlas::load(const QImage &tileset)
+{
+    clear();
+
+    QImage src      = tileset;
+    QByteArray data;
+    if (src.format() == QImage::Format_Indexed8) {
+        palette = src.colorTable();
+    }
+    else {
+        // keeps index 0 as the transparent colour, same as the gifs
+        data = Quantizer::toIndexed(src, palette, 0x100);
+    }
+
+    int tilesPerRow = src.width() / TILE_SIZE;
+    int tileRows    = src.height() / TILE_SIZE;
+    for (int t = 0; t < TILE_COUNT && t < tilesPerRow * tileRows; ++t) {
+        int tx = (t % tilesPerRow) * TILE_SIZE;
+        int ty = (t / tilesPerRow) * TILE_SIZE;
+
+        uchar *dst = tilePixels(t);
+        for (int y = 0; y < TILE_SIZE; ++y) {
+            const uchar *row = data.isEmpty()
+                                   ? src.constScanLine(ty + y)
+                                   : (const uchar *)data.constData() + (ty + y) * src.width();
+            memcpy(dst + y * TILE_SIZE, row + tx, TILE_SIZE);
+        }
+    }
+
+    markAllDirty();
+}
+
+void TileAtlas::setPalette(const QVector<QRgb> &colors)
+{
+    // the texture only holds indices, so this doesn't dirty anything
+    palette = colors;
+}
+
+QImage TileAtlas::image(int firstTile, int count) const
+{
+    QImage img(tilePixels(firstTile), TILE_SIZE, count * TILE_SIZE, TILE_SIZE, QImage::Format_Indexed8);
+    img.setColorTable(palette);
+    return img;
+}
+
+QImage TileAtlas::tileImage(int tile) const { return image(tile, 1).copy(); }
+
+QList<QImage> TileAtlas::tileImages() const
+{
+    QList<QImage> tiles;
+    tiles.reserve(TILE_COUNT);
+    for (int t = 0; t < TILE_COUNT; ++t) tiles.append(tileImage(t));
+    return tiles;
+}
+
+void TileAtlas::setTile(int tile, const uchar *src)
+{
+    if (tile < 0 || tile >= TILE_COUNT)
+        return;
+
+    memcpy(tilePixels(tile), src, TILE_BYTES);
+    markDirty(tile);
+}
+
+void TileAtlas::copyTile(int dst, int src)
+{
+    if (dst == src || src < 0 || src >= TILE_COUNT)
+        return;
+
+    setTile(dst, tilePixels(src));
+}
+
+bool TileAtlas::syncTile(const QImage &tile, int id)
+{
+    if (tile.width() != TILE_SIZE || tile.height() != TILE_SIZE)
+        return false;
+
+    uchar buffer[TILE_BYTES];
+    if (tile.format() == QImage::Format_Indexed8) {
+        for (int y = 0; y < TILE_SIZE; ++y)
+            memcpy(buffer + y * TILE_SIZE, tile.constScanLine(y), TILE_SIZE);
+    }
+    else {
+        QByteArray indexed = Quantizer::remap(tile, palette);
+        memcpy(buffer, indexed.constData(), TILE_BYTES);
+    }
+
+    if (!memcmp(buffer, tilePixels(id), TILE_BYTES))
+        return false;
+
+    setTile(id, buffer);
+    return true;
+}
+
+QList<int> TileAtlas::syncFrom(const QList<QImage> &tiles, int firstTile, int count)
+{
+    QList<int> changed;
+
+    int first = qMax(firstTile, 0);
+    int last  = qMin(qMin(firstTile + count, (int)TILE_COUNT), tiles.count());
+    for (int t = first; t < last; ++t) {
+        if (syncTile(tiles[t], t))
+            changed.append(t);
+    }
+
+    return changed;
+}
+
+QList<int> TileAtlas::syncFrom(const QList<QImage> &tiles, const QList<int> &ids)
+{
+    QList<int> changed;
+
+    for (int t : ids) {
+        if (t < 0 || t >= TILE_COUNT || t >= tiles.count())
+            continue;
+
+        if (syncTile(tiles[t], t))
+            changed.append(t);
+    }
+
+    return changed;
+}
+
+void TileAtlas::markDirty(int tile)
+{
+    if (tile < 0 || tile >= TILE_COUNT || isDirty(tile))
+        return;
+
+    dirty[tile >> 5] |= 1u << (tile & 0x1F);
+    ++dirtyCount;
+}
+
+void TileAtlas::markAllDirty()
+{
+    dirty.fill(0xFFFFFFFF);
+    dirtyCount = TILE_COUNT;
+}
+
+QList<QPair<int, int>> TileAtlas::takeDirtyRanges()
+{
+    QList<QPair<int, int>> ranges;
+    if (!dirtyCount)
+        return ranges;
+
+    for (int t = 0; t < TILE_COUNT;) {
+        // skip whole clean words at once
+        if (!(t & 0x1F) && !dirty[t >> 5]) {
+            t += 32;
+            continue;
+        }
+
+        if (!isDirty(t)) {
+            ++t;
+            continue;
+        }
+
+        int start = t;
+        while (t < TILE_COUNT && isDirty(t)) ++t;
+        ranges.append(QPair<int, int>(start, t - start));
+    }
+
+    dirty.fill(0);
+    dirtyCount = 0;
+    return ranges;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+// the whole tileset as a single indexed column of 0x400 tiles, the same layout the tile texture uses.
+// edits mark the tiles they touch so only those rows need to be re-uploaded
+class TileAtlas
+{
+public:
+    enum { TILE_SIZE = 0x10, TILE_COUNT = 0x400, TILE_BYTES = TILE_SIZE * TILE_SIZE };
+
+    TileAtlas();
+
+    // tiles are read left to right, top to bottom, anything that isn't indexed gets quantized
+    void load(const QImage &tileset);
+    void clear();
+
+    inline uchar *tilePixels(int tile) { return (uchar *)pixels.data() + tile * TILE_BYTES; }
+    inline const uchar *tilePixels(int tile) const
+    {
+        return (const uchar *)pixels.constData() + tile * TILE_BYTES;
+    }
+    inline const QByteArray &getPixels() const { return pixels; }
+
+    inline const QVector<QRgb> &getPalette() const { return palette; }
+    void setPalette(const QVector<QRgb> &colors);
+
+    // only wraps the buffer, so it's only valid until the next edit
+    QImage image(int firstTile = 0, int count = TILE_COUNT) const;
+    // deep copies, for icons & editors that want a QImage per tile
+    QImage tileImage(int tile) const;
+    QList<QImage> tileImages() const;
+
+    void setTile(int tile, const uchar *src);
+    void copyTile(int dst, int src);
+    // copies over the tiles in the range/list that differ from their image in the list, returns the
+    // ones that changed. only the tiles asked for are compared, so edits should pass what they touched
+    QList<int> syncFrom(const QList<QImage> &tiles, int firstTile = 0, int count = TILE_COUNT);
+    QList<int> syncFrom(const QList<QImage> &tiles, const QList<int> &ids);
+
+    void markDirty(int tile);
+    void markAllDirty();
+    inline bool isDirty() const { return dirtyCount > 0; }
+    inline bool isDirty(int tile) const { return (dirty[tile >> 5] >> (tile & 0x1F)) & 1; }
+    // runs of dirty tiles as (first tile, count), the dirty flags are cleared afterwards
+    QList<QPair<int, int>> takeDirtyRanges();
+
+private:
+    bool syncTile(const QImage &tile, int id);
+
+    QByteArray pixels;
+    QVector<QRgb> palette;
+
+    QVector<uint> dirty; // 1 bit per tile
+    int dirtyCount = 0;
+};
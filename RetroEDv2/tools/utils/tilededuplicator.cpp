@@ -0,0 +1,241 @@
+#include "includes.hpp"
+
+#include "tilededuplicator.hpp"
+
+quint64 TileDeduplicator::hashTile(const uchar *pixels, byte flip)
+{
+    // FNV-1a
+    quint64 hash = 0xCBF29CE484222325;
+    for (int y = 0; y < TileAtlas::TILE_SIZE; ++y) {
+        const uchar *row = pixels + ((flip & FLIP_Y) ? 0x0F - y : y) * TileAtlas::TILE_SIZE;
+        for (int x = 0; x < TileAtlas::TILE_SIZE; ++x) {
+            hash ^= row[(flip & FLIP_X) ? 0x0F - x : x];
+            hash *= 0x100000001B3;
+        }
+    }
+    return hash;
+}
+
+bool TileDeduplicator::compareTiles(const uchar *a, byte flipA, const uchar *b, byte flipB)
+{
+    for (int y = 0; y < TileAtlas::TILE_SIZE; ++y) {
+        const uchar *rowA = a + ((flipA & FLIP_Y) ? 0x0F - y : y) * TileAtlas::TILE_SIZE;
+        const uchar *rowB = b + ((flipB & FLIP_Y) ? 0x0F - y : y) * TileAtlas::TILE_SIZE;
+        for (int x = 0; x < TileAtlas::TILE_SIZE; ++x) {
+            if (rowA[(flipA & FLIP_X) ? 0x0F - x : x] != rowB[(flipB & FLIP_X) ? 0x0F - x : x])
+                return false;
+        }
+    }
+    return true;
+}
+
+bool TileDeduplicator::isBlank(const uchar *pixels)
+{
+    for (int p = 0; p < TileAtlas::TILE_BYTES; ++p) {
+        if (pixels[p])
+            return false;
+    }
+    return true;
+}
+
+QVector<TileDeduplicator::Match> TileDeduplicator::findTiles(const TileAtlas &atlas, int tileCount,
+                                                             const QVector<QByteArray> &keys,
+                                                             const QList<ushort> &excluded)
+{
+    tileCount = qBound(0, tileCount, (int)TileAtlas::TILE_COUNT);
+
+    QVector<bool> skipped(tileCount);
+    for (int t = 0; t < tileCount; ++t) skipped[t] = isBlank(atlas.tilePixels(t));
+    for (ushort t : excluded) {
+        if (t < tileCount)
+            skipped[t] = true;
+    }
+
+    // every tile gets the smallest hash out of its orientations, along with the flip that made it.
+    // any two tiles that match (flipped or not) end up with the same one
+    QVector<quint64> hashes(tileCount);
+    QVector<byte> orientations(tileCount);
+
+    QList<int> tileIDs;
+    tileIDs.reserve(tileCount);
+    for (int t = 0; t < tileCount; ++t) tileIDs.append(t);
+
+    QtConcurrent::blockingMap(tileIDs, [&](int &tile) {
+        bool flippable = tile >= keys.count() || keys[tile].isEmpty();
+
+        quint64 best = hashTile(atlas.tilePixels(tile), FLIP_NONE);
+        byte flip    = FLIP_NONE;
+        for (byte f = FLIP_X; flippable && f <= FLIP_XY; ++f) {
+            quint64 hash = hashTile(atlas.tilePixels(tile), f);
+            if (hash < best) {
+                best = hash;
+                flip = f;
+            }
+        }
+
+        hashes[tile]       = best;
+        orientations[tile] = flip;
+    });
+
+    // in order, so the lowest id out of any copies is the one that's kept
+    QVector<Match> matches(tileCount);
+    QHash<quint64, QVector<ushort>> kept;
+    kept.reserve(tileCount);
+    for (int t = 0; t < tileCount; ++t) {
+        matches[t] = { (ushort)t, FLIP_NONE };
+        if (skipped[t])
+            continue;
+
+        QByteArray key = t < keys.count() ? keys[t] : QByteArray();
+
+        QVector<ushort> &candidates = kept[hashes[t]];
+        for (ushort c : candidates) {
+            QByteArray candidateKey = c < keys.count() ? keys[c] : QByteArray();
+            if (candidateKey != key)
+                continue;
+
+            // hashes can collide, so make sure before merging anything
+            const uchar *pixels = atlas.tilePixels(t);
+            if (compareTiles(pixels, orientations[t], atlas.tilePixels(c), orientations[c])) {
+                // both flipped this way are the same, so t is c flipped by the difference
+                matches[t] = { c, (byte)(orientations[t] ^ orientations[c]) };
+                break;
+            }
+        }
+
+        if (matches[t].tile == t)
+            candidates.append(t);
+    }
+
+    return matches;
+}
+
+QVector<QByteArray> TileDeduplicator::collisionKeys(const RSDKv5::TileConfig &config)
+{
+    // a tile's collision has to come along with it, flipping it would flip the collision too
+    QVector<QByteArray> keys(0x400);
+    for (int t = 0; t < 0x400; ++t) {
+        bool solid = false;
+        QByteArray key;
+        for (int c = 0; c < 2; ++c) {
+            auto &mask = config.collisionPaths[c][t];
+            for (int i = 0; i < 0x10; ++i) {
+                solid |= mask.collision[i].solid;
+                key.append(mask.collision[i].height).append(mask.collision[i].solid);
+            }
+            key.append(mask.direction).append(mask.flags);
+            key.append(mask.floorAngle).append(mask.lWallAngle);
+            key.append(mask.rWallAngle).append(mask.roofAngle);
+        }
+
+        if (solid)
+            keys[t] = key;
+    }
+    return keys;
+}
+
+QVector<QByteArray> TileDeduplicator::collisionKeys(const RSDKv1::TileConfig &config)
+{
+    QVector<QByteArray> keys(0x400);
+    for (int t = 0; t < 0x400; ++t) {
+        bool solid = false;
+        QByteArray key;
+        for (int c = 0; c < 2; ++c) {
+            auto &mask = config.collisionPaths[c][t];
+            for (int f = 0; f < RSDKv1::TileConfig::Max; ++f) {
+                for (int i = 0; i < 0x10; ++i) {
+                    solid |= mask.collision[f][i].solid != 0;
+                    key.append(mask.collision[f][i].height).append(mask.collision[f][i].solid);
+                }
+            }
+            key.append(mask.collisionMode);
+        }
+
+        if (solid)
+            keys[t] = key;
+    }
+    return keys;
+}
+
+QVector<TileDeduplicator::Match> TileDeduplicator::findChunks(const FormatHelpers::Chunks &chunks,
+                                                              int chunkCount)
+{
+    chunkCount = qBound(0, chunkCount, 0x200);
+
+    QVector<Match> matches(chunkCount);
+    QHash<QByteArray, ushort> kept;
+    kept.reserve(chunkCount);
+    for (int c = 0; c < chunkCount; ++c) {
+        QByteArray key(8 * 8 * 5, 0);
+
+        byte *k = (byte *)key.data();
+        for (int h = 0; h < 0x8; ++h) {
+            for (int w = 0; w < 0x8; ++w) {
+                auto &tile = chunks.chunks[c].tiles[h][w];
+                *k++       = tile.tileIndex & 0xFF;
+                *k++       = tile.tileIndex >> 8;
+                *k++       = tile.direction;
+                *k++       = tile.visualPlane;
+                *k++       = (tile.solidityA << 4) | tile.solidityB;
+            }
+        }
+
+        if (!kept.contains(key))
+            kept.insert(key, c);
+        matches[c] = { kept.value(key), FLIP_NONE };
+    }
+
+    return matches;
+}
+
+int TileDeduplicator::remapChunks(FormatHelpers::Chunks &chunks, int chunkCount,
+                                  const QVector<Match> &matches)
+{
+    int changed = 0;
+    for (int c = 0; c < chunkCount && c < 0x200; ++c) {
+        for (int h = 0; h < 0x8; ++h) {
+            for (int w = 0; w < 0x8; ++w) {
+                auto &tile = chunks.chunks[c].tiles[h][w];
+                if (tile.tileIndex >= matches.count() || matches[tile.tileIndex].tile == tile.tileIndex)
+                    continue;
+
+                // the flips stack on top of whatever the chunk already flips the tile by
+                const Match &match = matches[tile.tileIndex];
+                tile.direction ^= match.flip;
+                tile.tileIndex  = match.tile;
+                ++changed;
+            }
+        }
+    }
+    return changed;
+}
+
+int TileDeduplicator::remapLayers(QList<SceneHelpers::TileLayer> &layers, const QVector<Match> &matches,
+                                  ushort idMask, ushort emptyValue)
+{
+    int changed = 0;
+    for (auto &layer : layers) {
+        for (auto &row : layer.layout) {
+            for (auto &value : row) {
+                ushort id = value & idMask;
+                if (value == emptyValue || id >= matches.count() || matches[id].tile == id)
+                    continue;
+
+                const Match &match = matches[id];
+                value              = ((value & ~idMask) ^ (match.flip << 10)) | match.tile;
+                ++changed;
+            }
+        }
+    }
+    return changed;
+}
+
+QList<ushort> TileDeduplicator::freedIDs(const QVector<Match> &matches)
+{
+    QList<ushort> freed;
+    for (int id = 0; id < matches.count(); ++id) {
+        if (matches[id].tile != id)
+            freed.append(id);
+    }
+    return freed;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <RSDKv1/tileconfigv1.hpp>
+#include <RSDKv5/tileconfigv5.hpp>
+
+#include "tools/sceneproperties/sceneincludesv5.hpp"
+#include "tileatlas.hpp"
+
+// finds tiles that are exact copies of another tile (or of one of its flipped versions), so the copies
+// can be pointed at the original. chunks (v1-v4) are matched the same way, minus the flipping
+class TileDeduplicator
+{
+public:
+    enum FlipFlags { FLIP_NONE, FLIP_X, FLIP_Y, FLIP_XY };
+
+    // drawing tile with flip looks exactly like the tile this is for. kept tiles point at themselves
+    struct Match {
+        ushort tile;
+        byte flip;
+    };
+
+    // tiles only match tiles with the same key, & only as a flipped copy if the key's empty. the
+    // editors key tiles by their collision, that way a merge can't change how anything collides.
+    // blank tiles & the excluded ones (animated tiles, anything objects draw into) are never merged
+    // either way, they only look alike until something fills them in
+    static QVector<Match> findTiles(const TileAtlas &atlas, int tileCount,
+                                    const QVector<QByteArray> &keys,
+                                    const QList<ushort> &excluded = QList<ushort>());
+    // keys for findTiles out of both collision planes, tiles that don't collide get an empty one
+    static QVector<QByteArray> collisionKeys(const RSDKv5::TileConfig &config);
+    static QVector<QByteArray> collisionKeys(const RSDKv1::TileConfig &config);
+    // chunks have to match exactly, planes & solidity included
+    static QVector<Match> findChunks(const FormatHelpers::Chunks &chunks, int chunkCount);
+
+    // points chunk tiles at their matches, returns how many entries changed
+    static int remapChunks(FormatHelpers::Chunks &chunks, int chunkCount,
+                           const QVector<Match> &matches);
+    // same for layouts, ids are (value & idMask) & flips get xor'd into bits 10 & 11 (v5 layouts)
+    static int remapLayers(QList<SceneHelpers::TileLayer> &layers, const QVector<Match> &matches,
+                           ushort idMask, ushort emptyValue);
+
+    // the ids that got pointed somewhere else, they aren't used by anything that was remapped anymore
+    static QList<ushort> freedIDs(const QVector<Match> &matches);
+
+    // every pixel is the transparent colour
+    static bool isBlank(const uchar *pixels);
+
+private:
+    // reads the tile's pixels in flipped order, so no flipped copies need to be made
+    static quint64 hashTile(const uchar *pixels, byte flip);
+    static bool compareTiles(const uchar *a, byte flipA, const uchar *b, byte flipB);
+};
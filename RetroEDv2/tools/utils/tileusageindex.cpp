@@ -0,0 +1,157 @@
+#include "includes.hpp"
+
+#include "tileusageindex.hpp"
+
+void TileUsageIndex::setup(ushort idMask, int idCount, ushort emptyValue)
+{
+    this->idMask     = idMask;
+    this->idCount    = idCount;
+    this->emptyValue = emptyValue;
+
+    usages.clear();
+    slots.clear();
+    sizes.clear();
+    built.clear();
+    valid = false;
+}
+
+void TileUsageIndex::ensure(const QList<SceneHelpers::TileLayer> &layers)
+{
+    if (valid && sizes.count() == layers.count()) {
+        bool changed = false;
+        for (int l = 0; l < layers.count() && !changed; ++l) {
+            changed = built[l] != &layers[l];
+            changed = changed || sizes[l] != QSize(layers[l].width, layers[l].height);
+        }
+
+        if (!changed)
+            return;
+    }
+
+    usages.fill(QVector<Usage>(), idCount);
+    slots.resize(layers.count());
+    sizes.resize(layers.count());
+    built.resize(layers.count());
+
+    for (int l = 0; l < layers.count(); ++l) {
+        auto &layer = layers[l];
+        sizes[l]    = QSize(layer.width, layer.height);
+        built[l]    = &layer;
+        slots[l].fill(-1, layer.width * layer.height);
+
+        for (int y = 0; y < layer.height && y < layer.layout.count(); ++y) {
+            auto &row = layer.layout[y];
+            for (int x = 0; x < layer.width && x < row.count(); ++x) {
+                if (tracked(row[x]))
+                    add(l, x, y, row[x] & idMask);
+            }
+        }
+    }
+
+    valid = true;
+}
+
+void TileUsageIndex::update(int layer, int x, int y, ushort prevValue, ushort value)
+{
+    if (!valid)
+        return;
+
+    if (layer < 0 || layer >= sizes.count() || x < 0 || x >= sizes[layer].width() || y < 0
+        || y >= sizes[layer].height()) {
+        // something's been resized without us knowing, start over next time
+        valid = false;
+        return;
+    }
+
+    if (tracked(prevValue))
+        remove(layer, x, y, prevValue & idMask);
+    if (tracked(value))
+        add(layer, x, y, value & idMask);
+}
+
+const QVector<TileUsageIndex::Usage> &TileUsageIndex::find(ushort id) const
+{
+    static const QVector<Usage> none;
+    if (!valid || id >= usages.count())
+        return none;
+
+    return usages[id];
+}
+
+QList<ushort> TileUsageIndex::unused() const
+{
+    QList<ushort> list;
+    if (!valid)
+        return list;
+
+    for (int id = 0; id < usages.count(); ++id) {
+        if (usages[id].isEmpty())
+            list.append(id);
+    }
+    return list;
+}
+
+QString TileUsageIndex::formatRanges(const QList<ushort> &ids)
+{
+    QStringList ranges;
+    for (int i = 0; i < ids.count();) {
+        int first = ids[i];
+        int last  = first;
+        while (++i < ids.count() && ids[i] == last + 1) last = ids[i];
+
+        ranges.append(first == last ? QString::number(first) : QString("%1-%2").arg(first).arg(last));
+    }
+    return ranges.join(", ");
+}
+
+bool TileUsageIndex::parseRanges(const QString &text, int idCount, QList<ushort> &ids)
+{
+    QVector<bool> found(idCount);
+    for (const QString &part : text.split(',')) {
+        if (part.trimmed().isEmpty())
+            continue;
+
+        QStringList bounds = part.split('-');
+        if (bounds.count() > 2)
+            return false;
+
+        bool okFirst = false, okLast = false;
+        int first    = bounds.first().trimmed().toInt(&okFirst);
+        int last     = bounds.last().trimmed().toInt(&okLast);
+        if (!okFirst || !okLast || first < 0 || first > last || last >= idCount)
+            return false;
+
+        for (int id = first; id <= last; ++id) found[id] = true;
+    }
+
+    ids.clear();
+    for (int id = 0; id < idCount; ++id) {
+        if (found[id])
+            ids.append(id);
+    }
+    return true;
+}
+
+void TileUsageIndex::add(int layer, int x, int y, ushort id)
+{
+    QVector<Usage> &list = usages[id];
+
+    slots[layer][y * sizes[layer].width() + x] = list.count();
+    list.append({ (byte)layer, (ushort)x, (ushort)y });
+}
+
+void TileUsageIndex::remove(int layer, int x, int y, ushort id)
+{
+    QVector<Usage> &list = usages[id];
+
+    int &slot = slots[layer][y * sizes[layer].width() + x];
+    if (slot < 0 || slot >= list.count())
+        return;
+
+    // swap the last placement into the gap so removing stays O(1)
+    Usage last  = list.last();
+    list[slot]  = last;
+    slots[last.layer][last.y * sizes[last.layer].width() + last.x] = slot;
+    list.removeLast();
+    slot = -1;
+}
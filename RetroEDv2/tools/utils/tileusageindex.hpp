@@ -0,0 +1,50 @@
+#pragma once
+
+#include "tools/sceneproperties/sceneincludesv5.hpp"
+
+// every placement of each tile (chunks for v1-v4) across all the layers. it's kept up to date as
+// tiles are placed, so finding, replacing & checking for unused tiles only touch the placements involved
+class TileUsageIndex
+{
+public:
+    struct Usage {
+        byte layer;
+        ushort x;
+        ushort y;
+    };
+
+    // ids are (value & idMask), placements of emptyValue aren't tracked
+    void setup(ushort idMask, int idCount, ushort emptyValue);
+    inline void invalidate() { valid = false; }
+    // rebuilds if it's been invalidated or any layer was added, removed, reordered or resized since.
+    // reordering is caught by each layer's address, which a QList keeps when its items are moved
+    void ensure(const QList<SceneHelpers::TileLayer> &layers);
+
+    // call after a layout entry is changed from prevValue to value
+    void update(int layer, int x, int y, ushort prevValue, ushort value);
+
+    const QVector<Usage> &find(ushort id) const;
+    inline int count(ushort id) const { return find(id).count(); }
+    QList<ushort> unused() const;
+
+    // "0-3, 7, 9-12", for listing ids in a message
+    static QString formatRanges(const QList<ushort> &ids);
+    // reads that back sorted & without repeats, false if any part isn't an id or range below idCount
+    static bool parseRanges(const QString &text, int idCount, QList<ushort> &ids);
+
+private:
+    void add(int layer, int x, int y, ushort id);
+    void remove(int layer, int x, int y, ushort id);
+    inline bool tracked(ushort value) const { return value != emptyValue && (value & idMask) < idCount; }
+
+    QVector<QVector<Usage>> usages; // per id
+    QVector<QVector<int>> slots;    // per layer, where each placement sits in its id's usages, or -1
+    QVector<QSize> sizes;           // per layer, what it was built with
+    // per layer, which layer it was built from
+    QVector<const SceneHelpers::TileLayer *> built;
+
+    ushort idMask     = 0x3FF;
+    int idCount       = 0x400;
+    ushort emptyValue = 0xFFFF;
+    bool valid        = false;
+};
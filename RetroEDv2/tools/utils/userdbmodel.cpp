@@ -0,0 +1,461 @@
+#include "includes.hpp"
+
+#include "userdbmodel.hpp"
+
+#include <cmath>
+#include <numeric>
+
+using namespace RSDKv5;
+
+namespace
+{
+
+// orders the same way the timestamp does, without needing a QDateTime per row
+inline qint64 timestampKey(const UserDB::TimeStamp &time)
+{
+    qint64 days = ((qint64)time.tm_year * 12 + time.tm_mon) * 31 + time.tm_mday;
+    return ((days * 24 + time.tm_hour) * 60 + time.tm_min) * 60 + time.tm_sec;
+}
+
+inline bool parseUUID(const QString &string, uint &uuid)
+{
+    QString text = string.trimmed();
+    bool ok      = false;
+    uuid         = text.toUInt(&ok, text.startsWith("0x", Qt::CaseInsensitive) ? 0x10 : 10);
+    return ok;
+}
+
+template <typename T> inline T readValue(const QByteArray &data)
+{
+    T value = 0;
+    memcpy(&value, data.constData(), qMin<int>(sizeof(T), data.size()));
+    return value;
+}
+
+template <typename T> inline bool isNaN(const T &) { return false; }
+inline bool isNaN(double value) { return std::isnan(value); }
+
+// descending compares the other way round rather than reversing, so equal keys stay in db order. nans
+// don't compare with anything (which breaks the sort's ordering), they're kept last in db order instead
+template <typename T> inline void sortByKeys(QVector<int> &rows, const QVector<T> &k, bool descending)
+{
+    auto numbers =
+        std::stable_partition(rows.begin(), rows.end(), [&k](int r) { return !isNaN(k[r]); });
+
+    if (descending)
+        std::stable_sort(rows.begin(), numbers, [&k](int a, int b) { return k[b] < k[a]; });
+    else
+        std::stable_sort(rows.begin(), numbers, [&k](int a, int b) { return k[a] < k[b]; });
+}
+
+} // namespace
+
+UserDBModel::UserDBModel(QObject *parent) : QAbstractTableModel(parent) {}
+
+void UserDBModel::setDB(UserDB *userDB)
+{
+    beginResetModel();
+    db = userDB;
+
+    keys.clear();
+    keys.resize(columnCount());
+
+    activeFilters.clear();
+    sortColumn = -1;
+    sortOrder  = Qt::AscendingOrder;
+    rebuildRows();
+    endResetModel();
+}
+
+int UserDBModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : rows.count();
+}
+
+int UserDBModel::columnCount(const QModelIndex &parent) const
+{
+    if (parent.isValid() || !db)
+        return 0;
+    return COLUMN_FIXEDCOUNT + db->columns.count();
+}
+
+QString UserDBModel::columnName(int column) const
+{
+    switch (column) {
+        case COLUMN_UUID: return "uuid";
+        case COLUMN_CREATED: return "Creation Date";
+        case COLUMN_MODIFIED: return "Modified Date";
+        default: return db->columns[column - COLUMN_FIXEDCOUNT].name;
+    }
+}
+
+QString UserDBModel::columnTypeName(int column) const
+{
+    switch (column) {
+        case COLUMN_UUID: return "uint32";
+        case COLUMN_CREATED:
+        case COLUMN_MODIFIED: return "timestamp";
+        default: return UserDB::typeName(db->columns[column - COLUMN_FIXEDCOUNT].type);
+    }
+}
+
+QString UserDBModel::cellText(int column, int dbRow) const
+{
+    const UserDB::TableRow &row = db->rows[dbRow];
+    switch (column) {
+        case COLUMN_UUID: return "0x" + QString::number(row.uuid, 0x10).toUpper();
+        case COLUMN_CREATED: return row.createDate.toDateString();
+        case COLUMN_MODIFIED: return row.modifyDate.toDateString();
+        default: {
+            int c = column - COLUMN_FIXEDCOUNT;
+            if (c >= row.entries.count())
+                return "";
+            return UserDB::valueToString(db->columns[c].type, row.entries[c].data);
+        }
+    }
+}
+
+QVariant UserDBModel::data(const QModelIndex &index, int role) const
+{
+    if (!db || !index.isValid() || index.row() >= rows.count())
+        return QVariant();
+
+    if (role == Qt::DisplayRole || role == Qt::EditRole)
+        return cellText(index.column(), rows[index.row()]);
+
+    return QVariant();
+}
+
+QVariant UserDBModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (!db)
+        return QVariant();
+
+    if (orientation == Qt::Horizontal) {
+        if (role == Qt::DisplayRole)
+            return columnName(section);
+        if (role == Qt::ToolTipRole)
+            return columnTypeName(section);
+    }
+    else if (role == Qt::DisplayRole && section < rows.count()) {
+        return rows[section];
+    }
+
+    return QVariant();
+}
+
+Qt::ItemFlags UserDBModel::flags(const QModelIndex &index) const
+{
+    if (!index.isValid())
+        return Qt::NoItemFlags;
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsEditable;
+}
+
+bool UserDBModel::setData(const QModelIndex &index, const QVariant &value, int role)
+{
+    if (!db || !index.isValid() || role != Qt::EditRole || index.row() >= rows.count())
+        return false;
+
+    UserDB::TableRow &row = db->rows[rows[index.row()]];
+    QString text          = value.toString();
+
+    switch (index.column()) {
+        case COLUMN_UUID:
+            if (!parseUUID(text, row.uuid))
+                return false;
+            break;
+
+        case COLUMN_CREATED:
+            if (!row.createDate.fromDateString(text))
+                return false;
+            break;
+
+        case COLUMN_MODIFIED:
+            if (!row.modifyDate.fromDateString(text))
+                return false;
+            break;
+
+        default: {
+            int c = index.column() - COLUMN_FIXEDCOUNT;
+            QByteArray data;
+            if (!UserDB::valueFromString(db->columns[c].type, text, data))
+                return false;
+
+            while (row.entries.count() <= c) row.entries.append(UserDB::TableRow::Value());
+            row.entries[c].data = data;
+            break;
+        }
+    }
+
+    // rows stay where they are until the next sort/filter, so the edited cell doesn't jump away
+    keys[index.column()] = ColumnKeys();
+
+    emit dataChanged(index, index, { Qt::DisplayRole, Qt::EditRole });
+    return true;
+}
+
+void UserDBModel::sort(int column, Qt::SortOrder order)
+{
+    if (!db)
+        return;
+
+    beginResetModel();
+    sortColumn = column < columnCount() ? column : -1;
+    sortOrder  = order;
+    rebuildRows();
+    endResetModel();
+}
+
+bool UserDBModel::setFilters(const QList<Filter> &filters)
+{
+    if (!db)
+        return false;
+
+    QList<ParsedFilter> parsed;
+    for (auto &filter : filters) {
+        if (filter.column < 0 || filter.column >= columnCount())
+            return false;
+
+        ParsedFilter p;
+        p.column = filter.column;
+        p.mode   = filter.mode;
+        p.hasMin = filter.mode == Filter::Equal || !filter.min.isEmpty();
+        p.hasMax = filter.mode == Filter::Range && !filter.max.isEmpty();
+
+        if (p.hasMin && !parseKey(filter.column, filter.min, p.min))
+            return false;
+        if (p.hasMax && !parseKey(filter.column, filter.max, p.max))
+            return false;
+
+        parsed.append(p);
+    }
+
+    beginResetModel();
+    activeFilters = parsed;
+    rebuildRows();
+    endResetModel();
+    return true;
+}
+
+byte UserDBModel::keyType(int column) const
+{
+    if (column < COLUMN_FIXEDCOUNT)
+        return KEY_INT;
+
+    switch (db->columns[column - COLUMN_FIXEDCOUNT].type) {
+        case UserDB::TableColumn::Bool:
+        case UserDB::TableColumn::UInt8:
+        case UserDB::TableColumn::UInt16:
+        case UserDB::TableColumn::UInt32:
+        case UserDB::TableColumn::UInt64:
+        case UserDB::TableColumn::Int8:
+        case UserDB::TableColumn::Int16:
+        case UserDB::TableColumn::Int32:
+        case UserDB::TableColumn::Int64:
+        case UserDB::TableColumn::Color: return KEY_INT;
+
+        case UserDB::TableColumn::Float:
+        case UserDB::TableColumn::Double: return KEY_REAL;
+
+        default: return KEY_BYTES;
+    }
+}
+
+UserDBModel::Key UserDBModel::makeKey(int column, int dbRow) const
+{
+    const UserDB::TableRow &row = db->rows[dbRow];
+
+    Key key;
+    switch (column) {
+        case COLUMN_UUID: key.i = row.uuid; break;
+        case COLUMN_CREATED: key.i = timestampKey(row.createDate); break;
+        case COLUMN_MODIFIED: key.i = timestampKey(row.modifyDate); break;
+        default: {
+            int c = column - COLUMN_FIXEDCOUNT;
+            if (c < row.entries.count())
+                key = dataKey(db->columns[c].type, row.entries[c].data);
+            break;
+        }
+    }
+    return key;
+}
+
+UserDBModel::Key UserDBModel::dataKey(byte type, const QByteArray &data)
+{
+    Key key;
+    switch (type) {
+        case UserDB::TableColumn::Bool:
+        case UserDB::TableColumn::UInt8: key.i = readValue<byte>(data); break;
+        case UserDB::TableColumn::UInt16: key.i = readValue<ushort>(data); break;
+        case UserDB::TableColumn::UInt32:
+        case UserDB::TableColumn::Color: key.i = readValue<uint>(data); break;
+        // flip the sign bit so unsigned order survives the signed compare
+        case UserDB::TableColumn::UInt64:
+            key.i = (qint64)(readValue<uint64>(data) ^ 0x8000000000000000ULL);
+            break;
+        case UserDB::TableColumn::Int8: key.i = readValue<sbyte>(data); break;
+        case UserDB::TableColumn::Int16: key.i = readValue<short>(data); break;
+        case UserDB::TableColumn::Int32: key.i = readValue<int>(data); break;
+        case UserDB::TableColumn::Int64: key.i = readValue<int64>(data); break;
+        case UserDB::TableColumn::Float: key.f = readValue<float>(data); break;
+        case UserDB::TableColumn::Double: key.f = readValue<double>(data); break;
+        default: key.b = data; break;
+    }
+    return key;
+}
+
+bool UserDBModel::parseKey(int column, const QString &string, Key &key) const
+{
+    switch (column) {
+        case COLUMN_UUID: {
+            uint uuid = 0;
+            if (!parseUUID(string, uuid))
+                return false;
+            key.i = uuid;
+            return true;
+        }
+
+        case COLUMN_CREATED:
+        case COLUMN_MODIFIED: {
+            UserDB::TimeStamp time;
+            if (!time.fromDateString(string))
+                return false;
+            key.i = timestampKey(time);
+            return true;
+        }
+
+        default: {
+            byte type = db->columns[column - COLUMN_FIXEDCOUNT].type;
+            QByteArray data;
+            if (!UserDB::valueFromString(type, string, data))
+                return false;
+            key = dataKey(type, data);
+            return true;
+        }
+    }
+}
+
+const UserDBModel::ColumnKeys &UserDBModel::columnKeys(int column) const
+{
+    ColumnKeys &cache = keys[column];
+    if (cache.valid)
+        return cache;
+
+    int count  = db->rows.count();
+    cache.type = keyType(column);
+    cache.sorted.clear();
+    cache.sortedDescending.clear();
+    cache.ints.clear();
+    cache.reals.clear();
+    cache.bytes.clear();
+    cache.nanCount = 0;
+
+    switch (cache.type) {
+        case KEY_INT:
+            cache.ints.resize(count);
+            for (int r = 0; r < count; ++r) cache.ints[r] = makeKey(column, r).i;
+            break;
+
+        case KEY_REAL:
+            cache.reals.resize(count);
+            for (int r = 0; r < count; ++r) cache.reals[r] = makeKey(column, r).f;
+            cache.nanCount = std::count_if(cache.reals.begin(), cache.reals.end(),
+                                           [](double value) { return std::isnan(value); });
+            break;
+
+        case KEY_BYTES:
+            cache.bytes.resize(count);
+            for (int r = 0; r < count; ++r) cache.bytes[r] = makeKey(column, r).b;
+            break;
+    }
+
+    cache.valid = true;
+    return cache;
+}
+
+const QVector<int> &UserDBModel::sortedRows(int column, Qt::SortOrder order) const
+{
+    const ColumnKeys &cache = columnKeys(column);
+    bool descending         = order == Qt::DescendingOrder;
+
+    QVector<int> &sorted = descending ? keys[column].sortedDescending : keys[column].sorted;
+    if (sorted.count() == db->rows.count())
+        return sorted;
+
+    sorted.resize(db->rows.count());
+    std::iota(sorted.begin(), sorted.end(), 0);
+
+    switch (cache.type) {
+        case KEY_INT: sortByKeys(sorted, cache.ints, descending); break;
+        case KEY_REAL: sortByKeys(sorted, cache.reals, descending); break;
+        case KEY_BYTES: sortByKeys(sorted, cache.bytes, descending); break;
+    }
+
+    return sorted;
+}
+
+int UserDBModel::compareKeys(const ColumnKeys &column, int dbRow, const Key &key) const
+{
+    switch (column.type) {
+        default:
+        case KEY_INT: return column.ints[dbRow] < key.i ? -1 : (column.ints[dbRow] > key.i ? 1 : 0);
+        case KEY_REAL: {
+            // the same order as the sort, nans after every number
+            double value = column.reals[dbRow];
+            if (std::isnan(value) || std::isnan(key.f))
+                return std::isnan(value) - std::isnan(key.f);
+            return value < key.f ? -1 : (value > key.f ? 1 : 0);
+        }
+        case KEY_BYTES: return column.bytes[dbRow] < key.b ? -1 : (column.bytes[dbRow] > key.b ? 1 : 0);
+    }
+}
+
+void UserDBModel::rebuildRows()
+{
+    rows.clear();
+    if (!db)
+        return;
+
+    QVector<int> order;
+    if (sortColumn >= 0) {
+        order = sortedRows(sortColumn, sortOrder);
+    }
+    else {
+        order.resize(db->rows.count());
+        std::iota(order.begin(), order.end(), 0);
+    }
+
+    if (!activeFilters.count()) {
+        rows = order;
+        return;
+    }
+
+    // each filter is a contiguous run of its column's ascending index, found with a binary search on
+    // either end. a row is visible once every filter has counted it
+    QVector<int> passed(db->rows.count(), 0);
+    for (auto &filter : activeFilters) {
+        const ColumnKeys &cache   = columnKeys(filter.column);
+        const QVector<int> &index = sortedRows(filter.column, Qt::AscendingOrder);
+
+        auto below = [this, &cache](int r, const Key &key) { return compareKeys(cache, r, key) < 0; };
+        auto above = [this, &cache](const Key &key, int r) { return compareKeys(cache, r, key) > 0; };
+
+        bool hasMax    = filter.mode == Filter::Equal || filter.hasMax;
+        const Key &max = filter.mode == Filter::Equal ? filter.min : filter.max;
+
+        // nans are at the end of the index & in no range, only a filter on nan itself finds them
+        bool nanKey = (filter.hasMin && std::isnan(filter.min.f)) || (hasMax && std::isnan(max.f));
+        auto end    = nanKey ? index.end() : index.end() - cache.nanCount;
+
+        auto first =
+            filter.hasMin ? std::lower_bound(index.begin(), end, filter.min, below) : index.begin();
+        auto last = hasMax ? std::upper_bound(first, end, max, above) : end;
+        for (auto r = first; r < last; ++r) ++passed[*r];
+    }
+
+    rows.reserve(order.count());
+    for (int r : order) {
+        if (passed[r] == activeFilters.count())
+            rows.append(r);
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <RSDKv5/userdbv5.hpp>
+
+// only formats the cells a view asks for, sorting & filtering work on cached per-column keys
+class UserDBModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    // uuid & timestamps come before the db's own columns
+    enum FixedColumns { COLUMN_UUID, COLUMN_CREATED, COLUMN_MODIFIED, COLUMN_FIXEDCOUNT };
+
+    struct Filter {
+        enum Modes { Equal, Range };
+
+        int column  = -1;
+        byte mode   = Equal;
+        QString min = ""; // the value to match for Equal, either bound can be left empty for Range
+        QString max = "";
+    };
+
+    explicit UserDBModel(QObject *parent = nullptr);
+
+    void setDB(RSDKv5::UserDB *userDB);
+    inline RSDKv5::UserDB *getDB() const { return db; }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    // returns false (and leaves the current filters alone) if a filter value can't be parsed
+    bool setFilters(const QList<Filter> &filters);
+    inline void clearFilters() { setFilters(QList<Filter>()); }
+
+    // maps a visible row back to its index in db->rows
+    inline int dbRow(int row) const { return rows[row]; }
+
+    QString columnName(int column) const;
+    QString columnTypeName(int column) const;
+
+private:
+    enum KeyTypes { KEY_INT, KEY_REAL, KEY_BYTES };
+
+    struct Key {
+        qint64 i = 0;
+        double f = 0;
+        QByteArray b;
+    };
+
+    struct ColumnKeys {
+        bool valid = false;
+        byte type  = KEY_INT;
+
+        QVector<qint64> ints;
+        QVector<double> reals;
+        QVector<QByteArray> bytes;
+        int nanCount = 0; // reals only, they sort last
+
+        // db rows in key order, built on the first sort or filter that needs them
+        QVector<int> sorted;
+        QVector<int> sortedDescending;
+    };
+
+    struct ParsedFilter {
+        int column  = -1;
+        byte mode   = Filter::Equal;
+        bool hasMin = false;
+        bool hasMax = false;
+        Key min;
+        Key max;
+    };
+
+    RSDKv5::UserDB *db = nullptr;
+
+    QVector<int> rows;
+    QList<ParsedFilter> activeFilters;
+    int sortColumn          = -1;
+    Qt::SortOrder sortOrder = Qt::AscendingOrder;
+
+    mutable QVector<ColumnKeys> keys;
+
+    byte keyType(int column) const;
+    static Key dataKey(byte type, const QByteArray &data);
+    Key makeKey(int column, int dbRow) const;
+    bool parseKey(int column, const QString &string, Key &key) const;
+    const ColumnKeys &columnKeys(int column) const;
+    const QVector<int> &sortedRows(int column, Qt::SortOrder order) const;
+    int compareKeys(const ColumnKeys &column, int dbRow, const Key &key) const;
+
+    QString cellText(int column, int dbRow) const;
+
+    void rebuildRows();
+};
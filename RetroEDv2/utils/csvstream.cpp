@@ -0,0 +1,435 @@
+#include "includes.hpp"
+
+using RSDKv5::UserDB;
+
+CSVReader::CSVReader(QString filePath, int bufferSize) : file(filePath), bufferSize(bufferSize)
+{
+    file.open(QIODevice::ReadOnly);
+    buffer.reserve(bufferSize);
+}
+
+void CSVReader::rewind()
+{
+    if (!file.isOpen())
+        return;
+
+    file.seek(0);
+    buffer.resize(0);
+    bufferPos = 0;
+}
+
+bool CSVReader::fillBuffer()
+{
+    if (!file.isOpen() || file.atEnd())
+        return false;
+
+    buffer.resize(bufferSize);
+    qint64 count = file.read(buffer.data(), bufferSize);
+    buffer.resize((int)qMax<qint64>(count, 0));
+    bufferPos = 0;
+    return count > 0;
+}
+
+bool CSVReader::readRow(CSVRow &row)
+{
+    row.clear();
+
+    if (bufferPos >= buffer.size() && !fillBuffer())
+        return false;
+
+    QByteArray field;
+    bool quoted    = false;
+    bool wasQuoted = false;
+
+    while (true) {
+        if (bufferPos >= buffer.size() && !fillBuffer()) {
+            // eof ends the row, same as a line break
+            row.append(field);
+            return true;
+        }
+
+        const char *data = buffer.constData();
+        int size         = buffer.size();
+
+        if (quoted) {
+            // copy everything up to the next quote in one go
+            int start = bufferPos;
+            while (bufferPos < size && data[bufferPos] != '"') ++bufferPos;
+            field.append(data + start, bufferPos - start);
+
+            if (bufferPos >= size)
+                continue;
+            ++bufferPos;
+
+            // a doubled quote is an escaped one, anything else closes the field
+            if (bufferPos >= size && !fillBuffer()) {
+                quoted = false;
+                continue;
+            }
+            data = buffer.constData();
+            if (data[bufferPos] == '"') {
+                field.append('"');
+                ++bufferPos;
+            }
+            else {
+                quoted = false;
+            }
+            continue;
+        }
+
+        int start = bufferPos;
+        while (bufferPos < size) {
+            char c = data[bufferPos];
+            if (c == ',' || c == '\n' || c == '\r' || c == '"')
+                break;
+            ++bufferPos;
+        }
+        field.append(data + start, bufferPos - start);
+
+        if (bufferPos >= size)
+            continue;
+
+        char c = data[bufferPos++];
+        switch (c) {
+            case '"':
+                // quotes only open a field at its start, elsewhere they're kept as-is
+                if (field.isEmpty() && !wasQuoted) {
+                    quoted    = true;
+                    wasQuoted = true;
+                }
+                else {
+                    field.append(c);
+                }
+                break;
+
+            case ',':
+                row.append(field);
+                field.clear();
+                wasQuoted = false;
+                break;
+
+            case '\r':
+                // swallow the \n of a \r\n pair
+                if (bufferPos < size || fillBuffer()) {
+                    if (buffer.constData()[bufferPos] == '\n')
+                        ++bufferPos;
+                }
+                row.append(field);
+                return true;
+
+            case '\n': row.append(field); return true;
+        }
+    }
+}
+
+CSVWriter::CSVWriter(QString filePath, int bufferSize) : file(filePath), bufferSize(bufferSize)
+{
+    file.open(QIODevice::WriteOnly);
+    buffer.reserve(bufferSize);
+}
+
+void CSVWriter::encodeRow(QByteArray &out, const CSVRow &row)
+{
+    for (int f = 0; f < row.count(); ++f) {
+        if (f)
+            out.append(',');
+
+        const QByteArray &field = row[f];
+
+        bool needsQuotes = false;
+        for (char c : field) {
+            if (c == ',' || c == '"' || c == '\n' || c == '\r') {
+                needsQuotes = true;
+                break;
+            }
+        }
+
+        if (!needsQuotes) {
+            out.append(field);
+            continue;
+        }
+
+        out.append('"');
+        for (char c : field) {
+            if (c == '"')
+                out.append('"');
+            out.append(c);
+        }
+        out.append('"');
+    }
+    out.append('\n');
+}
+
+void CSVWriter::flushBuffer()
+{
+    if (buffer.size())
+        file.write(buffer);
+    buffer.resize(0);
+}
+
+void CSVWriter::writeRow(const CSVRow &row)
+{
+    encodeRow(buffer, row);
+    if (buffer.size() >= bufferSize)
+        flushBuffer();
+}
+
+void CSVWriter::writeEncoded(const QByteArray &rows)
+{
+    if (buffer.size() + rows.size() >= bufferSize) {
+        flushBuffer();
+
+        // big enough to not be worth copying into the buffer first
+        if (rows.size() >= bufferSize) {
+            file.write(rows);
+            return;
+        }
+    }
+    buffer.append(rows);
+}
+
+bool CSVWriter::close()
+{
+    if (!file.isOpen())
+        return false;
+
+    flushBuffer();
+    return file.commit();
+}
+
+namespace
+{
+
+inline int maxCSVChunks() { return qMax(QThread::idealThreadCount(), 1) * 2; }
+
+} // namespace
+
+QByteArray EncodeCSVRows(const UserDB &userDB, int start, int count)
+{
+    QByteArray out;
+
+    CSVRow fields;
+    for (int r = start; r < start + count; ++r) {
+        const UserDB::TableRow &row = userDB.rows[r];
+
+        fields.clear();
+        fields.append("0x" + QByteArray::number(row.uuid, 0x10).toUpper());
+        fields.append(row.createDate.toDateString().toLatin1());
+        fields.append(row.modifyDate.toDateString().toLatin1());
+
+        for (int c = 0; c < userDB.columns.count(); ++c) {
+            QString value = "";
+            if (c < row.entries.count())
+                value = UserDB::valueToString(userDB.columns[c].type, row.entries[c].data);
+            fields.append(value.toUtf8());
+        }
+
+        CSVWriter::encodeRow(out, fields);
+    }
+
+    return out;
+}
+
+QList<UserDB::TableRow> DecodeCSVRows(const QList<CSVRow> &csvRows, const QList<byte> &types)
+{
+    QList<UserDB::TableRow> rows;
+    rows.reserve(csvRows.count());
+
+    for (auto &fields : csvRows) {
+        UserDB::TableRow row;
+
+        QString uuid = QString::fromLatin1(fields[0]).trimmed();
+        row.uuid     = uuid.toUInt(nullptr, uuid.startsWith("0x", Qt::CaseInsensitive) ? 0x10 : 10);
+
+        if (fields.count() > 1)
+            row.createDate.fromDateString(QString::fromLatin1(fields[1]));
+        if (fields.count() > 2)
+            row.modifyDate.fromDateString(QString::fromLatin1(fields[2]));
+
+        row.entries.reserve(types.count());
+        for (int c = 0; c < types.count(); ++c) {
+            QString value = c + 3 < fields.count() ? QString::fromUtf8(fields[c + 3]) : "";
+
+            UserDB::TableRow::Value entry;
+            if (!UserDB::valueFromString(types[c], value, entry.data))
+                UserDB::valueFromString(types[c], "0", entry.data);
+            row.entries.append(entry);
+        }
+
+        rows.append(row);
+    }
+
+    return rows;
+}
+
+QList<byte> InferCSVTypes(CSVReader &reader, int columnCount)
+{
+    struct Inference {
+        bool any     = false;
+        bool isBool  = true;
+        bool isInt   = true;
+        bool isHex   = true;
+        bool isFloat = true;
+        qint64 min   = 0;
+        qint64 max   = 0;
+        quint64 hex  = 0;
+    };
+
+    QVector<Inference> columns(columnCount);
+
+    CSVRow fields;
+    while (reader.readRow(fields)) {
+        for (int c = 0; c < columnCount && c + 3 < fields.count(); ++c) {
+            QByteArray value = fields[c + 3].trimmed();
+            if (value.isEmpty())
+                continue;
+
+            Inference &column = columns[c];
+            column.any        = true;
+
+            QByteArray lower = value.toLower();
+            column.isBool &= lower == "y" || lower == "n";
+
+            bool ok = false;
+            if (column.isHex) {
+                quint64 hex  = lower.startsWith("0x") ? lower.mid(2).toULongLong(&ok, 0x10) : 0;
+                column.isHex = ok;
+                column.hex   = qMax(column.hex, hex);
+            }
+
+            if (column.isInt) {
+                qint64 number = value.toLongLong(&ok);
+                column.isInt  = ok;
+                column.min    = qMin(column.min, number);
+                column.max    = qMax(column.max, number);
+            }
+
+            if (column.isFloat) {
+                value.toDouble(&ok);
+                column.isFloat = ok;
+            }
+        }
+    }
+
+    const qint64 intMin = std::numeric_limits<int>::min();
+    const qint64 intMax = std::numeric_limits<int>::max();
+
+    QList<byte> types;
+    for (auto &column : columns) {
+        if (!column.any)
+            types.append(UserDB::TableColumn::String);
+        else if (column.isBool)
+            types.append(UserDB::TableColumn::Bool);
+        else if (column.isHex)
+            types.append(column.hex > 0xFFFFFFFF ? UserDB::TableColumn::UInt64
+                                                 : UserDB::TableColumn::UInt32);
+        else if (column.isInt)
+            types.append(column.min < intMin || column.max > intMax ? UserDB::TableColumn::Int64
+                                                                    : UserDB::TableColumn::Int32);
+        else if (column.isFloat)
+            types.append(UserDB::TableColumn::Double);
+        else
+            types.append(UserDB::TableColumn::String);
+    }
+
+    return types;
+}
+
+void TrimCSVRow(CSVRow &row)
+{
+    if (row.count() > 1 && row.last().isEmpty())
+        row.removeLast();
+}
+
+void WriteUserDBCSV(const UserDB &userDB, CSVWriter &writer, int chunkSize)
+{
+    CSVRow names = { "uuid", "Creation Date", "Modified Date" };
+    CSVRow types = { "uint32", "string", "string" };
+    for (auto &col : userDB.columns) {
+        names.append(col.name.toUtf8());
+        types.append(UserDB::typeName(col.type).toLatin1());
+    }
+    writer.writeRow(names);
+    writer.writeRow(types);
+
+    chunkSize = qMax(chunkSize, 1);
+
+    QList<QFuture<QByteArray>> chunks;
+    for (int r = 0; r < userDB.rows.count(); r += chunkSize) {
+        int count   = qMin(chunkSize, userDB.rows.count() - r);
+        auto encode = [&userDB, r, count] { return EncodeCSVRows(userDB, r, count); };
+        chunks.append(QtConcurrent::run(encode));
+
+        if (chunks.count() >= maxCSVChunks())
+            writer.writeEncoded(chunks.takeFirst().result());
+    }
+    while (chunks.count()) writer.writeEncoded(chunks.takeFirst().result());
+}
+
+bool ReadUserDBCSV(UserDB &userDB, CSVReader &reader, int chunkSize)
+{
+    userDB.columns.clear();
+    userDB.rows.clear();
+
+    CSVRow names;
+    if (!reader.readRow(names) || names.count() < 3)
+        return false;
+    TrimCSVRow(names);
+
+    for (int i = 3; i < names.count(); ++i) {
+        UserDB::TableColumn column;
+        column.name = QString::fromUtf8(names[i]);
+        userDB.columns.append(column);
+    }
+
+    // the type row is optional, if it's missing (or anything in it isn't a type) they're inferred
+    QList<byte> types;
+    CSVRow typeRow;
+    bool hasTypes = reader.readRow(typeRow) && typeRow[0] == "uint32";
+    TrimCSVRow(typeRow);
+    for (int i = 3; i < names.count() && hasTypes; ++i) {
+        QString name = i < typeRow.count() ? QString::fromLatin1(typeRow[i]) : "";
+        byte type    = UserDB::typeFromName(name);
+        hasTypes &= type != UserDB::TableColumn::Invalid || name == "invalid";
+        types.append(type);
+    }
+
+    if (!hasTypes) {
+        reader.rewind();
+        reader.readRow(names);
+        types = InferCSVTypes(reader, userDB.columns.count());
+
+        reader.rewind();
+        reader.readRow(names);
+    }
+
+    for (int c = 0; c < userDB.columns.count(); ++c)
+        userDB.columns[c].type = (UserDB::TableColumn::Types)types[c];
+
+    chunkSize = qMax(chunkSize, 1);
+
+    QList<QFuture<QList<UserDB::TableRow>>> chunks;
+    auto takeChunk = [&userDB, &chunks] { userDB.rows.append(chunks.takeFirst().result()); };
+
+    QList<CSVRow> chunk;
+    CSVRow fields;
+    while (true) {
+        bool read = reader.readRow(fields);
+        if (read && !(fields.count() == 1 && fields[0].isEmpty()))
+            chunk.append(fields);
+
+        if (chunk.count() && (chunk.count() >= chunkSize || !read)) {
+            chunks.append(QtConcurrent::run([chunk, types] { return DecodeCSVRows(chunk, types); }));
+            chunk.clear();
+
+            if (chunks.count() >= maxCSVChunks())
+                takeChunk();
+        }
+
+        if (!read)
+            break;
+    }
+    while (chunks.count()) takeChunk();
+
+    return true;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+// fields are kept as utf-8 bytes, callers decide how to interpret them
+typedef QList<QByteArray> CSVRow;
+
+// reads a csv file through a fixed size buffer, supports quoted fields (with "" escapes & line breaks)
+class CSVReader
+{
+public:
+    CSVReader(QString filePath, int bufferSize = 0x10000);
+
+    inline bool isOpen() const { return file.isOpen(); }
+    inline bool atEnd() const { return bufferPos >= buffer.size() && file.atEnd(); }
+
+    // returns false once there's nothing left to read
+    bool readRow(CSVRow &row);
+
+    // starts reading from the beginning again
+    void rewind();
+
+private:
+    QFile file;
+    QByteArray buffer;
+    int bufferSize = 0x10000;
+    int bufferPos  = 0;
+
+    bool fillBuffer();
+};
+
+// writes a csv file through a fixed size buffer, rows can also be encoded up front on other threads
+class CSVWriter
+{
+public:
+    CSVWriter(QString filePath, int bufferSize = 0x10000);
+    ~CSVWriter() { close(); }
+
+    inline bool isOpen() const { return file.isOpen(); }
+
+    static void encodeRow(QByteArray &out, const CSVRow &row);
+
+    void writeRow(const CSVRow &row);
+    void writeEncoded(const QByteArray &rows);
+
+    // flushes anything left & commits the file
+    bool close();
+
+private:
+    QSaveFile file;
+    QByteArray buffer;
+    int bufferSize = 0x10000;
+
+    void flushBuffer();
+};
+
+// user db <-> csv, the first 2 rows are the column names & their types (the type row is optional when
+// reading). rows are converted in chunks of chunkSize on the thread pool with only a few chunks in
+// flight, so memory stays flat & the rows keep their order
+void WriteUserDBCSV(const RSDKv5::UserDB &userDB, CSVWriter &writer, int chunkSize = 0x100);
+// false if the csv doesn't have the fixed uuid & date columns
+bool ReadUserDBCSV(RSDKv5::UserDB &userDB, CSVReader &reader, int chunkSize = 0x100);
+
+// the parts of the above that each chunk runs
+QByteArray EncodeCSVRows(const RSDKv5::UserDB &userDB, int start, int count);
+QList<RSDKv5::UserDB::TableRow> DecodeCSVRows(const QList<CSVRow> &csvRows, const QList<byte> &types);
+
+// used when a csv doesn't have a type row, picks the narrowest type every value in the column fits.
+// reads to the end of the file, the reader should be just past the name row
+QList<byte> InferCSVTypes(CSVReader &reader, int columnCount);
+
+// older exports end every line with a comma
+void TrimCSVRow(CSVRow &row);
@@ -0,0 +1,211 @@
+#include "includes.hpp"
+
+FrameProfiler::FrameProfiler()
+{
+    clock.start();
+    clear();
+}
+
+void FrameProfiler::setEnabled(bool state)
+{
+    if (enabled == state)
+        return;
+
+    // keep the recorded frames around after disabling so they can still be exported
+    enabled = state;
+    if (enabled)
+        clear();
+}
+
+void FrameProfiler::clear()
+{
+    inFrame = false;
+    frames.clear();
+    openEvents.clear();
+    totals.clear();
+    lastTotals.clear();
+
+    current = Frame();
+    memset(current.counters, 0, sizeof(current.counters));
+    memset(windowCounters, 0, sizeof(windowCounters));
+    memset(lastCounters, 0, sizeof(lastCounters));
+
+    windowFrameTime = 0;
+    windowFrames    = 0;
+    windowStart     = clock.nsecsElapsed();
+    lastFrameTime   = 0;
+    lastFrames      = 0;
+}
+
+void FrameProfiler::beginFrame()
+{
+    if (!enabled)
+        return;
+
+    current       = Frame();
+    current.id    = frameID++;
+    current.start = clock.nsecsElapsed();
+    memset(current.counters, 0, sizeof(current.counters));
+    openEvents.clear();
+    inFrame = true;
+}
+
+void FrameProfiler::endFrame()
+{
+    if (!enabled || !inFrame)
+        return;
+
+    // close anything that was left hanging so the trace stays well formed
+    while (openEvents.count()) end();
+
+    qint64 now       = clock.nsecsElapsed();
+    current.duration = now - current.start;
+    inFrame          = false;
+
+    for (auto &event : current.events) {
+        Total &total = totals[QString::fromLatin1(event.category) + ": " + event.name];
+        total.time += event.duration;
+        total.calls++;
+    }
+
+    windowFrameTime += current.duration;
+    for (int c = 0; c < COUNTER_COUNT; ++c) windowCounters[c] += current.counters[c];
+    ++windowFrames;
+
+    if (now - windowStart >= 1e9) {
+        lastTotals.clear();
+        for (auto it = totals.cbegin(); it != totals.cend(); ++it)
+            lastTotals.append(QPair<QString, Total>(it.key(), it.value()));
+
+        std::sort(lastTotals.begin(), lastTotals.end(),
+                  [](const QPair<QString, Total> &a, const QPair<QString, Total> &b) -> bool {
+                      return a.second.time > b.second.time;
+                  });
+
+        lastFrameTime = windowFrameTime;
+        lastFrames    = windowFrames;
+        memcpy(lastCounters, windowCounters, sizeof(lastCounters));
+
+        totals.clear();
+        windowFrameTime = 0;
+        windowFrames    = 0;
+        memset(windowCounters, 0, sizeof(windowCounters));
+        windowStart = now;
+    }
+
+    frames.append(current);
+    while (frames.count() > maxFrames) frames.removeFirst();
+}
+
+void FrameProfiler::begin(const QString &name, const char *category)
+{
+    if (!enabled || !inFrame)
+        return;
+
+    Event event;
+    event.name     = name;
+    event.category = category;
+    event.depth    = openEvents.count();
+    event.start    = clock.nsecsElapsed();
+
+    openEvents.append(current.events.count());
+    current.events.append(event);
+}
+
+void FrameProfiler::end()
+{
+    if (!enabled || !inFrame || !openEvents.count())
+        return;
+
+    Event &event   = current.events[openEvents.takeLast()];
+    event.duration = clock.nsecsElapsed() - event.start;
+}
+
+QStringList FrameProfiler::summary(int maxLines)
+{
+    QStringList lines;
+    if (!lastFrames) {
+        lines.append("Profiler: collecting...");
+        return lines;
+    }
+
+    float frameMS = (lastFrameTime / (float)lastFrames) / 1e6f;
+    lines.append(QString("Frame: %1 ms (%2 frames)").arg(frameMS, 0, 'f', 2).arg(lastFrames));
+    lines.append(QString("Vertices: %1, States: %2, Draw Calls: %3, Composite Passes: %4")
+                     .arg(lastCounters[COUNTER_VERTICES] / lastFrames)
+                     .arg(lastCounters[COUNTER_RENDERSTATES] / lastFrames)
+                     .arg(lastCounters[COUNTER_DRAWCALLS] / lastFrames)
+                     .arg(lastCounters[COUNTER_COMPOSITEPASSES] / lastFrames));
+
+    for (int i = 0; i < lastTotals.count() && lines.count() < maxLines; ++i) {
+        auto &total = lastTotals[i];
+        lines.append(QString("%1 ms  x%2  %3")
+                         .arg((total.second.time / (float)lastFrames) / 1e6f, 6, 'f', 3)
+                         .arg(total.second.calls / lastFrames)
+                         .arg(total.first));
+    }
+
+    return lines;
+}
+
+bool FrameProfiler::exportTrace(QString filePath)
+{
+    QJsonArray traceEvents;
+
+    QJsonObject process;
+    process.insert("name", "process_name");
+    process.insert("ph", "M");
+    process.insert("pid", 1);
+    process.insert("tid", 1);
+    process.insert("args", QJsonObject({ { "name", "RetroED SceneViewer" } }));
+    traceEvents.append(process);
+
+    const char *counterNames[] = { "Vertices", "Render States", "Draw Calls", "Composite Passes" };
+
+    for (auto &frame : frames) {
+        QJsonObject frameEvent;
+        frameEvent.insert("name", QString("Frame %1").arg(frame.id));
+        frameEvent.insert("cat", "frame");
+        frameEvent.insert("ph", "X");
+        frameEvent.insert("ts", frame.start / 1000.0);
+        frameEvent.insert("dur", frame.duration / 1000.0);
+        frameEvent.insert("pid", 1);
+        frameEvent.insert("tid", 1);
+        traceEvents.append(frameEvent);
+
+        for (auto &event : frame.events) {
+            QJsonObject traceEvent;
+            traceEvent.insert("name", event.name);
+            traceEvent.insert("cat", QLatin1String(event.category));
+            traceEvent.insert("ph", "X");
+            traceEvent.insert("ts", event.start / 1000.0);
+            traceEvent.insert("dur", event.duration / 1000.0);
+            traceEvent.insert("pid", 1);
+            traceEvent.insert("tid", 1);
+            traceEvents.append(traceEvent);
+        }
+
+        QJsonObject args;
+        for (int c = 0; c < COUNTER_COUNT; ++c) args.insert(counterNames[c], frame.counters[c]);
+
+        QJsonObject counterEvent;
+        counterEvent.insert("name", "Counters");
+        counterEvent.insert("ph", "C");
+        counterEvent.insert("ts", frame.start / 1000.0);
+        counterEvent.insert("pid", 1);
+        counterEvent.insert("args", args);
+        traceEvents.append(counterEvent);
+    }
+
+    QJsonObject root;
+    root.insert("traceEvents", traceEvents);
+    root.insert("displayTimeUnit", "ms");
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    file.close();
+    return true;
+}
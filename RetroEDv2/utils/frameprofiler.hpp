@@ -0,0 +1,113 @@
+#pragma once
+
+class FrameProfiler
+{
+public:
+    enum CounterTypes {
+        COUNTER_VERTICES,
+        COUNTER_RENDERSTATES,
+        COUNTER_DRAWCALLS,
+        COUNTER_COMPOSITEPASSES,
+        COUNTER_COUNT,
+    };
+
+    struct Event {
+        QString name;
+        const char *category = ""; // always a literal
+        qint64 start         = 0;  // nsecs since the profiler was created
+        qint64 duration      = 0;
+        int depth            = 0;
+    };
+
+    struct Frame {
+        int id          = 0;
+        qint64 start    = 0;
+        qint64 duration = 0;
+        int counters[COUNTER_COUNT];
+
+        QList<Event> events;
+    };
+
+    // RAII helper, does nothing if the profiler is disabled when it's created. scopes sit in hot loops,
+    // so nothing gets converted to a QString (& allocated) unless the profiler is running
+    class Scope
+    {
+    public:
+        Scope(FrameProfiler &profiler, const QString &name, const char *category)
+            : profiler(profiler.enabled ? &profiler : nullptr)
+        {
+            if (this->profiler)
+                this->profiler->begin(name, category);
+        }
+        Scope(FrameProfiler &profiler, const char *name, const char *category)
+            : profiler(profiler.enabled ? &profiler : nullptr)
+        {
+            if (this->profiler)
+                this->profiler->begin(QString::fromLatin1(name), category);
+        }
+        ~Scope()
+        {
+            if (profiler)
+                profiler->end();
+        }
+
+    private:
+        FrameProfiler *profiler = nullptr;
+    };
+
+    FrameProfiler();
+
+    bool enabled     = false;
+    bool showOverlay = false;
+
+    // how many frames are kept around for trace exports
+    int maxFrames = 600;
+
+    void setEnabled(bool state);
+
+    void beginFrame();
+    void endFrame();
+
+    void begin(const QString &name, const char *category);
+    void end();
+
+    inline void addCounter(byte type, int amount)
+    {
+        if (enabled && inFrame)
+            current.counters[type] += amount;
+    }
+
+    // averaged over the last completed second, for the overlay
+    QStringList summary(int maxLines = 16);
+
+    bool exportTrace(QString filePath);
+
+    void clear();
+
+private:
+    struct Total {
+        qint64 time = 0;
+        int calls   = 0;
+    };
+
+    QElapsedTimer clock;
+
+    bool inFrame = false;
+    int frameID  = 0;
+    Frame current;
+    QList<int> openEvents;
+    QList<Frame> frames;
+
+    // accumulated over the current sampling window
+    QHash<QString, Total> totals;
+    qint64 windowFrameTime = 0;
+    int windowCounters[COUNTER_COUNT];
+    int windowFrames     = 0;
+    qint64 windowStart   = 0;
+
+    // last completed sampling window
+    QList<QPair<QString, Total>> lastTotals;
+    qint64 lastFrameTime = 0;
+    int lastCounters[COUNTER_COUNT];
+    int lastFrames = 0;
+};